@@ -20,38 +20,43 @@ All rights reserved.
 /******************************************************************************/
 #include "AnimatorSystem.h"
 
-AnimatorSystem::AnimatorSystem() : System_Internal(&AnimatorSystem::UpdateAnimatorComp) {}
+AnimatorSystem::AnimatorSystem() : ParallelSystem_Internal(&AnimatorSystem::UpdateAnimatorComp)
+{
+	// Only touches the animator and the sprite of the same entity, and reads animation resources.
+	DeclareWrites<RenderComponent>();
+	AllowConcurrentExecution();
+}
 
 void AnimatorSystem::UpdateAnimatorComp(AnimatorComponent& animatorComp)
 {
-    if(animatorComp.GetCurrentAnimationName().empty() || !ResourceManager::AnimationExists(animatorComp.GetCurrentAnimationName()) || !animatorComp.IsPlaying()) return;
-    auto entity = ecs::GetEntity(&animatorComp);
-    if(!entity->GetComp<RenderComponent>())
-    {
-        return;
-    }
-    float dt{ GameTime::FixedDt() };
-    const Animation& anim = ResourceManager::GetAnimation(animatorComp.GetCurrentAnimationName());
-    const FrameData& frameData = anim.frames[animatorComp.GetCurrentFrame()];
-
-    animatorComp.currentFrameTime += dt * animatorComp.playbackSpeed;
-
-    if(animatorComp.currentFrameTime >= frameData.duration) {
-        animatorComp.currentFrameTime -= frameData.duration;
-        animatorComp.currentFrame++;
-
-        // Handle animation completion
-        if(animatorComp.currentFrame >= anim.totalFrames) {
-            if(animatorComp.IsLooping()) {
-                animatorComp.currentFrame = 0;
-            }
-            else {
-                animatorComp.currentFrame = anim.totalFrames - 1;
-                animatorComp.isPlaying = false;
-            }
-        }
-
-    }
-    const FrameData& new_frameData = anim.frames[animatorComp.currentFrame];
-    entity->GetComp<RenderComponent>()->SetSpriteID(new_frameData.spriteID);
+	if(animatorComp.GetCurrentAnimationName().empty() || !ResourceManager::AnimationExists(animatorComp.GetCurrentAnimationName()) || !animatorComp.IsPlaying()) return;
+	auto entity = ecs::GetEntity(&animatorComp);
+	if(!entity->GetComp<RenderComponent>())
+	{
+		return;
+	}
+	float dt{ GameTime::FixedDt() };
+	const Animation& anim = ResourceManager::GetAnimation(animatorComp.GetCurrentAnimationName());
+	const FrameData& frameData = anim.frames[animatorComp.GetCurrentFrame()];
+
+	animatorComp.currentFrameTime += dt * animatorComp.playbackSpeed;
+
+	if(animatorComp.currentFrameTime >= frameData.duration) {
+		animatorComp.currentFrameTime -= frameData.duration;
+		animatorComp.currentFrame++;
+
+		// Handle animation completion
+		if(animatorComp.currentFrame >= anim.totalFrames) {
+			if(animatorComp.IsLooping()) {
+				animatorComp.currentFrame = 0;
+			}
+			else {
+				animatorComp.currentFrame = anim.totalFrames - 1;
+				animatorComp.isPlaying = false;
+			}
+		}
+
+	}
+	const FrameData& new_frameData = anim.frames[animatorComp.currentFrame];
+	entity->GetComp<RenderComponent>()->SetSpriteID(new_frameData.spriteID);
 }
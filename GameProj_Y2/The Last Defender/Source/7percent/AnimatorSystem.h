@@ -22,7 +22,7 @@ All rights reserved.
 
 #include "AnimatorComponent.h"
 
-class AnimatorSystem : public ecs::System<AnimatorSystem, AnimatorComponent>
+class AnimatorSystem : public ecs::ParallelSystem<AnimatorSystem, AnimatorComponent>
 {
 public:
   explicit AnimatorSystem();
@@ -0,0 +1,1061 @@
+/******************************************************************************/
+/*!
+\file   Benchmarks.cpp
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the source file implementing engine benchmarks. Benchmarks that create
+  entities do so within the benchmark ECS pool so the scene is left untouched.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#include "Benchmarks.h"
+#include "PrefabManager.h"
+#include "GameSettings.h"
+#include "Collision.h"
+#include "Broadphase.h"
+#include "Narrowphase.h"
+#include "ContactSolver.h"
+#include "JobSystem.h"
+#include "Physics.h"
+#include "ECSSysLayers.h"
+#include "ryan-c/DrawKeys.h"
+#include "ryan-c/VulkanContext.h"
+
+namespace benchmarks {
+
+#pragma region Helpers
+
+	namespace {
+
+		/*****************************************************************//*!
+		\class BenchmarkPoolScope
+		\brief
+			Switches to a fresh benchmark ECS pool on construction, and deletes it and switches back to the previous pool on destruction.
+		*//******************************************************************/
+		class BenchmarkPoolScope
+		{
+		public:
+			BenchmarkPoolScope()
+				: prevPool{ ecs::GetCurrentPoolId() }
+			{
+				ecs::SwitchToPool(ecs::POOL::BENCHMARK);
+			}
+
+			~BenchmarkPoolScope()
+			{
+				// Setting an entity's layer lists it in EntitiesByLayer, which would keep handles to the deleted entities
+				for (auto layerCompIter{ ecs::GetCompsBegin<EntityLayerComponent>() }, endIter{ ecs::GetCompsEnd<EntityLayerComponent>() }; layerCompIter != endIter; ++layerCompIter)
+					ST<EntitiesByLayer>::Get()->RemoveEntity(layerCompIter->GetLayer(), layerCompIter.GetEntity());
+
+				ecs::SwitchToPool(prevPool);
+				ecs::DeletePool(ecs::POOL::BENCHMARK);
+			}
+
+		private:
+			ecs::POOL prevPool;
+		};
+
+		/*****************************************************************//*!
+		\brief
+			Times the average duration of a function over a number of iterations.
+		\param numIterations
+			The number of times to call the function.
+		\param func
+			The function to time.
+		\return
+			The average duration of 1 call, in milliseconds.
+		*//******************************************************************/
+		template <typename FuncType>
+		double TimeAverageMs(int numIterations, FuncType&& func)
+		{
+			auto startTime{ std::chrono::high_resolution_clock::now() };
+			for (int i{}; i < numIterations; ++i)
+				func();
+			std::chrono::duration<double, std::milli> duration{ std::chrono::high_resolution_clock::now() - startTime };
+			return duration.count() / numIterations;
+		}
+
+		/*****************************************************************//*!
+		\brief
+			Gets the entity counts that a benchmark should be run with.
+		\param args
+			The arguments passed to the benchmark. If any are numbers, they are used as the entity counts.
+		\param defaultCounts
+			The entity counts to use if no numbers are passed to the benchmark.
+		\return
+			The entity counts.
+		*//******************************************************************/
+		std::vector<int> GetEntityCounts(const std::vector<std::string>& args, std::initializer_list<int> defaultCounts)
+		{
+			std::vector<int> counts{};
+			for (const std::string& arg : args)
+				try {
+					counts.push_back(std::stoi(arg));
+				}
+				catch (const std::exception&) {}
+
+			if (counts.empty())
+				counts.assign(defaultCounts);
+			return counts;
+		}
+
+	}
+
+#pragma endregion // Helpers
+
+#pragma region ECS Iteration
+
+	namespace {
+
+		struct BenchPosition { Vector2 pos; };
+		struct BenchVelocity { Vector2 vel; };
+		struct BenchHealth { float health; };
+		struct BenchTag { int tag; };
+
+		/*****************************************************************//*!
+		\class BenchMoveSystem
+		\brief
+			A system requiring 2 components, exposing both the CompArr and cached query iteration paths.
+		*//******************************************************************/
+		class BenchMoveSystem : public ecs::System<BenchMoveSystem, BenchPosition, BenchVelocity>
+		{
+		public:
+			BenchMoveSystem()
+				: System_Internal{ &BenchMoveSystem::UpdateComp }
+			{
+			}
+
+			void RunByCompArr()
+			{
+				RunOnCompArr(*ecs::internal::GetCompArrWithLeastComps<BenchPosition, BenchVelocity>());
+			}
+
+			void RunByQuery()
+			{
+				RunOnQuery();
+			}
+
+		private:
+			void UpdateComp(BenchPosition& position, BenchVelocity& velocity)
+			{
+				position.pos += velocity.vel * 0.016f;
+			}
+		};
+
+		/*****************************************************************//*!
+		\brief
+			Compares iterating a 2 component system via CompArr lookups against via its cached archetype query.
+			Entities are given varying component sets so that multiple archetypes exist.
+		\param args
+			Entity counts to benchmark with. Defaults to 1k, 10k and 100k.
+		*//******************************************************************/
+		void BenchmarkECSIteration(const std::vector<std::string>& args)
+		{
+			constexpr int numIterations{ 20 };
+
+			for (int numEntities : GetEntityCounts(args, { 1000, 10000, 100000 }))
+			{
+				BenchmarkPoolScope poolScope{};
+
+				for (int i{}; i < numEntities; ++i)
+				{
+					ecs::EntityHandle entity{ reinterpret_cast<ecs::EntityHandle>(ecs::internal::CurrentPool::Entities().CreateEntity(nullptr)) };
+					entity->AddCompNow(BenchPosition{ Vector2{ static_cast<float>(i), 0.0f } });
+					if (i % 2 == 0)
+						entity->AddCompNow(BenchVelocity{ Vector2{ 1.0f, 1.0f } });
+					if (i % 3 == 0)
+						entity->AddCompNow(BenchHealth{ 100.0f });
+					if (i % 5 == 0)
+						entity->AddCompNow(BenchTag{ i });
+				}
+
+				BenchMoveSystem system{};
+				double compArrMs{ TimeAverageMs(numIterations, [&system]() -> void { system.RunByCompArr(); }) };
+				double queryMs{ TimeAverageMs(numIterations, [&system]() -> void { system.RunByQuery(); }) };
+
+				CONSOLE_LOG(LEVEL_INFO) << "ECS iteration (" << numEntities << " entities, "
+					<< ecs::internal::CurrentPool::Archetypes()->GetNumArchetypes() << " archetypes): CompArr "
+					<< compArrMs << "ms, query " << queryMs << "ms, speedup " << compArrMs / queryMs << "x";
+			}
+		}
+
+	}
+
+#pragma endregion // ECS Iteration
+
+#pragma region CompArr Layout
+
+	namespace {
+
+		/*****************************************************************//*!
+		\struct InterleavedBenchPosition
+		\brief
+			Mimics the previous CompArr layout, where each component was prefixed by pointers to its CompArr and entity.
+		*//******************************************************************/
+		struct InterleavedBenchPosition
+		{
+			void* compArr;
+			ecs::internal::InternalEntityHandle entity;
+			BenchPosition comp;
+		};
+
+		/*****************************************************************//*!
+		\brief
+			Compares looping over only components and only entities within a CompArr, against the same loops
+			over an interleaved array mimicking the previous layout. Also times looking up entities from component addresses,
+			both within a single CompArr and alternating between 4 CompArrs, along with how often the per-thread lookup cache hit.
+			Hardware cache miss counts aren't available from within the engine, so the bytes streamed per component
+			are printed instead. To get cache miss counts, run this benchmark under a profiler such as VTune or perf.
+		\param args
+			Entity counts to benchmark with. Defaults to 10k, 100k and 1m.
+		*//******************************************************************/
+		void BenchmarkCompArrLayout(const std::vector<std::string>& args)
+		{
+			constexpr int numIterations{ 20 };
+
+			for (int numEntities : GetEntityCounts(args, { 10000, 100000, 1000000 }))
+			{
+				BenchmarkPoolScope poolScope{};
+
+				std::vector<InterleavedBenchPosition> interleaved{};
+				interleaved.reserve(numEntities);
+				for (int i{}; i < numEntities; ++i)
+				{
+					ecs::internal::InternalEntityHandle entity{ ecs::internal::CurrentPool::Entities().CreateEntity(nullptr) };
+					reinterpret_cast<ecs::EntityHandle>(entity)->AddCompNow(BenchPosition{ Vector2{ static_cast<float>(i), 0.0f } });
+					reinterpret_cast<ecs::EntityHandle>(entity)->AddCompNow(BenchVelocity{ Vector2{ 1.0f, 1.0f } });
+					reinterpret_cast<ecs::EntityHandle>(entity)->AddCompNow(BenchHealth{ 100.0f });
+					reinterpret_cast<ecs::EntityHandle>(entity)->AddCompNow(BenchTag{ i });
+					interleaved.push_back(InterleavedBenchPosition{ nullptr, entity, BenchPosition{ Vector2{ static_cast<float>(i), 0.0f } } });
+				}
+				ecs::internal::CompArr& compArr{ ecs::internal::GetCompArr<BenchPosition>() };
+
+				// Sums are printed so that the loops aren't optimized away
+				float compSum{}, entitySum{};
+
+				double splitCompMs{ TimeAverageMs(numIterations, [&compArr, &compSum]() -> void {
+					for (auto iter{ compArr.User_Begin<BenchPosition, ecs::EntityHandle>() }, end{ compArr.User_End<BenchPosition, ecs::EntityHandle>() }; iter != end; ++iter)
+						compSum += iter->pos.x;
+				}) };
+				double interleavedCompMs{ TimeAverageMs(numIterations, [&interleaved, &compSum]() -> void {
+					for (const InterleavedBenchPosition& elem : interleaved)
+						compSum += elem.comp.pos.x;
+				}) };
+
+				double splitEntityMs{ TimeAverageMs(numIterations, [&compArr, &entitySum]() -> void {
+					for (uint32_t index{}, end{ compArr.GetNumComps() }; index < end; ++index)
+						entitySum += static_cast<float>(reinterpret_cast<uintptr_t>(compArr.GetEntity(index)) & 1);
+				}) };
+				double interleavedEntityMs{ TimeAverageMs(numIterations, [&interleaved, &entitySum]() -> void {
+					for (const InterleavedBenchPosition& elem : interleaved)
+						entitySum += static_cast<float>(reinterpret_cast<uintptr_t>(elem.entity) & 1);
+				}) };
+
+				ecs::internal::CompArr::ResetLookupStats();
+				double lookupEntityMs{ TimeAverageMs(numIterations, [&compArr, &entitySum]() -> void {
+					for (auto iter{ compArr.User_Begin<BenchPosition, ecs::EntityHandle>() }, end{ compArr.User_End<BenchPosition, ecs::EntityHandle>() }; iter != end; ++iter)
+						entitySum += static_cast<float>(reinterpret_cast<uintptr_t>(ecs::GetEntity(&*iter)) & 1);
+				}) };
+				ecs::internal::CompArr::LookupStats lookupStats{ ecs::internal::CompArr::GetLookupStats() };
+
+				// Entities were given their components in the same order, so each entity's components are at the same index in every CompArr
+				std::array<ecs::internal::CompArr*, 4> mixedCompArrs{ &compArr, &ecs::internal::GetCompArr<BenchVelocity>(),
+					&ecs::internal::GetCompArr<BenchHealth>(), &ecs::internal::GetCompArr<BenchTag>() };
+				ecs::internal::CompArr::ResetLookupStats();
+				double lookupMixedMs{ TimeAverageMs(numIterations, [&mixedCompArrs, &entitySum]() -> void {
+					for (uint32_t index{}, end{ mixedCompArrs[0]->GetNumComps() }; index < end; ++index)
+						for (ecs::internal::CompArr* mixedCompArr : mixedCompArrs)
+							entitySum += static_cast<float>(reinterpret_cast<uintptr_t>(ecs::GetEntity(mixedCompArr->GetComp(index))) & 1);
+				}) };
+				ecs::internal::CompArr::LookupStats mixedLookupStats{ ecs::internal::CompArr::GetLookupStats() };
+
+				auto getHitRate{ [](const ecs::internal::CompArr::LookupStats& stats) -> double {
+					return 100.0 * static_cast<double>(stats.numHits) / static_cast<double>(std::max<size_t>(stats.numHits + stats.numMisses, 1));
+				} };
+				double nsPerLookup{ 1000000.0 / numEntities };
+
+				CONSOLE_LOG(LEVEL_INFO) << "CompArr layout (" << numEntities << " entities, "
+					<< sizeof(BenchPosition) << " bytes/comp split vs " << sizeof(InterleavedBenchPosition) << " bytes/comp interleaved): "
+					<< "comp loop " << splitCompMs << "ms vs " << interleavedCompMs << "ms, "
+					<< "entity loop " << splitEntityMs << "ms vs " << interleavedEntityMs << "ms, "
+					<< "entity from comp addr " << lookupEntityMs * nsPerLookup << "ns/lookup (" << getHitRate(lookupStats) << "% cached) in 1 CompArr, "
+					<< lookupMixedMs * nsPerLookup / mixedCompArrs.size() << "ns/lookup (" << getHitRate(mixedLookupStats) << "% cached) across "
+					<< mixedCompArrs.size() << " CompArrs (sums " << compSum << ", " << entitySum << ")";
+			}
+		}
+
+	}
+
+#pragma endregion // CompArr Layout
+
+#pragma region Prefab Instancing
+
+	namespace {
+
+		/*****************************************************************//*!
+		\brief
+			Compares spawning copies of a prefab by cloning the cached prefab entity once per copy,
+			against instantiating all copies at once from the prefab's compiled template.
+		\param args
+			The name of the prefab, and numbers of copies to spawn. Defaults to 1000 "Bullet" prefabs.
+		*//******************************************************************/
+		void BenchmarkPrefabInstancing(const std::vector<std::string>& args)
+		{
+			constexpr int numIterations{ 10 };
+
+			std::string prefabName{ "Bullet" };
+			for (const std::string& arg : args)
+				if (arg.find_first_not_of("0123456789") != std::string::npos)
+					prefabName = arg;
+
+			ecs::EntityHandle prefabEntity{ PrefabManager::GetCachedPrefab(prefabName) };
+			if (!prefabEntity)
+			{
+				CONSOLE_LOG(LEVEL_ERROR) << "Prefab '" << prefabName << "' does not exist";
+				return;
+			}
+
+			for (int numCopies : GetEntityCounts(args, { 1000 }))
+			{
+				// Each spawn happens within a fresh pool so that both paths start from the same state
+				double cloneMs{}, instantiateMs{};
+				for (int iteration{}; iteration < numIterations; ++iteration)
+				{
+					{
+						BenchmarkPoolScope poolScope{};
+						cloneMs += TimeAverageMs(1, [prefabEntity, numCopies]() -> void {
+							ecs::SwitchToPool(ecs::POOL::PREFAB_CACHE);
+							for (int i{}; i < numCopies; ++i)
+								ecs::CloneEntityToPoolNow(prefabEntity, ecs::POOL::BENCHMARK, true);
+							ecs::SwitchToPool(ecs::POOL::BENCHMARK);
+						});
+					}
+					{
+						BenchmarkPoolScope poolScope{};
+						instantiateMs += TimeAverageMs(1, [&prefabName, numCopies]() -> void {
+							PrefabManager::LoadPrefabs(prefabName, static_cast<uint32_t>(numCopies));
+						});
+					}
+				}
+
+				CONSOLE_LOG(LEVEL_INFO) << "Prefab instancing (" << numCopies << " '" << prefabName << "'): CloneEntityToPoolNow "
+					<< cloneMs / numIterations << "ms, template " << instantiateMs / numIterations << "ms, speedup " << cloneMs / instantiateMs << "x";
+			}
+		}
+
+	}
+
+#pragma endregion // Prefab Instancing
+
+#pragma region Raycast
+
+	namespace {
+
+		/*****************************************************************//*!
+		\brief
+			Raycasts by testing every active collider, which is how raycasts were done before the broadphase.
+		\param origin
+			The origin of the ray.
+		\param direction
+			The direction of the ray.
+		\param mask
+			The layers to raycast against.
+		\param outRaycastResult
+			The closest hit is written here.
+		\return
+			True if the ray hit a collider. False otherwise.
+		*//******************************************************************/
+		bool RaycastLinear(const Vector2& origin, const Vector2& direction, const EntityLayersMask& mask, Physics::RaycastResult* outRaycastResult)
+		{
+			Physics::Ray ray{ .originPoint = origin, .direction = direction };
+
+			bool collided{ false };
+			for (auto iter{ ecs::GetCompsActiveBegin<Physics::ColliderComp>() }, end{ ecs::GetCompsEnd<Physics::ColliderComp>() }; iter != end; ++iter)
+				if (iter->GetMask().TestMaskRaw(mask) && iter->CheckRaycast(ray, outRaycastResult))
+					collided = true;
+			return collided;
+		}
+
+		/*****************************************************************//*!
+		\brief
+			Compares raycasting against every collider against raycasting via the broadphase, with colliders of random sizes
+			on random layers scattered across the world. Rays start at random positions, point in random directions, and
+			either test all layers or a single random layer. The results of both are compared to ensure they are identical.
+		\param args
+			Numbers of colliders to benchmark with. Defaults to 5000.
+		*//******************************************************************/
+		void BenchmarkRaycast(const std::vector<std::string>& args)
+		{
+			constexpr int numRays{ 10000 };
+			constexpr float worldHalfExtent{ 5000.0f };
+
+			for (int numColliders : GetEntityCounts(args, { 5000 }))
+			{
+				BenchmarkPoolScope poolScope{};
+
+				std::vector<ecs::EntityHandle> entities{ ecs::CreateEntities(static_cast<uint32_t>(numColliders), Physics::ColliderComp{}, EntityLayerComponent{}) };
+				ecs::FlushChanges();
+				for (ecs::EntityHandle entity : entities)
+				{
+					entity->GetTransform().SetWorldPosition(Vector2{ util::RandomRangeFloat(-worldHalfExtent, worldHalfExtent), util::RandomRangeFloat(-worldHalfExtent, worldHalfExtent) });
+					entity->GetTransform().SetWorldScale(Vector2{ util::RandomRangeFloat(10.0f, 150.0f), util::RandomRangeFloat(10.0f, 150.0f) });
+					entity->GetComp<EntityLayerComponent>()->SetLayer(static_cast<ENTITY_LAYER>(util::RandomRange(0, +ENTITY_LAYER::TOTAL)));
+				}
+
+				double syncMs{ TimeAverageMs(1, []() -> void { ST<Physics::Broadphase>::Get()->Sync(); }) };
+
+				struct BenchRay
+				{
+					Vector2 origin;
+					Vector2 direction;
+					EntityLayersMask mask;
+				};
+				std::vector<BenchRay> rays{};
+				rays.reserve(numRays);
+				for (int i{}; i < numRays; ++i)
+				{
+					float angle{ util::RandomRangeFloat(0.0f, 2.0f * math::PI_f) };
+					EntityLayersMask mask{};
+					if (i % 2)
+						mask = EntityLayersMask{ { static_cast<ENTITY_LAYER>(util::RandomRange(0, +ENTITY_LAYER::TOTAL)) } };
+					rays.push_back(BenchRay{
+						Vector2{ util::RandomRangeFloat(-worldHalfExtent, worldHalfExtent), util::RandomRangeFloat(-worldHalfExtent, worldHalfExtent) },
+						Vector2{ std::cos(angle), std::sin(angle) },
+						mask
+					});
+				}
+
+				std::vector<Physics::RaycastResult> linearResults(numRays), broadphaseResults(numRays);
+				double linearMs{ TimeAverageMs(1, [&rays, &linearResults]() -> void {
+					for (int i{}; i < numRays; ++i)
+						RaycastLinear(rays[i].origin, rays[i].direction, rays[i].mask, &linearResults[i]);
+				}) };
+				double broadphaseMs{ TimeAverageMs(1, [&rays, &broadphaseResults]() -> void {
+					for (int i{}; i < numRays; ++i)
+						Physics::Raycast(rays[i].origin, rays[i].direction, rays[i].mask, &broadphaseResults[i]);
+				}) };
+
+				// Compare distances rather than colliders, since rays starting within overlapping colliders hit all of them at distance 0
+				int numMismatches{};
+				for (int i{}; i < numRays; ++i)
+					if (linearResults[i].distance != broadphaseResults[i].distance)
+						++numMismatches;
+
+				CONSOLE_LOG(numMismatches ? LEVEL_ERROR : LEVEL_INFO) << "Raycast (" << numRays << " rays, " << numColliders << " colliders): linear "
+					<< linearMs << "ms, broadphase " << broadphaseMs << "ms (sync " << syncMs << "ms), speedup " << linearMs / broadphaseMs
+					<< "x, " << numMismatches << " mismatched results";
+			}
+		}
+
+	}
+
+#pragma endregion // Raycast
+
+#pragma region Overlap Queries
+
+	namespace {
+
+		/*****************************************************************//*!
+		\brief
+			Compares finding colliders within circles and finding the nearest colliders to points by testing every active
+			collider, against doing so via the broadphase. Colliders of random sizes on random layers are scattered across
+			the world, and queries either search all layers or a single random layer. The number of colliders found within
+			each circle and the distances to the nearest colliders are compared to ensure they are identical.
+		\param args
+			Numbers of colliders to benchmark with. Defaults to 5000.
+		*//******************************************************************/
+		void BenchmarkOverlapQueries(const std::vector<std::string>& args)
+		{
+			constexpr int numQueries{ 10000 };
+			constexpr int numNearest{ 8 };
+			constexpr float worldHalfExtent{ 5000.0f };
+			constexpr float maxRadius{ 500.0f };
+
+			for (int numColliders : GetEntityCounts(args, { 5000 }))
+			{
+				BenchmarkPoolScope poolScope{};
+
+				std::vector<ecs::EntityHandle> entities{ ecs::CreateEntities(static_cast<uint32_t>(numColliders), Physics::ColliderComp{}, EntityLayerComponent{}) };
+				ecs::FlushChanges();
+				for (ecs::EntityHandle entity : entities)
+				{
+					entity->GetTransform().SetWorldPosition(Vector2{ util::RandomRangeFloat(-worldHalfExtent, worldHalfExtent), util::RandomRangeFloat(-worldHalfExtent, worldHalfExtent) });
+					entity->GetTransform().SetWorldScale(Vector2{ util::RandomRangeFloat(10.0f, 150.0f), util::RandomRangeFloat(10.0f, 150.0f) });
+					entity->GetComp<EntityLayerComponent>()->SetLayer(static_cast<ENTITY_LAYER>(util::RandomRange(0, +ENTITY_LAYER::TOTAL)));
+				}
+				ST<Physics::Broadphase>::Get()->Sync();
+
+				struct BenchQuery
+				{
+					Vector2 center;
+					float radius;
+					EntityLayersMask mask;
+				};
+				std::vector<BenchQuery> queries{};
+				queries.reserve(numQueries);
+				for (int i{}; i < numQueries; ++i)
+				{
+					EntityLayersMask mask{};
+					if (i % 2)
+						mask = EntityLayersMask{ { static_cast<ENTITY_LAYER>(util::RandomRange(0, +ENTITY_LAYER::TOTAL)) } };
+					queries.push_back(BenchQuery{
+						Vector2{ util::RandomRangeFloat(-worldHalfExtent, worldHalfExtent), util::RandomRangeFloat(-worldHalfExtent, worldHalfExtent) },
+						util::RandomRangeFloat(10.0f, maxRadius),
+						mask
+					});
+				}
+
+				// Each query's distances to every matching collider, for the linear searches
+				auto getDistances{ [](const BenchQuery& query, std::vector<float>* outDistances) -> void {
+					outDistances->clear();
+					for (auto iter{ ecs::GetCompsActiveBegin<Physics::ColliderComp>() }, end{ ecs::GetCompsEnd<Physics::ColliderComp>() }; iter != end; ++iter)
+					{
+						if (!iter->GetMask().TestMaskRaw(query.mask))
+							continue;
+						Physics::BoxWrapper box{ iter->CreateBoxWrapper() };
+						Vector2 offset{ std::max(std::fabs(query.center.x - box.GetCenter().x) - box.GetHalfLengths().x, 0.0f),
+							std::max(std::fabs(query.center.y - box.GetCenter().y) - box.GetHalfLengths().y, 0.0f) };
+						outDistances->push_back(offset.Length());
+					}
+				} };
+
+				std::vector<uint32_t> linearCounts(numQueries), broadphaseCounts(numQueries);
+				std::vector<float> linearNearest(numQueries * numNearest, -1.0f), broadphaseNearest(numQueries * numNearest, -1.0f);
+				std::vector<float> distances{};
+				double linearMs{ TimeAverageMs(1, [&]() -> void {
+					for (int i{}; i < numQueries; ++i)
+					{
+						getDistances(queries[i], &distances);
+						linearCounts[i] = static_cast<uint32_t>(std::count_if(distances.begin(), distances.end(), [radius = queries[i].radius](float distance) -> bool {
+							return distance <= radius;
+						}));
+						std::erase_if(distances, [](float distance) -> bool { return distance > maxRadius; });
+						std::sort(distances.begin(), distances.end());
+						std::copy_n(distances.begin(), std::min(distances.size(), static_cast<size_t>(numNearest)), linearNearest.begin() + i * numNearest);
+					}
+				}) };
+
+				std::vector<ecs::CompHandle<Physics::ColliderComp>> overlapBuffer(numColliders);
+				std::array<Physics::NearestResult, numNearest> nearestBuffer{};
+				double broadphaseMs{ TimeAverageMs(1, [&]() -> void {
+					for (int i{}; i < numQueries; ++i)
+					{
+						broadphaseCounts[i] = Physics::OverlapCircle(queries[i].center, queries[i].radius, queries[i].mask, overlapBuffer);
+						uint32_t numFound{ Physics::QueryNearest(queries[i].center, maxRadius, queries[i].mask, nearestBuffer) };
+						for (uint32_t j{}; j < numFound; ++j)
+							broadphaseNearest[i * numNearest + j] = nearestBuffer[j].distance;
+					}
+				}) };
+
+				// Compare distances rather than colliders, since colliders at the same distance may be found in either order
+				int numMismatches{};
+				for (int i{}; i < numQueries; ++i)
+					if (linearCounts[i] != broadphaseCounts[i] ||
+						!std::equal(linearNearest.begin() + i * numNearest, linearNearest.begin() + (i + 1) * numNearest, broadphaseNearest.begin() + i * numNearest,
+							[](float a, float b) -> bool { return std::fabs(a - b) <= 0.001f; }))
+						++numMismatches;
+
+				CONSOLE_LOG(numMismatches ? LEVEL_ERROR : LEVEL_INFO) << "Overlap queries (" << numQueries << " circle and nearest " << numNearest << " queries, "
+					<< numColliders << " colliders): linear " << linearMs << "ms, broadphase " << broadphaseMs << "ms, speedup " << linearMs / broadphaseMs
+					<< "x, " << numMismatches << " mismatched results";
+			}
+		}
+
+	}
+
+#pragma endregion // Overlap Queries
+
+#pragma region Narrowphase
+
+	namespace {
+
+		/*****************************************************************//*!
+		\brief
+			Compares testing AABB pairs one at a time against testing them with SIMD, with pairs of random sizes at random
+			offsets such that roughly half of them collide. Some pairs are placed exactly edge to edge, centered on each other,
+			or given equal penetration on both axes to exercise ties. The results of both are compared to ensure they are identical.
+		\param args
+			Numbers of pairs to benchmark with. Defaults to 100000.
+		*//******************************************************************/
+		void BenchmarkNarrowphase(const std::vector<std::string>& args)
+		{
+			constexpr int numIterations{ 20 };
+
+			for (int numPairs : GetEntityCounts(args, { 100000 }))
+			{
+				Physics::AABBPairBatch simdBatch{}, scalarBatch{};
+				for (int i{}; i < numPairs; ++i)
+				{
+					Vector2 posA{ util::RandomRangeFloat(-5000.0f, 5000.0f), util::RandomRangeFloat(-5000.0f, 5000.0f) };
+					Vector2 halfLengthsA{ util::RandomRangeFloat(5.0f, 75.0f), util::RandomRangeFloat(5.0f, 75.0f) };
+					Vector2 halfLengthsB{ util::RandomRangeFloat(5.0f, 75.0f), util::RandomRangeFloat(5.0f, 75.0f) };
+					Vector2 posB{ posA + Vector2{ util::RandomRangeFloat(-150.0f, 150.0f), util::RandomRangeFloat(-150.0f, 150.0f) } };
+					switch (i % 16)
+					{
+					case 0: // Touching edges
+						posB.x = posA.x + halfLengthsA.x + halfLengthsB.x;
+						break;
+					case 1: // Centered
+						posB = posA;
+						break;
+					case 2: // Equal penetration on both axes
+						halfLengthsB = halfLengthsA;
+						posB = posA + Vector2{ halfLengthsA.x, halfLengthsA.y };
+						break;
+					}
+
+					simdBatch.Add(posA, halfLengthsA, posB, halfLengthsB);
+					scalarBatch.Add(posA, halfLengthsA, posB, halfLengthsB);
+				}
+
+				double scalarMs{ TimeAverageMs(numIterations, [&scalarBatch]() -> void { scalarBatch.TestScalar(); }) };
+				double simdMs{ TimeAverageMs(numIterations, [&simdBatch]() -> void { simdBatch.Test(); }) };
+
+				int numHits{}, numMismatches{};
+				for (uint32_t i{}; i < simdBatch.Size(); ++i)
+				{
+					numHits += scalarBatch.IsHit(i);
+					if (simdBatch.IsHit(i) != scalarBatch.IsHit(i) ||
+						(scalarBatch.IsHit(i) && (simdBatch.GetPenetrationDepth(i) != scalarBatch.GetPenetrationDepth(i) ||
+							simdBatch.GetCollisionNormal(i) != scalarBatch.GetCollisionNormal(i))))
+						++numMismatches;
+				}
+
+				CONSOLE_LOG(numMismatches ? LEVEL_ERROR : LEVEL_INFO) << "Narrowphase (" << numPairs << " AABB pairs, " << numHits << " colliding, "
+					<< (Physics::AABBPairBatch::IsAVXSupported() ? "AVX" : "SSE") << "): scalar " << scalarMs << "ms, SIMD " << simdMs
+					<< "ms, speedup " << scalarMs / simdMs << "x, " << numMismatches << " mismatched results";
+			}
+		}
+
+	}
+
+#pragma endregion // Narrowphase
+
+#pragma region Contact Solver
+
+	namespace {
+
+		/*****************************************************************//*!
+		\brief
+			Simulates stacks of dynamic boxes resting on the ground, solving contacts with the contact solver each update.
+			Each stack is its own island. The simulation is run with islands solved on worker threads and on this thread,
+			and final positions are compared to ensure they are identical.
+		\param args
+			Numbers of boxes to benchmark with. Defaults to 2000.
+		*//******************************************************************/
+		void BenchmarkContactSolver(const std::vector<std::string>& args)
+		{
+			constexpr int numUpdates{ 300 };
+			constexpr int boxesPerStack{ 20 };
+			constexpr float halfLength{ 16.0f };
+			constexpr float gravity{ -980.0f };
+			constexpr float dt{ 1.0f / 60.0f };
+			const int velocityIterations{ ST<GameSettings>::Get()->m_physicsVelocityIterations };
+			const int positionIterations{ ST<GameSettings>::Get()->m_physicsPositionIterations };
+			const bool prevIsSingleThreaded{ ST<JobSystem>::Get()->GetIsSingleThreaded() };
+
+			for (int numBoxes : GetEntityCounts(args, { 2000 }))
+			{
+				std::vector<Vector2> finalPositions[2]{};
+				double solveMs[2]{};
+				float maxPenetration[2]{}, maxDrift[2]{};
+				uint32_t numIslands{}, numContacts{};
+				for (bool isSingleThreaded : { false, true })
+				{
+					ST<JobSystem>::Get()->SetIsSingleThreaded(isSingleThreaded);
+
+					// Boxes start exactly touching the box below them, with the ground's surface at y = 0
+					std::vector<Vector2> positions(numBoxes), velocities(numBoxes);
+					std::vector<Physics::Contact> contacts(numBoxes);
+					for (int i{}; i < numBoxes; ++i)
+						positions[i] = Vector2{ (i / boxesPerStack) * halfLength * 4.0f, halfLength + (i % boxesPerStack) * halfLength * 2.0f };
+					const std::vector<Vector2> restPositions{ positions };
+
+					Physics::ContactSolver solver{};
+					for (int update{}; update < numUpdates; ++update)
+					{
+						// Same integration as PhysicsSystem
+						for (int i{}; i < numBoxes; ++i)
+						{
+							Vector2 finalVelocity{ velocities[i] + Vector2{ 0.0f, gravity * dt } };
+							positions[i] += (velocities[i] + finalVelocity) * (0.5f * dt);
+							velocities[i] = finalVelocity;
+						}
+
+						// Body 0 is the ground, and each box touches only what is directly below it
+						solver.Clear();
+						solver.AddBody(Vector2{}, 0.0f);
+						for (int i{}; i < numBoxes; ++i)
+							solver.AddBody(velocities[i], 1.0f);
+						for (int i{}; i < numBoxes; ++i)
+						{
+							bool isOnGround{ i % boxesPerStack == 0 };
+							float penetrationDepth{ isOnGround ? halfLength - positions[i].y : halfLength * 2.0f - (positions[i].y - positions[i - 1].y) };
+							if (penetrationDepth < 0.0f)
+							{
+								contacts[i] = Physics::Contact{};
+								continue;
+							}
+							contacts[i].normal = Vector2{ 0.0f, 1.0f };
+							solver.AddContact(static_cast<uint32_t>(i + 1), isOnGround ? 0 : static_cast<uint32_t>(i), Vector2{ 0.0f, 1.0f }, penetrationDepth, 0.4f, 0.4f, &contacts[i]);
+						}
+
+						solveMs[isSingleThreaded] += TimeAverageMs(1, [&solver, velocityIterations, positionIterations]() -> void {
+							solver.Solve(dt, velocityIterations, positionIterations);
+						});
+						for (int i{}; i < numBoxes; ++i)
+						{
+							velocities[i] = solver.GetVelocity(static_cast<uint32_t>(i + 1));
+							positions[i] += solver.GetPositionCorrection(static_cast<uint32_t>(i + 1));
+						}
+					}
+
+					numIslands = solver.GetNumIslands();
+					numContacts = solver.GetNumContacts();
+					for (int i{}; i < numBoxes; ++i)
+					{
+						float penetrationDepth{ i % boxesPerStack == 0 ? halfLength - positions[i].y : halfLength * 2.0f - (positions[i].y - positions[i - 1].y) };
+						maxPenetration[isSingleThreaded] = std::max(maxPenetration[isSingleThreaded], penetrationDepth);
+						maxDrift[isSingleThreaded] = std::max(maxDrift[isSingleThreaded], (positions[i] - restPositions[i]).Length());
+					}
+					finalPositions[isSingleThreaded] = std::move(positions);
+				}
+
+				int numMismatches{};
+				for (int i{}; i < numBoxes; ++i)
+					numMismatches += (finalPositions[0][i] != finalPositions[1][i]);
+
+				CONSOLE_LOG(numMismatches ? LEVEL_ERROR : LEVEL_INFO) << "Contact solver (" << numBoxes << " boxes in stacks of " << boxesPerStack << ", "
+					<< numIslands << " islands, " << numContacts << " contacts, " << velocityIterations << "/" << positionIterations << " iterations): single threaded "
+					<< solveMs[1] / numUpdates << "ms, parallel " << solveMs[0] / numUpdates << "ms per update, speedup " << solveMs[1] / solveMs[0]
+					<< "x, after " << numUpdates << " updates max penetration " << maxPenetration[0] << ", max drift " << maxDrift[0] << ", "
+					<< numMismatches << " mismatched positions";
+			}
+
+			ST<JobSystem>::Get()->SetIsSingleThreaded(prevIsSingleThreaded);
+		}
+
+	}
+
+#pragma endregion // Contact Solver
+
+#pragma region Physics Determinism
+
+	namespace {
+
+		/*****************************************************************//*!
+		\brief
+			Simulates boxes thrown onto the ground through the PhysicsSystem and CollisionSystem in deterministic mode,
+			three times from the same starting state: twice with jobs on worker threads and once on this thread. The frame
+			hash after every update of each run is compared against the first run, and asserted to be identical.
+		\param args
+			Numbers of boxes to benchmark with. Defaults to 500.
+		*//******************************************************************/
+		void BenchmarkPhysicsDeterminism(const std::vector<std::string>& args)
+		{
+			constexpr int numUpdates{ 300 };
+			const bool prevIsSingleThreaded{ ST<JobSystem>::Get()->GetIsSingleThreaded() };
+			const bool prevIsDeterministic{ ST<GameSettings>::Get()->m_physicsDeterministic };
+			const bool prevIsFixedDtMode{ GameTime::IsFixedDtMode() };
+			const float prevFixedDt{ GameTime::FixedDt() };
+
+			// The layers matrix is part of the settings, so find a layer whose colliders collide with each other
+			ENTITY_LAYER layer{};
+			while (layer < ENTITY_LAYER::TOTAL && !EntityLayersMask::TestMatrix(layer, layer))
+				++layer;
+			if (layer == ENTITY_LAYER::TOTAL)
+			{
+				CONSOLE_LOG(LEVEL_ERROR) << "Physics determinism: no layer collides with itself in the layers matrix";
+				return;
+			}
+
+			ST<GameSettings>::Get()->m_physicsDeterministic = true;
+			if (!prevIsFixedDtMode)
+				GameTime::SetTargetFixedDt(1.0f / 60.0f);
+			for (int numBoxes : GetEntityCounts(args, { 500 }))
+			{
+				struct BoxState
+				{
+					Vector2 position;
+					Vector2 scale;
+					Vector2 velocity;
+				};
+				std::vector<BoxState> startStates{};
+				startStates.reserve(numBoxes);
+				for (int i{}; i < numBoxes; ++i)
+					startStates.push_back(BoxState{
+						Vector2{ util::RandomRangeFloat(-400.0f, 400.0f), util::RandomRangeFloat(-150.0f, 500.0f) },
+						Vector2{ util::RandomRangeFloat(10.0f, 40.0f), util::RandomRangeFloat(10.0f, 40.0f) },
+						Vector2{ util::RandomRangeFloat(-200.0f, 200.0f), util::RandomRangeFloat(-200.0f, 200.0f) }
+					});
+
+				// The first two runs have the same input, so any difference between them is nondeterminism within the simulation
+				constexpr bool runIsSingleThreaded[]{ false, false, true };
+				constexpr int numRuns{ static_cast<int>(std::size(runIsSingleThreaded)) };
+				std::vector<uint64_t> hashes[numRuns]{};
+				double updateMs[numRuns]{};
+				for (int run{}; run < numRuns; ++run)
+				{
+					ST<JobSystem>::Get()->SetIsSingleThreaded(runIsSingleThreaded[run]);
+					BenchmarkPoolScope poolScope{};
+					ecs::AddSystem(ECS_LAYER::PHYSICS, Physics::PhysicsSystem{});
+					ecs::AddSystem(ECS_LAYER::COLLISION, Physics::CollisionSystem{});
+
+					// The ground has no PhysicsComp so that it's static
+					ecs::EntityHandle ground{ ecs::CreateEntities(1, Physics::ColliderComp{}, EntityLayerComponent{}, EntityEventsComponent{}).front() };
+					std::vector<ecs::EntityHandle> boxes{ ecs::CreateEntities(static_cast<uint32_t>(numBoxes), Physics::PhysicsComp{}, Physics::ColliderComp{}, EntityLayerComponent{}, EntityEventsComponent{}) };
+					ecs::FlushChanges();
+
+					ground->GetTransform().SetWorldPosition(Vector2{ 0.0f, -200.0f });
+					ground->GetTransform().SetWorldScale(Vector2{ 1000.0f, 40.0f });
+					ground->GetComp<EntityLayerComponent>()->SetLayer(layer);
+					for (int i{}; i < numBoxes; ++i)
+					{
+						boxes[i]->GetTransform().SetWorldPosition(startStates[i].position);
+						boxes[i]->GetTransform().SetWorldScale(startStates[i].scale);
+						boxes[i]->GetComp<EntityLayerComponent>()->SetLayer(layer);
+						boxes[i]->GetComp<Physics::PhysicsComp>()->SetVelocity(startStates[i].velocity);
+					}
+
+					hashes[run].reserve(numUpdates);
+					updateMs[run] = TimeAverageMs(numUpdates, [&hashes, run]() -> void {
+						ecs::RunSystems(ECS_LAYER::PHYSICS);
+						ecs::RunSystems(ECS_LAYER::COLLISION);
+						hashes[run].push_back(Physics::ComputeFrameHash());
+					});
+				}
+
+				bool isDiverged{};
+				std::string result{};
+				for (int run{ 1 }; run < numRuns; ++run)
+				{
+					auto mismatchIter{ std::mismatch(hashes[0].begin(), hashes[0].end(), hashes[run].begin()).first };
+					if (mismatchIter == hashes[0].end())
+						continue;
+					isDiverged = true;
+					result += (runIsSingleThreaded[run] ? "single threaded run diverged at update " : "repeated run diverged at update ")
+						+ std::to_string(mismatchIter - hashes[0].begin() + 1) + " ";
+				}
+				CONSOLE_LOG(isDiverged ? LEVEL_ERROR : LEVEL_INFO) << "Physics determinism (" << numBoxes << " boxes, " << numUpdates << " updates): parallel "
+					<< updateMs[0] << "ms, single threaded " << updateMs[2] << "ms per update, "
+					<< (isDiverged ? result : "identical hashes, final " + std::to_string(hashes[0].back()));
+				assert(!isDiverged && "Physics is not deterministic: the same input produced different frame hashes");
+			}
+
+			ST<GameSettings>::Get()->m_physicsDeterministic = prevIsDeterministic;
+			GameTime::SetTargetFixedDt(prevIsFixedDtMode ? prevFixedDt : 0.0f);
+			ST<JobSystem>::Get()->SetIsSingleThreaded(prevIsSingleThreaded);
+		}
+
+	}
+
+#pragma endregion // Physics Determinism
+
+#pragma region Scene Load
+
+	namespace {
+
+		/*****************************************************************//*!
+		\brief
+			Loads all entities of a scene file into the current pool, either as-is or after reserving space
+			for every entity and component in the file, as Scene::LoadFromFile() does.
+		\param filepath
+			The filepath of the scene file.
+		\param bulk
+			Whether to reserve space for all entities and components up front.
+		\return
+			The loaded entities.
+		*//******************************************************************/
+		std::vector<ecs::EntityHandle> LoadSceneEntities(const std::string& filepath, bool bulk)
+		{
+			Deserializer deserializer{ filepath };
+			if (!deserializer.IsValid())
+				return {};
+
+			std::vector<ecs::EntityHandle> entities{};
+			if (bulk)
+			{
+				std::map<ecs::CompHash, uint32_t> compCounts{};
+				uint32_t numEntities{ deserializer.GetNumRemainingEntities(&compCounts) };
+				for (const auto& [compHash, count] : compCounts)
+					if (const RegisteredComponentData* registeredData{ RegisteredComponents::GetData(compHash) })
+						registeredData->ReserveComps(count);
+				ecs::ReserveEntities(numEntities);
+				entities.reserve(numEntities);
+			}
+
+			while (deserializer.HasEntity())
+			{
+				entities.push_back(ecs::CreateEntity());
+				deserializer.Deserialize(entities.back());
+			}
+			return entities;
+		}
+
+		/*****************************************************************//*!
+		\brief
+			Compares loading and unloading each scene in the scenes folder entity by entity,
+			against reserving space up front and deleting all entities at once.
+		\param args
+			The names of the scenes to load. Defaults to all scenes in the scenes folder.
+		*//******************************************************************/
+		void BenchmarkSceneLoad(const std::vector<std::string>& args)
+		{
+			constexpr int numIterations{ 10 };
+
+			std::vector<std::filesystem::path> scenePaths{};
+			for (const auto& entry : std::filesystem::directory_iterator{ ST<Filepaths>::Get()->scenesSave })
+				if (entry.path().extension() == ".scene" &&
+					(args.empty() || std::find(args.begin(), args.end(), entry.path().stem().string()) != args.end()))
+					scenePaths.push_back(entry.path());
+			std::sort(scenePaths.begin(), scenePaths.end());
+
+			for (const std::filesystem::path& scenePath : scenePaths)
+			{
+				// Each load happens within a fresh pool so that both paths start from the same state
+				double loadMs[2]{}, unloadMs[2]{};
+				size_t numEntities{};
+				for (int iteration{}; iteration < numIterations; ++iteration)
+					for (bool bulk : { false, true })
+					{
+						BenchmarkPoolScope poolScope{};
+						std::vector<ecs::EntityHandle> entities{};
+						loadMs[bulk] += TimeAverageMs(1, [&entities, &scenePath, bulk]() -> void {
+							entities = LoadSceneEntities(scenePath.string(), bulk);
+							ecs::FlushChanges();
+						});
+						numEntities = entities.size();
+
+						unloadMs[bulk] += TimeAverageMs(1, [&entities, bulk]() -> void {
+							if (bulk)
+								ecs::DeleteEntities(entities);
+							else
+								for (ecs::EntityHandle entity : entities)
+									ecs::DeleteEntity(entity);
+							ecs::FlushChanges();
+						});
+					}
+
+				CONSOLE_LOG(LEVEL_INFO) << "Scene load ('" << scenePath.stem().string() << "', " << numEntities << " entities): load "
+					<< loadMs[0] / numIterations << "ms -> " << loadMs[1] / numIterations << "ms (" << loadMs[0] / loadMs[1] << "x), unload "
+					<< unloadMs[0] / numIterations << "ms -> " << unloadMs[1] / numIterations << "ms (" << unloadMs[0] / unloadMs[1] << "x)";
+			}
+		}
+
+	}
+
+#pragma endregion // Scene Load
+
+#pragma region Draw Keys
+
+	namespace {
+
+		/*****************************************************************//*!
+		\brief
+			Compares the renderer's previous way of ordering sprite instances, a stable sort of the instances by depth followed
+			by a copy into the instance buffer, against sorting draw keys and gathering instances into the buffer. Sprites
+			share a small number of depths as they do in scenes, so ties must keep their order. Both outputs are compared
+			to ensure they are identical. Runs entirely on the CPU.
+		\param args
+			Numbers of sprites to benchmark with. Defaults to 20000.
+		*//******************************************************************/
+		void BenchmarkDrawKeys(const std::vector<std::string>& args)
+		{
+			constexpr int numIterations{ 50 };
+			constexpr int numDepths{ 16 };
+
+			for (int numSprites : GetEntityCounts(args, { 20000 }))
+			{
+				std::vector<SpriteInstanceData> sprites(numSprites);
+				for (int i{}; i < numSprites; ++i)
+				{
+					sprites[i].model = glm::mat4{ 1.0f };
+					sprites[i].model[3] = glm::vec4{ util::RandomRangeFloat(-5000.0f, 5000.0f), util::RandomRangeFloat(-5000.0f, 5000.0f),
+						static_cast<float>(util::RandomRange(-numDepths / 2, numDepths / 2)), 1.0f };
+					sprites[i].textureIndex = static_cast<uint32_t>(i);
+				}
+				auto getDepth{ [](const SpriteInstanceData& sprite) -> float { return sprite.model[3][2]; } };
+
+				// Stands in for the mapped instance buffer
+				std::vector<SpriteInstanceData> stableSortOutput(numSprites), drawKeysOutput(numSprites);
+
+				std::vector<SpriteInstanceData> stableSortInstances{};
+				double stableSortMs{ TimeAverageMs(numIterations, [&]() -> void {
+					stableSortInstances = sprites;
+					std::ranges::stable_sort(stableSortInstances, [&getDepth](const auto& a, const auto& b) {
+						return getDepth(a) < getDepth(b);
+					});
+					std::memcpy(stableSortOutput.data(), stableSortInstances.data(), sizeof(SpriteInstanceData) * stableSortInstances.size());
+				}) };
+
+				DrawKeySorter sorter{};
+				double drawKeysMs{ TimeAverageMs(numIterations, [&]() -> void {
+					sorter.SortInto(sprites, getDepth, drawKeysOutput.data());
+				}) };
+
+				bool isMatching{ std::memcmp(stableSortOutput.data(), drawKeysOutput.data(), sizeof(SpriteInstanceData) * numSprites) == 0 };
+
+				CONSOLE_LOG(isMatching ? LEVEL_INFO : LEVEL_ERROR) << "Draw keys (" << numSprites << " sprites, " << numDepths << " depths): stable sort "
+					<< stableSortMs << "ms, draw keys " << drawKeysMs << "ms, speedup " << stableSortMs / drawKeysMs << "x, "
+					<< (isMatching ? "identical order" : "ORDER MISMATCH");
+			}
+		}
+
+	}
+
+#pragma endregion // Draw Keys
+
+#pragma region Registry
+
+	namespace {
+
+		//! All benchmarks, sorted by name.
+		const std::map<std::string, BenchmarkFuncSig> benchmarkMap{
+			{ "compArrLayout", BenchmarkCompArrLayout },
+			{ "contactSolver", BenchmarkContactSolver },
+			{ "drawKeys", BenchmarkDrawKeys },
+			{ "ecsIteration", BenchmarkECSIteration },
+			{ "narrowphase", BenchmarkNarrowphase },
+			{ "overlapQueries", BenchmarkOverlapQueries },
+			{ "physicsDeterminism", BenchmarkPhysicsDeterminism },
+			{ "prefabInstancing", BenchmarkPrefabInstancing },
+			{ "raycast", BenchmarkRaycast },
+			{ "sceneLoad", BenchmarkSceneLoad },
+		};
+
+	}
+
+	bool Run(const std::string& name, const std::vector<std::string>& args)
+	{
+		auto benchmarkIter{ benchmarkMap.find(name) };
+		if (benchmarkIter == benchmarkMap.end())
+			return false;
+
+		CONSOLE_LOG(LEVEL_INFO) << "Running benchmark '" << name << "'...";
+		benchmarkIter->second(args);
+		return true;
+	}
+
+	std::vector<std::string> GetNames()
+	{
+		std::vector<std::string> names{};
+		for (const auto& [name, _] : benchmarkMap)
+			names.push_back(name);
+		return names;
+	}
+
+#pragma endregion // Registry
+
+}
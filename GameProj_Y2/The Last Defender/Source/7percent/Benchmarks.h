@@ -0,0 +1,50 @@
+/******************************************************************************/
+/*!
+\file   Benchmarks.h
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is an interface file for engine benchmarks, which measure the performance
+  of engine subsystems in isolation and print the results to the console.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#pragma once
+
+namespace benchmarks {
+
+	//! The signature of a benchmark function. Receives the arguments passed to the benchmark command.
+	using BenchmarkFuncSig = void(*)(const std::vector<std::string>& args);
+
+	/*****************************************************************//*!
+	\brief
+		Runs a benchmark.
+	\param name
+		The name of the benchmark.
+	\param args
+		Arguments to be passed to the benchmark.
+	\return
+		True if a benchmark with the specified name exists. False otherwise.
+	*//******************************************************************/
+	bool Run(const std::string& name, const std::vector<std::string>& args);
+
+	/*****************************************************************//*!
+	\brief
+		Gets the names of all benchmarks.
+	\return
+		The names of all benchmarks, sorted alphabetically.
+	*//******************************************************************/
+	std::vector<std::string> GetNames();
+
+}
@@ -0,0 +1,650 @@
+/******************************************************************************/
+/*!
+\file   Broadphase.cpp
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the source file implementing a persistent dynamic AABB tree of colliders,
+  and the broadphase that keeps a tree per ECS pool in sync with the colliders
+  within it.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#include "Broadphase.h"
+#include "Collision.h"
+#include "Physics.h"
+
+namespace {
+	//! The minimum distance that proxies are fattened by on each side.
+	constexpr float FAT_MARGIN{ 8.0f };
+	//! The fraction of a collider's size that its proxy is fattened by on each side, on top of the margin.
+	constexpr float FAT_SIZE_RATIO{ 0.1f };
+	//! How far a reinserted proxy is extended in the direction of motion, as a multiple of the displacement since it was last inserted.
+	constexpr float FAT_DISPLACEMENT_MULTIPLIER{ 2.0f };
+	//! If a proxy's fattened AABB exceeds what it would be if reinserted now by this many times the margin, it is shrunk.
+	constexpr float FAT_SHRINK_MARGIN_MULTIPLIER{ 4.0f };
+
+	/*****************************************************************//*!
+	\brief
+		Calculates the fattened half lengths of a collider's AABB, not including any extension from motion.
+	\param halfLengths
+		The half lengths of the collider's AABB.
+	\return
+		The fattened half lengths.
+	*//******************************************************************/
+	Vector2 GetFatHalfLengths(const Vector2& halfLengths)
+	{
+		return halfLengths * (1.0f + FAT_SIZE_RATIO) + Vector2{ FAT_MARGIN, FAT_MARGIN };
+	}
+
+	/*****************************************************************//*!
+	\brief
+		Gets the bottom left corner of the union of 2 AABBs.
+	\param a
+		The bottom left corner of the first AABB.
+	\param b
+		The bottom left corner of the second AABB.
+	\return
+		The component-wise minimum.
+	*//******************************************************************/
+	Vector2 UnionMin(const Vector2& a, const Vector2& b)
+	{
+		return Vector2{ std::min(a.x, b.x), std::min(a.y, b.y) };
+	}
+
+	/*****************************************************************//*!
+	\brief
+		Gets the top right corner of the union of 2 AABBs.
+	\param a
+		The top right corner of the first AABB.
+	\param b
+		The top right corner of the second AABB.
+	\return
+		The component-wise maximum.
+	*//******************************************************************/
+	Vector2 UnionMax(const Vector2& a, const Vector2& b)
+	{
+		return Vector2{ std::max(a.x, b.x), std::max(a.y, b.y) };
+	}
+
+	/*****************************************************************//*!
+	\brief
+		Narrows the interval along a ray that lies between a pair of parallel planes of an AABB.
+		Same as ColliderBase, a ray parallel to the planes only lies between them if it starts between them.
+	\param start
+		The ray origin's coordinate on this axis.
+	\param dir
+		The ray direction's coordinate on this axis.
+	\param min
+		The AABB's minimum coordinate on this axis.
+	\param max
+		The AABB's maximum coordinate on this axis.
+	\param tMin
+		The start of the interval.
+	\param tMax
+		The end of the interval.
+	\return
+		True if the interval is not empty. False otherwise.
+	*//******************************************************************/
+	bool ClipRayOnAxis(float start, float dir, float min, float max, float* tMin, float* tMax)
+	{
+		if (std::abs(dir) <= std::numeric_limits<float>::epsilon())
+			return (min <= start && start <= max);
+
+		float t1{ (min - start) / dir }, t2{ (max - start) / dir };
+		if (t1 > t2)
+			std::swap(t1, t2);
+		*tMin = std::max(*tMin, t1);
+		*tMax = std::min(*tMax, t2);
+		return *tMin <= *tMax;
+	}
+}
+
+namespace Physics {
+
+#pragma region AABB Tree
+
+	bool AABBTree::Node::IsLeaf() const
+	{
+		return children[0] == NULL_NODE;
+	}
+
+	AABBTree::AABBTree()
+		: root{ NULL_NODE }
+		, freeList{ NULL_NODE }
+		, numProxies{ 0 }
+	{
+	}
+
+	uint32_t AABBTree::CreateProxy(const Vector2& center, const Vector2& halfLengths, uint32_t layerBits, ecs::EntityHash entity, uint32_t syncStamp)
+	{
+		uint32_t proxy{ AllocateNode() };
+		Node& node{ nodes[proxy] };
+
+		Vector2 fatHalfLengths{ GetFatHalfLengths(halfLengths) };
+		node.min = center - fatHalfLengths;
+		node.max = center + fatHalfLengths;
+		node.height = 0;
+		node.layerBits = layerBits;
+		node.entity = entity;
+		node.syncStamp = syncStamp;
+
+		InsertLeaf(proxy);
+		++numProxies;
+		return proxy;
+	}
+
+	void AABBTree::DestroyProxy(uint32_t proxy)
+	{
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		--numProxies;
+	}
+
+	bool AABBTree::MoveProxy(uint32_t proxy, const Vector2& center, const Vector2& halfLengths, uint32_t layerBits, uint32_t syncStamp)
+	{
+		Node& node{ nodes[proxy] };
+		node.syncStamp = syncStamp;
+
+		Vector2 tightMin{ center - halfLengths }, tightMax{ center + halfLengths };
+		Vector2 fatHalfLengths{ GetFatHalfLengths(halfLengths) };
+		Vector2 shrinkExtent{ fatHalfLengths + Vector2{ FAT_SHRINK_MARGIN_MULTIPLIER * FAT_MARGIN, FAT_SHRINK_MARGIN_MULTIPLIER * FAT_MARGIN } };
+
+		// Keep the proxy where it is if it still contains the collider and isn't excessively large (e.g. after moving fast and stopping)
+		bool containsCollider{ node.min.x <= tightMin.x && node.min.y <= tightMin.y && tightMax.x <= node.max.x && tightMax.y <= node.max.y };
+		bool isExcessive{ center.x - node.min.x > shrinkExtent.x || node.max.x - center.x > shrinkExtent.x ||
+			center.y - node.min.y > shrinkExtent.y || node.max.y - center.y > shrinkExtent.y };
+		if (containsCollider && !isExcessive && node.layerBits == layerBits)
+			return false;
+
+		// Extend the new AABB in the direction the proxy has moved since it was last inserted, since it will probably continue moving that way
+		Vector2 displacement{ (center - (node.min + node.max) * 0.5f) * FAT_DISPLACEMENT_MULTIPLIER };
+		RemoveLeaf(proxy);
+
+		Node& movedNode{ nodes[proxy] };
+		movedNode.min = center - fatHalfLengths;
+		movedNode.max = center + fatHalfLengths;
+		if (containsCollider && !isExcessive)
+			displacement = Vector2{}; // Only the layer changed
+		(displacement.x < 0.0f ? movedNode.min.x : movedNode.max.x) += displacement.x;
+		(displacement.y < 0.0f ? movedNode.min.y : movedNode.max.y) += displacement.y;
+		movedNode.layerBits = layerBits;
+
+		InsertLeaf(proxy);
+		return true;
+	}
+
+	bool AABBTree::IsProxyClaimable(uint32_t proxy, ecs::EntityHash entity, uint32_t syncStamp) const
+	{
+		if (proxy >= nodes.size())
+			return false;
+		const Node& node{ nodes[proxy] };
+		return node.height == 0 && node.entity == entity && node.syncStamp != syncStamp;
+	}
+
+	void AABBTree::DestroyProxiesNotSynced(uint32_t syncStamp)
+	{
+		// Destroying proxies doesn't allocate nodes, so the node pool doesn't move while iterating
+		for (uint32_t i{}; i < static_cast<uint32_t>(nodes.size()); ++i)
+			if (nodes[i].height == 0 && nodes[i].syncStamp != syncStamp)
+				DestroyProxy(i);
+	}
+
+	bool AABBTree::IsProxy(uint32_t proxy) const
+	{
+		return proxy < nodes.size() && nodes[proxy].height == 0;
+	}
+
+	bool AABBTree::TestProxiesOverlap(uint32_t proxyA, uint32_t proxyB) const
+	{
+		const Node& a{ nodes[proxyA] };
+		const Node& b{ nodes[proxyB] };
+		return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y;
+	}
+
+	void AABBTree::GetProxyBounds(uint32_t proxy, Vector2* outMin, Vector2* outMax) const
+	{
+		*outMin = nodes[proxy].min;
+		*outMax = nodes[proxy].max;
+	}
+
+	uint32_t AABBTree::GetProxyLayerBits(uint32_t proxy) const
+	{
+		return nodes[proxy].layerBits;
+	}
+
+	ecs::EntityHash AABBTree::GetProxyEntity(uint32_t proxy) const
+	{
+		return nodes[proxy].entity;
+	}
+
+	void AABBTree::Clear()
+	{
+		nodes.clear();
+		root = NULL_NODE;
+		freeList = NULL_NODE;
+		numProxies = 0;
+	}
+
+	uint32_t AABBTree::GetNumProxies() const
+	{
+		return numProxies;
+	}
+
+	uint32_t AABBTree::GetCapacity() const
+	{
+		return static_cast<uint32_t>(nodes.size());
+	}
+
+	int AABBTree::GetHeight() const
+	{
+		return (root == NULL_NODE ? 0 : nodes[root].height);
+	}
+
+	uint32_t AABBTree::AllocateNode()
+	{
+		if (freeList == NULL_NODE)
+		{
+			// Double the pool and link the new nodes into the free list
+			uint32_t oldSize{ static_cast<uint32_t>(nodes.size()) };
+			uint32_t newSize{ std::max(oldSize * 2, 16u) };
+			nodes.resize(newSize);
+			for (uint32_t i{ oldSize }; i < newSize; ++i)
+			{
+				nodes[i].parent = (i + 1 < newSize ? i + 1 : NULL_NODE);
+				nodes[i].height = -1;
+			}
+			freeList = oldSize;
+		}
+
+		uint32_t index{ freeList };
+		Node& node{ nodes[index] };
+		freeList = node.parent;
+		node.parent = NULL_NODE;
+		node.children[0] = node.children[1] = NULL_NODE;
+		node.height = 0;
+		node.layerBits = 0;
+		node.entity = 0;
+		node.syncStamp = 0;
+		return index;
+	}
+
+	void AABBTree::FreeNode(uint32_t node)
+	{
+		nodes[node].parent = freeList;
+		nodes[node].height = -1;
+		freeList = node;
+	}
+
+	void AABBTree::InsertLeaf(uint32_t leaf)
+	{
+		if (root == NULL_NODE)
+		{
+			root = leaf;
+			nodes[leaf].parent = NULL_NODE;
+			return;
+		}
+
+		// Descend towards the sibling that increases the tree's total perimeter the least
+		Vector2 leafMin{ nodes[leaf].min }, leafMax{ nodes[leaf].max };
+		uint32_t index{ root };
+		while (!nodes[index].IsLeaf())
+		{
+			const Node& node{ nodes[index] };
+			float perimeter{ GetPerimeter(node.min, node.max) };
+			float combinedPerimeter{ GetPerimeter(UnionMin(node.min, leafMin), UnionMax(node.max, leafMax)) };
+
+			// The cost of pairing the leaf with this node, and the cost that any descendant inherits from enlarging this node
+			float cost{ 2.0f * combinedPerimeter };
+			float inheritanceCost{ 2.0f * (combinedPerimeter - perimeter) };
+
+			float childCosts[2]{};
+			for (int i{}; i < 2; ++i)
+			{
+				const Node& child{ nodes[node.children[i]] };
+				float childCombinedPerimeter{ GetPerimeter(UnionMin(child.min, leafMin), UnionMax(child.max, leafMax)) };
+				childCosts[i] = inheritanceCost + (child.IsLeaf() ? childCombinedPerimeter : childCombinedPerimeter - GetPerimeter(child.min, child.max));
+			}
+
+			if (cost < childCosts[0] && cost < childCosts[1])
+				break;
+			index = node.children[childCosts[0] < childCosts[1] ? 0 : 1];
+		}
+		uint32_t sibling{ index };
+
+		// Create a new parent for the leaf and its sibling
+		uint32_t oldParent{ nodes[sibling].parent };
+		uint32_t newParent{ AllocateNode() };
+		nodes[newParent].parent = oldParent;
+		nodes[newParent].children[0] = sibling;
+		nodes[newParent].children[1] = leaf;
+		nodes[sibling].parent = newParent;
+		nodes[leaf].parent = newParent;
+
+		if (oldParent == NULL_NODE)
+			root = newParent;
+		else
+			nodes[oldParent].children[nodes[oldParent].children[0] == sibling ? 0 : 1] = newParent;
+
+		RefitAncestors(newParent);
+	}
+
+	void AABBTree::RemoveLeaf(uint32_t leaf)
+	{
+		if (leaf == root)
+		{
+			root = NULL_NODE;
+			return;
+		}
+
+		uint32_t parent{ nodes[leaf].parent };
+		uint32_t grandParent{ nodes[parent].parent };
+		uint32_t sibling{ nodes[parent].children[nodes[parent].children[0] == leaf ? 1 : 0] };
+
+		// Replace the parent with the sibling
+		nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+		if (grandParent == NULL_NODE)
+		{
+			root = sibling;
+			return;
+		}
+
+		nodes[grandParent].children[nodes[grandParent].children[0] == parent ? 0 : 1] = sibling;
+		RefitAncestors(grandParent);
+	}
+
+	void AABBTree::RefitAncestors(uint32_t node)
+	{
+		while (node != NULL_NODE)
+		{
+			node = Balance(node);
+			RefitNode(node);
+			node = nodes[node].parent;
+		}
+	}
+
+	uint32_t AABBTree::Balance(uint32_t node)
+	{
+		if (nodes[node].IsLeaf() || nodes[node].height < 2)
+			return node;
+
+		uint32_t left{ nodes[node].children[0] }, right{ nodes[node].children[1] };
+		int balance{ nodes[right].height - nodes[left].height };
+		if (-1 <= balance && balance <= 1)
+			return node;
+
+		// Rotate the taller child up into this node's position
+		int tallSide{ balance > 1 ? 1 : 0 };
+		uint32_t tall{ nodes[node].children[tallSide] };
+		uint32_t tallLeft{ nodes[tall].children[0] }, tallRight{ nodes[tall].children[1] };
+
+		uint32_t parent{ nodes[node].parent };
+		nodes[tall].parent = parent;
+		nodes[node].parent = tall;
+		if (parent == NULL_NODE)
+			root = tall;
+		else
+			nodes[parent].children[nodes[parent].children[0] == node ? 0 : 1] = tall;
+
+		// The taller grandchild stays with the rotated child, the shorter one takes the rotated child's place under this node
+		bool keepLeft{ nodes[tallLeft].height > nodes[tallRight].height };
+		uint32_t kept{ keepLeft ? tallLeft : tallRight }, moved{ keepLeft ? tallRight : tallLeft };
+		nodes[tall].children[0] = node;
+		nodes[tall].children[1] = kept;
+		nodes[node].children[tallSide] = moved;
+		nodes[moved].parent = node;
+
+		RefitNode(node);
+		RefitNode(tall);
+		return tall;
+	}
+
+	void AABBTree::RefitNode(uint32_t node)
+	{
+		Node& parent{ nodes[node] };
+		const Node& left{ nodes[parent.children[0]] };
+		const Node& right{ nodes[parent.children[1]] };
+		parent.min = UnionMin(left.min, right.min);
+		parent.max = UnionMax(left.max, right.max);
+		parent.height = 1 + std::max(left.height, right.height);
+		parent.layerBits = left.layerBits | right.layerBits;
+	}
+
+	bool AABBTree::RayEntersNode(const Node& node, const Vector2& origin, const Vector2& direction, float maxDistance, float* outDistance)
+	{
+		float tMin{ 0.0f }, tMax{ maxDistance };
+		if (!ClipRayOnAxis(origin.x, direction.x, node.min.x, node.max.x, &tMin, &tMax) ||
+			!ClipRayOnAxis(origin.y, direction.y, node.min.y, node.max.y, &tMin, &tMax))
+			return false;
+
+		*outDistance = tMin;
+		return true;
+	}
+
+	float AABBTree::GetPerimeter(const Vector2& min, const Vector2& max)
+	{
+		return 2.0f * ((max.x - min.x) + (max.y - min.y));
+	}
+
+#pragma endregion // AABB Tree
+
+#pragma region Broadphase
+
+	Broadphase::Broadphase()
+		: syncStamp{ 0 }
+	{
+		Messaging::Subscribe("OnECSPoolDeletion", Broadphase::OnECSPoolDeletion);
+	}
+
+	Broadphase::~Broadphase()
+	{
+		Messaging::Unsubscribe("OnECSPoolDeletion", Broadphase::OnECSPoolDeletion);
+	}
+
+	void Broadphase::Sync()
+	{
+		PoolData& pool{ pools[ecs::GetCurrentPoolId()] };
+		SyncProxies(pool);
+		UpdatePairs(pool);
+		pool.movedProxies.clear();
+		pool.bodyCounts.numPairs = static_cast<uint32_t>(pool.pairs.size());
+	}
+
+	void Broadphase::SyncProxiesIfStale()
+	{
+		PoolData& pool{ pools[ecs::GetCurrentPoolId()] };
+		if (pool.isDirty || pool.syncedBatch != ecs::GetNumSystemBatchesRun())
+			SyncProxies(pool);
+	}
+
+	void Broadphase::MarkDirty()
+	{
+		ST<Broadphase>::Get()->pools[ecs::GetCurrentPoolId()].isDirty = true;
+	}
+
+	void Broadphase::SyncProxies(PoolData& pool)
+	{
+		AABBTree& tree{ pool.tree };
+		++syncStamp;
+		pool.bodyCounts = BodyCounts{ .numPairs = static_cast<uint32_t>(pool.pairs.size()) };
+		pool.syncedBatch = ecs::GetNumSystemBatchesRun();
+		pool.isDirty = false;
+
+		// If the layers matrix was edited, every proxy needs to find the pairs that its layer now allows
+		bool isMatrixChanged{ false };
+		for (ENTITY_LAYER layer{}; layer < ENTITY_LAYER::TOTAL; ++layer)
+		{
+			uint32_t collisionBits{ GetCollisionLayerBits(layer) };
+			isMatrixChanged |= (pool.layerCollisionBits[+layer] != collisionBits);
+			pool.layerCollisionBits[+layer] = collisionBits;
+		}
+
+		for (auto compIter{ ecs::GetCompsActiveBegin<ColliderComp>() }, endIter{ ecs::GetCompsEnd<ColliderComp>() }; compIter != endIter; ++compIter)
+		{
+			ColliderComp& comp{ *compIter };
+			ecs::EntityHash entity{ compIter.GetEntity()->GetHash() };
+
+			comp.UpdateColliderDimensions();
+			BoxWrapper box{ comp.CreateBoxWrapper() };
+			uint32_t layerBits{ 1u << +comp.GetLayer() };
+			BODY_TYPE bodyType{ GetBodyType(compIter.GetEntity(), &pool.bodyCounts) };
+
+			// Colliders that were copied from another keep the original's proxy id, so only reuse proxies that are this entity's
+			bool isMoved{ true };
+			if (tree.IsProxyClaimable(comp.broadphaseProxy, entity, syncStamp))
+				isMoved = tree.MoveProxy(comp.broadphaseProxy, box.GetCenter(), box.GetHalfLengths(), layerBits, syncStamp);
+			else
+				comp.broadphaseProxy = tree.CreateProxy(box.GetCenter(), box.GetHalfLengths(), layerBits, entity, syncStamp);
+
+			if (pool.proxyColliders.size() < tree.GetCapacity())
+			{
+				pool.proxyColliders.resize(tree.GetCapacity());
+				pool.proxyBodyTypes.resize(tree.GetCapacity());
+				pool.proxyCollisionBits.resize(tree.GetCapacity());
+			}
+			pool.proxyColliders[comp.broadphaseProxy] = &comp;
+			pool.proxyCollisionBits[comp.broadphaseProxy] = pool.layerCollisionBits[+comp.GetLayer()];
+			isMoved |= isMatrixChanged;
+
+			// A collider that is no longer static needs pairs with the static colliders it was already overlapping
+			if (pool.proxyBodyTypes[comp.broadphaseProxy] == BODY_TYPE::STATIC && bodyType != BODY_TYPE::STATIC)
+				isMoved = true;
+			pool.proxyBodyTypes[comp.broadphaseProxy] = bodyType;
+			if (isMoved)
+				pool.movedProxies.push_back(comp.broadphaseProxy);
+		}
+
+		tree.DestroyProxiesNotSynced(syncStamp);
+	}
+
+	Broadphase::BodyCounts Broadphase::GetBodyCounts()
+	{
+		return pools[ecs::GetCurrentPoolId()].bodyCounts;
+	}
+
+	const AABBTree& Broadphase::GetTree()
+	{
+		return pools[ecs::GetCurrentPoolId()].tree;
+	}
+
+	uint32_t Broadphase::GetLayerBits(const EntityLayersMask& mask)
+	{
+		static_assert(+ENTITY_LAYER::TOTAL <= 32, "Layer bits cannot represent more than 32 layers");
+
+		uint32_t layerBits{ 0 };
+		for (ENTITY_LAYER layer{}; layer < ENTITY_LAYER::TOTAL; ++layer)
+			if (mask.TestMask(layer))
+				layerBits |= 1u << +layer;
+		return layerBits;
+	}
+
+	uint32_t Broadphase::GetCollisionLayerBits(ENTITY_LAYER layer)
+	{
+		uint32_t layerBits{ 0 };
+		for (ENTITY_LAYER otherLayer{}; otherLayer < ENTITY_LAYER::TOTAL; ++otherLayer)
+			if (EntityLayersMask::TestMatrix(layer, otherLayer))
+				layerBits |= 1u << +otherLayer;
+		return layerBits;
+	}
+
+	BODY_TYPE Broadphase::GetBodyType(ecs::EntityHandle entity, BodyCounts* counts)
+	{
+		ecs::CompHandle<PhysicsComp> physComp{ entity->GetComp<PhysicsComp>() };
+		if (!physComp)
+		{
+			++counts->numStatic;
+			return BODY_TYPE::STATIC;
+		}
+		if (!physComp->IsDynamic())
+		{
+			++counts->numKinematic;
+			return BODY_TYPE::KINEMATIC;
+		}
+
+		++(physComp->IsSleeping() ? counts->numSleeping : counts->numAwake);
+		return BODY_TYPE::DYNAMIC;
+	}
+
+	ecs::CompHandle<ColliderComp> Broadphase::GetProxyCollider(const AABBTree& tree, uint32_t proxy)
+	{
+		ecs::EntityHandle entity{ ecs::GetEntity(tree.GetProxyEntity(proxy)) };
+		if (!entity)
+			return nullptr;
+
+		ecs::CompHandle<ColliderComp> comp{ entity->GetComp<ColliderComp>() };
+		if (!comp || comp->broadphaseProxy != proxy || !ecs::GetCompActive(comp))
+			return nullptr;
+		return comp;
+	}
+
+	void Broadphase::UpdatePairs(PoolData& pool)
+	{
+		const AABBTree& tree{ pool.tree };
+
+		// Destroyed proxies are freed nodes unless a later sync reused them,
+		// in which case the pair now refers to the new proxy and is kept or dropped based on it instead
+		std::erase_if(pool.pairs, [&pool, &tree](uint64_t pair) -> bool {
+			uint32_t proxyA{ static_cast<uint32_t>(pair >> 32) }, proxyB{ static_cast<uint32_t>(pair) };
+			return !tree.IsProxy(proxyA) || !tree.IsProxy(proxyB) || !tree.TestProxiesOverlap(proxyA, proxyB) ||
+				!(tree.GetProxyLayerBits(proxyA) & pool.proxyCollisionBits[proxyB]) ||
+				(pool.proxyBodyTypes[proxyA] == BODY_TYPE::STATIC && pool.proxyBodyTypes[proxyB] == BODY_TYPE::STATIC);
+		});
+
+		// Only proxies that were reinserted can have started overlapping something new, since the others haven't grown
+		pool.newPairs.clear();
+		for (uint32_t proxy : pool.movedProxies)
+		{
+			// Proxies moved by a query's sync may have been destroyed by a later sync
+			if (!tree.IsProxy(proxy))
+				continue;
+
+			Vector2 min{}, max{};
+			tree.GetProxyBounds(proxy, &min, &max);
+			// Most level geometry is static and overlaps other static geometry, none of which can collide
+			bool isStatic{ pool.proxyBodyTypes[proxy] == BODY_TYPE::STATIC };
+			// Subtrees without any layer that this proxy collides with are skipped entirely, since the layers matrix is symmetric
+			tree.Query(min, max, pool.proxyCollisionBits[proxy], [&pool, proxy, isStatic](uint32_t otherProxy) -> bool {
+				if (otherProxy != proxy && !(isStatic && pool.proxyBodyTypes[otherProxy] == BODY_TYPE::STATIC))
+					pool.newPairs.push_back(MakePair(proxy, otherProxy));
+				return true;
+			});
+		}
+		if (pool.newPairs.empty())
+			return;
+
+		// Pairs between 2 moved proxies are found twice, and pairs that already existed may be found again
+		std::sort(pool.newPairs.begin(), pool.newPairs.end());
+		pool.newPairs.erase(std::unique(pool.newPairs.begin(), pool.newPairs.end()), pool.newPairs.end());
+		std::vector<uint64_t> mergedPairs{};
+		mergedPairs.reserve(pool.pairs.size() + pool.newPairs.size());
+		std::set_union(pool.pairs.begin(), pool.pairs.end(), pool.newPairs.begin(), pool.newPairs.end(), std::back_inserter(mergedPairs));
+		pool.pairs.swap(mergedPairs);
+	}
+
+	uint64_t Broadphase::MakePair(uint32_t proxyA, uint32_t proxyB)
+	{
+		if (proxyA > proxyB)
+			std::swap(proxyA, proxyB);
+		return (static_cast<uint64_t>(proxyA) << 32) | proxyB;
+	}
+
+	void Broadphase::OnECSPoolDeletion(ecs::POOL id)
+	{
+		ST<Broadphase>::Get()->pools.erase(id);
+	}
+
+#pragma endregion // Broadphase
+
+}
@@ -0,0 +1,674 @@
+/******************************************************************************/
+/*!
+\file   Broadphase.h
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the interface file for a persistent dynamic AABB tree of colliders, and
+  the broadphase that keeps a tree per ECS pool in sync with the colliders within
+  it, so that collision detection and spatial queries such as raycasts don't need
+  to test every collider.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "EntityLayers.h"
+
+namespace Physics {
+
+	/* Forward Declares */
+	class ColliderComp;
+
+#pragma region AABB Tree
+
+	/*****************************************************************//*!
+	\class AABBTree
+	\brief
+		A bounding volume hierarchy of AABBs that persists between updates. Each leaf (proxy) is a collider,
+		whose AABB is fattened so that small movements don't require the tree to be restructured.
+		Internal nodes store the union of their children's layers, so that queries can skip entire
+		subtrees that contain no colliders on the layers being queried.
+		The tree is kept balanced by rotations as proxies are inserted and removed.
+	*//******************************************************************/
+	class AABBTree
+	{
+	public:
+		//! The index representing no node.
+		static constexpr uint32_t NULL_NODE{ std::numeric_limits<uint32_t>::max() };
+
+		/*****************************************************************//*!
+		\brief
+			Constructor.
+		*//******************************************************************/
+		AABBTree();
+
+		/*****************************************************************//*!
+		\brief
+			Creates a proxy for a collider.
+		\param center
+			The center of the collider.
+		\param halfLengths
+			The half lengths of the AABB that encapsulates the collider.
+		\param layerBits
+			The layer bit of the collider's entity.
+		\param entity
+			The hash of the collider's entity.
+		\param syncStamp
+			The sync that the proxy is created in.
+		\return
+			The id of the proxy.
+		*//******************************************************************/
+		uint32_t CreateProxy(const Vector2& center, const Vector2& halfLengths, uint32_t layerBits, ecs::EntityHash entity, uint32_t syncStamp);
+
+		/*****************************************************************//*!
+		\brief
+			Destroys a proxy.
+		\param proxy
+			The id of the proxy.
+		*//******************************************************************/
+		void DestroyProxy(uint32_t proxy);
+
+		/*****************************************************************//*!
+		\brief
+			Updates a proxy with the collider's current bounds. The proxy is only reinserted into the tree if the collider
+			has moved outside of the proxy's fattened AABB, in which case the new fattened AABB is extended in the direction of motion.
+		\param proxy
+			The id of the proxy.
+		\param center
+			The center of the collider.
+		\param halfLengths
+			The half lengths of the AABB that encapsulates the collider.
+		\param layerBits
+			The layer bit of the collider's entity.
+		\param syncStamp
+			The sync that the proxy is updated in.
+		\return
+			True if the proxy was reinserted. False otherwise.
+		*//******************************************************************/
+		bool MoveProxy(uint32_t proxy, const Vector2& center, const Vector2& halfLengths, uint32_t layerBits, uint32_t syncStamp);
+
+		/*****************************************************************//*!
+		\brief
+			Checks whether a proxy exists, belongs to an entity and has not been updated within a sync yet.
+		\param proxy
+			The id of the proxy.
+		\param entity
+			The hash of the entity.
+		\param syncStamp
+			The current sync.
+		\return
+			True if the proxy can be updated by the entity's collider. False otherwise.
+		*//******************************************************************/
+		bool IsProxyClaimable(uint32_t proxy, ecs::EntityHash entity, uint32_t syncStamp) const;
+
+		/*****************************************************************//*!
+		\brief
+			Destroys all proxies that were not created or updated within a sync.
+		\param syncStamp
+			The sync.
+		*//******************************************************************/
+		void DestroyProxiesNotSynced(uint32_t syncStamp);
+
+		/*****************************************************************//*!
+		\brief
+			Checks whether an id refers to an existing proxy.
+		\param proxy
+			The id.
+		\return
+			True if the id refers to a proxy. False otherwise.
+		*//******************************************************************/
+		bool IsProxy(uint32_t proxy) const;
+
+		/*****************************************************************//*!
+		\brief
+			Checks whether the fattened AABBs of 2 proxies overlap.
+		\param proxyA
+			The id of a proxy.
+		\param proxyB
+			The id of another proxy.
+		\return
+			True if the proxies overlap. False otherwise.
+		*//******************************************************************/
+		bool TestProxiesOverlap(uint32_t proxyA, uint32_t proxyB) const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets the fattened AABB of a proxy.
+		\param proxy
+			The id of the proxy.
+		\param outMin
+			The bottom left corner of the AABB is written here.
+		\param outMax
+			The top right corner of the AABB is written here.
+		*//******************************************************************/
+		void GetProxyBounds(uint32_t proxy, Vector2* outMin, Vector2* outMax) const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets the layer bit of a proxy.
+		\param proxy
+			The id of the proxy.
+		\return
+			The layer bit.
+		*//******************************************************************/
+		uint32_t GetProxyLayerBits(uint32_t proxy) const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets the hash of the entity of a proxy's collider.
+		\param proxy
+			The id of the proxy.
+		\return
+			The hash of the entity.
+		*//******************************************************************/
+		ecs::EntityHash GetProxyEntity(uint32_t proxy) const;
+
+		/*****************************************************************//*!
+		\brief
+			Calls a function for each proxy whose fattened AABB may be hit by a ray before the maximum distance.
+			Subtrees closer to the ray's origin are visited first, and the function may shorten the maximum
+			distance as hits are found, so that closest hit queries skip subtrees beyond the closest hit.
+		\tparam Callback
+			float(uint32_t proxy, float maxDistance). Returns the new maximum distance, or a negative number to stop.
+		\param origin
+			The origin of the ray.
+		\param direction
+			The direction of the ray. Distances are measured in multiples of this vector.
+		\param maxDistance
+			The maximum distance along the ray.
+		\param layerMask
+			Only proxies on these layers are visited.
+		\param callback
+			The function to call for each proxy.
+		*//******************************************************************/
+		template <typename Callback>
+		void RayCast(const Vector2& origin, const Vector2& direction, float maxDistance, uint32_t layerMask, Callback&& callback) const;
+
+		/*****************************************************************//*!
+		\brief
+			Calls a function for each proxy whose fattened AABB overlaps an AABB.
+		\tparam Callback
+			bool(uint32_t proxy). Returns false to stop.
+		\param min
+			The bottom left corner of the AABB.
+		\param max
+			The top right corner of the AABB.
+		\param layerMask
+			Only proxies on these layers are visited.
+		\param callback
+			The function to call for each proxy.
+		*//******************************************************************/
+		template <typename Callback>
+		void Query(const Vector2& min, const Vector2& max, uint32_t layerMask, Callback&& callback) const;
+
+		/*****************************************************************//*!
+		\brief
+			Calls a function for each node within the tree, for debug drawing.
+		\tparam Callback
+			void(const Vector2& min, const Vector2& max, bool isLeaf)
+		\param callback
+			The function to call for each node.
+		*//******************************************************************/
+		template <typename Callback>
+		void ForEachNode(Callback&& callback) const;
+
+		/*****************************************************************//*!
+		\brief
+			Removes all proxies.
+		*//******************************************************************/
+		void Clear();
+
+		/*****************************************************************//*!
+		\brief
+			Gets the number of proxies within the tree.
+		\return
+			The number of proxies.
+		*//******************************************************************/
+		uint32_t GetNumProxies() const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets the number of nodes that the tree has space for. All proxy ids are less than this.
+		\return
+			The number of nodes.
+		*//******************************************************************/
+		uint32_t GetCapacity() const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets the height of the tree.
+		\return
+			The height of the tree. 0 if the tree is empty or only has 1 proxy.
+		*//******************************************************************/
+		int GetHeight() const;
+
+	private:
+		/*****************************************************************//*!
+		\struct Node
+		\brief
+			A node within the tree. Leaf nodes are proxies.
+		*//******************************************************************/
+		struct Node
+		{
+			//! The bottom left corner of this node's (fattened) AABB.
+			Vector2 min;
+			//! The top right corner of this node's (fattened) AABB.
+			Vector2 max;
+			//! The parent of this node. If this node is free, the next free node instead.
+			uint32_t parent;
+			//! The children of this node. NULL_NODE if this node is a leaf.
+			uint32_t children[2];
+			//! The height of this node. 0 for leaves, -1 for free nodes.
+			int height;
+			//! The layers of all proxies within this node.
+			uint32_t layerBits;
+			//! The hash of the entity of this proxy's collider.
+			ecs::EntityHash entity;
+			//! The last sync that this proxy was created or updated in.
+			uint32_t syncStamp;
+
+			/*****************************************************************//*!
+			\brief
+				Checks whether this node is a leaf.
+			\return
+				True if this node is a leaf. False otherwise.
+			*//******************************************************************/
+			bool IsLeaf() const;
+		};
+
+		/*****************************************************************//*!
+		\brief
+			Takes a node from the free list, growing the node pool if there are no free nodes.
+		\return
+			The index of the node.
+		*//******************************************************************/
+		uint32_t AllocateNode();
+
+		/*****************************************************************//*!
+		\brief
+			Returns a node to the free list.
+		\param node
+			The index of the node.
+		*//******************************************************************/
+		void FreeNode(uint32_t node);
+
+		/*****************************************************************//*!
+		\brief
+			Inserts a leaf into the tree next to the sibling that increases the tree's total perimeter the least.
+		\param leaf
+			The index of the leaf.
+		*//******************************************************************/
+		void InsertLeaf(uint32_t leaf);
+
+		/*****************************************************************//*!
+		\brief
+			Removes a leaf from the tree, without freeing it.
+		\param leaf
+			The index of the leaf.
+		*//******************************************************************/
+		void RemoveLeaf(uint32_t leaf);
+
+		/*****************************************************************//*!
+		\brief
+			Walks up the tree from a node, rebalancing and recalculating the bounds, heights and layers of each ancestor.
+		\param node
+			The index of the node to start from.
+		*//******************************************************************/
+		void RefitAncestors(uint32_t node);
+
+		/*****************************************************************//*!
+		\brief
+			Rotates a node's children if they are imbalanced.
+		\param node
+			The index of the node.
+		\return
+			The index of the node that now occupies the node's position within the tree.
+		*//******************************************************************/
+		uint32_t Balance(uint32_t node);
+
+		/*****************************************************************//*!
+		\brief
+			Recalculates a node's bounds, height and layers from its children.
+		\param node
+			The index of the node.
+		*//******************************************************************/
+		void RefitNode(uint32_t node);
+
+		/*****************************************************************//*!
+		\brief
+			Gets the distance along a ray at which it enters a node's AABB, if it does before the maximum distance.
+			Axes that the ray is parallel to are treated the same way as ColliderBase's raycast, so that
+			a ray that hits a collider always hits the collider's proxy.
+		\param node
+			The node.
+		\param origin
+			The origin of the ray.
+		\param direction
+			The direction of the ray.
+		\param maxDistance
+			The maximum distance along the ray.
+		\param outDistance
+			The entry distance is written here.
+		\return
+			True if the ray enters the node's AABB at or before the maximum distance. False otherwise.
+		*//******************************************************************/
+		static bool RayEntersNode(const Node& node, const Vector2& origin, const Vector2& direction, float maxDistance, float* outDistance);
+
+		/*****************************************************************//*!
+		\brief
+			Gets the perimeter of an AABB.
+		\param min
+			The bottom left corner of the AABB.
+		\param max
+			The top right corner of the AABB.
+		\return
+			The perimeter of the AABB.
+		*//******************************************************************/
+		static float GetPerimeter(const Vector2& min, const Vector2& max);
+
+	private:
+		//! The node pool.
+		std::vector<Node> nodes;
+		//! The root node of the tree.
+		uint32_t root;
+		//! The first node in the free list.
+		uint32_t freeList;
+		//! The number of proxies within the tree.
+		uint32_t numProxies;
+		//! Reused by queries to avoid allocating per query.
+		mutable std::vector<uint32_t> queryStack;
+	};
+
+#pragma endregion // AABB Tree
+
+#pragma region Broadphase
+
+	/*****************************************************************//*!
+	\brief
+		Enums that classify how a collider's body moves, which determines whether a pair of colliders can collide.
+	*//******************************************************************/
+	enum class BODY_TYPE : char
+	{
+		STATIC,		// No PhysicsComp. Never pushed, and never collides with other static bodies.
+		KINEMATIC,	// A PhysicsComp that isn't dynamic. Never pushed, but still produces collision events.
+		DYNAMIC		// A dynamic PhysicsComp.
+	};
+
+	/*****************************************************************//*!
+	\class Broadphase
+	\brief
+		Keeps an AABBTree of the active ColliderComps within each ECS pool, along with the pairs of colliders
+		whose proxies overlap. Pairs persist between syncs, and only proxies that were reinserted are queried
+		for new pairs, so colliders that stay within their fattened AABBs cost almost nothing to sync.
+		Pairs between 2 static bodies are never kept, since they can never collide. Neither are pairs whose
+		layers don't collide according to the layers matrix, which each proxy carries as a bit per layer.
+
+		Trees are fully synced at the start of each collision update. Queries also bring the proxies of the tree
+		up to date beforehand if systems have run or colliders were attached, resized or changed layers since the
+		last sync, so colliders that were created or moved outside their fattened AABBs since then are still found,
+		including in frames and ECS pools where no collision update ran. Pairs are only updated by full syncs.
+	*//******************************************************************/
+	class Broadphase
+	{
+	public:
+		// Enable singleton without exposing constructor
+		friend class ST<Broadphase>;
+
+		/*****************************************************************//*!
+		\struct BodyCounts
+		\brief
+			The number of colliders of each body type within an ECS pool, as of the last sync.
+		*//******************************************************************/
+		struct BodyCounts
+		{
+			//! The number of colliders without a PhysicsComp.
+			uint32_t numStatic;
+			//! The number of colliders whose PhysicsComp isn't dynamic.
+			uint32_t numKinematic;
+			//! The number of colliders whose PhysicsComp is dynamic and awake.
+			uint32_t numAwake;
+			//! The number of colliders whose PhysicsComp is dynamic and sleeping.
+			uint32_t numSleeping;
+			//! The number of pairs of overlapping proxies.
+			uint32_t numPairs;
+		};
+
+		/*****************************************************************//*!
+		\brief
+			Destructor.
+		*//******************************************************************/
+		~Broadphase();
+
+		/*****************************************************************//*!
+		\brief
+			Updates the current ECS pool's tree with the bounds and layers of all active ColliderComps within the pool.
+			Proxies of colliders that were removed or deactivated since the last sync are destroyed.
+			Then pairs whose proxies no longer overlap are dropped, and pairs with reinserted proxies are added.
+		*//******************************************************************/
+		void Sync();
+
+		/*****************************************************************//*!
+		\brief
+			Updates the proxies of the current ECS pool's tree as Sync() does, without updating pairs, if the tree may be stale.
+			The tree may be stale if any systems have run within the pool, or MarkDirty() was called, since the tree was last synced.
+			Proxies that are reinserted here have their pairs found by the next Sync().
+		*//******************************************************************/
+		void SyncProxiesIfStale();
+
+		/*****************************************************************//*!
+		\brief
+			Marks the current ECS pool's tree as stale, so that its proxies are updated before the next query.
+			This is called when a collider is attached, or its bounds or layer are changed.
+		*//******************************************************************/
+		static void MarkDirty();
+
+		/*****************************************************************//*!
+		\brief
+			Gets the number of colliders of each body type within the current ECS pool, as of the last sync.
+		\return
+			The counts.
+		*//******************************************************************/
+		BodyCounts GetBodyCounts();
+
+		/*****************************************************************//*!
+		\brief
+			Calls a function for each pair of colliders in the current ECS pool whose proxies overlapped as of the last sync.
+			Colliders are referenced as of the last sync, so this must be called before components are next flushed.
+		\tparam Callback
+			void(ColliderComp& compA, ColliderComp& compB)
+		\param callback
+			The function to call for each pair.
+		*//******************************************************************/
+		template <typename Callback>
+		void ForEachPair(Callback&& callback);
+
+		/*****************************************************************//*!
+		\brief
+			Calls a function for each active collider in the current ECS pool whose proxy may be hit by a ray
+			before the maximum distance. Colliders that no longer exist are skipped.
+		\tparam Callback
+			float(ColliderComp& comp, float maxDistance). Returns the new maximum distance, or a negative number to stop.
+		\param origin
+			The origin of the ray.
+		\param direction
+			The direction of the ray. Distances are measured in multiples of this vector.
+		\param maxDistance
+			The maximum distance along the ray.
+		\param mask
+			Only colliders on these layers are visited.
+		\param callback
+			The function to call for each collider.
+		*//******************************************************************/
+		template <typename Callback>
+		void RayCast(const Vector2& origin, const Vector2& direction, float maxDistance, const EntityLayersMask& mask, Callback&& callback);
+
+		/*****************************************************************//*!
+		\brief
+			Calls a function for each active collider in the current ECS pool whose proxy overlaps an AABB.
+			Colliders that no longer exist are skipped.
+		\tparam Callback
+			bool(ColliderComp& comp). Returns false to stop.
+		\param min
+			The bottom left corner of the AABB.
+		\param max
+			The top right corner of the AABB.
+		\param layerBits
+			Only colliders on these layers are visited, where bit N is set to visit layer N.
+		\param callback
+			The function to call for each collider.
+		*//******************************************************************/
+		template <typename Callback>
+		void Query(const Vector2& min, const Vector2& max, uint32_t layerBits, Callback&& callback);
+
+		/*****************************************************************//*!
+		\brief
+			Gets the current ECS pool's tree.
+		\return
+			The tree.
+		*//******************************************************************/
+		const AABBTree& GetTree();
+
+		/*****************************************************************//*!
+		\brief
+			Converts a layers mask into a bit per layer.
+		\param mask
+			The layers mask.
+		\return
+			The layers, where bit N is set if layer N is set.
+		*//******************************************************************/
+		static uint32_t GetLayerBits(const EntityLayersMask& mask);
+
+		/*****************************************************************//*!
+		\brief
+			Gets the layers that a layer collides with according to the layers matrix.
+		\param layer
+			The layer.
+		\return
+			The layers, where bit N is set if the layer collides with layer N.
+		*//******************************************************************/
+		static uint32_t GetCollisionLayerBits(ENTITY_LAYER layer);
+
+	private:
+		/*****************************************************************//*!
+		\struct PoolData
+		\brief
+			The broadphase state of a single ECS pool.
+		*//******************************************************************/
+		struct PoolData
+		{
+			//! The tree of colliders.
+			AABBTree tree;
+			//! The pairs of overlapping proxies, with the lower id in the upper 32 bits. Sorted.
+			std::vector<uint64_t> pairs;
+			//! The collider of each proxy as of the last sync, by proxy id.
+			std::vector<ecs::CompHandle<ColliderComp>> proxyColliders;
+			//! The body type of each proxy as of the last sync, by proxy id.
+			std::vector<BODY_TYPE> proxyBodyTypes;
+			//! The layers that each proxy's layer collides with as of the last sync, by proxy id.
+			std::vector<uint32_t> proxyCollisionBits;
+			//! The layers that each layer collides with as of the last sync, to detect changes to the layers matrix.
+			std::array<uint32_t, +ENTITY_LAYER::TOTAL> layerCollisionBits;
+			//! The number of colliders of each body type as of the last sync.
+			BodyCounts bodyCounts;
+			//! The proxies that were created or reinserted since pairs were last updated. Reused between syncs.
+			std::vector<uint32_t> movedProxies;
+			//! The pairs found by querying moved proxies in the current sync. Reused between syncs.
+			std::vector<uint64_t> newPairs;
+			//! The number of batches of systems that had run within the ECS pool when proxies were last updated.
+			uint64_t syncedBatch{};
+			//! Whether colliders may have changed in ways that systems running don't account for, since proxies were last updated.
+			bool isDirty{ true };
+		};
+
+		/*****************************************************************//*!
+		\brief
+			Constructor.
+		*//******************************************************************/
+		Broadphase();
+
+		/*****************************************************************//*!
+		\brief
+			Updates a pool's tree with the bounds and layers of all active ColliderComps within the current ECS pool,
+			destroying proxies of colliders that were removed or deactivated. Created and reinserted proxies are added to
+			the pool's moved proxies.
+		\param pool
+			The pool whose tree to update.
+		*//******************************************************************/
+		void SyncProxies(PoolData& pool);
+
+		/*****************************************************************//*!
+		\brief
+			Drops pairs that no longer overlap, and adds pairs between moved proxies and the proxies they overlap.
+			Pairs between 2 static proxies or proxies whose layers don't collide are neither kept nor added.
+		\param pool
+			The pool whose pairs to update.
+		*//******************************************************************/
+		static void UpdatePairs(PoolData& pool);
+
+		/*****************************************************************//*!
+		\brief
+			Packs 2 proxy ids into a pair, with the lower id first.
+		\param proxyA
+			The id of a proxy.
+		\param proxyB
+			The id of another proxy.
+		\return
+			The pair.
+		*//******************************************************************/
+		static uint64_t MakePair(uint32_t proxyA, uint32_t proxyB);
+
+		/*****************************************************************//*!
+		\brief
+			Classifies the body of a collider's entity, and counts it.
+		\param entity
+			The entity of the collider.
+		\param counts
+			The count of the entity's body type is incremented here.
+		\return
+			The body type.
+		*//******************************************************************/
+		static BODY_TYPE GetBodyType(ecs::EntityHandle entity, BodyCounts* counts);
+
+		/*****************************************************************//*!
+		\brief
+			Gets the collider of a proxy, if the proxy's entity still exists and its collider is active and still owns the proxy.
+		\param tree
+			The tree that the proxy is in.
+		\param proxy
+			The id of the proxy.
+		\return
+			The collider. nullptr if the proxy is stale.
+		*//******************************************************************/
+		static ecs::CompHandle<ColliderComp> GetProxyCollider(const AABBTree& tree, uint32_t proxy);
+
+		/*****************************************************************//*!
+		\brief
+			Deletes the tree of an ECS pool that is being deleted.
+		\param id
+			The id of the ECS pool.
+		*//******************************************************************/
+		static void OnECSPoolDeletion(ecs::POOL id);
+
+	private:
+		//! The broadphase state of each ECS pool.
+		std::map<ecs::POOL, PoolData> pools;
+		//! Increments with each sync, to identify proxies that were not synced.
+		uint32_t syncStamp;
+	};
+
+#pragma endregion // Broadphase
+
+}
+
+#include "Broadphase.ipp"
@@ -0,0 +1,157 @@
+/******************************************************************************/
+/*!
+\file   Broadphase.ipp
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the source file implementing templates within the broadphase, which are
+  the tree traversals for queries.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#include "Broadphase.h"
+
+namespace Physics {
+
+#pragma region AABB Tree
+
+	template<typename Callback>
+	void AABBTree::RayCast(const Vector2& origin, const Vector2& direction, float maxDistance, uint32_t layerMask, Callback&& callback) const
+	{
+		float entryDistance{};
+		if (root == NULL_NODE || !(nodes[root].layerBits & layerMask) || !RayEntersNode(nodes[root], origin, direction, maxDistance, &entryDistance))
+			return;
+
+		// The stack may be in use by a query further up the callstack (e.g. a raycast from within a callback)
+		std::vector<uint32_t> stack{};
+		stack.swap(queryStack);
+		stack.clear();
+		stack.push_back(root);
+
+		while (!stack.empty())
+		{
+			uint32_t nodeIndex{ stack.back() };
+			const Node& node{ nodes[nodeIndex] };
+			stack.pop_back();
+
+			// The maximum distance may have shortened since this node was pushed
+			if (!RayEntersNode(node, origin, direction, maxDistance, &entryDistance))
+				continue;
+
+			if (node.IsLeaf())
+			{
+				maxDistance = callback(nodeIndex, maxDistance);
+				if (maxDistance < 0.0f)
+					break;
+				continue;
+			}
+
+			// Push the farther child first so that the nearer child is visited first
+			float childDistances[2]{};
+			bool childHits[2]{};
+			for (int i{}; i < 2; ++i)
+			{
+				const Node& child{ nodes[node.children[i]] };
+				childHits[i] = (child.layerBits & layerMask) && RayEntersNode(child, origin, direction, maxDistance, &childDistances[i]);
+			}
+			int nearer{ (childHits[0] && childHits[1] && childDistances[1] < childDistances[0]) ? 1 : 0 };
+			if (childHits[1 - nearer])
+				stack.push_back(node.children[1 - nearer]);
+			if (childHits[nearer])
+				stack.push_back(node.children[nearer]);
+		}
+
+		stack.swap(queryStack);
+	}
+
+	template<typename Callback>
+	void AABBTree::Query(const Vector2& min, const Vector2& max, uint32_t layerMask, Callback&& callback) const
+	{
+		if (root == NULL_NODE)
+			return;
+
+		std::vector<uint32_t> stack{};
+		stack.swap(queryStack);
+		stack.clear();
+		stack.push_back(root);
+
+		while (!stack.empty())
+		{
+			uint32_t nodeIndex{ stack.back() };
+			const Node& node{ nodes[nodeIndex] };
+			stack.pop_back();
+
+			if (!(node.layerBits & layerMask) ||
+				node.max.x < min.x || node.min.x > max.x || node.max.y < min.y || node.min.y > max.y)
+				continue;
+
+			if (node.IsLeaf())
+			{
+				if (!callback(nodeIndex))
+					break;
+				continue;
+			}
+
+			stack.push_back(node.children[0]);
+			stack.push_back(node.children[1]);
+		}
+
+		stack.swap(queryStack);
+	}
+
+	template<typename Callback>
+	void AABBTree::ForEachNode(Callback&& callback) const
+	{
+		for (const Node& node : nodes)
+			if (node.height >= 0)
+				callback(node.min, node.max, node.IsLeaf());
+	}
+
+#pragma endregion // AABB Tree
+
+#pragma region Broadphase
+
+	template<typename Callback>
+	void Broadphase::RayCast(const Vector2& origin, const Vector2& direction, float maxDistance, const EntityLayersMask& mask, Callback&& callback)
+	{
+		SyncProxiesIfStale();
+		const AABBTree& tree{ GetTree() };
+		tree.RayCast(origin, direction, maxDistance, GetLayerBits(mask), [&tree, &callback](uint32_t proxy, float maxDistance) -> float {
+			ecs::CompHandle<ColliderComp> comp{ GetProxyCollider(tree, proxy) };
+			return comp ? callback(*comp, maxDistance) : maxDistance;
+		});
+	}
+
+	template<typename Callback>
+	void Broadphase::Query(const Vector2& min, const Vector2& max, uint32_t layerBits, Callback&& callback)
+	{
+		SyncProxiesIfStale();
+		const AABBTree& tree{ GetTree() };
+		tree.Query(min, max, layerBits, [&tree, &callback](uint32_t proxy) -> bool {
+			ecs::CompHandle<ColliderComp> comp{ GetProxyCollider(tree, proxy) };
+			return comp ? callback(*comp) : true;
+		});
+	}
+
+	template<typename Callback>
+	void Broadphase::ForEachPair(Callback&& callback)
+	{
+		const PoolData& pool{ pools[ecs::GetCurrentPoolId()] };
+		for (uint64_t pair : pool.pairs)
+			callback(*pool.proxyColliders[static_cast<uint32_t>(pair >> 32)], *pool.proxyColliders[static_cast<uint32_t>(pair)]);
+	}
+
+#pragma endregion // Broadphase
+
+}
@@ -28,6 +28,7 @@ All rights reserved.
 #include "AudioManager.h"
 #include "EnemyStateMachine.h"
 #include <FadeAndDie.h>
+#include "EntityRecycler.h"
 
 #define BULLET_SPEED_MULTIPLIER 25.0f
 
@@ -234,11 +235,11 @@ void BulletComponent::OnCollision(const Physics::CollisionEventData& collisionDa
 	ecs::EntityHandle bulletImpact{ nullptr };
 	if (isPlayerBullet)
 	{
-		bulletImpact = ST<PrefabManager>::Get()->LoadPrefab("BulletImpactBlue");
+		bulletImpact = ST<EntityRecycler>::Get()->Spawn("BulletImpactBlue");
 	}
 	else
 	{
-		bulletImpact = ST<PrefabManager>::Get()->LoadPrefab("BulletImpactRed");
+		bulletImpact = ST<EntityRecycler>::Get()->Spawn("BulletImpactRed");
 	}
 	bulletImpact->GetComp<AnimatorComponent>()->Play();
 	bulletImpact->GetTransform().SetWorldPosition(worldPosition);
@@ -262,7 +263,7 @@ void BulletComponent::OnCollision(const Physics::CollisionEventData& collisionDa
 				0.5f);
 			});
 	}
-	ecs::DeleteEntity(thisEntity);
+	ST<EntityRecycler>::Get()->Release(thisEntity);
 }
 
 BulletMovementSystem::BulletMovementSystem()
@@ -286,7 +287,7 @@ void BulletMovementSystem::UpdateBulletComp(BulletComponent& comp)
 	comp.LowerLifeTime(dt);
 	if (comp.GetLifeTime() <= 0.0f)
 	{
-		ecs::DeleteEntity(bulletEntity);
+		ST<EntityRecycler>::Get()->Release(bulletEntity);
 	}
 }
 
@@ -312,7 +313,7 @@ void LaserRendererSystem::UpdateLaserComp(LaserComponent& comp)
 	comp.LowerLifeTime(dt);
 	if (comp.GetLifeTime() <= 0.0f)
 	{
-		ecs::DeleteEntity(laserEntity);
+		ST<EntityRecycler>::Get()->Release(laserEntity);
 	}
 
 }
@@ -387,7 +388,7 @@ void LaserComponent::Fire(float distance, Vector2 origin, Vector2 direction, flo
 		// Create a new laser OBJECT for each segment past the first, but do not fire it because it do be expensive
 		ecs::EntityHandle newLaser = thisEntity;
 		if (currentSegment != 0.0f)
-			newLaser = PrefabManager::LoadPrefab(isPlayerLaser ? "Laser" : "LaserEnemy");
+			newLaser = ST<EntityRecycler>::Get()->Spawn(isPlayerLaser ? "Laser" : "LaserEnemy");
 
 		// Position is the midpoint between the previous and cuurent segment
 		newLaser->GetTransform().SetWorldPosition(origin + direction * (currentSegment + previousSegment) / 2 * maxDistancePerSegment);
@@ -451,7 +452,7 @@ void LaserComponent::Fire(float distance, Vector2 origin, Vector2 direction, flo
 			else
 			{
 				// Create a new laser and fire
-				ecs::EntityHandle newLaser = PrefabManager::LoadPrefab(isPlayerLaser ? "Laser" : "LaserEnemy");
+				ecs::EntityHandle newLaser = ST<EntityRecycler>::Get()->Spawn(isPlayerLaser ? "Laser" : "LaserEnemy");
 
 				// Get the new laser's fire direction through reflection
 				Vector2 normal = raycastResult.collisionNormal;
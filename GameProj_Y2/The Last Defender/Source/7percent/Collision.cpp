@@ -12,7 +12,7 @@
 \par    DigiPen login: kendrickheanguan.s
 
 \brief
-  This is the source file that implements the Collision system, QuadTree, collision component,
+  This is the source file that implements the Collision system, collision component,
   and various collider definitions such as AABB, that implement a structure that can detect
   and separate collisions.
 
@@ -22,11 +22,36 @@ All rights reserved.
 /******************************************************************************/
 
 #include "Collision.h"
+#include "Broadphase.h"
 #include "Physics.h"
 #include "Player.h"
 #include "GameSettings.h"
 #include "Editor.h"
 
+namespace {
+	//! How far short of the time of impact a swept collider is stopped, so that the discrete test doesn't report the same collision again.
+	constexpr float SWEEP_SKIN{ 0.01f };
+
+	/*****************************************************************//*!
+	\brief
+		Gets the squared distance from a point to the nearest point on an AABB.
+	\param point
+		The point.
+	\param center
+		The center of the AABB.
+	\param halfLengths
+		The half lengths of the AABB.
+	\return
+		The squared distance. 0 if the point is within the AABB.
+	*//******************************************************************/
+	float GetDistanceSquaredToAABB(const Vector2& point, const Vector2& center, const Vector2& halfLengths)
+	{
+		float distanceX{ std::max(std::fabs(point.x - center.x) - halfLengths.x, 0.0f) };
+		float distanceY{ std::max(std::fabs(point.y - center.y) - halfLengths.y, 0.0f) };
+		return distanceX * distanceX + distanceY * distanceY;
+	}
+}
+
 namespace Physics {
 
 #define X(name, str) str,
@@ -38,7 +63,7 @@ namespace Physics {
 	};
 #undef X
 
-#pragma region QuadTree
+#pragma region Broadphase
 
 	BoxWrapper::BoxWrapper(const Vector2& center, const Vector2& halfLengths, ecs::CompHandle<ColliderComp> comp)
 		: center{ center }
@@ -62,236 +87,15 @@ namespace Physics {
 		return compHandle;
 	}
 
-	Node::Node()
-		: remainingSplits{ 0 }
-		, isRoot{ false }
-		, center{}
-		, halfLength{ 0.0f }
-		, children{ nullptr }
-	{
-	}
-
-	Node::~Node()
-	{
-		if (children)
-			delete[] children;
-	}
-
-	void Node::Setup(int newRemainingSplits, const Vector2& newCenter, float newHalfLength, bool newIsRoot)
-	{
-		remainingSplits = newRemainingSplits;
-		isRoot = newIsRoot;
-		center = newCenter;
-		halfLength = newHalfLength;
-
-		SetupChildren();
-	}
-
-	bool Node::Insert(BoxWrapper& box)
-	{
-		// Nodes should only hold boxes that are fully contained within the node
-		// except the root node which should hold boxes that are at least partially overlapping
-		//	This variable is a pointer to a const member function of Node that takes a BoxWrapper and returns bool.
-		bool (Node::*ContainmentTest)(const BoxWrapper&) const { (isRoot ? &Node::IsOverlapping : &Node::FullyContains) };
-		if (!(this->*ContainmentTest)(box))
-			return false;
-
-		// Attempt to insert to children. If the children accepts the box, that means the box is fully contained within the child.
-		if (TryInsertToChildren(box))
-			return true;
-
-		// Failed to insert to any children, so this box should be inserted into ourselves
-		colliders.emplace_back(std::move(box));
-
-		// Check whether the threshold for further splitting is reached.
-		if (remainingSplits && colliders.size() > static_cast<size_t>(QuadTree::MAX_COLLIDERS) && !children)
-		{
-			children = new Node[4]{};
-			SetupChildren();
-
-			for (auto iter{ colliders.rbegin() }; iter != colliders.rend(); )
-			{
-				if (TryInsertToChildren(*iter))
-					// erase() is not defined for reverse iterators, so we kinda have to hack this a bit to make it work.
-					// We're converting the reverse iterator into a normal iterator to erase.
-					// erase() then gives back a normal iterator, which we use to construct a new reverse iterator pointing to the next collider in line.
-					iter = decltype(iter){ colliders.erase(std::next(iter).base()) };
-				else
-					++iter;
-			}
-		}
-
-		return true;
-	}
-
-	bool Node::Prune()
-	{
-		// Whether all our children are safe to be deleted
-		bool childrenSafeToDelete{ static_cast<bool>(children) };
-
-		// Need to tell our children to try to prune
-		if (children)
-		{
-			for (int i = 0; i < 4; ++i)
-				// If a child says that it can't be prune, we can't delete any of our children
-				if (!children[i].Prune())
-					childrenSafeToDelete = false;
-		}
-
-		// Delete children if they are empty
-		if (childrenSafeToDelete)
-		{
-			delete[] children;
-			children = nullptr;
-		}
-
-		// We are only safe to be deleted when we have no children and no colliders
-		return !children && colliders.empty();
-	}
-
-	void Node::Clear()
-	{
-		colliders.clear();
-		if (children)
-			for (int i = 0; i < 4; ++i)
-				children[i].Clear();
-	}
-
-	void Node::CheckCollisionPairs(CollisionSystem& collisionSystem) const
-	{
-		// Check colliders on this node
-		for (auto thisCollider{ colliders.begin() }, endCollider{ colliders.end() }; thisCollider != endCollider; ++thisCollider)
-		{
-			// Check collisions between each collider within this node
-			for (auto otherCollider{ thisCollider + 1 }; otherCollider != endCollider; ++otherCollider)
-				collisionSystem.CheckCollision(*thisCollider->GetCompHandle(), *otherCollider->GetCompHandle());
-
-			// Check for collisions between this collider and all colliders in children
-			if (children)
-				for (int i = 0; i < 4; ++i)
-					children[i].CheckCollisionPairs(*thisCollider, collisionSystem);
-		}
-
-		// Check colliders in children
-		if (children)
-			for (int i = 0; i < 4; ++i)
-				children[i].CheckCollisionPairs(collisionSystem);
-	}
-
-	Vector2 Node::GetCenter() const
-	{
-		return center;
-	}
-
-	void Node::SetupChildren()
-	{
-		if (!children)
-			return;
-
-		float quarterLength{ halfLength * 0.5f };
-		children[0].Setup(remainingSplits - 1, { center.x - quarterLength, center.y + quarterLength }, quarterLength); // Top left
-		children[1].Setup(remainingSplits - 1, { center.x + quarterLength, center.y + quarterLength }, quarterLength); // Top right
-		children[2].Setup(remainingSplits - 1, { center.x + quarterLength, center.y - quarterLength }, quarterLength); // Bot right
-		children[3].Setup(remainingSplits - 1, { center.x - quarterLength, center.y - quarterLength }, quarterLength); // Bot left
-	}
-
-	bool Node::FullyContains(const BoxWrapper& box) const
-	{
-		return QuadTree::CheckIsContained(center, halfLength, box.GetCenter(), box.GetHalfLengths());
-	}
-
-	bool Node::IsOverlapping(const BoxWrapper& box) const
-	{
-		return QuadTree::CheckIsOverlapping(center, halfLength, box.GetCenter(), box.GetHalfLengths());
-	}
-
-	bool Node::TryInsertToChildren(BoxWrapper& box)
-	{
-		if (children)
-			for (int i = 0; i < 4; ++i)
-				if (children[i].Insert(box))
-					return true;
-		return false;
-	}
-
-	void Node::CheckCollisionPairs(const BoxWrapper& box, CollisionSystem& collisionSystem) const
-	{
-		// This function is called from nodes above us. This collider may not collide with us.
-		if (!IsOverlapping(box))
-			return;
-
-		// Check collision between all colliders in this node.
-		for (const auto& collider : colliders)
-			collisionSystem.CheckCollision(*box.GetCompHandle(), *collider.GetCompHandle());
-
-		// Check collision in all children.
-		if (children)
-			for (int i = 0; i < 4; ++i)
-				children[i].CheckCollisionPairs(box, collisionSystem);
-	}
-
-	void Node::ExecuteFuncPerNode(void(*func)(const Vector2& nodeCenter, float nodeHalfLength)) const
-	{
-		func(center, halfLength);
-
-		if (children)
-			for (int i = 0; i < 4; ++i)
-				children[i].ExecuteFuncPerNode(func);
-	}
-
-	void QuadTree::Set(const Vector2& center, float length)
-	{
-		root.Setup(MAX_DEPTH - 1, center, length * 0.5f, true);
-	}
-
-	void QuadTree::Insert(ecs::CompHandle<ColliderComp> comp)
+	bool CheckIsOverlapping(const Vector2& squareCenter, float squareHalfLength, const Vector2& objCenter, const Vector2& objHalfLength)
 	{
-		BoxWrapper box{ comp->CreateBoxWrapper() };
-		root.Insert(box);
+		return squareCenter.x - squareHalfLength <= objCenter.x + objHalfLength.x &&
+			squareCenter.x + squareHalfLength >= objCenter.x - objHalfLength.x &&
+			squareCenter.y - squareHalfLength <= objCenter.y + objHalfLength.y &&
+			squareCenter.y + squareHalfLength >= objCenter.y - objHalfLength.y;
 	}
 
-	void QuadTree::Prune()
-	{
-		root.Prune();
-	}
-
-	void QuadTree::Clear()
-	{
-		root.Clear();
-	}
-
-	void QuadTree::CheckCollisionPairs(CollisionSystem& collisionSystem) const
-	{
-		root.CheckCollisionPairs(collisionSystem);
-	}
-
-	bool QuadTree::CheckIsContained(const Vector2& nodeCenter, float nodeHalfLength, const Vector2& objCenter, const Vector2& objHalfLength)
-	{
-		return nodeCenter.x - nodeHalfLength <= objCenter.x - objHalfLength.x &&
-			nodeCenter.x + nodeHalfLength >= objCenter.x + objHalfLength.x &&
-			nodeCenter.y - nodeHalfLength <= objCenter.y - objHalfLength.y &&
-			nodeCenter.y + nodeHalfLength >= objCenter.y + objHalfLength.y;
-	}
-
-	bool QuadTree::CheckIsOverlapping(const Vector2& nodeCenter, float nodeHalfLength, const Vector2& objCenter, const Vector2& objHalfLength)
-	{
-		return nodeCenter.x - nodeHalfLength <= objCenter.x + objHalfLength.x &&
-			nodeCenter.x + nodeHalfLength >= objCenter.x - objHalfLength.x &&
-			nodeCenter.y - nodeHalfLength <= objCenter.y + objHalfLength.y &&
-			nodeCenter.y + nodeHalfLength >= objCenter.y - objHalfLength.y;
-	}
-
-	void QuadTree::ExecuteFuncPerNode(void(*func)(const Vector2& nodeCenter, float nodeHalfLength)) const
-	{
-		root.ExecuteFuncPerNode(func);
-	}
-
-	Vector2 QuadTree::GetCenter() const
-	{
-		return root.GetCenter();
-	}
-
-#pragma endregion // QuadTree
+#pragma endregion // Broadphase
 
 #pragma region Collision
 
@@ -410,22 +214,24 @@ namespace Physics {
 		if (penetrationDist.x < 0.0f || penetrationDist.y < 0.0f)
 			return false;
 
-		// Let's take this collider as the main collider
-		outCollisionData->referenceCollider = this;
-		outCollisionData->otherCollider = &other;
-
 		// If x axis has smaller penetration than y axis, shortest separation vector is along x axis
 		if (penetrationDist.x < penetrationDist.y)
-		{
-			outCollisionData->collisionNormal = Vector2{ (positionDiff.x >= 0.0f ? -1.0f : 1.0f), 0.0f };
-			outCollisionData->penetrationDepth = penetrationDist.x;
-		}
+			CalculateCollision_AABB(thisPos, other, otherPos, Vector2{ (positionDiff.x >= 0.0f ? -1.0f : 1.0f), 0.0f }, penetrationDist.x, outCollisionData);
 		// Else shortest separation vector is along y axis
 		else
-		{
-			outCollisionData->collisionNormal = Vector2{ 0.0f, (positionDiff.y >= 0.0f ? -1.0f : 1.0f) };
-			outCollisionData->penetrationDepth = penetrationDist.y;
-		}
+			CalculateCollision_AABB(thisPos, other, otherPos, Vector2{ 0.0f, (positionDiff.y >= 0.0f ? -1.0f : 1.0f) }, penetrationDist.y, outCollisionData);
+
+		return true;
+	}
+
+	void AABB::CalculateCollision_AABB(const Vector2& thisPos, AABB& other, const Vector2& otherPos, const Vector2& collisionNormal, float penetrationDepth, CollisionData* outCollisionData)
+	{
+		// Let's take this collider as the main collider
+		outCollisionData->referenceCollider = this;
+		outCollisionData->otherCollider = &other;
+		outCollisionData->collisionNormal = collisionNormal;
+		outCollisionData->penetrationDepth = penetrationDepth;
+		Vector2 positionDiff{ otherPos - thisPos };
 
 		// Get the extents of the colliders along the orthogonal normal, separating between the shorter and longer collider
 		Vector2 right{ outCollisionData->collisionNormal.Rotate90() };
@@ -460,7 +266,43 @@ namespace Physics {
 			outCollisionData->collisionPoint += centerOfMassExtent;
 		else
 			outCollisionData->collisionPoint += receivingExtent;
+	}
+
+	bool AABB::TestSweep_AABB(const Vector2& startPos, const Vector2& displacement, const AABB& other, const Vector2& otherPos, float* outTimeOfImpact, Vector2* outCollisionNormal) const
+	{
+		// Sweeping this AABB against the other is the same as casting this AABB's center against the other AABB expanded by this AABB's size
+		Vector2 halfLengthsTotal{ halfLengths + other.halfLengths };
+		Vector2 expandedMin{ otherPos - halfLengthsTotal }, expandedMax{ otherPos + halfLengthsTotal };
 
+		// Same as TestCollision_AABB(), touching counts as overlapping
+		Vector2 startPenetration{ halfLengthsTotal - Abs(otherPos - startPos) };
+		if (startPenetration.x >= 0.0f && startPenetration.y >= 0.0f)
+			return false;
+
+		float tEnter{ 0.0f }, tExit{ 1.0f };
+		Vector2 normal{};
+		auto clipAxis{ [&tEnter, &tExit, &normal](float start, float dir, float min, float max, const Vector2& axis) -> bool {
+			if (dir == 0.0f)
+				return (min <= start && start <= max);
+
+			float t1{ (min - start) / dir }, t2{ (max - start) / dir };
+			if (t1 > t2)
+				std::swap(t1, t2);
+			if (t1 > tEnter)
+			{
+				tEnter = t1;
+				// The face that is entered faces against the direction of motion
+				normal = (dir > 0.0f ? -axis : axis);
+			}
+			tExit = std::min(tExit, t2);
+			return tEnter <= tExit;
+		} };
+		if (!clipAxis(startPos.x, displacement.x, expandedMin.x, expandedMax.x, Vector2{ 1.0f, 0.0f }) ||
+			!clipAxis(startPos.y, displacement.y, expandedMin.y, expandedMax.y, Vector2{ 0.0f, 1.0f }))
+			return false;
+
+		*outTimeOfImpact = tEnter;
+		*outCollisionNormal = normal;
 		return true;
 	}
 
@@ -599,6 +441,8 @@ namespace Physics {
 		, type{ type }
 		, collider{ AABB{ scale * 0.5f } }
 		, scale{ scale }
+		, broadphaseProxy{ AABBTree::NULL_NODE }
+		, layer{ ENTITY_LAYER::DEFAULT }
 	{
 	}
 
@@ -631,7 +475,7 @@ namespace Physics {
 	bool ColliderComp::CheckCollision(ColliderComp& otherCollider, CollisionData* outCollisionData)
 	{
 		// Don't need to check collision against colliders that don't collide with our masks
-		if (!GetMask().TestMask(otherCollider.GetMask()))
+		if (!TestLayerCollision(otherCollider))
 			return false;
 
 		return GetActiveCollider().TestCollision(
@@ -642,6 +486,39 @@ namespace Physics {
 		);
 	}
 
+	bool ColliderComp::CheckCollision(ColliderComp& otherCollider, const AABBPairBatch& batch, uint32_t batchIndex, CollisionData* outCollisionData)
+	{
+		// Don't need to check collision against colliders that don't collide with our masks
+		if (!TestLayerCollision(otherCollider))
+			return false;
+
+		// The batch was tested before any collisions were resolved, so colliders that have been pushed since need to be tested again
+		Vector2 thisPos{ ecs::GetEntityTransform(this).GetWorldPosition() };
+		Vector2 otherPos{ ecs::GetEntityTransform(&otherCollider).GetWorldPosition() };
+		if (!batch.IsPairAt(batchIndex, thisPos, otherPos))
+			return GetActiveCollider().TestCollision(thisPos, otherCollider.GetActiveCollider(), otherPos, outCollisionData);
+
+		if (!batch.IsHit(batchIndex))
+			return false;
+		collider.aabb.CalculateCollision_AABB(thisPos, otherCollider.collider.aabb, otherPos,
+			batch.GetCollisionNormal(batchIndex), batch.GetPenetrationDepth(batchIndex), outCollisionData);
+		return true;
+	}
+
+	bool ColliderComp::CheckSweep(ColliderComp& otherCollider, const Vector2& startPos, const Vector2& displacement, float* outTimeOfImpact, CollisionData* outCollisionData)
+	{
+		if (type != COLLIDER_TYPE::TYPE_AABB || otherCollider.type != COLLIDER_TYPE::TYPE_AABB || !TestLayerCollision(otherCollider))
+			return false;
+
+		Vector2 collisionNormal{};
+		Vector2 otherPos{ ecs::GetEntityTransform(&otherCollider).GetWorldPosition() };
+		if (!collider.aabb.TestSweep_AABB(startPos, displacement, otherCollider.collider.aabb, otherPos, outTimeOfImpact, &collisionNormal))
+			return false;
+
+		collider.aabb.CalculateCollision_AABB(startPos + displacement * *outTimeOfImpact, otherCollider.collider.aabb, otherPos, collisionNormal, 0.0f, outCollisionData);
+		return true;
+	}
+
 	bool ColliderComp::CheckRaycast(const Ray& ray, RaycastResult* outResult)
 	{
 		switch (GetActiveCollider().TestRaycast(ecs::GetEntityTransform(this).GetWorldPosition(), ray, outResult))
@@ -692,6 +569,7 @@ namespace Physics {
 	void ColliderComp::SetScale(const Vector2& newScale)
 	{
 		scale = newScale;
+		Broadphase::MarkDirty();
 	}
 
 	bool ColliderComp::IsTrigger() const
@@ -742,9 +620,25 @@ namespace Physics {
 		}
 	}
 
+	ENTITY_LAYER ColliderComp::GetLayer() const
+	{
+		return layer;
+	}
+
+	void ColliderComp::SetCachedLayer(ENTITY_LAYER newLayer)
+	{
+		layer = newLayer;
+		Broadphase::MarkDirty();
+	}
+
 	EntityLayersMask ColliderComp::GetMask() const
 	{
-		return EntityLayersMask{ { ecs::GetEntity(this)->GetComp<EntityLayerComponent>()->GetLayer() } };
+		return EntityLayersMask{ { layer } };
+	}
+
+	bool ColliderComp::TestLayerCollision(const ColliderComp& otherCollider) const
+	{
+		return EntityLayersMask::TestMatrix(layer, otherCollider.layer);
 	}
 
 	COLLIDER_TYPE ColliderComp::GetColliderType() const
@@ -755,6 +649,7 @@ namespace Physics {
 	void ColliderComp::SetColliderType(COLLIDER_TYPE newType)
 	{
 		type = newType;
+		Broadphase::MarkDirty();
 		switch (type)
 		{
 		case COLLIDER_TYPE::TYPE_AABB:
@@ -766,6 +661,21 @@ namespace Physics {
 		}
 	}
 
+	uint32_t ColliderComp::GetBroadphaseProxy() const
+	{
+		return broadphaseProxy;
+	}
+
+	void ColliderComp::OnAttached()
+	{
+		// The EntityLayerComponent may have been attached (and its layer set) before this component
+		if (ecs::CompHandle<EntityLayerComponent> layerComp{ ecs::GetEntity(this)->GetComp<EntityLayerComponent>() })
+			layer = layerComp->GetLayer();
+
+		// New colliders need proxies before they can be found by queries
+		Broadphase::MarkDirty();
+	}
+
 #ifdef IMGUI_ENABLED
 	void ColliderComp::EditorDraw(ColliderComp& comp)
 	{
@@ -819,20 +729,25 @@ namespace Physics {
 	}
 
 	CollisionSystem::CollisionSystem()
-		: SystemOperatingByLayer{ &CollisionSystem::AddCompToQuadTree }
-		, physSystemHandle{ ecs::GetSystem<PhysicsSystem>() }
+		: SystemOperatingByLayer{ &CollisionSystem::AddCompToSimulation }
+		, simulationCenter{}
+		, simulationHalfLength{ ST<GameSettings>::Get()->m_collisionSimulationSize * 0.5f }
 	{
-		quadTree.Set({}, ST<GameSettings>::Get()->m_collisionSimulationSize);
 	}
 
 	bool CollisionSystem::PreRun()
 	{
-		// Center the quadtree on the player
+		// Center the simulation area on the player
 		auto playerCompsIter{ ecs::GetCompsBegin<PlayerComponent>() };
 		if (playerCompsIter != ecs::GetCompsEnd<PlayerComponent>())
-			quadTree.Set(playerCompsIter.GetEntity()->GetTransform().GetWorldPosition(), ST<GameSettings>::Get()->m_collisionSimulationSize);
+			simulationCenter = playerCompsIter.GetEntity()->GetTransform().GetWorldPosition();
+		simulationHalfLength = ST<GameSettings>::Get()->m_collisionSimulationSize * 0.5f;
+
+		// Only colliders that moved need to be updated within the broadphase, and overlapping pairs are cached between updates
+		ST<Broadphase>::Get()->Sync();
+		isProxySimulated.assign(ST<Broadphase>::Get()->GetTree().GetCapacity(), false);
 
-		// QuadTree will be populated at Run().
+		// Colliders within the simulation area will be marked at Run().
 		// Finally collisions are checked at PostRun().
 
 		return true;
@@ -840,14 +755,38 @@ namespace Physics {
 
 	void CollisionSystem::PostRun()
 	{
-		// Prune the tree to keep it as small as required
-		quadTree.Prune();
-		// Query quadtree to check every possible collision
-		quadTree.CheckCollisionPairs(*this);
-		quadTree.Clear();
+		contactCache.BeginUpdate();
+
+		// Fast bodies are moved back to where they would have hit anything they passed through, before pairs are checked at their final positions
+		SweepContinuousBodies();
+
+		// Gather the pairs first so that AABB pairs can be tested together
+		candidatePairs.clear();
+		aabbBatch.Clear();
+		ST<Broadphase>::Get()->ForEachPair([this](ColliderComp& comp1, ColliderComp& comp2) -> void {
+			if (!isProxySimulated[comp1.GetBroadphaseProxy()] || !isProxySimulated[comp2.GetBroadphaseProxy()])
+				return;
+
+			uint32_t batchIndex{ AABBPairBatch::NO_INDEX };
+			if (comp1.GetColliderType() == COLLIDER_TYPE::TYPE_AABB && comp2.GetColliderType() == COLLIDER_TYPE::TYPE_AABB)
+			{
+				BoxWrapper box1{ comp1.CreateBoxWrapper() }, box2{ comp2.CreateBoxWrapper() };
+				batchIndex = aabbBatch.Add(box1.GetCenter(), box1.GetHalfLengths(), box2.GetCenter(), box2.GetHalfLengths());
+			}
+			candidatePairs.push_back(CandidatePair{ &comp1, &comp2, batchIndex });
+		});
+		aabbBatch.Test();
+
+		// Pairs are resolved in the same order as they were found, so resolution behaves as it did before batching
+		for (const CandidatePair& pair : candidatePairs)
+			CheckCollision(*pair.comp1, *pair.comp2, pair.batchIndex);
+
+		SolveContacts();
+		SendCollisionEvents();
+		EndContacts();
 	}
 
-	void CollisionSystem::CheckCollision(ColliderComp& comp1, ColliderComp& comp2)
+	void CollisionSystem::CheckCollision(ColliderComp& comp1, ColliderComp& comp2, uint32_t batchIndex)
 	{
 		// Only check for collisions if either components have physics comp
 		ecs::CompHandle<PhysicsComp> physComp1{ ecs::GetEntity(&comp1)->GetComp<PhysicsComp>() };
@@ -855,8 +794,34 @@ namespace Physics {
 		if (!(physComp1 || physComp2))
 			return;
 
-		if (comp1.CheckCollision(comp2, &collisionData))
+		// Bodies at rest can't push each other, so there's nothing to check unless a trigger wants to know about the overlap.
+		// Sleeping bodies are kept asleep as long as they're still in contact with something. Only pairs that were touching
+		// when last tested count, since an overlap of the broadphase's fattened bounds doesn't mean the bodies touch.
+		bool isAtRest1{ IsPhysCompAtRest(physComp1) }, isAtRest2{ IsPhysCompAtRest(physComp2) };
+		if (isAtRest1 && isAtRest2 && !comp1.IsTrigger() && !comp2.IsTrigger())
+		{
+			// They're still touching if they were, even though they weren't tested
+			if (contactCache.Keep(ecs::GetEntity(&comp1)->GetHash(), ecs::GetEntity(&comp2)->GetHash()))
+			{
+				if (physComp1)
+					physComp1->NotifyRestingContact();
+				if (physComp2)
+					physComp2->NotifyRestingContact();
+			}
+			return;
+		}
+
+		bool isColliding{ batchIndex == AABBPairBatch::NO_INDEX ?
+			comp1.CheckCollision(comp2, &collisionData) :
+			comp1.CheckCollision(comp2, aabbBatch, batchIndex, &collisionData) };
+		if (isColliding)
 		{
+			// Sleeping bodies are woken by contact with anything that could push them
+			if (physComp1 && !isAtRest2)
+				physComp1->Wake();
+			if (physComp2 && !isAtRest1)
+				physComp2->Wake();
+
 			if (comp1.IsReferenceCollider(collisionData))
 				ResolveCollision(comp1, physComp1, comp2, physComp2, &collisionData);
 			else
@@ -864,63 +829,252 @@ namespace Physics {
 		}
 	}
 
-	const QuadTree& CollisionSystem::GetQuadTree() const
+	const Vector2& CollisionSystem::GetSimulationCenter() const
 	{
-		return quadTree;
+		return simulationCenter;
 	}
 
-	void CollisionSystem::AddCompToQuadTree(ColliderComp& comp)
+	void CollisionSystem::AddCompToSimulation(ColliderComp& comp)
 	{
-		comp.UpdateColliderDimensions();
-		quadTree.Insert(&comp);
+		// Dimensions were updated when the broadphase was synced
+		BoxWrapper box{ comp.CreateBoxWrapper() };
+		if (comp.GetBroadphaseProxy() < isProxySimulated.size() && CheckIsOverlapping(simulationCenter, simulationHalfLength, box.GetCenter(), box.GetHalfLengths()))
+			isProxySimulated[comp.GetBroadphaseProxy()] = true;
+	}
+
+	void CollisionSystem::SweepContinuousBodies()
+	{
+		for (auto physCompIter{ ecs::GetCompsActiveBegin<PhysicsComp>() }, endIter{ ecs::GetCompsEnd<PhysicsComp>() }; physCompIter != endIter; ++physCompIter)
+		{
+			Vector2 start{}, end{};
+			if (!physCompIter->TakeSweep(&start, &end))
+				continue;
+
+			ecs::CompHandle<ColliderComp> comp{ physCompIter.GetEntity()->GetComp<ColliderComp>() };
+			if (comp && ecs::GetCompActive(comp))
+				SweepContinuousBody(*comp, physCompIter.GetComp(), start, end);
+		}
+	}
+
+	void CollisionSystem::SweepContinuousBody(ColliderComp& comp, ecs::CompHandle<PhysicsComp> physComp, const Vector2& start, const Vector2& end)
+	{
+		// If something else moved this body since it was simulated (e.g. teleporting it), it didn't travel along this path
+		Transform& transform{ ecs::GetEntityTransform(&comp) };
+		Vector2 displacement{ end - start };
+		if (transform.GetWorldPosition() != end || displacement == Vector2{} || comp.IsTrigger() ||
+			comp.GetBroadphaseProxy() >= isProxySimulated.size() || !isProxySimulated[comp.GetBroadphaseProxy()])
+			return;
+
+		// Find the earliest impact among colliders whose proxies overlap the area swept through
+		Vector2 halfLengths{ comp.CreateBoxWrapper().GetHalfLengths() };
+		Vector2 sweptMin{ Vector2{ std::min(start.x, end.x), std::min(start.y, end.y) } - halfLengths };
+		Vector2 sweptMax{ Vector2{ std::max(start.x, end.x), std::max(start.y, end.y) } + halfLengths };
+		float earliestTime{ std::numeric_limits<float>::max() };
+		ecs::CompHandle<ColliderComp> earliestComp{ nullptr };
+		CollisionData earliestCollisionData{};
+		ST<Broadphase>::Get()->Query(sweptMin, sweptMax, Broadphase::GetCollisionLayerBits(comp.GetLayer()), [this, &comp, &start, &displacement, &earliestTime, &earliestComp, &earliestCollisionData](ColliderComp& otherComp) -> bool {
+			if (&otherComp == &comp || otherComp.IsTrigger() ||
+				otherComp.GetBroadphaseProxy() >= isProxySimulated.size() || !isProxySimulated[otherComp.GetBroadphaseProxy()])
+				return true;
+
+			// Where other swept bodies were at the time of impact isn't known, so they're left to the discrete test
+			ecs::CompHandle<PhysicsComp> otherPhysComp{ ecs::GetEntity(&otherComp)->GetComp<PhysicsComp>() };
+			if (otherPhysComp && otherPhysComp->IsContinuous())
+				return true;
+
+			float time{};
+			if (comp.CheckSweep(otherComp, start, displacement, &time, &collisionData) && time < earliestTime)
+			{
+				earliestTime = time;
+				earliestComp = &otherComp;
+				earliestCollisionData = collisionData;
+			}
+			return true;
+		});
+
+		// If the body ended up overlapping what it hit first, it didn't pass through it and the discrete test will handle it
+		if (!earliestComp || comp.CheckCollision(*earliestComp, &collisionData))
+			return;
+
+		float stopTime{ std::max(0.0f, earliestTime - SWEEP_SKIN / displacement.Length()) };
+		transform.SetWorldPosition(start + displacement * stopTime);
+		ResolveCollision(comp, physComp, *earliestComp, ecs::GetEntity(earliestComp)->GetComp<PhysicsComp>(), &earliestCollisionData);
 	}
 
 	void CollisionSystem::ResolveCollision(ColliderComp& refComp, ecs::CompHandle<PhysicsComp> refPhysComp,
 		ColliderComp& otherComp, ecs::CompHandle<PhysicsComp> otherPhysComp, CollisionData* inCollisionData)
 	{
-		// If neither component is a trigger, resolve the intersection
 		bool isTriggerCollision{ refComp.IsTrigger() || otherComp.IsTrigger() };
-		if (!isTriggerCollision)
-			ResolveIntersection(refComp, IsPhysCompDynamic(refPhysComp), otherComp, IsPhysCompDynamic(otherPhysComp), inCollisionData);
 
-		// Inform messaging system about this collision so physics can update values
-		CollisionEventData collisionEventData{ isTriggerCollision, &refComp, refPhysComp, &otherComp, otherPhysComp, inCollisionData };
-		Messaging::BroadcastAll("OnCollision", collisionEventData);
+		// Point collider collisions aren't tracked as contacts since entities aren't informed of them
+		bool isPointCollision{ refComp.GetColliderType() == COLLIDER_TYPE::TYPE_POINT || otherComp.GetColliderType() == COLLIDER_TYPE::TYPE_POINT };
+		ecs::EntityHandle refEntity{ ecs::GetEntity(&refComp) }, otherEntity{ ecs::GetEntity(&otherComp) };
+		bool isNewContact{ false };
+		Contact* contact{ isPointCollision ? nullptr : &contactCache.Touch(refEntity->GetHash(), otherEntity->GetHash(),
+			inCollisionData->collisionNormal, inCollisionData->collisionPoint, inCollisionData->penetrationDepth, isTriggerCollision, &isNewContact) };
 
-		// Skip informing entities about this collision if we have a point collider collision
-		if (refComp.GetColliderType() == COLLIDER_TYPE::TYPE_POINT || otherComp.GetColliderType() == COLLIDER_TYPE::TYPE_POINT)
-			return;
+		// If neither component is a trigger, the contact is resolved along with all others once they've all been found
+		if (!isTriggerCollision && (IsPhysCompDynamic(refPhysComp) || IsPhysCompDynamic(otherPhysComp)))
+			AddSolverContact(refComp, refPhysComp, otherComp, otherPhysComp, *inCollisionData, contact);
 
-		// Inform entities about this collision
-		ecs::GetEntity(&refComp)->GetComp<EntityEventsComponent>()->BroadcastAll("OnCollision", collisionEventData);
-		std::swap(collisionEventData.refComp, collisionEventData.otherComp);
-		std::swap(collisionEventData.refPhysComp, collisionEventData.otherPhysComp);
-		std::swap(collisionEventData.collisionData->referenceCollider, collisionEventData.collisionData->otherCollider);
-		collisionEventData.collisionData->collisionNormal = -collisionEventData.collisionData->collisionNormal;
-		ecs::GetEntity(&otherComp)->GetComp<EntityEventsComponent>()->BroadcastAll("OnCollision", collisionEventData);
+		// The messaging system and entities are informed once all contacts are solved
+		PendingCollisionEvent& pendingEvent{ pendingCollisionEvents.emplace_back(PendingCollisionEvent{
+			refEntity->GetHash(), otherEntity->GetHash(), *inCollisionData, contact, isTriggerCollision, isPointCollision, isNewContact }) };
+		pendingEvent.collisionData.referenceCollider = nullptr;
+		pendingEvent.collisionData.otherCollider = nullptr;
 	}
 
-	void CollisionSystem::ResolveIntersection(ColliderComp& refComp, bool isRefPhysCompDynamic, ColliderComp& otherComp, bool isOtherPhysCompDynamic, const CollisionData* inCollisionData)
+	void CollisionSystem::SendCollisionEvents()
 	{
-		Transform& refTransform{ ecs::GetEntityTransform(&refComp) };
-		Transform& otherTransform{ ecs::GetEntityTransform(&otherComp) };
+		for (PendingCollisionEvent& pendingEvent : pendingCollisionEvents)
+		{
+			// Entities never move, but receivers of earlier events may have moved their components, so they're fetched before each broadcast
+			ecs::EntityHandle refEntity{ ecs::GetEntity(pendingEvent.refEntity) }, otherEntity{ ecs::GetEntity(pendingEvent.otherEntity) };
+			if (!refEntity || !otherEntity)
+				continue;
+			CollisionEventData collisionEventData{};
 
-		if (isRefPhysCompDynamic && isOtherPhysCompDynamic)
+			// Inform messaging system about this collision
+			if (!GetCollisionEventData(refEntity, otherEntity, pendingEvent.isTrigger, &pendingEvent.collisionData, pendingEvent.contact, &collisionEventData))
+				continue;
+			Messaging::BroadcastAll("OnCollision", collisionEventData);
+
+			// Skip informing entities about this collision if we have a point collider collision
+			if (pendingEvent.isPointCollision)
+				continue;
+
+			// Inform entities about this collision. OnCollision is sent every update the colliders touch, OnCollisionEnter only on the first.
+			if (!GetCollisionEventData(refEntity, otherEntity, pendingEvent.isTrigger, &pendingEvent.collisionData, pendingEvent.contact, &collisionEventData))
+				continue;
+			if (pendingEvent.isNewContact)
+				refEntity->GetComp<EntityEventsComponent>()->BroadcastAll("OnCollisionEnter", collisionEventData);
+			if (!GetCollisionEventData(refEntity, otherEntity, pendingEvent.isTrigger, &pendingEvent.collisionData, pendingEvent.contact, &collisionEventData))
+				continue;
+			refEntity->GetComp<EntityEventsComponent>()->BroadcastAll("OnCollision", collisionEventData);
+
+			pendingEvent.collisionData.collisionNormal = -pendingEvent.collisionData.collisionNormal;
+			if (!GetCollisionEventData(otherEntity, refEntity, pendingEvent.isTrigger, &pendingEvent.collisionData, pendingEvent.contact, &collisionEventData))
+				continue;
+			if (pendingEvent.isNewContact)
+				otherEntity->GetComp<EntityEventsComponent>()->BroadcastAll("OnCollisionEnter", collisionEventData);
+			if (!GetCollisionEventData(otherEntity, refEntity, pendingEvent.isTrigger, &pendingEvent.collisionData, pendingEvent.contact, &collisionEventData))
+				continue;
+			otherEntity->GetComp<EntityEventsComponent>()->BroadcastAll("OnCollision", collisionEventData);
+		}
+		pendingCollisionEvents.clear();
+	}
+
+	bool CollisionSystem::GetCollisionEventData(ecs::EntityHandle refEntity, ecs::EntityHandle otherEntity, bool isTrigger,
+		CollisionData* inCollisionData, Contact* contact, CollisionEventData* outEventData)
+	{
+		ecs::CompHandle<ColliderComp> refComp{ refEntity->GetComp<ColliderComp>() }, otherComp{ otherEntity->GetComp<ColliderComp>() };
+		if (!refComp || !otherComp)
+			return false;
+
+		inCollisionData->referenceCollider = &refComp->GetActiveCollider();
+		inCollisionData->otherCollider = &otherComp->GetActiveCollider();
+		*outEventData = CollisionEventData{ isTrigger, refComp, refEntity->GetComp<PhysicsComp>(), otherComp, otherEntity->GetComp<PhysicsComp>(), inCollisionData, contact };
+		return true;
+	}
+
+	void CollisionSystem::EndContacts()
+	{
+		endedContacts.clear();
+		contactCache.EndUpdate(&endedContacts);
+
+		for (const Contact& contact : endedContacts)
 		{
-			// Push both colliders away from each other equally
-			// NOTE: If these transforms are parented to each other, this resolution may not fully push them out of each other.
-			//		 If we want to fully fix this, we'll have to check if these components have a parent child relationship, then
-			//		 calculate the correct push vector relative to their spaces...
-			Vector2 pushVec{ inCollisionData->collisionNormal * inCollisionData->penetrationDepth * 0.5f };
-			refTransform.AddWorldPosition(pushVec);
-			otherTransform.AddWorldPosition(-pushVec);
+			// Either entity may have been deleted or lost its collider since the contact was last touched
+			ecs::EntityHandle entities[2]{ ecs::GetEntity(contact.entityA), ecs::GetEntity(contact.entityB) };
+			ecs::CompHandle<ColliderComp> comps[2]{};
+			ecs::CompHandle<PhysicsComp> physComps[2]{};
+			for (int i{}; i < 2; ++i)
+				if (entities[i])
+				{
+					comps[i] = entities[i]->GetComp<ColliderComp>();
+					physComps[i] = entities[i]->GetComp<PhysicsComp>();
+				}
+
+			// Colliders aren't kept by contacts, so only the last point and normal of the contact are known
+			for (int i{}; i < 2; ++i)
+			{
+				if (!comps[i])
+					continue;
+
+				CollisionData exitCollisionData{ nullptr, nullptr, contact.penetrationDepth, contact.GetNormal(entities[i]->GetHash()) };
+				exitCollisionData.collisionPoint = contact.point;
+				CollisionEventData collisionEventData{ contact.isTrigger, comps[i], physComps[i], comps[1 - i], physComps[1 - i], &exitCollisionData, nullptr };
+				if (ecs::CompHandle<EntityEventsComponent> eventsComp{ entities[i]->GetComp<EntityEventsComponent>() })
+					eventsComp->BroadcastAll("OnCollisionExit", collisionEventData);
+			}
+		}
+	}
+
+	void CollisionSystem::AddSolverContact(ColliderComp& refComp, ecs::CompHandle<PhysicsComp> refPhysComp,
+		ColliderComp& otherComp, ecs::CompHandle<PhysicsComp> otherPhysComp, const CollisionData& inCollisionData, Contact* contact)
+	{
+		auto compIter{ ecs::GetCompsBegin<PointTestComp>() };
+		if (compIter != ecs::GetCompsEnd<PointTestComp>())
+			ecs::GetEntity(compIter.GetComp())->GetTransform().SetWorldPosition(inCollisionData.collisionPoint);
+
+		// Colliders without a PhysicsComp collide with default physics parameters
+		const PhysicsCompParams defaultParams{};
+		float refRestitution{ refPhysComp ? refPhysComp->GetRestitutionCoeff() : defaultParams.restitutionCoeff };
+		float otherRestitution{ otherPhysComp ? otherPhysComp->GetRestitutionCoeff() : defaultParams.restitutionCoeff };
+		float refFriction{ refPhysComp ? refPhysComp->GetFrictionCoeff() : defaultParams.frictionCoeff };
+		float otherFriction{ otherPhysComp ? otherPhysComp->GetFrictionCoeff() : defaultParams.frictionCoeff };
+
+		uint32_t refBody{ GetSolverBody(refComp, refPhysComp) };
+		uint32_t otherBody{ GetSolverBody(otherComp, otherPhysComp) };
+		contactSolver.AddContact(refBody, otherBody, inCollisionData.collisionNormal, inCollisionData.penetrationDepth,
+			(refRestitution + otherRestitution) * 0.5f, std::min(refFriction, otherFriction), contact);
+	}
+
+	uint32_t CollisionSystem::GetSolverBody(ColliderComp& comp, ecs::CompHandle<PhysicsComp> physComp)
+	{
+		auto [indexIter, isNew] { solverBodyIndexes.try_emplace(physComp, 0) };
+		if (!isNew)
+			return indexIter->second;
+
+		// Static and kinematic bodies have a mass reciprocal of 0, so the solver won't change them
+		if (physComp)
+		{
+			indexIter->second = contactSolver.AddBody(physComp->GetVelocity(), physComp->GetMassReciprocal());
+			solverBodyComps.push_back(SolverBodyComps{ &comp, physComp });
 		}
 		else
-			// Push dynamic collider away from static
-			if (isRefPhysCompDynamic)
-				refTransform.AddWorldPosition(inCollisionData->collisionNormal * inCollisionData->penetrationDepth);
-			else // Other physComp is dynamic
-				otherTransform.AddWorldPosition(inCollisionData->collisionNormal * -inCollisionData->penetrationDepth);
+		{
+			indexIter->second = contactSolver.AddBody(Vector2{}, 0.0f);
+			solverBodyComps.push_back(SolverBodyComps{ nullptr, nullptr });
+		}
+		return indexIter->second;
+	}
+
+	void CollisionSystem::SolveContacts()
+	{
+		ecs::SysHandle<PhysicsSystem> physSystem{ ecs::GetSystem<PhysicsSystem>() };
+		float dt{ physSystem ? physSystem->GetDt() : GameTime::FixedDt() };
+		contactSolver.Solve(dt, ST<GameSettings>::Get()->m_physicsVelocityIterations, ST<GameSettings>::Get()->m_physicsPositionIterations);
+
+		// Results are applied in the order bodies were found, regardless of which threads solved them
+		for (uint32_t body{}; body < contactSolver.GetNumBodies(); ++body)
+		{
+			const SolverBodyComps& bodyComps{ solverBodyComps[body] };
+			if (!IsPhysCompDynamic(bodyComps.physComp))
+				continue;
+
+			// Applying a zero impulse would wake a sleeping body that nothing pushed
+			const Vector2& impulse{ contactSolver.GetImpulse(body) };
+			if (impulse != Vector2{})
+				bodyComps.physComp->ApplyImpulse(impulse, Vector2{}, bodyComps.comp->GetMomentOfInertia(), bodyComps.comp->SupportsRotation());
+			const Vector2& correction{ contactSolver.GetPositionCorrection(body) };
+			if (correction != Vector2{})
+				ecs::GetEntityTransform(bodyComps.comp).AddWorldPosition(correction);
+		}
+
+		contactSolver.Clear();
+		solverBodyComps.clear();
+		solverBodyIndexes.clear();
 	}
 
 	bool CollisionSystem::IsPhysCompDynamic(ecs::CompHandle<const PhysicsComp> physComp)
@@ -928,6 +1082,11 @@ namespace Physics {
 		return physComp && physComp->IsDynamic();
 	}
 
+	bool CollisionSystem::IsPhysCompAtRest(ecs::CompHandle<const PhysicsComp> physComp)
+	{
+		return !physComp || physComp->IsSleeping();
+	}
+
 	ColliderBorderSystem::ColliderBorderSystem()
 		: System_Internal{ &ColliderBorderSystem::RenderComp }
 	{
@@ -955,13 +1114,13 @@ namespace Physics {
 		{
 			if (ecs::SysHandle<CollisionSystem> collisionSystem{ ecs::GetSystem<CollisionSystem>() })
 			{
-				collisionSystem->GetQuadTree().ExecuteFuncPerNode([](const Vector2& center, float halfLength) -> void {
-					halfLength *= 2.0f;
-					util::DrawBoundingBox(center, { halfLength, halfLength }, { 1.0f, 1.0f, 0.5f }, 0.0f, 0.5f);
+				// Internal nodes in yellow, proxies (fattened collider bounds) in green
+				ST<Broadphase>::Get()->GetTree().ForEachNode([](const Vector2& min, const Vector2& max, bool isLeaf) -> void {
+					util::DrawBoundingBox((min + max) * 0.5f, max - min, (isLeaf ? Vector3{ 0.5f, 1.0f, 0.5f } : Vector3{ 1.0f, 1.0f, 0.5f }), 0.0f, 0.5f);
 				});
 
 				util::DrawBoundingBox(
-					collisionSystem->GetQuadTree().GetCenter(),
+					collisionSystem->GetSimulationCenter(),
 					Vector2{ ST<GameSettings>::Get()->m_physicsSimulationSize, ST<GameSettings>::Get()->m_physicsSimulationSize },
 					{ 0.5f, 1.0f, 1.0f }, 0.0f, 0.5f
 				);
@@ -999,15 +1158,17 @@ namespace Physics {
 	{
 		Ray ray{ .originPoint = origin, .direction = direction };
 
+		// The broadphase visits nearer colliders first, and skips those beyond the closest hit so far
 		bool collided{ false };
-		for (auto iter{ ecs::GetCompsActiveBegin<ColliderComp>() }, end{ ecs::GetCompsEnd<ColliderComp>() }; iter != end; ++iter)
-		{
-			if (!iter->GetMask().TestMaskRaw(mask))
-				continue;
+		ST<Broadphase>::Get()->RayCast(origin, direction, outRaycastResult->distance, mask, [&](ColliderComp& comp, float currentMaxDistance) -> float {
+			// The collider's layer may have changed since the broadphase was synced
+			if (!comp.GetMask().TestMaskRaw(mask))
+				return currentMaxDistance;
 
-			if (iter->CheckRaycast(ray, outRaycastResult))
+			if (comp.CheckRaycast(ray, outRaycastResult))
 				collided = true;
-		}
+			return outRaycastResult->distance;
+		});
 
 		return collided;
 	}
@@ -1023,23 +1184,111 @@ namespace Physics {
 		Ray ray{ .originPoint = origin, .direction = direction };
 		RaycastResult raycastResult{};
 
-		for (auto iter{ ecs::GetCompsActiveBegin<ColliderComp>() }, end{ ecs::GetCompsEnd<ColliderComp>() }; iter != end; ++iter)
-		{
-			if (!iter->GetMask().TestMaskRaw(mask))
-				continue;
+		ST<Broadphase>::Get()->RayCast(origin, direction, maxDistance, mask, [&](ColliderComp& comp, float) -> float {
+			if (!comp.GetMask().TestMaskRaw(mask))
+				return maxDistance;
 
-			if (iter->CheckRaycast(ray, &raycastResult))
+			if (comp.CheckRaycast(ray, &raycastResult))
 			{
 				if (raycastResult.distance <= maxDistance)
 					outRaycastResult->hits.push_back(raycastResult);
 				// This is the only variable required to be reset.
 				raycastResult.distance = std::numeric_limits<float>::max();
 			}
-		}
+			return maxDistance;
+		});
 
 		return !outRaycastResult->hits.empty();
 	}
 
 #pragma endregion // Raycast
 
+#pragma region Overlap Queries
+
+	uint32_t OverlapBox(const Vector2& center, const Vector2& halfLengths, const EntityLayersMask& mask, std::span<ecs::CompHandle<ColliderComp>> outComps)
+	{
+		if (outComps.empty())
+			return 0;
+
+		uint32_t numFound{};
+		ST<Broadphase>::Get()->Query(center - halfLengths, center + halfLengths, Broadphase::GetLayerBits(mask), [&](ColliderComp& comp) -> bool {
+			// The collider's layer may have changed since the broadphase was synced
+			if (!comp.GetMask().TestMaskRaw(mask))
+				return true;
+
+			// The broadphase's boxes are enlarged, so test against the collider's actual AABB
+			BoxWrapper box{ comp.CreateBoxWrapper() };
+			if (std::fabs(box.GetCenter().x - center.x) > halfLengths.x + box.GetHalfLengths().x ||
+				std::fabs(box.GetCenter().y - center.y) > halfLengths.y + box.GetHalfLengths().y)
+				return true;
+
+			outComps[numFound++] = &comp;
+			return numFound < outComps.size();
+		});
+		return numFound;
+	}
+
+	uint32_t OverlapCircle(const Vector2& center, float radius, const EntityLayersMask& mask, std::span<ecs::CompHandle<ColliderComp>> outComps)
+	{
+		if (outComps.empty())
+			return 0;
+
+		uint32_t numFound{};
+		Vector2 extent{ radius, radius };
+		ST<Broadphase>::Get()->Query(center - extent, center + extent, Broadphase::GetLayerBits(mask), [&](ColliderComp& comp) -> bool {
+			if (!comp.GetMask().TestMaskRaw(mask))
+				return true;
+
+			BoxWrapper box{ comp.CreateBoxWrapper() };
+			if (GetDistanceSquaredToAABB(center, box.GetCenter(), box.GetHalfLengths()) > radius * radius)
+				return true;
+
+			outComps[numFound++] = &comp;
+			return numFound < outComps.size();
+		});
+		return numFound;
+	}
+
+	uint32_t QueryNearest(const Vector2& point, float maxDistance, const EntityLayersMask& mask, std::span<NearestResult> outResults)
+	{
+		if (outResults.empty())
+			return 0;
+
+		// Distances are compared squared until the results are final
+		uint32_t numFound{};
+		float maxDistanceSquared{ maxDistance * maxDistance };
+		Vector2 extent{ maxDistance, maxDistance };
+		ST<Broadphase>::Get()->Query(point - extent, point + extent, Broadphase::GetLayerBits(mask), [&](ColliderComp& comp) -> bool {
+			if (!comp.GetMask().TestMaskRaw(mask))
+				return true;
+
+			BoxWrapper box{ comp.CreateBoxWrapper() };
+			float distanceSquared{ GetDistanceSquaredToAABB(point, box.GetCenter(), box.GetHalfLengths()) };
+			if (distanceSquared > maxDistanceSquared)
+				return true;
+
+			if (numFound < outResults.size())
+				++numFound;
+			else if (distanceSquared >= outResults[numFound - 1].distance)
+				return true;
+
+			// Insert in order, dropping the furthest result if the buffer is full
+			uint32_t index{ numFound - 1 };
+			for (; index > 0 && outResults[index - 1].distance > distanceSquared; --index)
+				outResults[index] = outResults[index - 1];
+			outResults[index] = NearestResult{ &comp, distanceSquared };
+
+			// Once the buffer is full, colliders further than the furthest result can't be among the nearest
+			if (numFound == outResults.size())
+				maxDistanceSquared = outResults[numFound - 1].distance;
+			return true;
+		});
+
+		for (uint32_t index{}; index < numFound; ++index)
+			outResults[index].distance = std::sqrt(outResults[index].distance);
+		return numFound;
+	}
+
+#pragma endregion // Overlap Queries
+
 }
@@ -12,7 +12,7 @@
 \par    DigiPen login: kendrickheanguan.s
 
 \brief
-  This is the interface file for the Collision system, QuadTree, collision component,
+  This is the interface file for the Collision system, collision component,
   and various collider definitions such as AABB, that implement a structure that can detect
   and separate collisions.
 
@@ -23,6 +23,9 @@ All rights reserved.
 
 #pragma once
 #include "EntityLayers.h"
+#include "Narrowphase.h"
+#include "ContactCache.h"
+#include "ContactSolver.h"
 
 namespace Physics {
 
@@ -43,12 +46,12 @@ namespace Physics {
 	class PhysicsComp;
 	class PhysicsSystem;
 
-#pragma region Quadtree
+#pragma region Broadphase
 
 	/*****************************************************************//*!
 	\class BoxWrapper
 	\brief
-		Represents a collider as a AABB for purposes of Quadtree.
+		Represents a collider as a AABB for purposes of the broadphase.
 	*//******************************************************************/
 	class BoxWrapper
 	{
@@ -100,264 +103,22 @@ namespace Physics {
 	};
 
 	/*****************************************************************//*!
-	\class Node
 	\brief
-		A node within a quadtree representing some square area.
-	*//******************************************************************/
-	class Node
-	{
-	public:
-		/*****************************************************************//*!
-		\brief
-			Default constructor.
-		*//******************************************************************/
-		Node();
-
-		/*****************************************************************//*!
-		\brief
-			Destructor.
-		*//******************************************************************/
-		~Node();
-
-		/*****************************************************************//*!
-		\brief
-			Setup this node with the provided parameters. Does not redistribute existing colliders.
-		\param newRemainingSplits
-			The available depth remaining.
-		\param newCenter
-			The center of this node.
-		\param newHalfLength
-			The half lengths of this node.
-		\param newIsRoot
-			Whether this node is the root node.
-		*//******************************************************************/
-		void Setup(int newRemainingSplits, const Vector2& newCenter, float newHalfLength, bool newIsRoot = false);
-
-		/*****************************************************************//*!
-		\brief
-			Attempts to insert a BoxWrapper into this node or its children.
-		\param box
-			The BoxWrapper to be inserted.
-		\return
-			True if the BoxWrapper was inserted. False otherwise.
-		*//******************************************************************/
-		bool Insert(BoxWrapper& box);
-
-		/*****************************************************************//*!
-		\brief
-			Prunes children if all children of this node have no colliders.
-		\return
-			True if this children is not a parent of any colliders and thus is safe to prune. False otherwise.
-		*//******************************************************************/
-		bool Prune();
-
-		/*****************************************************************//*!
-		\brief
-			Clears all colliders from this node, and recursively clears all colliders from children.
-		*//******************************************************************/
-		void Clear();
-
-		/*****************************************************************//*!
-		\brief
-			Calls a function within collision system for every potential collision within this node.
-		\param collisionSystem
-			The collision system.
-		*//******************************************************************/
-		void CheckCollisionPairs(CollisionSystem& collisionSystem) const;
-
-		/*****************************************************************//*!
-		\brief
-			Executes a function for each node given its position and scale.
-		\param func
-			The function to be executed for each node.
-		*//******************************************************************/
-		void ExecuteFuncPerNode(void (*func)(const Vector2& nodeCenter, float nodeHalfLength)) const;
-
-		/*****************************************************************//*!
-		\brief
-			Gets the center position of this node.
-		\return
-			The center position of this node.
-		*//******************************************************************/
-		Vector2 GetCenter() const;
-
-	private:
-		/*****************************************************************//*!
-		\brief
-			Sets up the parameters of children based on the parameters of this node.
-		*//******************************************************************/
-		void SetupChildren();
-
-		/*****************************************************************//*!
-		\brief
-			Checks if this node can fully contain a BoxWrapper.
-		\param box
-			The BoxWrapper to be checked.
-		\return
-			True if this node fully contains the BoxWrapper. False otherwise.
-		*//******************************************************************/
-		bool FullyContains(const BoxWrapper& box) const;
-
-		/*****************************************************************//*!
-		\brief
-			Checks if this node is overlapping a BoxWrapper.
-		\param box
-			The BoxWrapper to be checked.
-		\return
-			True if this node is overlapping the BoxWrapper. False otherwise.
-		*//******************************************************************/
-		bool IsOverlapping(const BoxWrapper& box) const;
-
-		/*****************************************************************//*!
-		\brief
-			Attempts to insert a BoxWrapper into one of this node's children.
-		\param box
-			The BoxWrapper to be inserted.
-		\return
-			True if the BoxWrapper was inserted into one of this node's children. False otherwise.
-		*//******************************************************************/
-		bool TryInsertToChildren(BoxWrapper& box);
-
-		/*****************************************************************//*!
-		\brief
-			Calls a function within the collision system for every potential collision
-			between a collider and all colliders within this node
-		\param box
-			The BoxWrapper to be checked.
-		\param collisionSystem
-			The collision system.
-		\return
-			True if the BoxWrapper was inserted into one of this node's children. False otherwise.
-		*//******************************************************************/
-		void CheckCollisionPairs(const BoxWrapper& box, CollisionSystem& collisionSystem) const;
-
-		//! The number of available splits remaining at this node depth.
-		int remainingSplits;
-		//! Whether this node is the root node
-		bool isRoot;
-
-		//! Position of the center of this node.
-		Vector2 center;
-		//! The half length of one side of this node.
-		float halfLength;
-
-		// Child nodes of this node. This is an array of 4 Nodes.
-		Node* children;
-		// Colliders contained within this node
-		std::vector<BoxWrapper> colliders;
-
-	};
-
-	/*****************************************************************//*!
-	\class QuadTree
-	\brief
-		A quadtree using fixed size square nodes.
+		Checks if an object is overlapping a square area.
+	\param squareCenter
+		The center of the square.
+	\param squareHalfLength
+		The half length of one side of the square.
+	\param objCenter
+		The object's center position.
+	\param objHalfLength
+		The object's half lengths.
+	\return
+		True if the object is overlapping the square. False otherwise.
 	*//******************************************************************/
-	class QuadTree
-	{
-	public:
-		/*****************************************************************//*!
-		\brief
-			Sets the parameters of this quadtree. Does not redistribute colliders that are already inserted.
-		\param center
-			The center of this quadtree.
-		\param length
-			The length of one side of this quadtree.
-		*//******************************************************************/
-		void Set(const Vector2& center, float length);
+	bool CheckIsOverlapping(const Vector2& squareCenter, float squareHalfLength, const Vector2& objCenter, const Vector2& objHalfLength);
 
-		/*****************************************************************//*!
-		\brief
-			Inserts a collider into the quadtree
-		\param comp
-			The collider component to insert into this quadtree.
-		\param length
-			The length of one side of this quadtree.
-		*//******************************************************************/
-		void Insert(ecs::CompHandle<ColliderComp> comp);
-
-		/*****************************************************************//*!
-		\brief
-			Prunes nodes with no colliders.
-		*//******************************************************************/
-		void Prune();
-
-		/*****************************************************************//*!
-		\brief
-			Empties this quadtree.
-		*//******************************************************************/
-		void Clear();
-
-		/*****************************************************************//*!
-		\brief
-			Calls a function within collision system for every potential collision
-			within this quadtree
-		\param collisionSystem
-			The collision system.
-		*//******************************************************************/
-		void CheckCollisionPairs(CollisionSystem& collisionSystem) const;
-
-		/*****************************************************************//*!
-		\brief
-			Checks if an object is contained within a node with the specified parameters.
-		\param nodeCenter
-			The center of the node.
-		\param nodeHalfLength
-			The half length of the node.
-		\param objCenter
-			The object's center position.
-		\param objHalfLength
-			The object's half lengths.
-		\return
-			True if the object is contained within the node. False otherwise.
-		*//******************************************************************/
-		static bool CheckIsContained(const Vector2& nodeCenter, float nodeHalfLength, const Vector2& objCenter, const Vector2& objHalfLength);
-
-		/*****************************************************************//*!
-		\brief
-			Checks if an object is overlapping a node with the specified parameters.
-		\param nodeCenter
-			The center of the node.
-		\param nodeHalfLength
-			The half length of the node.
-		\param objCenter
-			The object's center position.
-		\param objHalfLength
-			The object's half lengths.
-		\return
-			True if the object is overlapping the node. False otherwise.
-		*//******************************************************************/
-		static bool CheckIsOverlapping(const Vector2& nodeCenter, float nodeHalfLength, const Vector2& objCenter, const Vector2& objHalfLength);
-
-		/*****************************************************************//*!
-		\brief
-			Executes a function for each node given its position and scale.
-		\param func
-			The function to be executed for each node.
-		*//******************************************************************/
-		void ExecuteFuncPerNode(void (*func)(const Vector2& nodeCenter, float nodeHalfLength)) const;
-
-		/*****************************************************************//*!
-		\brief
-			Gets the center position of the quadtree.
-		\return
-			The center of the quadtree.
-		*//******************************************************************/
-		Vector2 GetCenter() const;
-
-		//! The maximum number of colliders that can be placed in the same node.
-		static constexpr int MAX_COLLIDERS{ 8 };
-
-	private:
-		//! The maximum depth of nodes. Depth of 1 means the root node never splits.
-		static constexpr int MAX_DEPTH{ 8 };
-
-		//! Root node.
-		Node root;
-
-	};
-
-#pragma endregion // Quadtree
+#pragma endregion // Broadphase
 
 #pragma region Collision
 
@@ -476,6 +237,46 @@ X(TYPE_POINT, "Point")
 		*//******************************************************************/
 		bool TestCollision_AABB(const Vector2& thisPos, AABB& other, const Vector2& otherPos, CollisionData* outCollisionData);
 
+		/*****************************************************************//*!
+		\brief
+			Fills in the characteristics of an AABB vs AABB collision whose normal and penetration depth are already known,
+			such as from an AABBPairBatch, with this collider as the reference collider.
+		\param thisPos
+			The world position of this collider.
+		\param other
+			The other AABB collider.
+		\param otherPos
+			The world position of the other collider.
+		\param collisionNormal
+			The normal of the collision, relative to this collider.
+		\param penetrationDepth
+			The penetration depth of the collision.
+		\param outCollisionData
+			The characteristics of the collision will be written here.
+		*//******************************************************************/
+		void CalculateCollision_AABB(const Vector2& thisPos, AABB& other, const Vector2& otherPos, const Vector2& collisionNormal, float penetrationDepth, CollisionData* outCollisionData);
+
+		/*****************************************************************//*!
+		\brief
+			Finds when this AABB, moving in a straight line, first touches another AABB that isn't moving.
+			AABBs that already overlap at the start are not considered to be hit, since the motion didn't cause it.
+		\param startPos
+			The world position of this collider before moving.
+		\param displacement
+			How far this collider moves.
+		\param other
+			The other AABB collider.
+		\param otherPos
+			The world position of the other collider.
+		\param outTimeOfImpact
+			If the colliders touch, the fraction of the displacement at which they first touch is written here.
+		\param outCollisionNormal
+			If the colliders touch, the normal of the face of the other collider that was hit is written here, relative to this collider.
+		\return
+			True if the colliders touch during the motion. False otherwise.
+		*//******************************************************************/
+		bool TestSweep_AABB(const Vector2& startPos, const Vector2& displacement, const AABB& other, const Vector2& otherPos, float* outTimeOfImpact, Vector2* outCollisionNormal) const;
+
 		/*****************************************************************//*!
 		\brief
 			Tests AABB vs Point collisions.
@@ -620,6 +421,8 @@ X(TYPE_POINT, "Point")
 		ecs::CompHandle<PhysicsComp> otherPhysComp;
 		//! The collision parameters.
 		CollisionData* collisionData;
+		//! The persistent contact between the entities, which holds the impulses used to resolve it. nullptr for point collider collisions.
+		Contact* contact;
 	};
 
 	/*****************************************************************//*!
@@ -645,7 +448,7 @@ X(IS_TRIGGER, "Is Trigger")
 	\brief
 		The collision component that contains the collider structure and interfaces for checking collisions with other collision components.
 	*//******************************************************************/
-	class ColliderComp : public IRegisteredComponent<ColliderComp>
+	class ColliderComp : public IRegisteredComponent<ColliderComp>, public ecs::IComponentCallbacks
 #ifdef IMGUI_ENABLED
 		, IEditorComponent<ColliderComp>
 #endif
@@ -700,6 +503,43 @@ X(IS_TRIGGER, "Is Trigger")
 		*//******************************************************************/
 		bool CheckCollision(ColliderComp& otherCollider, CollisionData* outCollisionData);
 
+		/*****************************************************************//*!
+		\brief
+			Checks if a collision is occuring with another ColliderComp, using the result of a batch that
+			tested both AABB colliders together with other pairs. If either collider has moved since the pair
+			was added to the batch, the colliders are tested individually instead.
+		\param otherCollider
+			The other ColliderComp to test collision with.
+		\param batch
+			The tested batch.
+		\param batchIndex
+			The index of the pair within the batch, with this collider as the reference AABB.
+		\param outCollisionData
+			If a collision has occured, the characteristics of the collision will be written here.
+		\return
+			True if a collision occured. False otherwise.
+		*//******************************************************************/
+		bool CheckCollision(ColliderComp& otherCollider, const AABBPairBatch& batch, uint32_t batchIndex, CollisionData* outCollisionData);
+
+		/*****************************************************************//*!
+		\brief
+			Checks if this collider hits another ColliderComp while moving in a straight line, treating the other collider as stationary.
+			Only AABB colliders can be swept.
+		\param otherCollider
+			The other ColliderComp to test collision with.
+		\param startPos
+			The world position of this collider before moving.
+		\param displacement
+			How far this collider moves.
+		\param outTimeOfImpact
+			If a collision has occured, the fraction of the displacement at which the colliders first touch is written here.
+		\param outCollisionData
+			If a collision has occured, the characteristics of the collision at the time of impact will be written here.
+		\return
+			True if a collision occured. False otherwise.
+		*//******************************************************************/
+		bool CheckSweep(ColliderComp& otherCollider, const Vector2& startPos, const Vector2& displacement, float* outTimeOfImpact, CollisionData* outCollisionData);
+
 		/*****************************************************************//*!
 		\brief
 			Checks if a ray intersects this collider.
@@ -770,13 +610,38 @@ X(IS_TRIGGER, "Is Trigger")
 
 		/*****************************************************************//*!
 		\brief
-			Queries the EntityLayerComponent to get its layer mask.
-			IDEALLY THIS SHOULD NOT BE CALLED OFTEN SINCE THIS REQUIRES MULTIPLE STEPS TO QUERY.
+			Gets the layer of this collider's entity, as cached from the EntityLayerComponent.
+		\return
+			The entity's layer.
+		*//******************************************************************/
+		ENTITY_LAYER GetLayer() const;
+
+		/*****************************************************************//*!
+		\brief
+			Updates the cached layer of this collider's entity. Called by EntityLayerComponent when its layer changes.
+		\param newLayer
+			The entity's new layer.
+		*//******************************************************************/
+		void SetCachedLayer(ENTITY_LAYER newLayer);
+
+		/*****************************************************************//*!
+		\brief
+			Gets the layer of this collider's entity as a mask.
 		\return
 			The entity's layer as a mask.
 		*//******************************************************************/
 		EntityLayersMask GetMask() const;
 
+		/*****************************************************************//*!
+		\brief
+			Checks whether the layers matrix allows this collider's layer to collide with another collider's layer.
+		\param otherCollider
+			The other ColliderComp.
+		\return
+			True if the layers collide. False otherwise.
+		*//******************************************************************/
+		bool TestLayerCollision(const ColliderComp& otherCollider) const;
+
 		/*****************************************************************//*!
 		\brief
 			Gets the type of collider.
@@ -793,6 +658,20 @@ X(IS_TRIGGER, "Is Trigger")
 		*//******************************************************************/
 		void SetColliderType(COLLIDER_TYPE newType);
 
+		/*****************************************************************//*!
+		\brief
+			Gets the id of this collider's proxy within the broadphase.
+		\return
+			The id of the proxy, as of the last broadphase sync.
+		*//******************************************************************/
+		uint32_t GetBroadphaseProxy() const;
+
+		/*****************************************************************//*!
+		\brief
+			Caches the layer of the entity's EntityLayerComponent.
+		*//******************************************************************/
+		void OnAttached() override;
+
 	private:
 		/*****************************************************************//*!
 		\brief
@@ -819,6 +698,15 @@ X(IS_TRIGGER, "Is Trigger")
 		ColliderData collider;
 		//! The scale of the collider. This is multiplied by the entity's scale to obtain the collider's actual dimensions.
 		Vector2 scale;
+		//! The id of this collider's proxy within the broadphase. Not serialized.
+		uint32_t broadphaseProxy;
+		//! The layer of the entity, cached so that it doesn't need to be fetched from the EntityLayerComponent. Not serialized.
+		ENTITY_LAYER layer;
+
+		// The broadphase manages the proxy id
+		friend class Broadphase;
+		// The collision system points collision data at the colliders when sending collision events
+		friend class CollisionSystem;
 
 	private:
 #ifdef IMGUI_ENABLED
@@ -850,7 +738,7 @@ X(IS_TRIGGER, "Is Trigger")
 
 		/*****************************************************************//*!
 		\brief
-			Updates the dimensions of all colliders and populates the QuadTree.
+			Syncs the broadphase with the current state of all colliders, and sets up the simulation area.
 		\return
 			True. The system will process components every time.
 		*//******************************************************************/
@@ -858,8 +746,9 @@ X(IS_TRIGGER, "Is Trigger")
 
 		/*****************************************************************//*!
 		\brief
-			Checks for and resolves collisions within the QuadTree, then clears
-			the QuadTree for the next update.
+			Checks for and resolves collisions between the pairs of colliders found by the broadphase
+			that are both within the simulation area. Pairs of AABB colliders are tested together in a batch
+			before any collisions are checked, and all contacts found are resolved together by the contact solver.
 		*//******************************************************************/
 		void PostRun() override;
 
@@ -870,29 +759,58 @@ X(IS_TRIGGER, "Is Trigger")
 			A ColliderComp.
 		\param comp2
 			Another ColliderComp.
+		\param batchIndex
+			The index of the pair within aabbBatch, or AABBPairBatch::NO_INDEX if the pair was not batched.
 		*//******************************************************************/
-		void CheckCollision(ColliderComp& comp1, ColliderComp& comp2);
+		void CheckCollision(ColliderComp& comp1, ColliderComp& comp2, uint32_t batchIndex = AABBPairBatch::NO_INDEX);
 
 		/*****************************************************************//*!
 		\brief
-			Gets the quadtree.
+			Gets the center of the area that collisions are simulated within.
 		\return
-			The quadtree.
+			The center of the simulation area.
 		*//******************************************************************/
-		const QuadTree& GetQuadTree() const;
+		const Vector2& GetSimulationCenter() const;
 
 	private:
 		/*****************************************************************//*!
 		\brief
-			Adds a component into the QuadTree.
+			Marks a component to be checked for collisions this update if it is within the simulation area.
 		\param comp
-			The component to be added into the QuadTree.
+			The component.
+		*//******************************************************************/
+		void AddCompToSimulation(ColliderComp& comp);
+
+		/*****************************************************************//*!
+		\brief
+			Sweeps the colliders of all continuous PhysicsComps along the paths they moved this update.
 		*//******************************************************************/
-		void AddCompToQuadTree(ColliderComp& comp);
+		void SweepContinuousBodies();
 
 		/*****************************************************************//*!
 		\brief
-			Resolves a detected collision by separating colliders and informing PhysicsSystem of the collision.
+			Sweeps a collider along the path it moved this update. If it passed through another collider without
+			ending up overlapping it, it is moved back to just before the earliest impact and the collision is resolved.
+		\param comp
+			The collider.
+		\param physComp
+			The physics component of the collider's entity.
+		\param start
+			The world position of the collider before moving.
+		\param end
+			The world position of the collider after moving.
+		*//******************************************************************/
+		void SweepContinuousBody(ColliderComp& comp, ecs::CompHandle<PhysicsComp> physComp, const Vector2& start, const Vector2& end);
+
+		/*****************************************************************//*!
+		\brief
+			Removes contacts that weren't touched this update, and informs both entities of each that the contact has ended.
+		*//******************************************************************/
+		void EndContacts();
+
+		/*****************************************************************//*!
+		\brief
+			Records a detected collision as a contact to be resolved by the contact solver, and queues informing entities of the collision.
 		\param refComp
 			The reference collision component that all values stored in CollisionData are relative to.
 		\param refPhysComp
@@ -909,19 +827,69 @@ X(IS_TRIGGER, "Is Trigger")
 
 		/*****************************************************************//*!
 		\brief
-			Seperates colliders.
+			Adds a contact between colliders to the contact solver.
 		\param refComp
 			The reference collision component that all values stored in CollisionData are relative to.
-		\param isRefPhysCompDynamic
-			Whether the physics component that the reference entity has is dynamic.
+		\param refPhysComp
+			The physics component that the reference entity has.
 		\param otherComp
 			The other collision component that the reference collision component is colliding with.
-		\param isOtherPhysCompDynamic
-			Whether the physics component that the other entity has is dynamic.
-		\param collisionData
+		\param otherPhysComp
+			The physics component that the other entity has.
+		\param inCollisionData
 			The characteristics of the collision.
+		\param contact
+			The persistent contact between the entities. May be nullptr.
+		*//******************************************************************/
+		void AddSolverContact(ColliderComp& refComp, ecs::CompHandle<PhysicsComp> refPhysComp,
+			ColliderComp& otherComp, ecs::CompHandle<PhysicsComp> otherPhysComp, const CollisionData& inCollisionData, Contact* contact);
+
+		/*****************************************************************//*!
+		\brief
+			Gets the contact solver's body for a collider, adding it if the collider doesn't have one yet this update.
+			All colliders without a PhysicsComp share the same body.
+		\param comp
+			The collider.
+		\param physComp
+			The physics component of the collider's entity.
+		\return
+			The index of the body within the contact solver.
+		*//******************************************************************/
+		uint32_t GetSolverBody(ColliderComp& comp, ecs::CompHandle<PhysicsComp> physComp);
+
+		/*****************************************************************//*!
+		\brief
+			Solves all contacts found this update, and applies the resulting impulses and position corrections to entities.
+		*//******************************************************************/
+		void SolveContacts();
+
+		/*****************************************************************//*!
+		\brief
+			Informs the messaging system and entities of all collisions found this update.
+			This is done after contacts are solved, since receivers may create entities and so move the components being simulated.
 		*//******************************************************************/
-		void ResolveIntersection(ColliderComp& refComp, bool isRefPhysCompDynamic, ColliderComp& otherComp, bool isOtherPhysCompDynamic, const CollisionData* inCollisionData);
+		void SendCollisionEvents();
+
+		/*****************************************************************//*!
+		\brief
+			Fetches the components of the entities in a collision, and points the collision's data at their colliders.
+		\param refEntity
+			The reference entity of the collision.
+		\param otherEntity
+			The entity that the reference entity is colliding with.
+		\param isTrigger
+			Whether a trigger collider is involved.
+		\param inCollisionData
+			The characteristics of the collision, relative to refEntity.
+		\param contact
+			The persistent contact between the entities. May be nullptr.
+		\param outEventData
+			The event data to fill.
+		\return
+			True if both entities still have a ColliderComp. False otherwise.
+		*//******************************************************************/
+		static bool GetCollisionEventData(ecs::EntityHandle refEntity, ecs::EntityHandle otherEntity, bool isTrigger,
+			CollisionData* inCollisionData, Contact* contact, CollisionEventData* outEventData);
 
 		/*****************************************************************//*!
 		\brief
@@ -933,14 +901,97 @@ X(IS_TRIGGER, "Is Trigger")
 		*//******************************************************************/
 		static bool IsPhysCompDynamic(ecs::CompHandle<const PhysicsComp> physComp);
 
+		/*****************************************************************//*!
+		\brief
+			Gets if a given physics component is at rest, meaning it is static or sleeping and so cannot push anything.
+		\param physComp
+			The physics component to check.
+		\return
+			True if physComp is nullptr or sleeping. False otherwise.
+		*//******************************************************************/
+		static bool IsPhysCompAtRest(ecs::CompHandle<const PhysicsComp> physComp);
+
 	private:
-		//! Colliders will be populated into this QuadTree for broad phase collision checking.
-		QuadTree quadTree;
+		//! The center of the area that collisions are simulated within.
+		Vector2 simulationCenter;
+		//! The half length of the area that collisions are simulated within.
+		float simulationHalfLength;
+		//! Whether each broadphase proxy's collider is checked for collisions this update, by proxy id.
+		std::vector<bool> isProxySimulated;
+
+		/*****************************************************************//*!
+		\struct CandidatePair
+		\brief
+			A pair of colliders within the simulation area to be checked for collision.
+		*//******************************************************************/
+		struct CandidatePair
+		{
+			//! A ColliderComp.
+			ecs::CompHandle<ColliderComp> comp1;
+			//! Another ColliderComp.
+			ecs::CompHandle<ColliderComp> comp2;
+			//! The index of the pair within aabbBatch, or AABBPairBatch::NO_INDEX if the pair was not batched.
+			uint32_t batchIndex;
+		};
+		//! The pairs to be checked this update. Reused between updates.
+		std::vector<CandidatePair> candidatePairs;
+		//! The AABB pairs to be tested together this update. Reused between updates.
+		AABBPairBatch aabbBatch;
+
+		//! The contacts between pairs of colliders, which persist between updates.
+		ContactCache contactCache;
+		//! The contacts that ended this update. Reused between updates.
+		std::vector<Contact> endedContacts;
+
+		/*****************************************************************//*!
+		\struct PendingCollisionEvent
+		\brief
+			A collision found this update that entities are yet to be informed of. Entities are kept by hash rather than
+			by component, since components may be moved before the events are sent.
+		*//******************************************************************/
+		struct PendingCollisionEvent
+		{
+			//! The hash of the reference entity.
+			ecs::EntityHash refEntity;
+			//! The hash of the entity that the reference entity is colliding with.
+			ecs::EntityHash otherEntity;
+			//! The characteristics of the collision. The colliders are pointed at when the events are sent.
+			CollisionData collisionData;
+			//! The persistent contact between the entities. nullptr for point collider collisions.
+			Contact* contact;
+			//! Whether a trigger collider is involved.
+			bool isTrigger;
+			//! Whether a point collider is involved, in which case only the messaging system is informed.
+			bool isPointCollision;
+			//! Whether the entities started touching this update.
+			bool isNewContact;
+		};
+		//! The collisions to be sent to the messaging system and entities once contacts are solved. Reused between updates.
+		std::vector<PendingCollisionEvent> pendingCollisionEvents;
+
+		/*****************************************************************//*!
+		\struct SolverBodyComps
+		\brief
+			The components that a body within the contact solver belongs to. These stay valid until contacts are solved,
+			since collision events, which could move components, are only sent afterwards.
+		*//******************************************************************/
+		struct SolverBodyComps
+		{
+			//! The ColliderComp. nullptr for the body shared by colliders without a PhysicsComp.
+			ecs::CompHandle<ColliderComp> comp;
+			//! The PhysicsComp. nullptr for the body shared by colliders without a PhysicsComp.
+			ecs::CompHandle<PhysicsComp> physComp;
+		};
+
+		//! Resolves the contacts found this update.
+		ContactSolver contactSolver;
+		//! The components of each body within the contact solver, by body index. Reused between updates.
+		std::vector<SolverBodyComps> solverBodyComps;
+		//! The index of the body within the contact solver of each PhysicsComp that has one, with nullptr for the shared body. Reused between updates.
+		std::unordered_map<ecs::ConstCompHandle<PhysicsComp>, uint32_t> solverBodyIndexes;
 
 		//! A buffer for collision data to avoid reallocating stack memory for CollisionData per collision component.
 		CollisionData collisionData;
-		//! Temporary: A handle to PhysicsSystem for informing it of collisions.
-		ecs::SysHandle<Physics::PhysicsSystem> physSystemHandle;
 	};
 
 	/*****************************************************************//*!
@@ -980,7 +1031,7 @@ X(IS_TRIGGER, "Is Trigger")
 	/*****************************************************************//*!
 	\class QuadtreeRenderSystem
 	\brief
-		A system that renders the collision quadtree to screen for debug
+		A system that renders the collision broadphase tree to screen for debug
 		purposes.
 	*//******************************************************************/
 	class QuadtreeRenderSystem : public ecs::System<QuadtreeRenderSystem>
@@ -988,7 +1039,7 @@ X(IS_TRIGGER, "Is Trigger")
 	public:
 		/*****************************************************************//*!
 		\brief
-			Renders the quadtree.
+			Renders the broadphase tree and the collision simulation area.
 		\return
 			False. The system will never process components.
 		*//******************************************************************/
@@ -1131,6 +1182,74 @@ X(IS_TRIGGER, "Is Trigger")
 
 #pragma region // Raycast
 
+#pragma region Overlap Queries
+
+	/*****************************************************************//*!
+	\struct NearestResult
+	\brief
+		Stores a collider found by a nearest query.
+	*//******************************************************************/
+	struct NearestResult
+	{
+		//! The collision component that was found.
+		ecs::CompHandle<ColliderComp> hitComp;
+		//! The distance from the query point to the collision component's AABB. 0 if the point is within the AABB.
+		float distance;
+	};
+
+	/*****************************************************************//*!
+	\brief
+		Finds colliders on certain layers whose AABB overlaps a box.
+		Uses the broadphase, which is brought up to date first if colliders may have changed, so this doesn't allocate or visit colliders far from the box.
+	\param center
+		The center of the box.
+	\param halfLengths
+		The half lengths of the box.
+	\param mask
+		The collision layers to search.
+	\param outComps
+		The colliders found are written here, in no particular order. Colliders beyond the size of this buffer are not found.
+	\return
+		The number of colliders written to outComps.
+	*//******************************************************************/
+	uint32_t OverlapBox(const Vector2& center, const Vector2& halfLengths, const EntityLayersMask& mask, std::span<ecs::CompHandle<ColliderComp>> outComps);
+
+	/*****************************************************************//*!
+	\brief
+		Finds colliders on certain layers whose AABB overlaps a circle.
+		Uses the broadphase, which is brought up to date first if colliders may have changed, so this doesn't allocate or visit colliders far from the circle.
+	\param center
+		The center of the circle.
+	\param radius
+		The radius of the circle.
+	\param mask
+		The collision layers to search.
+	\param outComps
+		The colliders found are written here, in no particular order. Colliders beyond the size of this buffer are not found.
+	\return
+		The number of colliders written to outComps.
+	*//******************************************************************/
+	uint32_t OverlapCircle(const Vector2& center, float radius, const EntityLayersMask& mask, std::span<ecs::CompHandle<ColliderComp>> outComps);
+
+	/*****************************************************************//*!
+	\brief
+		Finds the colliders on certain layers that are nearest to a point, up to as many as fit within the buffer.
+		Uses the broadphase, which is brought up to date first if colliders may have changed, so this doesn't allocate or visit colliders beyond maxDistance.
+	\param point
+		The point to search from.
+	\param maxDistance
+		The maximum distance from the point to a collider's AABB.
+	\param mask
+		The collision layers to search.
+	\param outResults
+		The nearest colliders are written here, sorted from nearest to furthest.
+	\return
+		The number of results written to outResults.
+	*//******************************************************************/
+	uint32_t QueryNearest(const Vector2& point, float maxDistance, const EntityLayersMask& mask, std::span<NearestResult> outResults);
+
+#pragma endregion // Overlap Queries
+
 }
 
 property_begin(Physics::ColliderComp)
@@ -28,6 +28,9 @@ All rights reserved.
 #include "Engine.h"
 #include "ryan-c/Renderer.h"
 #include "AudioManager.h"
+#include "Benchmarks.h"
+#include "Physics.h"
+#include "GameSettings.h"
 
 Console::Console()
 	: gui::Window{ ICON_FA_TERMINAL"Console", gui::Vec2{ 500, 400 }, gui::FLAG_WINDOW::HAS_MENU_BAR }
@@ -117,6 +120,26 @@ Console::Console()
 				CONSOLE_LOG(LEVEL_INFO) << i->first;
 			}
 		}},
+		// For measuring the performance of engine subsystems
+		{ "benchmark", [](Console& console, const std::vector<std::string>& tokens) -> void {
+			if (tokens.size() >= 2 && benchmarks::Run(tokens[1], std::vector<std::string>{ tokens.begin() + 2, tokens.end() }))
+				return;
+
+			std::string msg{ "Usage: benchmark <name> [args...]. Available benchmarks:" };
+			for (const std::string& name : benchmarks::GetNames())
+				msg += " " + name;
+			console.AddLog(msg);
+		}},
+		// For comparing the physics state between runs in deterministic mode
+		{ "physicsHash", [](Console& console, const std::vector<std::string>&) -> void {
+			ecs::SysHandle<Physics::PhysicsSystem> physSystem{ ecs::GetSystem<Physics::PhysicsSystem>() };
+			if (!physSystem || !ST<GameSettings>::Get()->m_physicsDeterministic)
+			{
+				console.AddLog("Physics is not running in deterministic mode.");
+				return;
+			}
+			CONSOLE_LOG(LEVEL_INFO) << "Physics update " << physSystem->GetFrameNumber() << " started from hash " << physSystem->GetFrameHash();
+		}},
 #endif
 	}
 {
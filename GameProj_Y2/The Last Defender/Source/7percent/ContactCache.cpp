@@ -0,0 +1,144 @@
+/******************************************************************************/
+/*!
+\file   ContactCache.cpp
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the source file implementing the cache of contacts between pairs of
+  colliders.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#include "ContactCache.h"
+
+namespace {
+	//! If a contact's normal turns by more than this (as a cosine of the angle), its impulses no longer apply and are reset.
+	constexpr float WARM_START_MIN_NORMAL_DOT{ 0.9f };
+}
+
+namespace Physics {
+
+	Vector2 Contact::GetNormal(ecs::EntityHash entity) const
+	{
+		return (entity == entityA ? normal : -normal);
+	}
+
+	ContactCache::ContactCache()
+		: updateStamp{ 0 }
+	{
+	}
+
+	void ContactCache::BeginUpdate()
+	{
+		++updateStamp;
+	}
+
+	Contact& ContactCache::Touch(ecs::EntityHash entityA, ecs::EntityHash entityB, const Vector2& normal, const Vector2& point, float penetrationDepth, bool isTrigger, bool* outIsNew)
+	{
+		Key key{ MakeKey(entityA, entityB) };
+		Vector2 orderedNormal{ key.first == entityA ? normal : -normal };
+
+		// Contacts that weren't touched in the previous update were removed at the end of it, so any existing contact continues
+		auto [iter, isNew] { contacts.try_emplace(key) };
+		Contact& contact{ iter->second };
+		if (isNew)
+		{
+			contact.entityA = key.first;
+			contact.entityB = key.second;
+			contact.normalImpulse = 0.0f;
+			contact.tangentImpulse = 0.0f;
+			contact.numTicks = 0;
+		}
+		else
+		{
+			// The same pair may be touched more than once within an update
+			if (contact.updateStamp != updateStamp)
+				++contact.numTicks;
+			if (contact.normal.Dot(orderedNormal) < WARM_START_MIN_NORMAL_DOT)
+			{
+				contact.normalImpulse = 0.0f;
+				contact.tangentImpulse = 0.0f;
+			}
+		}
+
+		contact.normal = orderedNormal;
+		contact.point = point;
+		contact.penetrationDepth = penetrationDepth;
+		contact.isTrigger = isTrigger;
+		contact.updateStamp = updateStamp;
+
+		*outIsNew = isNew;
+		return contact;
+	}
+
+	bool ContactCache::Keep(ecs::EntityHash entityA, ecs::EntityHash entityB)
+	{
+		auto iter{ contacts.find(MakeKey(entityA, entityB)) };
+		if (iter == contacts.end())
+			return false;
+		iter->second.updateStamp = updateStamp;
+		return true;
+	}
+
+	const Contact* ContactCache::Find(ecs::EntityHash entityA, ecs::EntityHash entityB) const
+	{
+		auto iter{ contacts.find(MakeKey(entityA, entityB)) };
+		return (iter == contacts.end() ? nullptr : &iter->second);
+	}
+
+	void ContactCache::EndUpdate(std::vector<Contact>* outEndedContacts)
+	{
+		size_t numPrevContacts{ outEndedContacts->size() };
+		for (auto iter{ contacts.begin() }; iter != contacts.end(); )
+		{
+			if (iter->second.updateStamp == updateStamp)
+			{
+				++iter;
+				continue;
+			}
+
+			outEndedContacts->push_back(iter->second);
+			iter = contacts.erase(iter);
+		}
+
+		// The map's order depends on its history and implementation, so order ended contacts by pair to keep events in a repeatable order
+		std::sort(outEndedContacts->begin() + numPrevContacts, outEndedContacts->end(), [](const Contact& a, const Contact& b) -> bool {
+			return std::tie(a.entityA, a.entityB) < std::tie(b.entityA, b.entityB);
+		});
+	}
+
+	void ContactCache::Clear()
+	{
+		contacts.clear();
+	}
+
+	uint32_t ContactCache::Size() const
+	{
+		return static_cast<uint32_t>(contacts.size());
+	}
+
+	size_t ContactCache::KeyHasher::operator()(const Key& key) const
+	{
+		// Same mixing as boost::hash_combine
+		size_t hash{ std::hash<ecs::EntityHash>{}(key.first) };
+		hash ^= std::hash<ecs::EntityHash>{}(key.second) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+		return hash;
+	}
+
+	ContactCache::Key ContactCache::MakeKey(ecs::EntityHash entityA, ecs::EntityHash entityB)
+	{
+		return (entityA < entityB ? Key{ entityA, entityB } : Key{ entityB, entityA });
+	}
+
+}
@@ -0,0 +1,201 @@
+/******************************************************************************/
+/*!
+\file   ContactCache.h
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the interface file for the cache of contacts between pairs of colliders,
+  which persists between collision updates so that it is known whether a contact
+  has just begun, is ongoing or has ended.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#pragma once
+
+namespace Physics {
+
+	/*****************************************************************//*!
+	\struct Contact
+	\brief
+		The manifold of a pair of colliders that are touching, as of the last collision update that they touched in.
+		Entities are ordered by hash, and the normal is relative to the first entity.
+	*//******************************************************************/
+	struct Contact
+	{
+		//! The hash of the entity with the lower hash.
+		ecs::EntityHash entityA;
+		//! The hash of the entity with the higher hash.
+		ecs::EntityHash entityB;
+		//! The normal of the contact, pointing in the direction that entity A is pushed.
+		Vector2 normal;
+		//! The point of contact.
+		Vector2 point;
+		//! The penetration depth of the contact.
+		float penetrationDepth;
+		//! The impulse applied along the normal to resolve this contact in the last update, for warm starting.
+		float normalImpulse;
+		//! The impulse applied by friction to resolve this contact in the last update, for warm starting.
+		float tangentImpulse;
+		//! The number of consecutive updates that the pair has been touching for, minus 1.
+		uint32_t numTicks;
+		//! Whether either collider is a trigger.
+		bool isTrigger;
+		//! The last update that the pair was touching in.
+		uint32_t updateStamp;
+
+		/*****************************************************************//*!
+		\brief
+			Gets the normal of the contact relative to one of the entities.
+		\param entity
+			The hash of the entity.
+		\return
+			The normal, pointing in the direction that the entity is pushed.
+		*//******************************************************************/
+		Vector2 GetNormal(ecs::EntityHash entity) const;
+	};
+
+	/*****************************************************************//*!
+	\class ContactCache
+	\brief
+		The contacts between pairs of colliders, keyed by the pair of entities. Contacts are touched as collisions
+		are found within an update, and contacts that weren't touched by the end of the update have ended.
+		Impulses are kept between updates so that a solver can warm start from the previous update's result,
+		as long as the contact's normal hasn't changed too much.
+	*//******************************************************************/
+	class ContactCache
+	{
+	public:
+		/*****************************************************************//*!
+		\brief
+			Constructor.
+		*//******************************************************************/
+		ContactCache();
+
+		/*****************************************************************//*!
+		\brief
+			Starts a new update. Contacts that aren't touched or kept before EndUpdate() is called will end.
+		*//******************************************************************/
+		void BeginUpdate();
+
+		/*****************************************************************//*!
+		\brief
+			Records that a pair of colliders is touching within this update.
+		\param entityA
+			The hash of an entity.
+		\param entityB
+			The hash of the other entity.
+		\param normal
+			The normal of the contact, pointing in the direction that the first entity is pushed.
+		\param point
+			The point of contact.
+		\param penetrationDepth
+			The penetration depth of the contact.
+		\param isTrigger
+			Whether either collider is a trigger.
+		\param outIsNew
+			Whether the pair was not touching in the previous update is written here.
+		\return
+			The contact. Valid until the contact is removed by EndUpdate() or Clear().
+		*//******************************************************************/
+		Contact& Touch(ecs::EntityHash entityA, ecs::EntityHash entityB, const Vector2& normal, const Vector2& point, float penetrationDepth, bool isTrigger, bool* outIsNew);
+
+		/*****************************************************************//*!
+		\brief
+			Keeps a pair's contact from ending within this update without updating it, for pairs that were not tested
+			because they can't have moved relative to each other (e.g. both are sleeping).
+		\param entityA
+			The hash of an entity.
+		\param entityB
+			The hash of the other entity.
+		\return
+			True if the pair had a contact to keep. False otherwise.
+		*//******************************************************************/
+		bool Keep(ecs::EntityHash entityA, ecs::EntityHash entityB);
+
+		/*****************************************************************//*!
+		\brief
+			Gets the contact between a pair of entities.
+		\param entityA
+			The hash of an entity.
+		\param entityB
+			The hash of the other entity.
+		\return
+			The contact. nullptr if the pair isn't touching.
+		*//******************************************************************/
+		const Contact* Find(ecs::EntityHash entityA, ecs::EntityHash entityB) const;
+
+		/*****************************************************************//*!
+		\brief
+			Ends this update, removing all contacts that weren't touched or kept within it.
+		\param outEndedContacts
+			The removed contacts are appended here, ordered by pair of entities.
+		*//******************************************************************/
+		void EndUpdate(std::vector<Contact>* outEndedContacts);
+
+		/*****************************************************************//*!
+		\brief
+			Removes all contacts without ending them.
+		*//******************************************************************/
+		void Clear();
+
+		/*****************************************************************//*!
+		\brief
+			Gets the number of contacts.
+		\return
+			The number of contacts.
+		*//******************************************************************/
+		uint32_t Size() const;
+
+	private:
+		//! The pair of entity hashes that a contact is keyed by, with the lower hash first.
+		using Key = std::pair<ecs::EntityHash, ecs::EntityHash>;
+
+		/*****************************************************************//*!
+		\struct KeyHasher
+		\brief
+			Hashes a pair of entity hashes.
+		*//******************************************************************/
+		struct KeyHasher
+		{
+			/*****************************************************************//*!
+			\brief
+				Hashes a pair of entity hashes.
+			\param key
+				The pair.
+			\return
+				The hash.
+			*//******************************************************************/
+			size_t operator()(const Key& key) const;
+		};
+
+		/*****************************************************************//*!
+		\brief
+			Orders a pair of entity hashes into a key.
+		\param entityA
+			The hash of an entity.
+		\param entityB
+			The hash of the other entity.
+		\return
+			The key.
+		*//******************************************************************/
+		static Key MakeKey(ecs::EntityHash entityA, ecs::EntityHash entityB);
+
+	private:
+		//! The contacts, keyed by pair of entities.
+		std::unordered_map<Key, Contact, KeyHasher> contacts;
+		//! Increments with each update, to identify contacts that weren't touched.
+		uint32_t updateStamp;
+	};
+
+}
@@ -0,0 +1,270 @@
+/******************************************************************************/
+/*!
+\file   ContactSolver.cpp
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the source file implementing the sequential impulse contact solver.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#include "ContactSolver.h"
+#include "ContactCache.h"
+#include "JobSystem.h"
+
+namespace {
+	//! Represents no island.
+	constexpr uint32_t NO_ISLAND{ std::numeric_limits<uint32_t>::max() };
+	//! Contacts approaching slower than this don't bounce, so that resting bodies settle instead of jittering. Roughly 1m/s with gravity at 980.
+	constexpr float RESTITUTION_MIN_SPEED{ 100.0f };
+	//! Friction removes a fraction of the sliding speed each update, scaled by this and the timestep, as collision resolution always has.
+	constexpr float FRICTION_SCALE{ 100.0f };
+	//! The penetration depth that is allowed to remain, so that resting contacts stay touching between updates.
+	constexpr float LINEAR_SLOP{ 0.5f };
+	//! The fraction of the remaining penetration to push bodies out by in each position iteration.
+	constexpr float POSITION_CORRECTION_FACTOR{ 0.8f };
+	//! The number of islands solved by each job.
+	constexpr uint32_t ISLANDS_PER_JOB{ 8 };
+	//! Below this many contacts, dispatching jobs costs more than solving all islands on this thread.
+	constexpr uint32_t MIN_CONTACTS_TO_PARALLELIZE{ 256 };
+}
+
+namespace Physics {
+
+	void ContactSolver::Clear()
+	{
+		bodies.clear();
+		contacts.clear();
+		islandContacts.clear();
+		islandStarts.clear();
+	}
+
+	uint32_t ContactSolver::AddBody(const Vector2& velocity, float massReciprocal)
+	{
+		uint32_t index{ static_cast<uint32_t>(bodies.size()) };
+		bodies.push_back(Body{ velocity, Vector2{}, Vector2{}, massReciprocal, index, NO_ISLAND });
+		return index;
+	}
+
+	void ContactSolver::AddContact(uint32_t bodyA, uint32_t bodyB, const Vector2& normal, float penetrationDepth, float restitution, float friction, Contact* cachedContact)
+	{
+		contacts.push_back(SolverContact{ bodyA, bodyB, normal, penetrationDepth, restitution, friction, cachedContact, NO_ISLAND });
+	}
+
+	void ContactSolver::Solve(float dt, int velocityIterations, int positionIterations)
+	{
+		BuildIslands();
+
+		auto solveIslands{ [this, dt, velocityIterations, positionIterations](uint32_t chunkIndex, uint32_t begin, uint32_t end) -> void {
+			UNREFERENCED_PARAMETER(chunkIndex);
+			for (uint32_t island{ begin }; island < end; ++island)
+				SolveIsland(island, dt, velocityIterations, positionIterations);
+		} };
+
+		// Islands don't share any bodies that the solver changes, so they can be solved at the same time
+		if (GetNumContacts() < MIN_CONTACTS_TO_PARALLELIZE)
+			solveIslands(0, 0, GetNumIslands());
+		else
+			ST<JobSystem>::Get()->ParallelFor(GetNumIslands(), ISLANDS_PER_JOB, solveIslands);
+	}
+
+	const Vector2& ContactSolver::GetImpulse(uint32_t body) const
+	{
+		return bodies[body].impulse;
+	}
+
+	const Vector2& ContactSolver::GetVelocity(uint32_t body) const
+	{
+		return bodies[body].velocity;
+	}
+
+	const Vector2& ContactSolver::GetPositionCorrection(uint32_t body) const
+	{
+		return bodies[body].positionCorrection;
+	}
+
+	uint32_t ContactSolver::GetNumBodies() const
+	{
+		return static_cast<uint32_t>(bodies.size());
+	}
+
+	uint32_t ContactSolver::GetNumContacts() const
+	{
+		return static_cast<uint32_t>(contacts.size());
+	}
+
+	uint32_t ContactSolver::GetNumIslands() const
+	{
+		return (islandStarts.empty() ? 0 : static_cast<uint32_t>(islandStarts.size() - 1));
+	}
+
+	uint32_t ContactSolver::FindRoot(uint32_t body)
+	{
+		while (bodies[body].parent != body)
+		{
+			// Halve the path as we go so that later searches are shorter
+			bodies[body].parent = bodies[bodies[body].parent].parent;
+			body = bodies[body].parent;
+		}
+		return body;
+	}
+
+	void ContactSolver::BuildIslands()
+	{
+		// Join the sets of bodies touching each other. The lower index always becomes the root so that islands don't depend on join order.
+		for (const SolverContact& contact : contacts)
+		{
+			if (bodies[contact.bodyA].massReciprocal <= 0.0f || bodies[contact.bodyB].massReciprocal <= 0.0f)
+				continue;
+
+			uint32_t rootA{ FindRoot(contact.bodyA) }, rootB{ FindRoot(contact.bodyB) };
+			if (rootA < rootB)
+				bodies[rootB].parent = rootA;
+			else if (rootB < rootA)
+				bodies[rootA].parent = rootB;
+		}
+
+		// Islands are numbered in the order that their first contact was added
+		uint32_t numIslands{};
+		for (SolverContact& contact : contacts)
+		{
+			uint32_t dynamicBody{ bodies[contact.bodyA].massReciprocal > 0.0f ? contact.bodyA : contact.bodyB };
+			if (bodies[dynamicBody].massReciprocal <= 0.0f)
+				continue; // Neither body can be changed, so there's nothing to solve
+
+			Body& root{ bodies[FindRoot(dynamicBody)] };
+			if (root.island == NO_ISLAND)
+				root.island = numIslands++;
+			contact.island = root.island;
+		}
+
+		// Order contacts by island, keeping the order they were added in within each island
+		islandStarts.assign(numIslands + 1, 0);
+		for (const SolverContact& contact : contacts)
+			if (contact.island != NO_ISLAND)
+				++islandStarts[contact.island + 1];
+		for (uint32_t island{}; island < numIslands; ++island)
+			islandStarts[island + 1] += islandStarts[island];
+
+		islandContacts.resize(islandStarts.back());
+		std::vector<uint32_t> nextIndexes{ islandStarts.begin(), islandStarts.end() - 1 };
+		for (uint32_t contactIndex{}; contactIndex < GetNumContacts(); ++contactIndex)
+			if (contacts[contactIndex].island != NO_ISLAND)
+				islandContacts[nextIndexes[contacts[contactIndex].island]++] = contactIndex;
+	}
+
+	void ContactSolver::SolveIsland(uint32_t island, float dt, int velocityIterations, int positionIterations)
+	{
+		const uint32_t* beginIter{ islandContacts.data() + islandStarts[island] };
+		const uint32_t* endIter{ islandContacts.data() + islandStarts[island + 1] };
+
+		// Prepare contacts from the velocities before any impulses are applied
+		for (const uint32_t* iter{ beginIter }; iter != endIter; ++iter)
+		{
+			SolverContact& contact{ contacts[*iter] };
+			const Body& bodyA{ bodies[contact.bodyA] };
+			const Body& bodyB{ bodies[contact.bodyB] };
+
+			Vector2 tangent{ contact.normal.Rotate90() };
+			Vector2 relativeVelocity{ bodyA.velocity - bodyB.velocity };
+			float normalVelocity{ relativeVelocity.Dot(contact.normal) };
+
+			contact.effectiveMass = 1.0f / (bodyA.massReciprocal + bodyB.massReciprocal);
+			contact.velocityBias = (normalVelocity < -RESTITUTION_MIN_SPEED ? -contact.restitution * normalVelocity : 0.0f);
+			// Friction isn't limited by the normal impulse, but removes a fraction of the sliding speed each update
+			contact.maxTangentImpulse = std::fabs(relativeVelocity.Dot(tangent)) *
+				std::min(1.0f, 0.5f * contact.friction * FRICTION_SCALE * dt) * contact.effectiveMass;
+			contact.normalImpulse = 0.0f;
+			contact.tangentImpulse = 0.0f;
+		}
+
+		// Apply the impulses each contact needed last update as a starting guess
+		for (const uint32_t* iter{ beginIter }; iter != endIter; ++iter)
+		{
+			SolverContact& contact{ contacts[*iter] };
+			if (!contact.cachedContact)
+				continue;
+
+			// Cached impulses are relative to the cached normal, which may point the other way
+			float tangentSign{ contact.cachedContact->normal.Dot(contact.normal) < 0.0f ? -1.0f : 1.0f };
+			contact.normalImpulse = std::max(contact.cachedContact->normalImpulse, 0.0f);
+			contact.tangentImpulse = std::clamp(contact.cachedContact->tangentImpulse * tangentSign, -contact.maxTangentImpulse, contact.maxTangentImpulse);
+			ApplyImpulse(contact, contact.normal * contact.normalImpulse + contact.normal.Rotate90() * contact.tangentImpulse);
+		}
+
+		// Solve velocities. Friction first, since the normal constraint matters more and so should have the last say.
+		for (int iteration{}; iteration < velocityIterations; ++iteration)
+			for (const uint32_t* iter{ beginIter }; iter != endIter; ++iter)
+			{
+				SolverContact& contact{ contacts[*iter] };
+				Vector2 tangent{ contact.normal.Rotate90() };
+
+				Vector2 relativeVelocity{ bodies[contact.bodyA].velocity - bodies[contact.bodyB].velocity };
+				float prevTangentImpulse{ contact.tangentImpulse };
+				contact.tangentImpulse = std::clamp(prevTangentImpulse - relativeVelocity.Dot(tangent) * contact.effectiveMass,
+					-contact.maxTangentImpulse, contact.maxTangentImpulse);
+				ApplyImpulse(contact, tangent * (contact.tangentImpulse - prevTangentImpulse));
+
+				relativeVelocity = bodies[contact.bodyA].velocity - bodies[contact.bodyB].velocity;
+				float prevNormalImpulse{ contact.normalImpulse };
+				contact.normalImpulse = std::max(prevNormalImpulse + (contact.velocityBias - relativeVelocity.Dot(contact.normal)) * contact.effectiveMass, 0.0f);
+				ApplyImpulse(contact, contact.normal * (contact.normalImpulse - prevNormalImpulse));
+			}
+
+		// Remember the impulses for next update
+		for (const uint32_t* iter{ beginIter }; iter != endIter; ++iter)
+		{
+			const SolverContact& contact{ contacts[*iter] };
+			if (!contact.cachedContact)
+				continue;
+			float tangentSign{ contact.cachedContact->normal.Dot(contact.normal) < 0.0f ? -1.0f : 1.0f };
+			contact.cachedContact->normalImpulse = contact.normalImpulse;
+			contact.cachedContact->tangentImpulse = contact.tangentImpulse * tangentSign;
+		}
+
+		// Push bodies out of each other, weighted by mass, leaving a little penetration so that contacts persist
+		for (int iteration{}; iteration < positionIterations; ++iteration)
+			for (const uint32_t* iter{ beginIter }; iter != endIter; ++iter)
+			{
+				const SolverContact& contact{ contacts[*iter] };
+				Body& bodyA{ bodies[contact.bodyA] };
+				Body& bodyB{ bodies[contact.bodyB] };
+
+				float separation{ (bodyA.positionCorrection - bodyB.positionCorrection).Dot(contact.normal) - contact.penetrationDepth };
+				float correction{ std::min(0.0f, POSITION_CORRECTION_FACTOR * (separation + LINEAR_SLOP)) };
+				Vector2 push{ contact.normal * (-correction * contact.effectiveMass) };
+				if (bodyA.massReciprocal > 0.0f)
+					bodyA.positionCorrection += push * bodyA.massReciprocal;
+				if (bodyB.massReciprocal > 0.0f)
+					bodyB.positionCorrection -= push * bodyB.massReciprocal;
+			}
+	}
+
+	void ContactSolver::ApplyImpulse(const SolverContact& contact, const Vector2& impulse)
+	{
+		Body& bodyA{ bodies[contact.bodyA] };
+		Body& bodyB{ bodies[contact.bodyB] };
+		if (bodyA.massReciprocal > 0.0f)
+		{
+			bodyA.velocity += impulse * bodyA.massReciprocal;
+			bodyA.impulse += impulse;
+		}
+		if (bodyB.massReciprocal > 0.0f)
+		{
+			bodyB.velocity -= impulse * bodyB.massReciprocal;
+			bodyB.impulse -= impulse;
+		}
+	}
+
+}
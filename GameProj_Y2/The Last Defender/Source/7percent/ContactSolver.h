@@ -0,0 +1,260 @@
+/******************************************************************************/
+/*!
+\file   ContactSolver.h
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the interface file for the solver that resolves all contacts found
+  within a collision update together, by splitting the bodies into islands of
+  bodies that touch each other and iteratively solving each island's contacts.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#pragma once
+
+namespace Physics {
+
+	struct Contact;
+
+	/*****************************************************************//*!
+	\class ContactSolver
+	\brief
+		Resolves contacts with sequential impulses. Bodies and contacts are added as they are found, then Solve()
+		splits dynamic bodies into islands that don't share any contacts, and solves the velocity and then the
+		position of each island's contacts over a number of iterations. Islands are solved in parallel on the JobSystem.
+
+		Bodies with a mass reciprocal of 0 (static or kinematic) are never changed by the solver, so they don't join
+		islands together. The result of each island depends only on the order that its bodies and contacts were
+		added in, so results are the same regardless of how many threads solve the islands.
+
+		Bodies only move linearly, as PhysicsComp::ApplyImpulse() doesn't rotate bodies.
+	*//******************************************************************/
+	class ContactSolver
+	{
+	public:
+		/*****************************************************************//*!
+		\brief
+			Removes all bodies and contacts.
+		*//******************************************************************/
+		void Clear();
+
+		/*****************************************************************//*!
+		\brief
+			Adds a body.
+		\param velocity
+			The velocity of the body.
+		\param massReciprocal
+			The mass reciprocal of the body. 0 if the body is static or kinematic.
+		\return
+			The index of the body.
+		*//******************************************************************/
+		uint32_t AddBody(const Vector2& velocity, float massReciprocal);
+
+		/*****************************************************************//*!
+		\brief
+			Adds a contact between 2 bodies.
+		\param bodyA
+			The index of a body.
+		\param bodyB
+			The index of the other body.
+		\param normal
+			The normal of the contact, pointing in the direction that body A is pushed.
+		\param penetrationDepth
+			The penetration depth of the contact.
+		\param restitution
+			The restitution coefficient of the contact.
+		\param friction
+			The friction coefficient of the contact.
+		\param cachedContact
+			The persistent contact to warm start from, and to store this update's impulses into. May be nullptr.
+		*//******************************************************************/
+		void AddContact(uint32_t bodyA, uint32_t bodyB, const Vector2& normal, float penetrationDepth, float restitution, float friction, Contact* cachedContact);
+
+		/*****************************************************************//*!
+		\brief
+			Solves all contacts.
+		\param dt
+			The timestep of this update.
+		\param velocityIterations
+			The number of times to iterate over each island's contacts to solve velocities.
+		\param positionIterations
+			The number of times to iterate over each island's contacts to push bodies out of each other.
+		*//******************************************************************/
+		void Solve(float dt, int velocityIterations, int positionIterations);
+
+		/*****************************************************************//*!
+		\brief
+			Gets the total impulse applied to a body by the last solve.
+		\param body
+			The index of the body.
+		\return
+			The impulse.
+		*//******************************************************************/
+		const Vector2& GetImpulse(uint32_t body) const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets the velocity of a body after the last solve.
+		\param body
+			The index of the body.
+		\return
+			The velocity.
+		*//******************************************************************/
+		const Vector2& GetVelocity(uint32_t body) const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets how far a body should be moved to push it out of what it is touching, as of the last solve.
+		\param body
+			The index of the body.
+		\return
+			The displacement.
+		*//******************************************************************/
+		const Vector2& GetPositionCorrection(uint32_t body) const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets the number of bodies.
+		\return
+			The number of bodies.
+		*//******************************************************************/
+		uint32_t GetNumBodies() const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets the number of contacts.
+		\return
+			The number of contacts.
+		*//******************************************************************/
+		uint32_t GetNumContacts() const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets the number of islands found by the last solve.
+		\return
+			The number of islands.
+		*//******************************************************************/
+		uint32_t GetNumIslands() const;
+
+	private:
+		/*****************************************************************//*!
+		\struct Body
+		\brief
+			The state of a body while solving.
+		*//******************************************************************/
+		struct Body
+		{
+			//! The velocity of the body.
+			Vector2 velocity;
+			//! The total impulse applied to the body.
+			Vector2 impulse;
+			//! The displacement to push the body out of what it is touching.
+			Vector2 positionCorrection;
+			//! The mass reciprocal of the body. 0 if the body isn't changed by the solver.
+			float massReciprocal;
+			//! The parent of the body within the disjoint set used to find islands.
+			uint32_t parent;
+			//! The island of the set that this body is the root of, if it is a root.
+			uint32_t island;
+		};
+
+		/*****************************************************************//*!
+		\struct SolverContact
+		\brief
+			The state of a contact while solving.
+		*//******************************************************************/
+		struct SolverContact
+		{
+			//! The index of a body.
+			uint32_t bodyA;
+			//! The index of the other body.
+			uint32_t bodyB;
+			//! The normal of the contact, pointing in the direction that body A is pushed.
+			Vector2 normal;
+			//! The penetration depth of the contact.
+			float penetrationDepth;
+			//! The restitution coefficient of the contact.
+			float restitution;
+			//! The friction coefficient of the contact.
+			float friction;
+			//! The persistent contact that impulses are warm started from and stored into. May be nullptr.
+			Contact* cachedContact;
+			//! The island that the contact belongs to.
+			uint32_t island;
+
+			//! The reciprocal of the combined mass reciprocals of both bodies.
+			float effectiveMass;
+			//! The normal velocity that the contact is solved towards, for restitution.
+			float velocityBias;
+			//! The maximum tangent impulse that friction can apply.
+			float maxTangentImpulse;
+			//! The total impulse applied along the normal.
+			float normalImpulse;
+			//! The total impulse applied along the tangent.
+			float tangentImpulse;
+		};
+
+		/*****************************************************************//*!
+		\brief
+			Finds the root of a body within the disjoint set used to find islands.
+		\param body
+			The index of the body.
+		\return
+			The index of the root body.
+		*//******************************************************************/
+		uint32_t FindRoot(uint32_t body);
+
+		/*****************************************************************//*!
+		\brief
+			Splits bodies into islands, and orders contacts by island.
+		*//******************************************************************/
+		void BuildIslands();
+
+		/*****************************************************************//*!
+		\brief
+			Solves the contacts of an island.
+		\param island
+			The index of the island.
+		\param dt
+			The timestep of this update.
+		\param velocityIterations
+			The number of times to iterate over the contacts to solve velocities.
+		\param positionIterations
+			The number of times to iterate over the contacts to push bodies out of each other.
+		*//******************************************************************/
+		void SolveIsland(uint32_t island, float dt, int velocityIterations, int positionIterations);
+
+		/*****************************************************************//*!
+		\brief
+			Applies an impulse to both bodies of a contact. Bodies that aren't changed by the solver are left untouched,
+			so that islands sharing them may be solved at the same time.
+		\param contact
+			The contact.
+		\param impulse
+			The impulse to apply to body A. The opposite is applied to body B.
+		*//******************************************************************/
+		void ApplyImpulse(const SolverContact& contact, const Vector2& impulse);
+
+	private:
+		//! The bodies.
+		std::vector<Body> bodies;
+		//! The contacts, in the order they were added.
+		std::vector<SolverContact> contacts;
+		//! The indexes of contacts, ordered by island.
+		std::vector<uint32_t> islandContacts;
+		//! The index within islandContacts where each island's contacts start, with an extra entry at the end.
+		std::vector<uint32_t> islandStarts;
+	};
+
+}
@@ -41,14 +41,14 @@ DropPodComponent::~DropPodComponent()
 
 void DropPodComponent::OnAttached()
 {
-	ecs::GetEntity(this)->GetComp<EntityEventsComponent>()->Subscribe("OnCollision", this, &DropPodComponent::OnCollision);
+	ecs::GetEntity(this)->GetComp<EntityEventsComponent>()->Subscribe("OnCollisionEnter", this, &DropPodComponent::OnCollision);
 
 }
 
 void DropPodComponent::OnDetached()
 {
 	if (auto eventsComp{ ecs::GetEntity(this)->GetComp<EntityEventsComponent>() })
-		eventsComp->Unsubscribe("OnCollision", this, &DropPodComponent::OnCollision);
+		eventsComp->Unsubscribe("OnCollisionEnter", this, &DropPodComponent::OnCollision);
 }
 
 void DropPodComponent::OnCollision([[maybe_unused]] const Physics::CollisionEventData& collisionData)
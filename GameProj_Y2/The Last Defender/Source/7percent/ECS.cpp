@@ -27,9 +27,15 @@ namespace ecs {
 
 #pragma region Globals
 
-#define X(name, callbacksEnabled) callbacksEnabled,
+#define X(name, callbacksEnabled, archetypesEnabled) callbacksEnabled,
 	constexpr bool compCallbacksEnabledForPool[]{ M_ECS_POOL };
 #undef X
+#define X(name, callbacksEnabled, archetypesEnabled) archetypesEnabled,
+	constexpr bool archetypesEnabledForPool[]{ M_ECS_POOL };
+#undef X
+
+	//! Whether systems that allow concurrency may run concurrently.
+	bool parallelSystemsEnabled{ true };
 
 #pragma endregion
 
@@ -37,7 +43,7 @@ namespace ecs {
 
 	void Initialize()
 	{
-		internal::CurrentPool::Init(compCallbacksEnabledForPool[0]);
+		internal::CurrentPool::Init(compCallbacksEnabledForPool[0], archetypesEnabledForPool[0]);
 	}
 
 	void Shutdown()
@@ -74,7 +80,7 @@ namespace ecs {
 		if (compIndexIter->second & COMP_STATUS_TO_ADD)
 		{
 			internal::CurrentPool::ChangesBuffer().RemoveCompBufferedForAddition(compHash, compIndexIter->second & COMP_STATUS_UNUSED_BITS);
-			components.erase(compIndexIter);
+			UnregisterComp(compIndexIter);
 			return true;
 		}
 
@@ -105,7 +111,7 @@ namespace ecs {
 		}
 
 		// Unregister component from this entity
-		components.erase(compIndexIter);
+		UnregisterComp(compIndexIter);
 
 		return true;
 	}
@@ -254,6 +260,78 @@ namespace ecs {
 		return entityClone;
 	}
 
+	EntityTemplate CompileEntityTemplate(EntityHandle entity, bool recursive)
+	{
+		return EntityTemplate{ reinterpret_cast<internal::InternalEntityHandle>(entity), recursive };
+	}
+
+	std::vector<EntityHandle> Instantiate(const EntityTemplate& entityTemplate, uint32_t count)
+	{
+		// Entities are grouped by template node, so the roots come first and parents are created before their children
+		uint32_t numNodes{ entityTemplate.GetNumNodes() };
+		std::vector<internal::InternalEntityHandle> entities{};
+		entities.reserve(static_cast<size_t>(numNodes) * count);
+		ReserveEntities(static_cast<size_t>(numNodes) * count);
+		for (uint32_t node{}; node < numNodes; ++node)
+		{
+			uint32_t parentNode{ entityTemplate.GetParentNode(node) };
+			for (uint32_t i{}; i < count; ++i)
+			{
+				EntityHandle parent{ (parentNode == EntityTemplate::NO_PARENT ? nullptr : reinterpret_cast<EntityHandle>(entities[static_cast<size_t>(parentNode) * count + i])) };
+				EntityHandle entity{ CreateEntity_NoBroadcast(parent) };
+				entityTemplate.ApplyTransform(node, entity->GetTransform());
+				entities.push_back(reinterpret_cast<internal::InternalEntityHandle>(entity));
+			}
+		}
+
+		entityTemplate.InstantiateComps(entities.data(), count);
+		internal::CurrentPool::ChangesBuffer().FlushComponentCallbacks();
+
+		// Broadcast children before their parents, same as cloning
+		for (auto entityIter{ entities.rbegin() }; entityIter != entities.rend(); ++entityIter)
+			BroadcastEntityCreated(reinterpret_cast<EntityHandle>(*entityIter));
+
+		std::vector<EntityHandle> roots{};
+		roots.reserve(count);
+		for (uint32_t i{}; i < count; ++i)
+			roots.push_back(reinterpret_cast<EntityHandle>(entities[i]));
+		return roots;
+	}
+
+	void ReserveEntities(size_t numEntities)
+	{
+		internal::CurrentPool::Entities().Reserve(numEntities);
+	}
+
+	bool ParkInstance(EntityHandle root, const EntityTemplate& entityTemplate)
+	{
+		std::vector<internal::InternalEntityHandle> entities{};
+		if (!entityTemplate.GetInstanceEntities(reinterpret_cast<internal::InternalEntityHandle>(root), entities))
+			return false;
+
+		entityTemplate.DetachInstanceComps(entities.data());
+		root->GetTransform().SetParent(nullptr);
+		root->SetActive(false);
+		for (internal::InternalEntityHandle entity : entities)
+			entity->INTERNAL_SetIsParked(true);
+		return true;
+	}
+
+	bool ReviveInstance(EntityHandle root, const EntityTemplate& entityTemplate)
+	{
+		std::vector<internal::InternalEntityHandle> entities{};
+		if (!entityTemplate.GetInstanceEntities(reinterpret_cast<internal::InternalEntityHandle>(root), entities))
+			return false;
+
+		for (uint32_t node{}; node < static_cast<uint32_t>(entities.size()); ++node)
+			entityTemplate.ApplyTransform(node, reinterpret_cast<EntityHandle>(entities[node])->GetTransform());
+		for (internal::InternalEntityHandle entity : entities)
+			entity->INTERNAL_SetIsParked(false);
+		entityTemplate.ResetInstanceComps(entities.data());
+		internal::CurrentPool::ChangesBuffer().FlushComponentCallbacks();
+		return true;
+	}
+
 	void DeleteEntity(EntityHandle entity, bool recursive)
 	{
 		internal::InternalEntityHandle internalEntity{ reinterpret_cast<internal::InternalEntityHandle>(entity) };
@@ -270,6 +348,28 @@ namespace ecs {
 		}
 	}
 
+	void DeleteEntities(std::span<const EntityHandle> entities, bool recursive)
+	{
+		// Gather every entity to be deleted first, so that space for all of them can be reserved at once
+		std::vector<internal::InternalEntityHandle> toDelete{};
+		toDelete.reserve(entities.size());
+		for (EntityHandle entity : entities)
+			toDelete.push_back(reinterpret_cast<internal::InternalEntityHandle>(entity));
+		if (recursive)
+			for (size_t i{}; i < toDelete.size(); ++i)
+				for (Transform* childTransform : reinterpret_cast<EntityHandle>(toDelete[i])->GetTransform().GetChildren())
+					toDelete.push_back(reinterpret_cast<internal::InternalEntityHandle>(childTransform->GetEntity()));
+
+		// Entities may be listed multiple times, either directly or as a descendant of another listed entity
+		std::sort(toDelete.begin(), toDelete.end());
+		toDelete.erase(std::unique(toDelete.begin(), toDelete.end()), toDelete.end());
+		std::erase_if(toDelete, [](internal::InternalEntityHandle entity) -> bool {
+			return entity->INTERNAL_GetIsMarkedForDeletion();
+		});
+
+		internal::CurrentPool::ChangesBuffer().DeleteEntities(toDelete.data(), toDelete.size());
+	}
+
 	void DeleteEntityNow(EntityHandle entity, bool recursive)
 	{
 		// TODO: Make a flow to delete entities immediately without buffering
@@ -282,6 +382,14 @@ namespace ecs {
 		internal::CurrentPool::ChangesBuffer().FlushChanges();
 	}
 
+	void DeferChange(std::function<void()> change)
+	{
+		if (internal::CompChangesShard* shard{ internal::CompChangesShard::GetActive() })
+			shard->Defer(std::move(change));
+		else
+			change();
+	}
+
 	EntityHandle GetEntity(void* component)
 	{
 		return reinterpret_cast<EntityHandle>(internal::GetEntityFromCompAddr(component));
@@ -307,7 +415,15 @@ namespace ecs {
 
 	bool IsEntityHandleValid(EntityHandle entity)
 	{
-		return entity && internal::CurrentPool::Entities().CheckValidHandle(reinterpret_cast<internal::InternalEntityHandle>(entity));
+		// Parked instances are kept around for reuse, but are as good as deleted to anything holding on to them
+		return entity && internal::CurrentPool::Entities().CheckValidHandle(reinterpret_cast<internal::InternalEntityHandle>(entity))
+			&& !reinterpret_cast<internal::InternalEntityHandle>(entity)->INTERNAL_GetIsParked();
+	}
+
+	bool IsEntityHandleValid(EntityHandle entity, EntityHash hash)
+	{
+		return entity && internal::CurrentPool::Entities().CheckValidHandle(reinterpret_cast<internal::InternalEntityHandle>(entity), hash)
+			&& !reinterpret_cast<internal::InternalEntityHandle>(entity)->INTERNAL_GetIsParked();
 	}
 
 	EntityIterator GetEntitiesBegin()
@@ -354,7 +470,27 @@ namespace ecs {
 
 	void RunSystems(ECS_LAYER layer)
 	{
-		internal::CurrentPool::Systems().RunSystems(static_cast<int>(layer));
+		internal::CurrentPool::Systems().RunSystems(static_cast<int>(layer), parallelSystemsEnabled);
+	}
+
+	void SetParallelSystemsEnabled(bool enabled)
+	{
+		parallelSystemsEnabled = enabled;
+	}
+
+	bool GetParallelSystemsEnabled()
+	{
+		return parallelSystemsEnabled;
+	}
+
+	const internal::SysLayerStatsMapType& GetSystemsLayerStats()
+	{
+		return internal::CurrentPool::Systems().GetLayerStats();
+	}
+
+	uint64_t GetNumSystemBatchesRun()
+	{
+		return internal::CurrentPool::Systems().GetNumBatchesRun();
 	}
 	
 	void RemoveSystemsInLayer(ECS_LAYER layer)
@@ -391,7 +527,7 @@ namespace ecs {
 		if (id == GetCurrentPoolId())
 			return;
 
-		internal::CurrentPool::SwitchToPool_CreateIfNotExist(static_cast<int>(id), compCallbacksEnabledForPool[static_cast<int>(id)]);
+		internal::CurrentPool::SwitchToPool_CreateIfNotExist(static_cast<int>(id), compCallbacksEnabledForPool[static_cast<int>(id)], archetypesEnabledForPool[static_cast<int>(id)]);
 
 		Messaging::BroadcastAll("OnECSPoolSwitched", id);
 	}
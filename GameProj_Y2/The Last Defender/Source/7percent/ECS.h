@@ -64,6 +64,8 @@ namespace ecs {
 
 	// The user-facing iterator to iterate over entities
 	using EntityIterator = internal::ECSPool::Entity_IteratorBlueprint<EntityHandle, internal::EntMapType::iterator>;
+	// The user-facing type of a compiled entity hierarchy that can be instantiated many times
+	using EntityTemplate = internal::EntityTemplate;
 
 
 	// The user-facing handle to a component
@@ -102,6 +104,14 @@ namespace ecs {
 	//		PostRun()   - called once all entities have been processed.
 	template <typename SysType, typename ...Args>
 	using System = internal::System_Internal<SysType, Args...>;
+	// The user-facing system type whose per-entity function is run in chunks across worker threads.
+	//   The function may only touch the components passed to it and read-only state. Use ecs::DeferChange() for structural changes.
+	template <typename SysType, typename ...Args>
+	using ParallelSystem = internal::ParallelSystem_Internal<SysType, Args...>;
+	// The user-facing persistent query for entities that have all the specified components.
+	//   Call Update() once per use (returns false if the current pool doesn't track archetypes), then ForEach().
+	template <typename ...Args>
+	using Query = internal::Query_Internal<Args...>;
 	// The user-facing handle to a system
 	template <typename SysType>
 	using SysHandle = internal::InternalGenericSysHandle<SysType>;
@@ -518,6 +528,88 @@ namespace ecs {
 	*//******************************************************************/
 	EntityHandle CloneEntityNow(EntityHandle entity, bool recursive = false);
 
+	/*****************************************************************//*!
+	\brief
+		Compiles an entity into a template, copying the transform and all components of the entity as they are now.
+		The template is independent of the entity, so changes to the entity later on do not affect the template.
+	\param entity
+		The entity to be compiled.
+	\param recursive
+		Whether to compile child entities as well.
+	\return
+		The template.
+	*//******************************************************************/
+	EntityTemplate CompileEntityTemplate(EntityHandle entity, bool recursive = true);
+
+	/*****************************************************************//*!
+	\brief
+		Creates copies of a template's entities immediately. Space for all copies of each component type is reserved at once,
+		and trivially copyable components are copied with memcpy. This provides better performance than cloning an entity per copy.
+		The root of each copy is not parented to any entity.
+		COMPONENT ITERATORS TO COMPONENT ARRAYS OF ANY OF THE TEMPLATE'S COMPONENTS WILL BE INVALIDATED!
+	\param entityTemplate
+		The template to be instantiated.
+	\param count
+		The number of copies to create.
+	\return
+		EntityHandles to the root entity of each copy.
+	*//******************************************************************/
+	std::vector<EntityHandle> Instantiate(const EntityTemplate& entityTemplate, uint32_t count);
+
+	/*****************************************************************//*!
+	\brief
+		Creates multiple unparented entities immediately, each with a copy of the provided components attached.
+		Space for all entities and all components of each type is reserved at once, so this provides better performance
+		than creating entities and attaching components one by one.
+		COMPONENT ITERATORS TO COMPONENT ARRAYS OF ANY OF THE PROVIDED COMPONENT TYPES WILL BE INVALIDATED!
+	\tparam CompTypes
+		The types of the components to attach. Each type must appear only once.
+	\param count
+		The number of entities to create.
+	\param comps
+		The components to copy onto each entity.
+	\return
+		EntityHandles to the newly created entities.
+	*//******************************************************************/
+	template <typename ...CompTypes>
+	std::vector<EntityHandle> CreateEntities(uint32_t count, const CompTypes&... comps);
+
+	/*****************************************************************//*!
+	\brief
+		Reserves space so that the specified number of entities can be created without reallocating entity storage.
+	\param numEntities
+		The number of entities that are about to be created.
+	*//******************************************************************/
+	void ReserveEntities(size_t numEntities);
+
+	/*****************************************************************//*!
+	\brief
+		Parks an instance of a template so that it may be revived later instead of being deleted and instantiated again.
+		The instance's components are informed that they are detached, its root is unparented, and deactivating its components
+		is buffered until ecs::FlushChanges() is called. Handles to the instance's entities fail ecs::IsEntityHandleValid() until it is revived.
+	\param root
+		The root entity of the instance.
+	\param entityTemplate
+		The template that the instance was instantiated from.
+	\return
+		True if the instance was parked. False if the instance no longer matches the template, in which case no changes are made.
+	*//******************************************************************/
+	bool ParkInstance(EntityHandle root, const EntityTemplate& entityTemplate);
+
+	/*****************************************************************//*!
+	\brief
+		Revives an instance of a template that was parked by ecs::ParkInstance(). The instance's transforms and components are
+		reset to copies of the template's in place, and components are informed that they are attached.
+		The activeness of the instance's components is restored immediately, so the instance can be used right away.
+	\param root
+		The root entity of the instance.
+	\param entityTemplate
+		The template that the instance was instantiated from.
+	\return
+		True if the instance was revived. False if the instance no longer matches the template, in which case no changes are made.
+	*//******************************************************************/
+	bool ReviveInstance(EntityHandle root, const EntityTemplate& entityTemplate);
+
 	/*****************************************************************//*!
 	\brief
 		Deletes an entity, detaching and removing all attached components along the way. This change is buffered until ecs::FlushChanges() is called.
@@ -528,6 +620,18 @@ namespace ecs {
 	*//******************************************************************/
 	void DeleteEntity(EntityHandle entity, bool recursive = true);
 
+	/*****************************************************************//*!
+	\brief
+		Deletes multiple entities, detaching and removing all attached components along the way. Space for all removals
+		is reserved at once, so this provides better performance than deleting entities one by one.
+		This change is buffered until ecs::FlushChanges() is called.
+	\param entities
+		The entities to be deleted. Entities that appear more than once, or are descendants of other entities, are deleted once.
+	\param recursive
+		Whether to delete child entities as well.
+	*//******************************************************************/
+	void DeleteEntities(std::span<const EntityHandle> entities, bool recursive = true);
+
 	/*****************************************************************//*!
 	\brief
 		Deletes an entity immediately, detaching and removing all attached components along the way.
@@ -549,7 +653,17 @@ namespace ecs {
 
 	/*****************************************************************//*!
 	\brief
-		Checks if an entity handle is to a valid entity in the currently loaded pool.
+		Requests a structural change (e.g. deleting an entity, adding/removing components) from within a ParallelSystem.
+		Within a ParallelSystem's chunk, the change is recorded and applied on the main thread after all chunks complete,
+		in the same order regardless of how many threads processed the chunks. Otherwise the change is applied immediately.
+	\param change
+		The function that makes the change.
+	*//******************************************************************/
+	void DeferChange(std::function<void()> change);
+
+	/*****************************************************************//*!
+	\brief
+		Checks if an entity handle is to a valid entity in the currently loaded pool. Entities of parked instances are not valid.
 	\param handle
 		The entity handle.
 	\return
@@ -557,6 +671,19 @@ namespace ecs {
 	*//******************************************************************/
 	bool IsEntityHandleValid(EntityHandle entity);
 
+	/*****************************************************************//*!
+	\brief
+		Checks if an entity handle is still to the entity that had the specified hash in the currently loaded pool.
+		Unlike checking the handle alone, this rejects stale handles to slots that have been reused by a newer entity.
+	\param entity
+		The entity handle.
+	\param hash
+		The hash of the entity when the handle was taken.
+	\return
+		True if the entity handle is valid and still has the hash. False otherwise.
+	*//******************************************************************/
+	bool IsEntityHandleValid(EntityHandle entity, EntityHash hash);
+
 	/*****************************************************************//*!
 	\brief
 		Gets an iterator to the beginning of the entities list.
@@ -653,6 +780,19 @@ namespace ecs {
 	template <typename CompType>
 	CompIterator<CompType> GetCompsIter(CompHandle<CompType> comp);
 
+	/*****************************************************************//*!
+	\brief
+		Reserves space so that the specified number of components can be added on top of the existing
+		components of a type, without moving the existing components each time the component array grows.
+		Does not invalidate component iterators unless more memory needs to be allocated.
+	\tparam CompType
+		The component type.
+	\param numToAdd
+		The number of components that are about to be added.
+	*//******************************************************************/
+	template <typename CompType>
+	void ReserveComps(uint32_t numToAdd);
+
 	/*****************************************************************//*!
 	\brief
 		Gets whether a component is active or not.
@@ -808,6 +948,41 @@ namespace ecs {
 	*//******************************************************************/
 	void RunSystems(ECS_LAYER layer);
 
+	/*****************************************************************//*!
+	\brief
+		Sets whether systems that allow concurrency may run concurrently with other systems in the same layer.
+		When disabled, all systems run one after another on the calling thread.
+	\param enabled
+		Whether systems may run concurrently.
+	*//******************************************************************/
+	void SetParallelSystemsEnabled(bool enabled);
+
+	/*****************************************************************//*!
+	\brief
+		Gets whether systems that allow concurrency may run concurrently with other systems in the same layer.
+	\return
+		True if systems may run concurrently. False otherwise.
+	*//******************************************************************/
+	bool GetParallelSystemsEnabled();
+
+	/*****************************************************************//*!
+	\brief
+		Gets statistics about how systems within each layer of the current ECS pool ran the last time the layer was run.
+	\return
+		The map of layer to statistics.
+	*//******************************************************************/
+	const internal::SysLayerStatsMapType& GetSystemsLayerStats();
+
+	/*****************************************************************//*!
+	\brief
+		Gets the number of batches of systems that have been run within the current ECS pool.
+		This changes whenever systems may have modified components, so data derived from components
+		can compare this against the value when it was last derived to tell whether it may be stale.
+	\return
+		The number of batches of systems run within the current ECS pool.
+	*//******************************************************************/
+	uint64_t GetNumSystemBatchesRun();
+
 	/*****************************************************************//*!
 	\brief
 		Removes a system of the provided type from ecs management.
@@ -883,15 +1058,16 @@ namespace ecs {
 
 	/*****************************************************************//*!
 	\enum POOL
-		Identifies ECS pools. Format: (name, whether to call component callbacks)
+		Identifies ECS pools. Format: (name, whether to call component callbacks, whether to track archetypes)
 	*//******************************************************************/
 #define M_ECS_POOL \
-X(DEFAULT, true)		/* Default pool is ALWAYS 0 */ \
-X(PREFAB, false)		/* For prefab editor */ \
-X(PREFAB_CACHE, false)	/* For prefab caching */ \
-X(UNDO, false)			/* For the undo feature - deleted entities are stored within this pool. */
+X(DEFAULT, true, true)			/* Default pool is ALWAYS 0 */ \
+X(PREFAB, false, false)			/* For prefab editor */ \
+X(PREFAB_CACHE, false, false)	/* For prefab caching */ \
+X(UNDO, false, false)			/* For the undo feature - deleted entities are stored within this pool. */ \
+X(BENCHMARK, false, true)		/* For benchmarks - isolated from the scene's entities. */
 
-#define X(name, callbacksEnabled) name,
+#define X(name, callbacksEnabled, archetypesEnabled) name,
 	enum class POOL : int
 	{
 		M_ECS_POOL
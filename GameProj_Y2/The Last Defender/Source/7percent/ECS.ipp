@@ -39,7 +39,7 @@ namespace ecs {
 		indexInBuffer |= COMP_STATUS_TO_ADD;
 
 		// Register component as pending addition in this entity
-		components.emplace(internal::GetCompHash<T>(), indexInBuffer);
+		RegisterComp(internal::GetCompHash<T>(), indexInBuffer);
 
 		return true;
 	}
@@ -55,7 +55,7 @@ namespace ecs {
 		uint32_t compIndex{ compArr.AddComp(GetHandle(), std::forward<T>(comp), !isActive) };
 
 		// Register component in this entity
-		components.emplace(internal::GetCompHash<T>(), compIndex);
+		RegisterComp(internal::GetCompHash<T>(), compIndex);
 
 		// Flush component callbacks
 		internal::CurrentPool::ChangesBuffer().FlushComponentCallbacks();
@@ -153,6 +153,15 @@ namespace ecs {
 
 #pragma region // Entities
 
+	template<typename ...CompTypes>
+	std::vector<EntityHandle> CreateEntities(uint32_t count, const CompTypes&... comps)
+	{
+		// Compile the components into a single node template, so all entities are created and filled in one pass
+		std::array<const internal::CompArr*, sizeof...(CompTypes)> compTypes{ &internal::GetCompArr<CompTypes>()... };
+		std::array<const internal::RawData*, sizeof...(CompTypes)> compData{ reinterpret_cast<const internal::RawData*>(&comps)... };
+		return Instantiate(EntityTemplate{ compTypes.data(), compData.data(), sizeof...(CompTypes) }, count);
+	}
+
 #pragma region // Components
 
 	template<typename CompType>
@@ -192,8 +201,14 @@ namespace ecs {
 	template<typename CompType>
 	CompIterator<CompType> GetCompsIter(CompHandle<CompType> comp)
 	{
-		return internal::GetCompArr<CompType>().User_Custom<CompType, EntityHandle>(
-			reinterpret_cast<internal::InternalEntityHandle>(reinterpret_cast<internal::RawData*>(comp) - internal::CompArr::EntPtrSize));
+		return internal::GetCompArr<CompType>().User_Custom<CompType, EntityHandle>(comp);
+	}
+
+	template<typename CompType>
+	void ReserveComps(uint32_t numToAdd)
+	{
+		internal::CompArr& compArr{ internal::GetCompArr<CompType>() };
+		compArr.Reserve(compArr.GetNumComps() + numToAdd);
 	}
 
 	template<typename CompType>
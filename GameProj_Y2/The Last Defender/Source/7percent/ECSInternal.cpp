@@ -21,6 +21,8 @@ All rights reserved.
 /******************************************************************************/
 
 #include "ECSInternal.h"
+#include "JobSystem.h"
+#include <shared_mutex>
 
 namespace ecs {
 	namespace internal {
@@ -29,10 +31,12 @@ namespace ecs {
 
 #pragma region ECSPool
 
-		ECSPool::ECSPool(int id, bool compCallbacksEnabled)
-			: id{ id }
+		ECSPool::ECSPool(int id, bool compCallbacksEnabled, bool archetypesEnabled)
+			: archetypes{ comps }
+			, id{ id }
 			, compCallbacksEnabled{ compCallbacksEnabled }
-			, entitiesWrapper{ entities, validEntityHandles }
+			, archetypesEnabled{ archetypesEnabled }
+			, entitiesWrapper{ entities, (archetypesEnabled ? &archetypes : nullptr) }
 		{
 		}
 
@@ -41,16 +45,21 @@ namespace ecs {
 			return compCallbacksEnabled;
 		}
 
+		ArchetypeManager* ECSPool::GetArchetypes()
+		{
+			return (archetypesEnabled ? &archetypes : nullptr);
+		}
+
 #pragma endregion // ECSPool
 
 #pragma region CurrentPool
 
-		void CurrentPool::Init(bool defaultPoolHasCompCallbacksEnabled)
+		void CurrentPool::Init(bool defaultPoolHasCompCallbacksEnabled, bool defaultPoolHasArchetypesEnabled)
 		{
 			pools = std::make_unique<PoolsMapType>();
 
 			// Create a default pool with id 0 and set it as active.
-			SwitchToPool_CreateIfNotExist(0, defaultPoolHasCompCallbacksEnabled);
+			SwitchToPool_CreateIfNotExist(0, defaultPoolHasCompCallbacksEnabled, defaultPoolHasArchetypesEnabled);
 		}
 
 		void CurrentPool::Shutdown()
@@ -90,6 +99,10 @@ namespace ecs {
 		{
 			return *ST<TypeMetaManager>::Get();
 		}
+		ArchetypeManager* CurrentPool::Archetypes()
+		{
+			return activePool->GetArchetypes();
+		}
 
 		CompArrMapType& CurrentPool::Comps(int id)
 		{
@@ -118,14 +131,14 @@ namespace ecs {
 				activePool = &poolIter->second;
 		}
 
-		void CurrentPool::SwitchToPool_CreateIfNotExist(int id, bool compCallbacksEnabled)
+		void CurrentPool::SwitchToPool_CreateIfNotExist(int id, bool compCallbacksEnabled, bool archetypesEnabled)
 		{
 			if (activePool && activePool->id == id)
 				return;
 
 			PoolsMapType::iterator poolIter{ pools->find(id) };
 			if (poolIter == pools->end())
-				poolIter = pools->try_emplace(id, id, compCallbacksEnabled).first;
+				poolIter = pools->try_emplace(id, id, compCallbacksEnabled, archetypesEnabled).first;
 
 			activePool = &poolIter->second;
 		}
@@ -170,6 +183,11 @@ namespace ecs {
 			// Clear the entities
 			poolToDelete.entitiesWrapper.ClearAll();
 
+			// Clear the archetypes
+			// (entities remove themselves from their archetypes when destroyed, so this needs to happen after)
+			if (ArchetypeManager* archetypes{ poolToDelete.GetArchetypes() })
+				archetypes->Clear();
+
 			// Switch back to initial pool
 			if (currentPoolId >= 0)
 				SwitchToPool(currentPoolId);
@@ -206,6 +224,10 @@ namespace ecs {
 			: mapKey{ mapKey }
 			, transform{}
 			, isMarkedForDeletion{ false }
+			, isParked{ false }
+			, archetypeManager{ nullptr }
+			, archetype{ nullptr }
+			, archetypeRow{}
 		{
 		}
 
@@ -220,7 +242,17 @@ namespace ecs {
 			: mapKey{ mapKey }
 			, transform{ transformCopy }
 			, isMarkedForDeletion{ false }
+			, isParked{ false }
+			, archetypeManager{ nullptr }
+			, archetype{ nullptr }
+			, archetypeRow{}
+		{
+		}
+
+		Entity_Internal::~Entity_Internal()
 		{
+			if (archetype)
+				archetypeManager->OnEntityErased(this);
 		}
 
 		void Entity_Internal::INTERNAL_CloneCompsToEntity(InternalEntityHandle entity) const
@@ -238,7 +270,7 @@ namespace ecs {
 				uint32_t indexInBuffer{ CurrentPool::ChangesBuffer().CloneComp(GetCompArr(compIter->first), compIter->second, entity) };
 
 				// Register the component to the entity
-				entity->components.emplace(compIter->first, indexInBuffer | COMP_STATUS_TO_ADD);
+				entity->RegisterComp(compIter->first, indexInBuffer | COMP_STATUS_TO_ADD);
 			}
 		}
 
@@ -264,7 +296,7 @@ namespace ecs {
 				uint32_t compIndex{ srcCompArr.CloneComp(compIter->second, entity, destCompArr) };
 
 				// Register the component to the entity
-				entity->components.emplace(compIter->first, compIndex);
+				entity->RegisterComp(compIter->first, compIndex);
 			}
 		}
 
@@ -272,16 +304,28 @@ namespace ecs {
 		{
 			// Copy flags into the value to be set
 			EntCompMapType::iterator compIter{ components.find(compHash) };
+			uint32_t prevIndex{ compIter->second };
 			if (!overrideFlags)
-				newIndex = (compIter->second & COMP_STATUS_ANY) + (newIndex & COMP_STATUS_UNUSED_BITS);
+				newIndex = (prevIndex & COMP_STATUS_ANY) + (newIndex & COMP_STATUS_UNUSED_BITS);
 
 			// Set the value of the new index
 			compIter->second = newIndex;
+
+			// Keep our archetype updated. Components pending addition are not part of any archetype yet.
+			if (!archetypeManager || (newIndex & COMP_STATUS_TO_ADD))
+				return;
+			if (prevIndex & COMP_STATUS_TO_ADD)
+				// The component has just been transferred from the addition buffer, so it is now attached to us
+				archetypeManager->OnCompAttached(this, compHash, newIndex & COMP_STATUS_UNUSED_BITS);
+			else
+				archetypeManager->OnCompIndexChanged(this, compHash, newIndex & COMP_STATUS_UNUSED_BITS);
 		}
 
 		void Entity_Internal::INTERNAL_RemoveComp(CompHash compHash)
 		{
-			components.erase(compHash);
+			EntCompMapType::iterator compIter{ components.find(compHash) };
+			if (compIter != components.end())
+				UnregisterComp(compIter);
 		}
 
 		EntCompMapType::const_iterator Entity_Internal::INTERNAL_CompsBegin() const
@@ -304,6 +348,16 @@ namespace ecs {
 			return isMarkedForDeletion;
 		}
 
+		void Entity_Internal::INTERNAL_SetIsParked(bool newIsParked)
+		{
+			isParked = newIsParked;
+		}
+
+		bool Entity_Internal::INTERNAL_GetIsParked() const
+		{
+			return isParked;
+		}
+
 		void Entity_Internal::INTERNAL_MarkAllCompsRemoved()
 		{
 			for (auto& [_, index] : components)
@@ -315,6 +369,11 @@ namespace ecs {
 			return mapKey;
 		}
 
+		void Entity_Internal::INTERNAL_SetArchetypeManager(ArchetypeManager* manager)
+		{
+			archetypeManager = manager;
+		}
+
 		bool Entity_Internal::INTERNAL_GetHasComp(CompHash compHash) const
 		{
 			return components.find(compHash) != components.end();
@@ -383,10 +442,51 @@ namespace ecs {
 			return true;
 		}
 
+		void Entity_Internal::RegisterComp(CompHash compHash, uint32_t index)
+		{
+			components.emplace(compHash, index);
+
+			// Components pending addition join our archetype when they are transferred out of the addition buffer
+			if (archetypeManager && !(index & COMP_STATUS_TO_ADD))
+				archetypeManager->OnCompAttached(this, compHash, index & COMP_STATUS_UNUSED_BITS);
+		}
+
+		void Entity_Internal::UnregisterComp(EntCompMapType::iterator compIter)
+		{
+			if (archetypeManager && !(compIter->second & COMP_STATUS_TO_ADD))
+				archetypeManager->OnCompDetached(this, compIter->first);
+
+			components.erase(compIter);
+		}
+
 #pragma endregion // Entity
 
 #pragma region CompChangesBuffer
 
+		thread_local CompChangesShard* CompChangesShard::activeShard{ nullptr };
+
+		void CompChangesShard::Defer(std::function<void()>&& change)
+		{
+			changes.push_back(std::move(change));
+		}
+
+		void CompChangesShard::Apply()
+		{
+			for (std::function<void()>& change : changes)
+				change();
+			changes.clear();
+		}
+
+		CompChangesShard* CompChangesShard::GetActive()
+		{
+			return activeShard;
+		}
+
+		void CompChangesShard::SetActive(CompChangesShard* shard)
+		{
+			activeShard = shard;
+		}
+
 		CompModifyTask::CompModifyTask(InternalEntityHandle entity, TYPE type)
 			: entity{ entity }
 			, type{ type }
@@ -415,13 +515,8 @@ namespace ecs {
 
 		void CompChangesBuffer::RemoveComp(InternalEntityHandle entity, CompHash compType)
 		{
-			auto emplaceResult{ GetModifySet(compType).emplace(entity, CompModifyTask::TYPE::REMOVE) };
-			if (!emplaceResult.second)
-			{
-				// A task pointing to the same component already exists. Overwrite its type.
-				// note: for some reason, the iterator is const. gonna need to hack it a bit...
-				emplaceResult.first._Ptr->_Myval.SetType(CompModifyTask::TYPE::REMOVE);
-			}
+			// If a task pointing to the same component already exists, removal will override it when flushed.
+			AddModifyTask(compType, CompModifyTask{ entity, CompModifyTask::TYPE::REMOVE });
 		}
 
 		void CompChangesBuffer::RemoveCompBufferedForAddition(CompHash compType, uint32_t index)
@@ -431,34 +526,8 @@ namespace ecs {
 
 		void CompChangesBuffer::ChangeCompActiveness(InternalEntityHandle entity, CompHash compType, bool isInactive)
 		{
-			// Check if this component is already queued for modification. If so, we can delete the task.
-			CompModifyTask task{ entity, (isInactive ? CompModifyTask::TYPE::SET_INACTIVE : CompModifyTask::TYPE::SET_ACTIVE) };
-			auto& modifySet{ GetModifySet(compType) };
-			auto existingTaskIter{ modifySet.find(task) };
-			if (existingTaskIter != modifySet.end())
-				switch (existingTaskIter->GetType())
-				{
-				case CompModifyTask::TYPE::REMOVE:
-					// Setting comp activeness on a comp that's about to be removed has no effect.
-					return;
-				case CompModifyTask::TYPE::SET_ACTIVE:
-					if (isInactive)
-						modifySet.erase(existingTaskIter);
-					return;
-				case CompModifyTask::TYPE::SET_INACTIVE:
-					if (!isInactive)
-						modifySet.erase(existingTaskIter);
-					return;
-				default:
-					assert(false);
-				}
-
-			// Check for no-op
-			if (GetCompArr(compType).GetIsCompActive(entity->INTERNAL_GetCompIndex(compType)) == !isInactive)
-				return;
-
-			// Add task
-			GetModifySet(compType).insert(std::move(task));
+			// Tasks on the same component, and changes that end up as no-ops, are resolved when flushed.
+			AddModifyTask(compType, CompModifyTask{ entity, (isInactive ? CompModifyTask::TYPE::SET_INACTIVE : CompModifyTask::TYPE::SET_ACTIVE) });
 		}
 
 		uint32_t CompChangesBuffer::CloneComp(CompArr& srcArr, uint32_t index, InternalEntityHandle entityOwner)
@@ -494,24 +563,32 @@ namespace ecs {
 					RemoveCompBufferedForAddition(compIter->first, compIter->second & Entity_Internal::COMP_STATUS_UNUSED_BITS);
 				// Buffer removal of components already attached to entity
 				else if (!(compIter->second & Entity_Internal::COMP_STATUS_TO_REMOVE))
-				{
-					auto& modifySet{ GetModifySet(compIter->first) };
-					auto emplaceResult{ modifySet.emplace(entity, CompModifyTask::TYPE::REMOVE) };
-					// The emplacement may have failed if there is already a task to act on the component. In this case just change the task to removal.
-					if (!emplaceResult.second)
-					{
-						// std::set doesn't allow modification of existing items...
-						CompModifyTask task{ *emplaceResult.first };
-						task.SetType(CompModifyTask::TYPE::REMOVE);
-						modifySet.erase(emplaceResult.first);
-						modifySet.insert(std::move(task));
-					}
-				}
+					AddModifyTask(compIter->first, CompModifyTask{ entity, CompModifyTask::TYPE::REMOVE });
 			}
 			// In case components' destructors call GetComp() looking for another component
 			entity->INTERNAL_MarkAllCompsRemoved();
 		}
 
+		void CompChangesBuffer::DeleteEntities(const InternalEntityHandle* entities, size_t numEntities)
+		{
+			// Count the removal tasks of each component type first, so each task container grows at most once
+			std::unordered_map<CompHash, size_t> numRemovals{};
+			for (size_t i{}; i < numEntities; ++i)
+				for (EntCompMapType::const_iterator compIter{ entities[i]->INTERNAL_CompsBegin() }, compEnd{ entities[i]->INTERNAL_CompsEnd() }; compIter != compEnd; ++compIter)
+					if (!(compIter->second & (Entity_Internal::COMP_STATUS_TO_ADD | Entity_Internal::COMP_STATUS_TO_REMOVE)))
+						++numRemovals[compIter->first];
+
+			for (const auto& [compType, count] : numRemovals)
+			{
+				CompModifyTaskContType& tasks{ compsToModify[compType] };
+				tasks.reserve(tasks.size() + count);
+			}
+			entitiesToRemove.reserve(entitiesToRemove.size() + numEntities);
+
+			for (size_t i{}; i < numEntities; ++i)
+				DeleteEntity(entities[i]);
+		}
+
 		void CompChangesBuffer::AddComponentCallback(CompInformAttachedSig callback, InternalEntityHandle entity)
 		{
 			componentCallbacksQueue.emplace_back(callback, entity);
@@ -520,37 +597,13 @@ namespace ecs {
 		void CompChangesBuffer::FlushChanges()
 		{
 			// Modify/Remove components
-			if (!compsToModify.empty())
+			// Component detached callbacks may queue more tasks, so keep going until they're all flushed before entities are deleted.
+			while (!compTypesToModify.empty())
 			{
-				for (ModifyCompSetType::iterator compSetIter{ compsToModify.begin() }, compSetEnd{ compsToModify.end() }; compSetIter != compSetEnd; ++compSetIter)
-				{
-					CompArr& compArr{ GetCompArr(compSetIter->first) };
-					for (CompIndexSetType<CompModifyTask>::iterator taskIter{ compSetIter->second.begin() }, taskEnd{ compSetIter->second.end() };
-						taskIter != taskEnd; ++taskIter)
-					{
-						uint32_t compIndex{ taskIter->GetCompIndex(compSetIter->first) };
-						switch (taskIter->GetType())
-						{
-						case CompModifyTask::TYPE::REMOVE:
-							// note: we can optimize the number of moves if the components to be removed are sequential.
-							//       this can be considered if performance is an issue here
-							compArr.RemoveComp(compIndex);
-							break;
-						case CompModifyTask::TYPE::SET_ACTIVE:
-							compArr.SetCompActiveness(compIndex, false);
-							break;
-						case CompModifyTask::TYPE::SET_INACTIVE:
-							compArr.SetCompActiveness(compIndex, true);
-							break;
-						default:
-							assert(false);
-						}
-					}
-				}
-
-				// TODO: this may be very expensive if we're making changes in a majority of frames.
-				//		 would be better to keep the memory of all CompArr loaded and keep a list of component types that are pending addition
-				compsToModify.clear();
+				std::swap(flushingCompTypes, compTypesToModify);
+				for (CompHash compType : flushingCompTypes)
+					FlushModifyTasks(compType);
+				flushingCompTypes.clear();
 			}
 
 			// Delete entities
@@ -609,33 +662,157 @@ namespace ecs {
 				compsToAdd.clear();
 			}
 			// Clear remove components
-			compsToModify.clear();
+			for (auto& [_, tasks] : compsToModify)
+				tasks.clear();
+			compTypesToModify.clear();
 			// Clear remove entities
 			entitiesToRemove.clear();
 		}
 
-		CompIndexSetType<CompModifyTask>& CompChangesBuffer::GetModifySet(CompHash compType)
+		void CompChangesBuffer::AddModifyTask(CompHash compType, CompModifyTask&& task)
 		{
-			ModifyCompSetType::iterator removeSetIter{ compsToModify.find(compType) };
-			if (removeSetIter != compsToModify.end())
-				return removeSetIter->second;
-			else
+			// Creates the container if it doesn't exist
+			CompModifyTaskContType& tasks{ compsToModify[compType] };
+			if (tasks.empty())
+				compTypesToModify.push_back(compType);
+			tasks.push_back(std::move(task));
+		}
+
+		void CompChangesBuffer::FlushModifyTasks(CompHash compType)
+		{
+			// Take the tasks out, so that tasks queued by callbacks while flushing are kept for the next pass
+			std::swap(flushingTasks, compsToModify.at(compType));
+			CompArr& compArr{ GetCompArr(compType) };
+
+			// Group tasks on the same component together, keeping the order that they were queued in
+			std::stable_sort(flushingTasks.begin(), flushingTasks.end());
+
+			// Resolve each group into a single task. Activeness changes are applied immediately,
+			// while removals are moved to the front of the container to be applied together afterwards.
+			size_t numRemovals{};
+			for (size_t groupBegin{}, groupEnd{}; groupBegin < flushingTasks.size(); groupBegin = groupEnd)
 			{
-				std::pair<ModifyCompSetType::iterator, bool> insertIter{ compsToModify.try_emplace(compType) };
-				return insertIter.first->second;
+				CompModifyTask::TYPE type{ flushingTasks[groupBegin].GetType() };
+				for (groupEnd = groupBegin + 1; groupEnd < flushingTasks.size() && !(flushingTasks[groupBegin] < flushingTasks[groupEnd]); ++groupEnd)
+					if (type != CompModifyTask::TYPE::REMOVE)
+						type = flushingTasks[groupEnd].GetType();
+
+				if (type == CompModifyTask::TYPE::REMOVE)
+				{
+					flushingTasks[numRemovals++] = flushingTasks[groupBegin];
+					continue;
+				}
+
+				// Skip no-ops
+				bool setInactive{ type == CompModifyTask::TYPE::SET_INACTIVE };
+				uint32_t compIndex{ flushingTasks[groupBegin].GetCompIndex(compType) };
+				if (compArr.GetIsCompActive(compIndex) == setInactive)
+					compArr.SetCompActiveness(compIndex, setInactive);
 			}
+
+			// Indexes are only fetched now since activeness changes may have moved components around
+			for (size_t i{}; i < numRemovals; ++i)
+				removalIndexes.push_back(flushingTasks[i].GetCompIndex(compType));
+			compArr.RemoveComps(removalIndexes);
+
+			removalIndexes.clear();
+			flushingTasks.clear();
 		}
 
 #pragma endregion // CompChangesBuffer
 
 #pragma region CompArr
 
-		CompArr::CompArr(CompHash compHash, uint32_t compSize, CompCopySig copyFunc, CompMoveSig moveFunc, CompDestroySig destroyFunc,
+		namespace {
+
+			/*****************************************************************//*!
+			\struct CompMemoryRange
+			\brief
+				The allocated component memory of a CompArr.
+			*//******************************************************************/
+			struct CompMemoryRange
+			{
+				//! The start of the CompArr's component memory.
+				const RawData* begin;
+				//! 1 past the end of the CompArr's allocated component memory.
+				const RawData* end;
+				//! The CompArr.
+				CompArr* compArr;
+
+				/*****************************************************************//*!
+				\brief
+					Checks whether an address lies within this range.
+				\param addr
+					The address.
+				\return
+					True if the address is within this range. False otherwise.
+				*//******************************************************************/
+				bool Contains(const RawData* addr) const
+				{
+					return !std::less<const RawData*>{}(addr, begin) && std::less<const RawData*>{}(addr, end);
+				}
+			};
+
+			/*****************************************************************//*!
+			\struct CompMemoryRegistry
+			\brief
+				Records the component memory of every CompArr, sorted by address,
+				so that the CompArr storing a component can be found from the component's address.
+			*//******************************************************************/
+			struct CompMemoryRegistry
+			{
+				//! Guards the ranges. Lookups may happen from multiple threads while systems run concurrently.
+				std::shared_mutex mutex;
+				//! The allocated component memory of each CompArr, sorted by address.
+				std::vector<CompMemoryRange> ranges;
+				//! Incremented whenever a CompArr is destroyed, invalidating each thread's cached CompArrs.
+				//! Reallocations don't invalidate them, since cached CompArrs are checked against their current memory.
+				std::atomic<uint32_t> version{ 1 };
+			};
+
+			/*****************************************************************//*!
+			\brief
+				Gets the component memory registry, constructing it on first use.
+			\return
+				The component memory registry.
+			*//******************************************************************/
+			CompMemoryRegistry& GetCompMemoryRegistry()
+			{
+				static CompMemoryRegistry registry{};
+				return registry;
+			}
+
+			/*****************************************************************//*!
+			\struct CompMemoryLookupCache
+			\brief
+				The last few CompArrs found by a thread. Usually consecutive lookups are into the same few CompArrs,
+				such as a system looking up the entity of each of the components it is passed.
+				Hits are checked against the CompArrs' current components, so they stay valid while CompArrs reallocate.
+			*//******************************************************************/
+			struct CompMemoryLookupCache
+			{
+				//! The number of CompArrs cached.
+				static constexpr size_t NUM_ENTRIES{ 4 };
+
+				//! The registry version when the CompArrs were found.
+				uint32_t version;
+				//! The index of the entry to replace on the next miss.
+				uint32_t nextEntry;
+				//! The CompArrs that were found. nullptr for unused entries.
+				std::array<CompArr*, NUM_ENTRIES> entries;
+				//! How lookups on this thread were resolved.
+				CompArr::LookupStats stats;
+			};
+			thread_local CompMemoryLookupCache compMemoryLookupCache{};
+
+		}
+
+		CompArr::CompArr(CompHash compHash, uint32_t compSize, bool isTriviallyCopyable, CompCopySig copyFunc, CompMoveSig moveFunc, CompDestroySig destroyFunc,
 			CompInformAttachedSig informAttachedFunc, CompInformDetachedSig informDetachedFunc,
 			CompInformAttachedSig trueInformAttachedFunc, CompInformDetachedSig trueInformDetachedFunc)
 			: compHash{ compHash }
 			, compSize{ compSize }
-			, compStepSize{ ReservedBytes + compSize }
+			, isTriviallyCopyable{ isTriviallyCopyable }
 			, numInactive{}
 			, firstActiveIndex{ numInactive }
 			, callCopyFunc{ copyFunc }
@@ -648,12 +825,15 @@ namespace ecs {
 			, tempCompSpace{ new RawData[compSize] }
 		{
 			// Reserve space for 32 components of this type
-			arrRaw.reserve(32 * static_cast<size_t>(compStepSize));
+			arrRaw.reserve(32 * static_cast<size_t>(compSize));
+			entities.reserve(32);
+			RegisterCompMemory(nullptr);
 		}
 
 		CompArr::~CompArr()
 		{
 			RemoveAllComps();
+			UnregisterCompMemory();
 		}
 
 		CompArr& GetCompArr(CompHash compType)
@@ -689,8 +869,7 @@ namespace ecs {
 			SetEntityPtr(compIndex, entPtr);
 
 			// Move the component into the expanded memory
-			size_t insertIndex{ compIndex * compStepSize + ReservedBytes };
-			callMoveFunc(comp, arrRaw.data() + insertIndex);
+			callMoveFunc(comp, GetComp(compIndex));
 			// Destructor is not called as we assume this component came from outside,
 			// where the original object will be destroyed by going out of scope.
 
@@ -729,6 +908,61 @@ namespace ecs {
 			SetArraySize(lastIndex);
 		}
 
+		void CompArr::RemoveComps(std::vector<uint32_t>& indexes, bool informOwnerEntity)
+		{
+			if (indexes.empty())
+				return;
+			std::sort(indexes.begin(), indexes.end());
+
+			// Destroy all the components first, while every component is still at its original index
+			for (uint32_t index : indexes)
+			{
+				InternalEntityHandle entity{ GetEntity(index) };
+				callInformDetachedFunc(entity);
+				if (informOwnerEntity)
+					entity->INTERNAL_RemoveComp(compHash);
+				callDestructorFunc(GetComp(index));
+			}
+
+			uint32_t numComps{ GetNumComps() };
+			std::vector<uint32_t>::const_iterator firstActiveRemovedIter{ std::lower_bound(indexes.cbegin(), indexes.cend(), firstActiveIndex) };
+			uint32_t newNumInactive{ numInactive - static_cast<uint32_t>(firstActiveRemovedIter - indexes.cbegin()) };
+			uint32_t newNumComps{ numComps - static_cast<uint32_t>(indexes.size()) };
+
+			// Creates a function that returns the indexes of alive components, from the back of [0, end), skipping removed components.
+			// removedEnd is 1 past the last removed index below end.
+			auto makeAliveCompsFromBack{ [&indexes](uint32_t end, std::vector<uint32_t>::const_iterator removedEnd) {
+				return [srcIndex = end, removedIter = std::make_reverse_iterator(removedEnd), removedREnd = indexes.crend()]() mutable -> uint32_t {
+					while (true)
+					{
+						--srcIndex;
+						while (removedIter != removedREnd && *removedIter > srcIndex)
+							++removedIter;
+						if (removedIter == removedREnd || *removedIter != srcIndex)
+							return srcIndex;
+					}
+				};
+			} };
+
+			// Fill holes in the new inactive range with the last inactive components.
+			// This vacates all of [newNumInactive, numInactive).
+			auto nextInactiveComp{ makeAliveCompsFromBack(firstActiveIndex, firstActiveRemovedIter) };
+			std::vector<uint32_t>::const_iterator removedIter{ indexes.cbegin() };
+			for (; removedIter != firstActiveRemovedIter && *removedIter < newNumInactive; ++removedIter)
+				MoveComp(nextInactiveComp(), *removedIter);
+
+			// Fill holes in the new active range with the last active components.
+			// The holes are the vacated end of the old inactive range, followed by removed active components.
+			auto nextActiveComp{ makeAliveCompsFromBack(numComps, indexes.cend()) };
+			for (uint32_t destIndex{ newNumInactive }, destEnd{ std::min(firstActiveIndex, newNumComps) }; destIndex < destEnd; ++destIndex)
+				MoveComp(nextActiveComp(), destIndex);
+			for (removedIter = firstActiveRemovedIter; removedIter != indexes.cend() && *removedIter < newNumComps; ++removedIter)
+				MoveComp(nextActiveComp(), *removedIter);
+
+			numInactive = newNumInactive;
+			SetArraySize(newNumComps);
+		}
+
 		uint32_t CompArr::CloneComp(uint32_t index, InternalEntityHandle entityOwner, CompArr& destArr)
 		{
 			// TODO: Throw something if the other CompArr doesn't store the same type of components as us
@@ -750,8 +984,7 @@ namespace ecs {
 
 		void CompArr::SetCompActiveness(void* compAddr, bool setInactive)
 		{
-			auto byteOffset{ reinterpret_cast<RawData*>(compAddr) - arrRaw.data() };
-			SetCompActiveness(static_cast<uint32_t>(byteOffset / compStepSize), setInactive);
+			SetCompActiveness(GetCompIndex(compAddr), setInactive);
 		}
 
 
@@ -788,11 +1021,11 @@ namespace ecs {
 
 		RawData* CompArr::GetComp(uint32_t index)
 		{
-			return arrRaw.data() + index * compStepSize + ReservedBytes;
+			return arrRaw.data() + index * compSize;
 		}
 		const RawData* CompArr::GetComp(uint32_t index) const
 		{
-			return arrRaw.data() + index * compStepSize + ReservedBytes;
+			return arrRaw.data() + index * compSize;
 		}
 
 		void CompArr::TransferCompsFrom(CompArr& other)
@@ -830,6 +1063,7 @@ namespace ecs {
 			}
 
 			other.arrRaw.clear();
+			other.entities.clear();
 		}
 
 		std::pair<CompArrMapType::iterator, bool> CompArr::CloneWithoutCompDataIntoPool(CompArrMapType& compArrPool) const
@@ -841,7 +1075,7 @@ namespace ecs {
 			return compArrPool.emplace(
 				std::piecewise_construct, // Need to construct in place due to deleted copy/move constructor
 				std::make_tuple(compHash),
-				std::make_tuple(compHash, compSize, callCopyFunc, callMoveFunc, callDestructorFunc,
+				std::make_tuple(compHash, compSize, isTriviallyCopyable, callCopyFunc, callMoveFunc, callDestructorFunc,
 				compCallbacksEnabled ? trueInformAttachedFunc : [](InternalEntityHandle) -> void {},
 				compCallbacksEnabled ? trueInformDetachedFunc : [](InternalEntityHandle) -> void {},
 				trueInformAttachedFunc,
@@ -861,6 +1095,7 @@ namespace ecs {
 			}
 
 			arrRaw.clear();
+			entities.clear();
 			numInactive = 0;
 		}
 
@@ -871,54 +1106,131 @@ namespace ecs {
 
 		void CompArr::SetArraySize(uint32_t numComps)
 		{
-			uint32_t originalNumComps{ GetNumComps() };
-			size_t newVecSize{ static_cast<size_t>(compStepSize) * numComps };
-			// If no reallocation needs to happen, we can simply resize.
-			if (newVecSize <= arrRaw.capacity())
-			{
-				arrRaw.resize(newVecSize);
-				InsertCompArrPtr(originalNumComps, numComps);
-				return;
-			}
+			// Entity pointers are trivially copyable, so their vector can manage its own memory.
+			// Expand to at least twice the requested amount so we don't have to reallocate so often
+			if (static_cast<size_t>(compSize) * numComps > arrRaw.capacity())
+				Reallocate(numComps * 2);
+
+			arrRaw.resize(static_cast<size_t>(compSize) * numComps);
+			entities.resize(numComps);
+		}
+
+		void CompArr::Reserve(uint32_t numComps)
+		{
+			if (static_cast<size_t>(compSize) * numComps > arrRaw.capacity())
+				Reallocate(numComps);
+		}
 
+		void CompArr::Reallocate(uint32_t capacity)
+		{
 			// Make a new vector so we can have valid source and destination memory for the manual move
 			decltype(arrRaw) newVec{};
-			newVec.reserve(newVecSize * 2); // Expand to at least twice the requested amount so we don't have to reallocate so often
-			newVec.resize(newVecSize); // Make the vector know that we're using this amount of memory
+			newVec.reserve(static_cast<size_t>(compSize) * capacity);
+			newVec.resize(arrRaw.size()); // Make the vector know that we're using this amount of memory
 
 			// Move memory contents from arrRaw to the new vector.
 			for (uint32_t index{}, end{ GetNumComps() }; index < end; ++index)
 			{
-				// Set entity pointer
-				SetEntityPtr(index, GetEntity(index), &newVec);
-				// Move the component
-				RawData* srcComp{ GetComp(index) }, *destComp{ newVec.data() + index * compStepSize + ReservedBytes };
+				RawData* srcComp{ GetComp(index) }, *destComp{ newVec.data() + index * compSize };
 				callMoveFunc(srcComp, destComp);
 				callDestructorFunc(srcComp);
 			}
 
 			// Set arrRaw to point to the new memory in the new vector
+			const RawData* prevMemory{ arrRaw.data() };
 			arrRaw = std::move(newVec);
+			entities.reserve(capacity);
+			RegisterCompMemory(prevMemory);
+		}
+
+		void CompArr::RegisterCompMemory(const RawData* prevMemory)
+		{
+			CompMemoryRegistry& registry{ GetCompMemoryRegistry() };
+			std::unique_lock lock{ registry.mutex };
 
-			// Insert the comp arr pointer for each component
-			InsertCompArrPtr(0, numComps);
+			auto findRange{ [&ranges = registry.ranges](const RawData* memory) {
+				return std::lower_bound(ranges.begin(), ranges.end(), memory, [](const CompMemoryRange& range, const RawData* memory) -> bool {
+					return std::less<const RawData*>{}(range.begin, memory);
+				});
+			} };
+
+			// Ranges cover the whole allocation so they never overlap, but only addresses of stored components resolve to this CompArr
+			if (prevMemory)
+				registry.ranges.erase(findRange(prevMemory));
+			registry.ranges.insert(findRange(arrRaw.data()), CompMemoryRange{ arrRaw.data(), arrRaw.data() + arrRaw.capacity(), this });
 		}
 
-		void CompArr::InsertCompArrPtr(uint32_t startIndex, uint32_t endIndex)
+		void CompArr::UnregisterCompMemory()
 		{
-			const CompArr* thisPtr{ this };
-			for (; startIndex < endIndex; ++startIndex)
-				std::memcpy(arrRaw.data() + startIndex * compStepSize, &thisPtr, CompArrPtrSize);
+			CompMemoryRegistry& registry{ GetCompMemoryRegistry() };
+			std::unique_lock lock{ registry.mutex };
+
+			std::erase_if(registry.ranges, [this](const CompMemoryRange& range) -> bool {
+				return range.compArr == this;
+			});
+			++registry.version;
 		}
 
-		void CompArr::SetEntityPtr(uint32_t index, InternalEntityHandle entPtr)
+		bool CompArr::GetIsCompAddrWithin(const void* compAddr) const
+		{
+			const RawData* addr{ static_cast<const RawData*>(compAddr) };
+			return !std::less<const RawData*>{}(addr, arrRaw.data()) && std::less<const RawData*>{}(addr, arrRaw.data() + arrRaw.size());
+		}
+
+		CompArr* CompArr::FindFromCompAddr(const void* compAddr)
+		{
+			CompMemoryRegistry& registry{ GetCompMemoryRegistry() };
+			CompMemoryLookupCache& cache{ compMemoryLookupCache };
+			const RawData* addr{ static_cast<const RawData*>(compAddr) };
+
+			// Common case: the address is a component of one of the CompArrs this thread recently looked up
+			uint32_t version{ registry.version.load(std::memory_order_acquire) };
+			if (cache.version == version)
+				for (CompArr* entry : cache.entries)
+					if (entry && entry->GetIsCompAddrWithin(addr))
+					{
+						++cache.stats.numHits;
+						return entry;
+					}
+			++cache.stats.numMisses;
+
+			std::shared_lock lock{ registry.mutex };
+			auto rangeIter{ std::upper_bound(registry.ranges.begin(), registry.ranges.end(), addr, [](const RawData* addr, const CompMemoryRange& range) -> bool {
+				return std::less<const RawData*>{}(addr, range.begin);
+			}) };
+			// The address may not be within any CompArr's memory, either before the first or past the end of the closest preceding one.
+			// It may also be within a CompArr's memory but past its last component, where there is no entity to map it to.
+			if (rangeIter == registry.ranges.begin() || !std::prev(rangeIter)->Contains(addr))
+				return nullptr;
+			CompArr* compArr{ std::prev(rangeIter)->compArr };
+			if (!compArr->GetIsCompAddrWithin(addr))
+				return nullptr;
+
+			// Cached CompArrs may have been destroyed whenever the version changes
+			version = registry.version.load(std::memory_order_relaxed);
+			if (cache.version != version)
+			{
+				cache.version = version;
+				cache.entries.fill(nullptr);
+			}
+			cache.entries[cache.nextEntry] = compArr;
+			cache.nextEntry = (cache.nextEntry + 1) % CompMemoryLookupCache::NUM_ENTRIES;
+			return compArr;
+		}
+
+		CompArr::LookupStats CompArr::GetLookupStats()
+		{
+			return compMemoryLookupCache.stats;
+		}
+
+		void CompArr::ResetLookupStats()
 		{
-			SetEntityPtr(index, entPtr, &arrRaw);
+			compMemoryLookupCache.stats = LookupStats{};
 		}
 
-		void CompArr::SetEntityPtr(size_t index, InternalEntityHandle entPtr, CompContType* arr)
+		void CompArr::SetEntityPtr(uint32_t index, InternalEntityHandle entPtr)
 		{
-			std::memcpy(arr->data() + index * compStepSize + CompArrPtrSize, &entPtr, EntPtrSize);
+			entities[index] = entPtr;
 		}
 
 		uint32_t CompArr::ExpandArrayForComp(bool isInactive)
@@ -945,19 +1257,45 @@ namespace ecs {
 
 		std::pair<uint32_t, uint32_t> CompArr::ExpandArrayForComp(uint32_t numActiveToAdd, uint32_t numInactiveToAdd)
 		{
-			// Pack initial indexes
-			std::pair<uint32_t, uint32_t> indexes{ GetNumComps(), firstActiveIndex };
-			auto& [activeIndex, inactiveIndex] { indexes };
-			
+			uint32_t numComps{ GetNumComps() };
+			uint32_t inactiveIndex{ firstActiveIndex };
+
 			// Expand array
-			SetArraySize(activeIndex + numActiveToAdd + numInactiveToAdd);
+			SetArraySize(numComps + numActiveToAdd + numInactiveToAdd);
+
+			// New inactive components take the place of the first active components, so move those active components to the back.
+			// Each active component is moved at most once, and only as many as there are in the way.
+			uint32_t numToMove{ std::min(numInactiveToAdd, numComps - firstActiveIndex) };
+			for (uint32_t i{}; i < numToMove; ++i)
+				MoveComp(inactiveIndex + i, numComps + numInactiveToAdd - numToMove + i);
+			numInactive += numInactiveToAdd;
+
+			// New active components go after the moved active components
+			return { numComps + numInactiveToAdd, inactiveIndex };
+		}
 
-			// If there are active components, we need to move them to make space for inactive components
-			if (firstActiveIndex != activeIndex)
-				for (; numInactiveToAdd; --numInactiveToAdd)
-					MoveComp(firstActiveIndex++, activeIndex++);
+		void CompArr::CopyCompIntoRange(const RawData* comp, uint32_t firstIndex, const InternalEntityHandle* entPtrs, uint32_t count)
+		{
+			if (!count)
+				return;
+
+			std::copy(entPtrs, entPtrs + count, entities.begin() + firstIndex);
+
+			RawData* destComp{ GetComp(firstIndex) };
+			if (isTriviallyCopyable)
+			{
+				// Copy once, then keep doubling the copied range so large counts are copied in few big memcpys
+				std::memcpy(destComp, comp, compSize);
+				for (size_t numCopied{ 1 }; numCopied < count; numCopied *= 2)
+					std::memcpy(destComp + numCopied * compSize, destComp, std::min<size_t>(numCopied, count - numCopied) * compSize);
+			}
+			else
+				for (uint32_t i{}; i < count; ++i)
+					callCopyFunc(const_cast<RawData*>(comp), destComp + static_cast<size_t>(i) * compSize);
 
-			return indexes;
+			// Inform components of attach event
+			for (uint32_t i{}; i < count; ++i)
+				CurrentPool::ChangesBuffer().AddComponentCallback(callInformAttachedFunc, entPtrs[i]);
 		}
 
 		void CompArr::MoveComp(uint32_t srcIndex, uint32_t destIndex)
@@ -968,19 +1306,34 @@ namespace ecs {
 			// Destroy the component that is left in the source location.
 			callDestructorFunc(srcComp);
 			// Move the entity key
-			std::memcpy(destComp - EntPtrSize, srcComp - EntPtrSize, EntPtrSize);
+			entities[destIndex] = entities[srcIndex];
 			// Inform the entity of the new index
 			GetEntity(destIndex)->INTERNAL_ChangeCompIndex(compHash, destIndex);
 		}
 
 		InternalEntityHandle CompArr::GetEntity(uint32_t index)
 		{
-			return *reinterpret_cast<InternalEntityHandle*>(arrRaw.data() + index * compStepSize + CompArrPtrSize);
+			return entities[index];
+		}
+
+		uint32_t CompArr::GetCompIndex(const void* compAddr) const
+		{
+			return static_cast<uint32_t>((static_cast<const RawData*>(compAddr) - arrRaw.data()) / compSize);
 		}
 
 		uint32_t CompArr::GetNumComps() const
 		{
-			return static_cast<uint32_t>(arrRaw.size() / compStepSize);
+			return static_cast<uint32_t>(entities.size());
+		}
+
+		uint32_t CompArr::GetFirstActiveIndex() const
+		{
+			return firstActiveIndex;
+		}
+
+		uint32_t CompArr::GetCompStepSize() const
+		{
+			return compSize;
 		}
 
 		bool CompArr::GetIsCompActive(const void* compAddr) const
@@ -995,32 +1348,56 @@ namespace ecs {
 		
 		CompArr::iterator CompArr::begin()
 		{
-			// Iterators have no use of the CompArrPtr.
-			return iterator{ compStepSize, arrRaw.data() + CompArrPtrSize };
+			return iterator{ compSize, arrRaw.data(), entities.data() };
 		}
 		CompArr::const_iterator CompArr::begin() const
 		{
-			return const_iterator{ compStepSize, arrRaw.data() + CompArrPtrSize };
+			return const_iterator{ compSize, arrRaw.data(), entities.data() };
 		}
 		CompArr::iterator CompArr::begin_active()
 		{
-			return iterator{ compStepSize, arrRaw.data() + firstActiveIndex * compStepSize + CompArrPtrSize };
+			return iterator{ compSize, arrRaw.data() + firstActiveIndex * compSize, entities.data() + firstActiveIndex };
 		}
 		CompArr::const_iterator CompArr::begin_active() const
 		{
-			return const_iterator{ compStepSize, arrRaw.data() + firstActiveIndex * compStepSize + CompArrPtrSize };
+			return const_iterator{ compSize, arrRaw.data() + firstActiveIndex * compSize, entities.data() + firstActiveIndex };
 		}
 		CompArr::iterator CompArr::end()
 		{
-			return iterator{ compStepSize, arrRaw.data() + arrRaw.size() + CompArrPtrSize };
+			return iterator{ compSize, arrRaw.data() + arrRaw.size(), entities.data() + entities.size() };
 		}
 		CompArr::const_iterator CompArr::end() const
 		{
-			return const_iterator{ compStepSize, arrRaw.data() + arrRaw.size() + CompArrPtrSize };
+			return const_iterator{ compSize, arrRaw.data() + arrRaw.size(), entities.data() + entities.size() };
 		}
 
 #pragma endregion // CompArr
 
+#pragma region Systems
+
+		bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+		{
+			auto writesAny{ [](const std::vector<CompHash>& writes, const std::vector<CompHash>& types) -> bool {
+				return std::any_of(writes.begin(), writes.end(), [&types](CompHash hash) -> bool {
+					return std::find(types.begin(), types.end(), hash) != types.end();
+				});
+			} };
+
+			return writesAny(writes, other.reads) || writesAny(writes, other.writes) || writesAny(other.writes, reads);
+		}
+
+		const SystemAccess& System_Internal_Base::GetAccess() const
+		{
+			return access;
+		}
+
+		void System_Internal_Base::AllowConcurrentExecution()
+		{
+			access.allowsConcurrency = true;
+		}
+
+#pragma endregion // Systems
+
 #pragma region SystemsManager
 
 		SystemsManager::~SystemsManager()
@@ -1063,15 +1440,92 @@ namespace ecs {
 			layerToSystemsMap.clear();
 		}
 
-		void SystemsManager::RunSystems(int layer)
+		void SystemsManager::RunSystems(int layer, bool allowConcurrency)
 		{
+			auto startTime{ std::chrono::steady_clock::now() };
+			LayerRunStats stats{};
+
+			std::vector<System_Internal_Base*> batch{};
 			for (auto& [_, sysPtr] : GetSystemsMap(layer))
 			{
-				if (!sysPtr->PreRun())
-					continue;
-				sysPtr->Run();
-				sysPtr->PostRun();
+				++stats.numSystems;
+
+				// Systems that allow concurrency are gathered into a batch, until a system that conflicts with the batch is found.
+				// Systems that don't allow concurrency are run by themselves.
+				bool isConcurrent{ allowConcurrency && sysPtr->GetAccess().allowsConcurrency };
+				if (!isConcurrent || std::any_of(batch.begin(), batch.end(), [sysPtr](System_Internal_Base* batchSys) -> bool {
+					return batchSys->GetAccess().ConflictsWith(sysPtr->GetAccess());
+				}))
+					RunSystemsBatch(batch, stats);
+
+				batch.push_back(sysPtr);
+				if (!isConcurrent)
+					RunSystemsBatch(batch, stats);
 			}
+			RunSystemsBatch(batch, stats);
+
+			stats.wallMs = std::chrono::duration<float, std::milli>{ std::chrono::steady_clock::now() - startTime }.count();
+			layerStats[layer] = stats;
+		}
+
+		const SysLayerStatsMapType& SystemsManager::GetLayerStats() const
+		{
+			return layerStats;
+		}
+
+		uint64_t SystemsManager::GetNumBatchesRun() const
+		{
+			return numBatchesRun;
+		}
+
+		void SystemsManager::RunSystemsBatch(std::vector<System_Internal_Base*>& batch, LayerRunStats& stats)
+		{
+			if (batch.empty())
+				return;
+			// Systems may modify components from PreRun() onwards
+			++numBatchesRun;
+
+			// PreRun() and PostRun() may touch shared state, so they are always called on this thread.
+			std::erase_if(batch, [](System_Internal_Base* system) -> bool {
+				return !system->PreRun();
+			});
+			if (batch.empty())
+				return;
+
+			++stats.numBatches;
+			if (batch.size() == 1)
+			{
+				auto startTime{ std::chrono::steady_clock::now() };
+				batch.front()->Run();
+				stats.serialMs += std::chrono::duration<float, std::milli>{ std::chrono::steady_clock::now() - startTime }.count();
+			}
+			else
+			{
+				std::vector<float> runMs(batch.size());
+				std::vector<JobSystem::JobFunc> jobs{};
+				jobs.reserve(batch.size());
+				for (size_t i{}; i < batch.size(); ++i)
+				{
+					batch[i]->INTERNAL_PrepareConcurrentRun();
+					jobs.emplace_back([system = batch[i], &runMs = runMs[i]]() -> void {
+						auto startTime{ std::chrono::steady_clock::now() };
+						system->Run();
+						runMs = std::chrono::duration<float, std::milli>{ std::chrono::steady_clock::now() - startTime }.count();
+					});
+				}
+				ST<JobSystem>::Get()->Dispatch(jobs);
+
+				stats.numConcurrentSystems += static_cast<uint32_t>(batch.size());
+				for (float ms : runMs)
+					stats.serialMs += ms;
+			}
+
+			for (System_Internal_Base* system : batch)
+			{
+				system->INTERNAL_ApplyDeferredChanges();
+				system->PostRun();
+			}
+			batch.clear();
 		}
 
 		SysMapType& SystemsManager::GetSystemsMap(int layer)
@@ -1112,62 +1566,757 @@ namespace ecs {
 
 #pragma endregion // Type Meta
 
+#pragma region Archetypes
+
+		Archetype::Archetype(size_t index, ArchetypeSignature&& signature, CompArrMapType& compArrMap)
+			: index{ index }
+			, signature{ std::move(signature) }
+			, compIndexes(this->signature.size())
+		{
+			compArrs.reserve(this->signature.size());
+			for (CompHash compHash : this->signature)
+				compArrs.push_back(&internal::GetCompArr(compArrMap, compHash));
+		}
+
+		uint32_t Archetype::AddRow(InternalEntityHandle entity)
+		{
+			uint32_t row{ GetNumRows() };
+			entities.push_back(entity);
+			for (std::vector<uint32_t>& column : compIndexes)
+				column.push_back(0);
+			return row;
+		}
+
+		void Archetype::RemoveRow(uint32_t row)
+		{
+			// Move the last row into the removed row's place
+			uint32_t lastRow{ GetNumRows() - 1 };
+			if (row != lastRow)
+			{
+				entities[row] = entities[lastRow];
+				entities[row]->archetypeRow = row;
+				for (std::vector<uint32_t>& column : compIndexes)
+					column[row] = column[lastRow];
+			}
+
+			entities.pop_back();
+			for (std::vector<uint32_t>& column : compIndexes)
+				column.pop_back();
+		}
+
+		uint32_t Archetype::GetColumn(CompHash compHash) const
+		{
+			ArchetypeSignature::const_iterator hashIter{ std::lower_bound(signature.begin(), signature.end(), compHash) };
+			if (hashIter == signature.end() || *hashIter != compHash)
+				return NO_COLUMN;
+			return static_cast<uint32_t>(hashIter - signature.begin());
+		}
+
+		bool Archetype::GetColumns(const CompHash* compHashes, uint32_t* outColumns, size_t count) const
+		{
+			for (size_t i{}; i < count; ++i)
+				if ((outColumns[i] = GetColumn(compHashes[i])) == NO_COLUMN)
+					return false;
+			return true;
+		}
+
+		uint32_t Archetype::GetCompIndex(uint32_t column, uint32_t row) const
+		{
+			return compIndexes[column][row];
+		}
+
+		void Archetype::SetCompIndex(uint32_t column, uint32_t row, uint32_t compIndex)
+		{
+			compIndexes[column][row] = compIndex;
+		}
+
+		CompArr& Archetype::GetCompArr(uint32_t column) const
+		{
+			return *compArrs[column];
+		}
+
+		InternalEntityHandle Archetype::GetEntity(uint32_t row) const
+		{
+			return entities[row];
+		}
+
+		uint32_t Archetype::GetNumRows() const
+		{
+			return static_cast<uint32_t>(entities.size());
+		}
+
+		const ArchetypeSignature& Archetype::GetSignature() const
+		{
+			return signature;
+		}
+
+		size_t Archetype::GetIndex() const
+		{
+			return index;
+		}
+
+		namespace {
+
+			/*****************************************************************//*!
+			\brief
+				Gets a new archetype generation that has never been returned before.
+			\return
+				The new generation.
+			*//******************************************************************/
+			size_t GetNextArchetypeGeneration()
+			{
+				static std::atomic<size_t> nextGeneration{ 1 };
+				return nextGeneration.fetch_add(1, std::memory_order_relaxed);
+			}
+
+		}
+
+		ArchetypeManager::ArchetypeManager(CompArrMapType& compArrMap)
+			: compArrMap{ compArrMap }
+			, generation{ GetNextArchetypeGeneration() }
+		{
+		}
+
+		void ArchetypeManager::OnCompAttached(InternalEntityHandle entity, CompHash compHash, uint32_t compIndex)
+		{
+			Archetype* src{ entity->archetype };
+			ArchetypeEdgeMapType& edges{ (src ? src->addEdges : rootEdges) };
+
+			// Follow the cached edge if we've made this transition before
+			Archetype* dest{};
+			ArchetypeEdgeMapType::iterator edgeIter{ edges.find(compHash) };
+			if (edgeIter != edges.end())
+				dest = edgeIter->second;
+			else
+			{
+				ArchetypeSignature signature{ (src ? src->signature : ArchetypeSignature{}) };
+				signature.insert(std::lower_bound(signature.begin(), signature.end(), compHash), compHash);
+				dest = FindOrCreate(std::move(signature));
+
+				edges.emplace(compHash, dest);
+				if (src)
+					dest->removeEdges.emplace(compHash, src);
+			}
+
+			MoveEntity(entity, dest, compHash, compIndex);
+		}
+
+		void ArchetypeManager::OnCompDetached(InternalEntityHandle entity, CompHash compHash)
+		{
+			Archetype* src{ entity->archetype };
+			if (!src || src->GetColumn(compHash) == Archetype::NO_COLUMN)
+				return;
+
+			// If this is the last component, the entity no longer belongs to any archetype
+			Archetype* dest{};
+			if (src->signature.size() > 1)
+			{
+				ArchetypeEdgeMapType::iterator edgeIter{ src->removeEdges.find(compHash) };
+				if (edgeIter != src->removeEdges.end())
+					dest = edgeIter->second;
+				else
+				{
+					ArchetypeSignature signature{ src->signature };
+					signature.erase(std::lower_bound(signature.begin(), signature.end(), compHash));
+					dest = FindOrCreate(std::move(signature));
+
+					src->removeEdges.emplace(compHash, dest);
+					dest->addEdges.emplace(compHash, src);
+				}
+			}
+
+			MoveEntity(entity, dest, compHash, 0);
+		}
+
+		void ArchetypeManager::OnCompIndexChanged(InternalEntityHandle entity, CompHash compHash, uint32_t compIndex)
+		{
+			Archetype* archetype{ entity->archetype };
+			if (!archetype)
+				return;
+
+			uint32_t column{ archetype->GetColumn(compHash) };
+			if (column != Archetype::NO_COLUMN)
+				archetype->SetCompIndex(column, entity->archetypeRow, compIndex);
+		}
+
+		void ArchetypeManager::OnEntityErased(InternalEntityHandle entity)
+		{
+			if (!entity->archetype)
+				return;
+
+			entity->archetype->RemoveRow(entity->archetypeRow);
+			entity->archetype = nullptr;
+			entity->archetypeRow = 0;
+		}
+
+		Archetype& ArchetypeManager::GetOrCreateArchetype(const ArchetypeSignature& signature)
+		{
+			ArchetypeMapType::iterator archetypeIter{ signatureToArchetype.find(signature) };
+			if (archetypeIter != signatureToArchetype.end())
+				return *archetypeIter->second;
+			return *FindOrCreate(ArchetypeSignature{ signature });
+		}
+
+		void ArchetypeManager::AddEntity(InternalEntityHandle entity, Archetype& archetype, const uint32_t* compIndexes)
+		{
+			assert(!entity->archetype);
+
+			uint32_t row{ archetype.AddRow(entity) };
+			for (size_t column{}; column < archetype.compIndexes.size(); ++column)
+				archetype.compIndexes[column][row] = compIndexes[column];
+
+			entity->archetype = &archetype;
+			entity->archetypeRow = row;
+		}
+
+		size_t ArchetypeManager::GetNumArchetypes() const
+		{
+			return archetypes.size();
+		}
+
+		Archetype& ArchetypeManager::GetArchetype(size_t index)
+		{
+			return *archetypes[index];
+		}
+
+		size_t ArchetypeManager::GetGeneration() const
+		{
+			return generation;
+		}
+
+		void ArchetypeManager::Clear()
+		{
+			rootEdges.clear();
+			signatureToArchetype.clear();
+			archetypes.clear();
+			generation = GetNextArchetypeGeneration();
+		}
+
+		Archetype* ArchetypeManager::FindOrCreate(ArchetypeSignature&& signature)
+		{
+			ArchetypeMapType::iterator archetypeIter{ signatureToArchetype.find(signature) };
+			if (archetypeIter != signatureToArchetype.end())
+				return archetypeIter->second;
+
+			std::unique_ptr<Archetype>& archetype{ archetypes.emplace_back(std::make_unique<Archetype>(archetypes.size(), std::move(signature), compArrMap)) };
+			signatureToArchetype.emplace(archetype->GetSignature(), archetype.get());
+			return archetype.get();
+		}
+
+		void ArchetypeManager::MoveEntity(InternalEntityHandle entity, Archetype* dest, CompHash newCompHash, uint32_t newCompIndex)
+		{
+			Archetype* src{ entity->archetype };
+			uint32_t srcRow{ entity->archetypeRow };
+			uint32_t destRow{};
+
+			if (dest)
+			{
+				destRow = dest->AddRow(entity);
+
+				// Both signatures are sorted, so the source column of each shared component type can be found by walking forward
+				for (uint32_t destColumn{}, srcColumn{}, numColumns{ static_cast<uint32_t>(dest->signature.size()) }; destColumn < numColumns; ++destColumn)
+				{
+					CompHash compHash{ dest->signature[destColumn] };
+					if (compHash == newCompHash)
+					{
+						dest->compIndexes[destColumn][destRow] = newCompIndex;
+						continue;
+					}
+
+					while (src->signature[srcColumn] != compHash)
+						++srcColumn;
+					dest->compIndexes[destColumn][destRow] = src->compIndexes[srcColumn][srcRow];
+				}
+			}
+
+			if (src)
+				src->RemoveRow(srcRow);
+
+			entity->archetype = dest;
+			entity->archetypeRow = destRow;
+		}
+
+#pragma endregion // Archetypes
+
+#pragma region Entity Templates
+
+		EntityTemplate::EntityTemplate(InternalEntityHandle root, bool recursive)
+		{
+			std::vector<InternalEntityHandle> entities{};
+			AddNode(root, NO_PARENT, recursive, entities);
+
+			// Only copy fully attached components, same as cloning
+			std::vector<SrcComp> srcComps{};
+			for (uint32_t node{}; node < static_cast<uint32_t>(entities.size()); ++node)
+				for (const auto& [compHash, compIndex] : entities[node]->components)
+					if (!(compIndex & Entity_Internal::COMP_STATUS_ANY))
+					{
+						const CompArr& srcCompArr{ GetCompArr(compHash) };
+						srcComps.push_back(SrcComp{ node, &srcCompArr, srcCompArr.GetComp(compIndex), !srcCompArr.GetIsCompActive(compIndex) });
+					}
+
+			CompileComps(srcComps);
+		}
+
+		EntityTemplate::EntityTemplate(const CompArr* const* compTypes, const RawData* const* comps, size_t numComps)
+		{
+			// A single unparented entity with a default transform
+			const Transform defaultTransform{};
+			nodes.push_back(Node{ NO_PARENT, defaultTransform.GetWorldPosition(), defaultTransform.GetWorldScale(), defaultTransform.GetWorldRotation(), defaultTransform.GetZPos() });
+
+			std::vector<SrcComp> srcComps{};
+			srcComps.reserve(numComps);
+			for (size_t i{}; i < numComps; ++i)
+				srcComps.push_back(SrcComp{ 0, compTypes[i], comps[i], false });
+
+			CompileComps(srcComps);
+		}
+
+		void EntityTemplate::CompileComps(const std::vector<SrcComp>& srcComps)
+		{
+			// Sort the components into columns by type, remembering where each component is to be copied from
+			std::unordered_map<CompHash, uint32_t> typeToColumn{};
+			std::vector<std::vector<const RawData*>> columnSrcComps{};
+			for (const SrcComp& srcComp : srcComps)
+			{
+				const CompArr& srcCompArr{ *srcComp.compType };
+				auto [columnIter, isNewColumn]{ typeToColumn.try_emplace(srcCompArr.compHash, static_cast<uint32_t>(columns.size())) };
+				if (isNewColumn)
+				{
+					columns.push_back(Column{ std::make_unique<CompArr>(srcCompArr.compHash, srcCompArr.compSize, srcCompArr.isTriviallyCopyable,
+						srcCompArr.callCopyFunc, srcCompArr.callMoveFunc, srcCompArr.callDestructorFunc,
+						srcCompArr.trueInformAttachedFunc, srcCompArr.trueInformDetachedFunc,
+						srcCompArr.trueInformAttachedFunc, srcCompArr.trueInformDetachedFunc), {}, 0 });
+					columnSrcComps.emplace_back();
+				}
+
+				columns[columnIter->second].slots.push_back(CompSlot{ srcComp.node, 0, srcComp.isInactive });
+				columnSrcComps[columnIter->second].push_back(srcComp.comp);
+			}
+
+			// Lay out the prototypes, aligning each as the allocator aligns CompArr memory
+			constexpr size_t alignment{ __STDCPP_DEFAULT_NEW_ALIGNMENT__ };
+			size_t numBytes{};
+			for (Column& column : columns)
+				for (CompSlot& slot : column.slots)
+				{
+					slot.prototypeOffset = numBytes;
+					numBytes += (column.compType->compSize + alignment - 1) / alignment * alignment;
+				}
+
+			// Copy the prototypes. The vector must not reallocate after this, as components may not be safe to move with memcpy.
+			prototypes.resize(numBytes);
+			for (size_t columnIndex{}; columnIndex < columns.size(); ++columnIndex)
+			{
+				Column& column{ columns[columnIndex] };
+				for (size_t slotIndex{}; slotIndex < column.slots.size(); ++slotIndex)
+					column.compType->callCopyFunc(const_cast<RawData*>(columnSrcComps[columnIndex][slotIndex]), prototypes.data() + column.slots[slotIndex].prototypeOffset);
+
+				// Inactive components first, so that each column's inactive and active components can be reserved as 2 ranges
+				column.numInactive = static_cast<uint32_t>(std::stable_partition(column.slots.begin(), column.slots.end(), [](const CompSlot& slot) -> bool {
+					return slot.isInactive;
+				}) - column.slots.begin());
+			}
+
+			// Work out the archetype signature of each entity, and where each of its components are within the columns
+			for (uint32_t columnIndex{}; columnIndex < static_cast<uint32_t>(columns.size()); ++columnIndex)
+				for (uint32_t slotIndex{}; slotIndex < static_cast<uint32_t>(columns[columnIndex].slots.size()); ++slotIndex)
+					nodes[columns[columnIndex].slots[slotIndex].node].compSlots.emplace_back(columnIndex, slotIndex);
+			for (Node& node : nodes)
+			{
+				std::sort(node.compSlots.begin(), node.compSlots.end(), [this](const std::pair<uint32_t, uint32_t>& a, const std::pair<uint32_t, uint32_t>& b) -> bool {
+					return columns[a.first].compType->GetCompHash() < columns[b.first].compType->GetCompHash();
+				});
+				for (const auto& [columnIndex, _] : node.compSlots)
+					node.signature.push_back(columns[columnIndex].compType->GetCompHash());
+			}
+		}
+
+		EntityTemplate::~EntityTemplate()
+		{
+			for (Column& column : columns)
+				for (const CompSlot& slot : column.slots)
+					column.compType->callDestructorFunc(prototypes.data() + slot.prototypeOffset);
+		}
+
+		uint32_t EntityTemplate::GetNumNodes() const
+		{
+			return static_cast<uint32_t>(nodes.size());
+		}
+
+		uint32_t EntityTemplate::GetParentNode(uint32_t node) const
+		{
+			return nodes[node].parent;
+		}
+
+		void EntityTemplate::ApplyTransform(uint32_t node, Transform& transform) const
+		{
+			const Node& nodeData{ nodes[node] };
+			if (nodeData.parent == NO_PARENT)
+				transform.SetWorld(nodeData.posZ, nodeData.position, nodeData.scale, nodeData.rotation);
+			else
+				transform.SetLocal(nodeData.posZ, nodeData.position, nodeData.scale, nodeData.rotation);
+		}
+
+		void EntityTemplate::InstantiateComps(const InternalEntityHandle* entities, uint32_t count) const
+		{
+			if (!count)
+				return;
+
+			// Reserve space for all copies of each column at once, then copy the prototypes in
+			CompArrMapType& compArrMap{ CurrentPool::Comps() };
+			std::vector<std::vector<uint32_t>> slotFirstIndexes(columns.size());
+			for (size_t columnIndex{}; columnIndex < columns.size(); ++columnIndex)
+			{
+				const Column& column{ columns[columnIndex] };
+				CompArr& compArr{ GetCompArr(compArrMap, *column.compType) };
+				uint32_t numSlots{ static_cast<uint32_t>(column.slots.size()) };
+				auto [activeIndex, inactiveIndex] { compArr.ExpandArrayForComp((numSlots - column.numInactive) * count, column.numInactive * count) };
+
+				slotFirstIndexes[columnIndex].reserve(numSlots);
+				for (const CompSlot& slot : column.slots)
+				{
+					uint32_t& firstIndex{ (slot.isInactive ? inactiveIndex : activeIndex) };
+					compArr.CopyCompIntoRange(prototypes.data() + slot.prototypeOffset, firstIndex, entities + static_cast<size_t>(slot.node) * count, count);
+					slotFirstIndexes[columnIndex].push_back(firstIndex);
+					firstIndex += count;
+				}
+			}
+
+			// Register the components to each entity, and put each entity straight into its final archetype
+			ArchetypeManager* archetypes{ CurrentPool::Archetypes() };
+			std::vector<uint32_t> compIndexes{};
+			for (uint32_t nodeIndex{}; nodeIndex < static_cast<uint32_t>(nodes.size()); ++nodeIndex)
+			{
+				const Node& node{ nodes[nodeIndex] };
+				Archetype* archetype{ (archetypes && !node.signature.empty() ? &archetypes->GetOrCreateArchetype(node.signature) : nullptr) };
+				compIndexes.resize(node.compSlots.size());
+
+				for (uint32_t i{}; i < count; ++i)
+				{
+					InternalEntityHandle entity{ entities[static_cast<size_t>(nodeIndex) * count + i] };
+					entity->components.reserve(node.compSlots.size());
+					for (size_t comp{}; comp < node.compSlots.size(); ++comp)
+					{
+						const auto& [columnIndex, slotIndex] { node.compSlots[comp] };
+						compIndexes[comp] = slotFirstIndexes[columnIndex][slotIndex] + i;
+						entity->components.emplace(node.signature[comp], compIndexes[comp]);
+					}
+
+					if (archetype)
+						archetypes->AddEntity(entity, *archetype, compIndexes.data());
+				}
+			}
+		}
+
+		bool EntityTemplate::GetInstanceEntities(InternalEntityHandle root, std::vector<InternalEntityHandle>& outEntities) const
+		{
+			// Walk the hierarchy in the same order that it was compiled in, checking each entity against its node along the way
+			outEntities.clear();
+			std::vector<std::pair<InternalEntityHandle, uint32_t>> toVisit{ { root, NO_PARENT } };
+			while (!toVisit.empty())
+			{
+				auto [entity, parent] { toVisit.back() };
+				toVisit.pop_back();
+
+				uint32_t nodeIndex{ static_cast<uint32_t>(outEntities.size()) };
+				if (nodeIndex >= nodes.size() || nodes[nodeIndex].parent != parent || entity->INTERNAL_GetIsMarkedForDeletion())
+					return false;
+
+				const Node& node{ nodes[nodeIndex] };
+				if (entity->components.size() != node.signature.size())
+					return false;
+				for (CompHash compHash : node.signature)
+				{
+					auto compIter{ entity->components.find(compHash) };
+					if (compIter == entity->components.end() || (compIter->second & Entity_Internal::COMP_STATUS_ANY))
+						return false;
+				}
+				outEntities.push_back(entity);
+
+				// Push children in reverse so that they're visited in order
+				const auto& children{ entity->transform.GetChildren() };
+				for (auto childIter{ children.rbegin() }; childIter != children.rend(); ++childIter)
+					toVisit.emplace_back(reinterpret_cast<InternalEntityHandle>((*childIter)->GetEntity()), nodeIndex);
+			}
+			return outEntities.size() == nodes.size();
+		}
+
+		void EntityTemplate::DetachInstanceComps(const InternalEntityHandle* entities) const
+		{
+			for (const Column& column : columns)
+			{
+				CompArr& compArr{ GetCompArr(column.compType->GetCompHash()) };
+				for (const CompSlot& slot : column.slots)
+					compArr.callInformDetachedFunc(entities[slot.node]);
+			}
+		}
+
+		void EntityTemplate::ResetInstanceComps(const InternalEntityHandle* entities) const
+		{
+			CompChangesBuffer& changesBuffer{ CurrentPool::ChangesBuffer() };
+			for (const Column& column : columns)
+			{
+				CompHash compHash{ column.compType->GetCompHash() };
+				CompArr& compArr{ GetCompArr(compHash) };
+				for (const CompSlot& slot : column.slots)
+				{
+					InternalEntityHandle entity{ entities[slot.node] };
+
+					// Replace the component with a copy of the prototype. The component stays at its index, so the entity's archetype is unaffected.
+					RawData* comp{ compArr.GetComp(entity->components.at(compHash)) };
+					compArr.callDestructorFunc(comp);
+					compArr.callCopyFunc(const_cast<RawData*>(prototypes.data() + slot.prototypeOffset), comp);
+
+					// Applied now so that the instance can be used as soon as it's revived. Parked instances are entirely inactive, and reactivating
+					// a component only swaps it with another inactive component, so active components aren't moved while they may be iterated over.
+					uint32_t compIndex{ entity->components.at(compHash) };
+					if (compArr.GetIsCompActive(compIndex) == slot.isInactive)
+						compArr.SetCompActiveness(compIndex, slot.isInactive);
+					changesBuffer.AddComponentCallback(compArr.callInformAttachedFunc, entity);
+				}
+			}
+		}
+
+		void EntityTemplate::AddNode(InternalEntityHandle entity, uint32_t parent, bool recursive, std::vector<InternalEntityHandle>& outEntities)
+		{
+			uint32_t node{ static_cast<uint32_t>(nodes.size()) };
+			const Transform& transform{ entity->transform };
+			if (parent == NO_PARENT)
+				nodes.push_back(Node{ parent, transform.GetWorldPosition(), transform.GetWorldScale(), transform.GetWorldRotation(), transform.GetZPos() });
+			else
+				nodes.push_back(Node{ parent, transform.GetLocalPosition(), transform.GetLocalScale(), transform.GetLocalRotation(), transform.GetZPos() });
+			outEntities.push_back(entity);
+
+			if (recursive)
+				for (Transform* childTransform : entity->transform.GetChildren())
+					AddNode(reinterpret_cast<InternalEntityHandle>(childTransform->GetEntity()), node, recursive, outEntities);
+		}
+
+#pragma endregion // Entity Templates
+
 #pragma region Pools
 
-		EntityMapWrapper::EntityMapWrapper(EntMapType& entities, ValidEntHandleSetType& validEntityHandles)
+		EntitySlotMap::EntitySlotMap()
+			: freeHead{ INVALID_INDEX }
+			, freeTail{ INVALID_INDEX }
+		{
+		}
+
+		EntitySlotMap::~EntitySlotMap()
+		{
+			Clear();
+		}
+
+		InternalEntityHandle EntitySlotMap::Get(EntityHash hash)
+		{
+			uint32_t index{ static_cast<uint32_t>(hash) };
+			if (index >= pages.size() * SLOTS_PER_PAGE)
+				return nullptr;
+
+			Slot& slot{ GetSlot(index) };
+			if (slot.denseIndex == INVALID_INDEX || MakeHash(index, slot.generation) != hash)
+				return nullptr;
+			return reinterpret_cast<InternalEntityHandle>(slot.storage);
+		}
+
+		bool EntitySlotMap::Erase(EntityHash hash)
+		{
+			InternalEntityHandle entity{ Get(hash) };
+			if (!entity)
+				return false;
+
+			uint32_t index{ static_cast<uint32_t>(hash) };
+			Slot& slot{ GetSlot(index) };
+
+			// Swap the last alive entity into the erased entity's place
+			InternalEntityHandle lastEntity{ aliveEntities.back() };
+			aliveEntities[slot.denseIndex] = lastEntity;
+			GetSlot(static_cast<uint32_t>(lastEntity->INTERNAL_GetMapKey())).denseIndex = slot.denseIndex;
+			aliveEntities.pop_back();
+
+			entity->~Entity_Internal();
+
+			// Invalidate hashes to this slot. Generation 0 is skipped so that no hash is ever 0.
+			if (++slot.generation == 0)
+				slot.generation = 1;
+
+			// Append to the free list
+			slot.denseIndex = INVALID_INDEX;
+			slot.nextFree = INVALID_INDEX;
+			if (freeTail == INVALID_INDEX)
+				freeHead = index;
+			else
+				GetSlot(freeTail).nextFree = index;
+			freeTail = index;
+			return true;
+		}
+
+		void EntitySlotMap::Clear()
+		{
+			// Erasing from the back avoids moving entities around within aliveEntities
+			while (!aliveEntities.empty())
+				Erase(aliveEntities.back()->INTERNAL_GetMapKey());
+		}
+
+		bool EntitySlotMap::Contains(ConstInternalEntityHandle handle) const
+		{
+			// Pages are aligned to their size, so masking the handle gives the start of the page it would be within
+			uintptr_t address{ reinterpret_cast<uintptr_t>(handle) };
+			auto pageIter{ pageIndexes.find(address & ~(PAGE_BYTES - 1)) };
+			if (pageIter == pageIndexes.end())
+				return false;
+
+			// The handle must point to the start of a slot within the page
+			uintptr_t offset{ address & (PAGE_BYTES - 1) };
+			if (offset >= SLOTS_PER_PAGE * sizeof(Slot) || offset % sizeof(Slot))
+				return false;
+
+			return pages[pageIter->second][offset / sizeof(Slot)].denseIndex != INVALID_INDEX;
+		}
+
+		bool EntitySlotMap::Contains(ConstInternalEntityHandle handle, EntityHash hash) const
+		{
+			uint32_t index{ static_cast<uint32_t>(hash) };
+			if (index >= pages.size() * SLOTS_PER_PAGE)
+				return false;
+
+			const Slot& slot{ GetSlot(index) };
+			return slot.denseIndex != INVALID_INDEX && MakeHash(index, slot.generation) == hash
+				&& reinterpret_cast<ConstInternalEntityHandle>(slot.storage) == handle;
+		}
+
+		size_t EntitySlotMap::size() const
+		{
+			return aliveEntities.size();
+		}
+
+		EntitySlotMap::iterator EntitySlotMap::begin()
+		{
+			return aliveEntities.begin();
+		}
+
+		EntitySlotMap::iterator EntitySlotMap::end()
+		{
+			return aliveEntities.end();
+		}
+
+		void EntitySlotMap::PageDeleter::operator()(Slot* page) const
+		{
+			::operator delete(page, std::align_val_t{ PAGE_BYTES });
+		}
+
+		EntitySlotMap::Slot& EntitySlotMap::GetSlot(uint32_t index)
+		{
+			return pages[index / SLOTS_PER_PAGE][index % SLOTS_PER_PAGE];
+		}
+
+		const EntitySlotMap::Slot& EntitySlotMap::GetSlot(uint32_t index) const
+		{
+			return pages[index / SLOTS_PER_PAGE][index % SLOTS_PER_PAGE];
+		}
+
+		void EntitySlotMap::Reserve(size_t numEntities)
+		{
+			// Every slot that isn't holding an alive entity is within the free list
+			size_t numRequiredSlots{ aliveEntities.size() + numEntities };
+			while (pages.size() * SLOTS_PER_PAGE < numRequiredSlots)
+				AllocatePage();
+			aliveEntities.reserve(numRequiredSlots);
+		}
+
+		uint32_t EntitySlotMap::AcquireSlot()
+		{
+			if (freeHead == INVALID_INDEX)
+				AllocatePage();
+
+			// Pop the oldest free slot
+			uint32_t index{ freeHead };
+			freeHead = GetSlot(index).nextFree;
+			if (freeHead == INVALID_INDEX)
+				freeTail = INVALID_INDEX;
+			return index;
+		}
+
+		void EntitySlotMap::AllocatePage()
+		{
+			uint32_t pageIndex{ static_cast<uint32_t>(pages.size()) };
+			// Slots are trivial, so the page's memory is used as an array of slots directly
+			pages.emplace_back(static_cast<Slot*>(::operator new(PAGE_BYTES, std::align_val_t{ PAGE_BYTES })));
+			Slot* page{ pages.back().get() };
+			for (uint32_t i{}; i < SLOTS_PER_PAGE; ++i)
+			{
+				page[i].generation = 1;
+				page[i].denseIndex = INVALID_INDEX;
+				page[i].nextFree = (i + 1 < SLOTS_PER_PAGE ? pageIndex * SLOTS_PER_PAGE + i + 1 : INVALID_INDEX);
+			}
+
+			// Append the new slots to the back of the free list, so that older free slots are still reused first
+			uint32_t firstIndex{ pageIndex * SLOTS_PER_PAGE };
+			if (freeTail == INVALID_INDEX)
+				freeHead = firstIndex;
+			else
+				GetSlot(freeTail).nextFree = firstIndex;
+			freeTail = firstIndex + SLOTS_PER_PAGE - 1;
+
+			pageIndexes.emplace(reinterpret_cast<uintptr_t>(page), pageIndex);
+		}
+
+		EntityHash EntitySlotMap::MakeHash(uint32_t index, uint32_t generation)
+		{
+			return (static_cast<EntityHash>(generation) << 32) | index;
+		}
+
+		EntityMapWrapper::EntityMapWrapper(EntMapType& entities, ArchetypeManager* archetypes)
 			: entities{ entities }
-			, validEntityHandles{ validEntityHandles }
+			, archetypes{ archetypes }
 		{
 		}
 
 		InternalEntityHandle EntityMapWrapper::CreateEntity(InternalEntityHandle parent)
 		{
-			// Get an unused entity hash as key
-			EntityHash key{ GetUnusedEntityHash(entities) };
-			// Place into container and return a pointer to the entity
-			std::pair<EntMapType::iterator, bool> emplaceResult{ (parent ? entities.try_emplace(key, key, parent) : entities.emplace(key, key)) };
-			// Update the list of valid entity handles
-			validEntityHandles.insert(&emplaceResult.first->second);
-			return &emplaceResult.first->second;
+			InternalEntityHandle entity{ entities.Emplace(parent) };
+			// Let the entity keep its archetype updated
+			entity->INTERNAL_SetArchetypeManager(archetypes);
+			return entity;
 		}
 
 		InternalEntityHandle EntityMapWrapper::CreateEntity(Transform& transformCopy)
 		{
-			// Get an unused entity hash as key
-			EntityHash key{ GetUnusedEntityHash(entities) };
-			// Place into container and return a pointer to the entity
-			std::pair<EntMapType::iterator, bool> emplaceResult{ entities.try_emplace(key, key, transformCopy) };
-			// Update the list of valid entity handles
-			validEntityHandles.insert(&emplaceResult.first->second);
-			return &emplaceResult.first->second;
+			InternalEntityHandle entity{ entities.Emplace(transformCopy) };
+			// Let the entity keep its archetype updated
+			entity->INTERNAL_SetArchetypeManager(archetypes);
+			return entity;
+		}
+
+		void EntityMapWrapper::Reserve(size_t numEntities)
+		{
+			entities.Reserve(numEntities);
 		}
 
 		InternalEntityHandle EntityMapWrapper::GetEntity(EntityHash hash)
 		{
-			auto entityIter{ entities.find(hash) };
-			if (entityIter == entities.end())
-				return nullptr;
-			return &entityIter->second;
+			return entities.Get(hash);
 		}
 
 		void EntityMapWrapper::EraseEntity(EntityHash hash)
 		{
-			auto entityIter{ entities.find(hash) };
-			if (entityIter == entities.end())
-				return;
-			validEntityHandles.erase(&entityIter->second);
-			entities.erase(entityIter);
+			entities.Erase(hash);
 		}
 
 		void EntityMapWrapper::ClearAll()
 		{
-			validEntityHandles.clear();
-			entities.clear();
+			entities.Clear();
 		}
 
 		bool EntityMapWrapper::CheckValidHandle(InternalEntityHandle handle)
 		{
-			return validEntityHandles.find(handle) != validEntityHandles.end();
+			return entities.Contains(handle);
+		}
+
+		bool EntityMapWrapper::CheckValidHandle(InternalEntityHandle handle, EntityHash hash)
+		{
+			return entities.Contains(handle, hash);
 		}
 
 #pragma endregion // Pools
@@ -1176,37 +2325,22 @@ namespace ecs {
 
 		InternalEntityHandle GetEntityFromCompAddr(void* compAddr)
 		{
-			return *reinterpret_cast<InternalEntityHandle*>(
-				reinterpret_cast<RawData*>(compAddr) - CompArr::EntPtrSize
-			);
+			CompArr* compArr{ CompArr::FindFromCompAddr(compAddr) };
+			return (compArr ? compArr->GetEntity(compArr->GetCompIndex(compAddr)) : nullptr);
 		}
 		ConstInternalEntityHandle GetEntityFromCompAddr(const void* compAddr)
 		{
-			return *reinterpret_cast<ConstInternalEntityHandle const*>(
-				reinterpret_cast<const RawData*>(compAddr) - CompArr::EntPtrSize
-			);
+			CompArr* compArr{ CompArr::FindFromCompAddr(compAddr) };
+			return (compArr ? compArr->GetEntity(compArr->GetCompIndex(compAddr)) : nullptr);
 		}
 
 		CompArr* GetCompArrFromCompAddr(void* compAddr)
 		{
-			return *reinterpret_cast<CompArr**>(
-				reinterpret_cast<RawData*>(compAddr) - internal::CompArr::EntPtrSize - internal::CompArr::CompArrPtrSize
-			);
+			return CompArr::FindFromCompAddr(compAddr);
 		}
 		const CompArr* GetCompArrFromCompAddr(const void* compAddr)
 		{
-			return *reinterpret_cast<const CompArr* const*>(
-				reinterpret_cast<const RawData*>(compAddr) - internal::CompArr::EntPtrSize - internal::CompArr::CompArrPtrSize
-			);
-		}
-
-		EntityHash GetUnusedEntityHash(const EntMapType& entityPool)
-		{
-			// Get an unused key
-			EntityHash key{ util::Rand_UID() };
-			while (entityPool.find(key) != entityPool.end())
-				key = util::Rand_UID();
-			return key;
+			return CompArr::FindFromCompAddr(compAddr);
 		}
 
 }
@@ -33,6 +33,7 @@ All rights reserved.
 #include <array>
 #include <iterator>
 #include <memory>
+#include <bit>
 
 #include "Transform.h"
 
@@ -46,9 +47,16 @@ namespace ecs {
 		class CompArr;
 		class System_Internal_Base;
 		class SystemsManager;
+		struct LayerRunStats;
 		struct CompTypeMeta;
 		struct SysTypeMeta;
 		class TypeMetaManager;
+		class Archetype;
+		class ArchetypeManager;
+		class EntityTemplate;
+		template <typename... Args>
+		class Query_Internal;
+		class EntitySlotMap;
 		class ECSPool;
 	}
 
@@ -64,6 +72,7 @@ namespace ecs {
 		// A const version of a handle to an entity's internal data
 		using ConstInternalEntityHandle = const internal::Entity_Internal*;
 		// The hash type of an entity hash
+		//   The lower 32 bits are the entity's slot index, and the upper 32 bits are the slot's generation.
 		using EntityHash = size_t;
 
 		// The handle to a system
@@ -82,28 +91,34 @@ namespace ecs {
 		using CompContType = std::vector<RawData>;
 		// The map type storing component arrays
 		using CompArrMapType = std::unordered_map<CompHash, internal::CompArr>;
-		// The map type storing entity hashes to entities
-		using EntMapType = std::unordered_map<EntityHash, internal::Entity_Internal>;
-		// The set type storing valid entity handles
-		using ValidEntHandleSetType = std::unordered_set<InternalEntityHandle>;
+		// The container type storing entities, addressable by entity hash
+		using EntMapType = internal::EntitySlotMap;
 		// The container type that entities use to store components that are attached to them.
 		//   ComponentTypeHash -> Indexes in CompArrs
 		using EntCompMapType = std::unordered_map<CompHash, uint32_t>;
-		// The set type storing components' indexes to be removed for a particular component type
-		template <typename T>
-		using CompIndexSetType = std::set<T>;
-		// The container type storing components' indexes to be removed
-		//   ComponentTypeHash -> Set of indexes to be removed
-		using ModifyCompSetType = std::unordered_map<EntityHash, CompIndexSetType<CompModifyTask>>;
+		// The container type storing tasks to modify components of a particular component type
+		using CompModifyTaskContType = std::vector<CompModifyTask>;
+		// The container type storing tasks to modify components
+		//   ComponentTypeHash -> Tasks to modify components of that type
+		using ModifyCompSetType = std::unordered_map<CompHash, CompModifyTaskContType>;
 		// The container type storing entities to be removed
 		using RemoveEntContType = std::vector<InternalEntityHandle>;
 
+		// The container type identifying an archetype, storing the sorted hashes of the component types in the archetype
+		using ArchetypeSignature = std::vector<CompHash>;
+		// The map type storing archetype signatures to archetypes
+		using ArchetypeMapType = std::map<ArchetypeSignature, internal::Archetype*>;
+		// The map type storing archetype graph edges, which link to the archetype that results from adding/removing a component type
+		using ArchetypeEdgeMapType = std::unordered_map<CompHash, internal::Archetype*>;
+
 		// The map type storing systems
 		using SysMapType = std::unordered_map<SysHash, internal::System_Internal_Base*>;
 		// The map type storing layer to systems
 		using SysLayerMapType = std::map<int, SysMapType>;
 		// The map type storing systems hashes to the layer that they are in
 		using SysHashToLayerMapType = std::unordered_map<SysHash, int>;
+		// The map type storing layer to the statistics of the last time the layer was run
+		using SysLayerStatsMapType = std::map<int, LayerRunStats>;
 
 
 		// The map type storing component types
@@ -178,6 +193,12 @@ namespace ecs {
 			// Disallow simple copying of entities.
 			Entity_Internal(const Entity_Internal&) = delete;
 
+			/*****************************************************************//*!
+			\brief
+				Destructor. Removes this entity from the archetype that it is in, if any.
+			*//******************************************************************/
+			~Entity_Internal();
+
 			/* INTERNAL */
 		public:
 			/*****************************************************************//*!
@@ -262,6 +283,22 @@ namespace ecs {
 			*//******************************************************************/
 			bool INTERNAL_GetIsMarkedForDeletion() const;
 
+			/*****************************************************************//*!
+			\brief
+				Sets whether this entity is part of a parked instance, which handles outside the ECS should treat as deleted.
+			\param isParked
+				Whether this entity is parked.
+			*//******************************************************************/
+			void INTERNAL_SetIsParked(bool isParked);
+
+			/*****************************************************************//*!
+			\brief
+				Checks if this entity is part of a parked instance.
+			\return
+				True if this entity is parked. False otherwise.
+			*//******************************************************************/
+			bool INTERNAL_GetIsParked() const;
+
 			/*****************************************************************//*!
 			\brief
 				For shutdown purposes: Marks all components of this entity as pending removal.
@@ -321,6 +358,15 @@ namespace ecs {
 				return offsetof(Entity_Internal, transform);
 			}
 
+			/*****************************************************************//*!
+			\brief
+				Sets the archetype manager that tracks which archetype this entity is in.
+				Must be called before any components are attached to this entity.
+			\param manager
+				The archetype manager of the pool that this entity is in. nullptr if the pool does not track archetypes.
+			*//******************************************************************/
+			void INTERNAL_SetArchetypeManager(ArchetypeManager* manager);
+
 		protected:
 			/*****************************************************************//*!
 			\brief
@@ -347,6 +393,26 @@ namespace ecs {
 			*//******************************************************************/
 			bool CheckCanRemoveComp(CompHash compHash, EntCompMapType::iterator& outCompIndexIter);
 
+			/*****************************************************************//*!
+			\brief
+				Registers a component to this entity's components map.
+				If the component is fully attached (no status flags), the archetype manager is informed.
+			\param compHash
+				The component type.
+			\param index
+				The index of the component within the compArr, including status flags.
+			*//******************************************************************/
+			void RegisterComp(CompHash compHash, uint32_t index);
+
+			/*****************************************************************//*!
+			\brief
+				Unregisters a component from this entity's components map.
+				If the component was fully attached (not pending addition), the archetype manager is informed.
+			\param compIter
+				An iterator to the component entry within this entity's components map.
+			*//******************************************************************/
+			void UnregisterComp(EntCompMapType::iterator compIter);
+
 		public:
 			//! Bitflag to test if a component is pending addition.
 			static constexpr uint32_t COMP_STATUS_TO_ADD{ 0x80000000 }; // Last bit of 32bits
@@ -368,9 +434,25 @@ namespace ecs {
 			//! Whether this entity is marked for deletion
 			bool isMarkedForDeletion;
 
+			//! Whether this entity is part of a parked instance
+			bool isParked;
+
 			//! The transform of this entity.
 			Transform transform;
 
+			//! The archetype manager of the pool this entity is in. nullptr if the pool does not track archetypes.
+			ArchetypeManager* archetypeManager;
+			//! The archetype this entity is currently in. nullptr if this entity has no fully attached components.
+			Archetype* archetype;
+			//! The row of this entity within its archetype.
+			uint32_t archetypeRow;
+
+			friend class Archetype;
+			friend class ArchetypeManager;
+			friend class EntityTemplate;
+			template <typename... Args>
+			friend class Query_Internal;
+
 
 			/* ITERATOR SUPPORT */
 		public:
@@ -639,6 +721,9 @@ namespace ecs {
 			Instead of storing component indexes, we store the entities that have the
 			component that needs to be modified, because the CompArr could change component
 			indexes while we're iterating through the modify tasks.
+
+			Multiple tasks may be queued for the same component. They are resolved when flushed:
+			removal overrides activeness changes, otherwise the last activeness change is applied.
 		*//******************************************************************/
 		class CompModifyTask
 		{
@@ -688,7 +773,7 @@ namespace ecs {
 			\param other
 				The other task.
 			\return
-				True if this task's index is smaller than the other task. False otherwise.
+				True if this task's entity is ordered before the other task's entity. False otherwise.
 			*//******************************************************************/
 			bool operator<(const CompModifyTask& other) const;
 
@@ -699,6 +784,54 @@ namespace ecs {
 			TYPE type;
 		};
 
+		/*****************************************************************//*!
+		\class CompChangesShard
+		\brief
+			Records structural changes requested from a chunk of a ParallelSystem, which may be on a worker thread.
+			Shards are applied on the main thread in chunk order once all chunks complete, so the resulting
+			CompChangesBuffer contents do not depend on the number of threads or on how chunks were scheduled.
+		*//******************************************************************/
+		class CompChangesShard
+		{
+		public:
+			/*****************************************************************//*!
+			\brief
+				Records a change to be applied later.
+			\param change
+				The function that makes the change.
+			*//******************************************************************/
+			void Defer(std::function<void()>&& change);
+
+			/*****************************************************************//*!
+			\brief
+				Applies all recorded changes in the order they were recorded, and clears this shard.
+			*//******************************************************************/
+			void Apply();
+
+			/*****************************************************************//*!
+			\brief
+				Gets the shard that changes requested on this thread are recorded into.
+			\return
+				The active shard of this thread. nullptr if changes should be applied immediately.
+			*//******************************************************************/
+			static CompChangesShard* GetActive();
+
+			/*****************************************************************//*!
+			\brief
+				Sets the shard that changes requested on this thread are recorded into.
+			\param shard
+				The shard to record into. nullptr if changes should be applied immediately.
+			*//******************************************************************/
+			static void SetActive(CompChangesShard* shard);
+
+		private:
+			//! The recorded changes.
+			std::vector<std::function<void()>> changes;
+
+			//! The active shard of each thread.
+			static thread_local CompChangesShard* activeShard;
+		};
+
 		/*****************************************************************//*!
 		\class CompChangesBuffer
 		\brief
@@ -783,6 +916,16 @@ namespace ecs {
 			*//******************************************************************/
 			void DeleteEntity(InternalEntityHandle entity);
 
+			/*****************************************************************//*!
+			\brief
+				Buffers the deletion of multiple entities, reserving space for all of their removal tasks at once.
+			\param entities
+				The entities to be deleted. Each entity must not already be marked for deletion, and must appear only once.
+			\param numEntities
+				The number of entities.
+			*//******************************************************************/
+			void DeleteEntities(const InternalEntityHandle* entities, size_t numEntities);
+
 			/*****************************************************************//*!
 			\brief
 				Buffers a component callback.
@@ -815,16 +958,36 @@ namespace ecs {
 		private:
 			/*****************************************************************//*!
 			\brief
-				Gets the set that stores the indexes of the components to be removed for a component type from compsToModify.
-				Creates it if it doesn't exist yet.
+				Queues a task to modify a component.
+			\param compType
+				The component type's hash.
+			\param task
+				The task.
+			*//******************************************************************/
+			void AddModifyTask(CompHash compType, CompModifyTask&& task);
+
+			/*****************************************************************//*!
+			\brief
+				Resolves and applies the queued tasks to modify components of a component type.
+				Activeness changes are applied first, then all removals are applied in a single batch.
+			\param compType
+				The component type's hash.
 			*//******************************************************************/
-			CompIndexSetType<CompModifyTask>& GetModifySet(CompHash compType);
+			void FlushModifyTasks(CompHash compType);
 			
 		private:
 			//! A map of component type hashes to compArrs that store components buffered for addition into ECSPool.
 			CompArrMapType compsToAdd;
-			//! A map of component type hashes to sets of index that store the indexes of components buffered for removal from ECSPool.
+			//! A map of component type hashes to tasks to modify components of that type.
+			//! Emptied containers are kept so that their memory is reused.
 			ModifyCompSetType compsToModify;
+			//! The component types that have queued tasks in compsToModify, in the order that they were first queued.
+			std::vector<CompHash> compTypesToModify;
+			//! Reused memory for the component types and tasks being flushed.
+			std::vector<CompHash> flushingCompTypes;
+			CompModifyTaskContType flushingTasks;
+			//! Reused memory for the indexes of components being removed.
+			std::vector<uint32_t> removalIndexes;
 			//! A vector containing handles to entities to be removed.
 			RemoveEntContType entitiesToRemove;
 
@@ -839,6 +1002,8 @@ namespace ecs {
 		\brief
 			This class holds the memory of all components of a single type, and pointers to
 			the entities that each component is attached to.
+			Components and entity pointers are stored in separate parallel arrays, so that loops
+			over only components or only entities don't pull the other through the cache.
 		*//******************************************************************/
 		class CompArr
 		{
@@ -851,6 +1016,8 @@ namespace ecs {
 				The component type hash.
 			\param compSize
 				The size of the component in bytes.
+			\param isTriviallyCopyable
+				Whether the component type is trivially copyable, allowing copies to be made with memcpy.
 			\param copyFunc
 				The method that copies a component.
 			\param moveFunc
@@ -868,7 +1035,7 @@ namespace ecs {
 				The method that always informs a component that it was attached to an entity.
 				Used for cloning a CompArr.
 			*//******************************************************************/
-			CompArr(CompHash compHash, uint32_t compSize, CompCopySig copyFunc, CompMoveSig moveFunc, CompDestroySig destroyFunc,
+			CompArr(CompHash compHash, uint32_t compSize, bool isTriviallyCopyable, CompCopySig copyFunc, CompMoveSig moveFunc, CompDestroySig destroyFunc,
 				CompInformAttachedSig informAttachedFunc, CompInformDetachedSig informDetachedFunc,
 				CompInformAttachedSig trueInformAttachedFunc, CompInformDetachedSig trueInformDetachedFunc);
 
@@ -923,6 +1090,17 @@ namespace ecs {
 			*//******************************************************************/
 			void RemoveComp(uint32_t index, bool informOwnerEntity = true);
 
+			/*****************************************************************//*!
+			\brief
+				Destroys and removes multiple components from this CompArr, then compacts this CompArr in a single pass.
+				Holes are filled by moving the last alive components of the same activeness into them, and the array is resized once.
+			\param indexes
+				The indexes of the components in this CompArr to be destroyed. Must be unique. This will be sorted.
+			\param informOwnerEntity
+				Whether to tell the entities that own the components of the removal.
+			*//******************************************************************/
+			void RemoveComps(std::vector<uint32_t>& indexes, bool informOwnerEntity = true);
+
 			/*****************************************************************//*!
 			\brief
 				Clone a component from this CompArr into specified CompArr, marking the specified entity as the owner of the clone.
@@ -1027,6 +1205,15 @@ namespace ecs {
 			*//******************************************************************/
 			uint32_t GetNumComps() const;
 
+			/*****************************************************************//*!
+			\brief
+				Allocates memory for at least the specified number of components, so that adding components
+				up to that number does not move existing components. Does nothing if enough memory is already allocated.
+			\param numComps
+				The total number of components to allocate memory for.
+			*//******************************************************************/
+			void Reserve(uint32_t numComps);
+
 			/*****************************************************************//*!
 			\brief
 				Gets whether a component stored at a certain address within this CompArr
@@ -1049,6 +1236,81 @@ namespace ecs {
 			*//******************************************************************/
 			bool GetIsCompActive(uint32_t index) const;
 
+			/*****************************************************************//*!
+			\brief
+				Gets the index of the first active component. Active components span from this index to the end of this CompArr.
+			\return
+				The index of the first active component.
+			*//******************************************************************/
+			uint32_t GetFirstActiveIndex() const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the number of bytes between consecutive components within this CompArr.
+			\return
+				The number of bytes between consecutive components.
+			*//******************************************************************/
+			uint32_t GetCompStepSize() const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the entity owner of a comonent in this CompArr at the specified index.
+			\param index
+				The index of the component within this CompArr.
+			\return
+				The entity that owns the specified component.
+			*//******************************************************************/
+			InternalEntityHandle GetEntity(uint32_t index);
+
+			/*****************************************************************//*!
+			\brief
+				Gets the index of a component within this CompArr from the component's address.
+			\param compAddr
+				The address of a component stored within this CompArr.
+			\return
+				The index of the component.
+			*//******************************************************************/
+			uint32_t GetCompIndex(const void* compAddr) const;
+
+			/*****************************************************************//*!
+			\brief
+				Finds the CompArr storing a component at the specified address.
+				The last few CompArrs found are cached per thread, so repeated lookups into the same CompArrs
+				are a constant time bounds check against each cached CompArr that doesn't lock.
+			\param compAddr
+				The address of a component.
+			\return
+				The CompArr storing the component. nullptr if the address is not that of any CompArr's stored component.
+			*//******************************************************************/
+			static CompArr* FindFromCompAddr(const void* compAddr);
+
+			/*****************************************************************//*!
+			\struct LookupStats
+			\brief
+				Counts how FindFromCompAddr() lookups on a thread were resolved.
+			*//******************************************************************/
+			struct LookupStats
+			{
+				//! The number of lookups resolved by the thread's cache.
+				size_t numHits;
+				//! The number of lookups that searched the registry of all CompArrs.
+				size_t numMisses;
+			};
+
+			/*****************************************************************//*!
+			\brief
+				Gets how FindFromCompAddr() lookups on the calling thread were resolved since the last reset.
+			\return
+				The lookup statistics of the calling thread.
+			*//******************************************************************/
+			static LookupStats GetLookupStats();
+
+			/*****************************************************************//*!
+			\brief
+				Resets the FindFromCompAddr() lookup statistics of the calling thread.
+			*//******************************************************************/
+			static void ResetLookupStats();
+
 		private:
 			/*****************************************************************//*!
 			\brief
@@ -1063,36 +1325,46 @@ namespace ecs {
 
 			/*****************************************************************//*!
 			\brief
-				Inserts the pointer to this CompArr within the array starting from startIndex
-				and ending 1 before endIndex.
-			\param startIndex
-				The starting index.
-			\param endIndex
-				1 past the end index.
+				Moves all components into newly allocated memory that fits the specified number of components,
+				via calling the move constructor.
+			\param capacity
+				The number of components that the new memory fits.
 			*//******************************************************************/
-			void InsertCompArrPtr(uint32_t startIndex, uint32_t endIndex);
+			void Reallocate(uint32_t capacity);
 
 			/*****************************************************************//*!
 			\brief
-				Resets the entity owner of a component at the specified index to the specified entity.
-			\param index
-				The index of the component within this CompArr whose entity owner is to be reset.
-			\param entPtr
-				The entity that will own the specified component.
+				Records where this CompArr's component memory is, so component addresses can be mapped back to this CompArr.
+			\param prevMemory
+				The component memory that was previously recorded for this CompArr, or nullptr if there was none.
 			*//******************************************************************/
-			void SetEntityPtr(uint32_t index, InternalEntityHandle entPtr);
+			void RegisterCompMemory(const RawData* prevMemory);
+
+			/*****************************************************************//*!
+			\brief
+				Forgets this CompArr's component memory.
+			*//******************************************************************/
+			void UnregisterCompMemory();
+
+			/*****************************************************************//*!
+			\brief
+				Checks whether an address lies within the components currently stored within this CompArr.
+			\param compAddr
+				The address to check.
+			\return
+				True if the address is within this CompArr's components. False otherwise.
+			*//******************************************************************/
+			bool GetIsCompAddrWithin(const void* compAddr) const;
 
 			/*****************************************************************//*!
 			\brief
-				Resets the entity owner of a component at the specified index of the specified vector to the specified entity.
+				Resets the entity owner of a component at the specified index to the specified entity.
 			\param index
-				The index within the vector where the entity pointer is at.
+				The index of the component within this CompArr whose entity owner is to be reset.
 			\param entPtr
 				The entity that will own the specified component.
-			\param arr
-				The vector storing the entity pointers and components.
 			*//******************************************************************/
-			void SetEntityPtr(size_t index, InternalEntityHandle entPtr, CompContType* arr);
+			void SetEntityPtr(uint32_t index, InternalEntityHandle entPtr);
 
 			/*****************************************************************//*!
 			\brief
@@ -1118,6 +1390,21 @@ namespace ecs {
 			*//******************************************************************/
 			std::pair<uint32_t, uint32_t> ExpandArrayForComp(uint32_t numActiveToAdd, uint32_t numInactiveToAdd);
 
+			/*****************************************************************//*!
+			\brief
+				Copies a component into a range of already allocated indexes, one copy for each entity owner.
+				Trivially copyable components are copied with memcpy. Entities are not informed of the addition.
+			\param comp
+				The component to copy.
+			\param firstIndex
+				The first index of the range.
+			\param entPtrs
+				The entity owner of each copy.
+			\param count
+				The number of copies.
+			*//******************************************************************/
+			void CopyCompIntoRange(const RawData* comp, uint32_t firstIndex, const InternalEntityHandle* entPtrs, uint32_t count);
+
 			/*****************************************************************//*!
 			\brief
 				Moves a component and its entity pointer to a destination index.
@@ -1128,40 +1415,23 @@ namespace ecs {
 			*//******************************************************************/
 			void MoveComp(uint32_t srcIndex, uint32_t destIndex);
 
-			/*****************************************************************//*!
-			\brief
-				Gets the entity owner of a comonent in this CompArr at the specified index.
-			\param index
-				The index of the component within this CompArr.
-			\return
-				The entity that owns the specified component.
-			*//******************************************************************/
-			InternalEntityHandle GetEntity(uint32_t index);
-
-		public:
-			//! The number of bytes of the pointer that points to the entity owner of each component.
-			static constexpr uint32_t EntPtrSize{ sizeof(InternalEntityHandle) };
-			//! The number of bytes of the pointer that points to this CompArr.
-			static constexpr uint32_t CompArrPtrSize{ sizeof(CompArr*) };
-
-			//! The number of bytes reserved before component data for each component.
-			static constexpr uint32_t ReservedBytes{ CompArrPtrSize + EntPtrSize };
-
 		private:
-			// Components are stored packed together with each element as:
-			// 8bytes CompArrPtr + 8bytes EntityPtr + ?bytes Component
+			// Components are stored tightly packed within arrRaw, and the entity owning the component at
+			// an index is stored at the same index within entities.
+			// Since a component's size is a multiple of its alignment, every component stays aligned as long as
+			// the array itself is, which the default allocator guarantees up to __STDCPP_DEFAULT_NEW_ALIGNMENT__.
 			// Inactive components are placed to the left, active to the right.
 
-			//! The container that stores all components and entity owner pointers, with the format:
-			//! 8bytes CompArrPtr + 8bytes EntityPtr + ?bytes Component
+			//! The container that stores all components.
 			CompContType arrRaw;
+			//! The entity owner of each component, parallel to arrRaw.
+			std::vector<InternalEntityHandle> entities;
 			//! The hash of the component type that this CompArr stores.
 			const CompHash compHash;
-			//! The number of bytes of each component.
+			//! The number of bytes of each component, which is also the number of bytes to jump by along arrRaw to get to the next component.
 			const uint32_t compSize;
-			//! The number of bytes to jump by along arrRaw to get to the next component.
-			//! Equal to CompArrPtrSize + EntPtrSize + compSize
-			const uint32_t compStepSize;
+			//! Whether the component type is trivially copyable.
+			const bool isTriviallyCopyable;
 
 			//! A count of the number of inactive components stored within this CompArr.
 			uint32_t numInactive;
@@ -1187,6 +1457,7 @@ namespace ecs {
 			//! Temporary space to store component data while doing shuffling operations.
 			const std::unique_ptr<RawData[]> tempCompSpace;
 
+			friend class EntityTemplate;
 
 			/* ITERATOR SUPPORT */
 		public:
@@ -1216,10 +1487,12 @@ namespace ecs {
 					Constructs an iterator to the CompArr.
 				\param compStepSize
 					The number of bytes to step over to increment/decrement to the next/previous component.
-				\param ptrToCompBaseLoc
-					A pointer to the memory location of the entity that owns the component.
+				\param ptrToComp
+					A pointer to the memory location of the component.
+				\param ptrToEntity
+					A pointer to the memory location of the pointer to the entity that owns the component.
 				*//******************************************************************/
-				iterator_blueprint(uint32_t compStepSize, pointer ptrToCompBaseLoc);
+				iterator_blueprint(uint32_t compStepSize, pointer ptrToComp, const InternalEntityHandle* ptrToEntity);
 
 				/*****************************************************************//*!
 				\brief
@@ -1356,8 +1629,10 @@ namespace ecs {
 					const iterator_blueprint<CompType_T, EntityHandleType_T, ValueType_T>& b);
 
 			private:
-				//! The pointer to the entity that owns the component that we're pointing to.
+				//! The pointer to the component that we're pointing to.
 				pointer ptr;
+				//! The pointer to the pointer to the entity that owns the component that we're pointing to.
+				const InternalEntityHandle* entityPtr;
 				//! The number of bytes to offset the pointer to get to the next/previous component.
 				uint32_t compStepSize;
 			};
@@ -1442,12 +1717,14 @@ namespace ecs {
 
 			/*****************************************************************//*!
 			\brief
-				Creates an iterator to 1 past the last component in this CompArr with a simplified template parameter options list.
+				Creates an iterator to the specified component in this CompArr with a simplified template parameter options list.
+			\param compAddr
+				The address of a component stored within this CompArr.
 			\return
-				An iterator to 1 past the last component in this CompArr.
+				An iterator to the specified component in this CompArr.
 			*//******************************************************************/
 			template <typename CompType, typename EntityHandleType>
-			iterator_blueprint<CompType, EntityHandleType> User_Custom(InternalEntityHandle entityHandle);
+			iterator_blueprint<CompType, EntityHandleType> User_Custom(const void* compAddr);
 
 		};
 
@@ -1462,6 +1739,34 @@ namespace ecs {
 
 #pragma region Systems
 
+		/*****************************************************************//*!
+		\struct SystemAccess
+		\brief
+			Declares which types a system reads and writes while running, and whether the system may run concurrently
+			with other systems in the same layer that it doesn't conflict with.
+			Any type may be declared, not only component types, so shared state such as Transform can be declared too.
+		*//******************************************************************/
+		struct SystemAccess
+		{
+			//! The types that the system only reads.
+			std::vector<CompHash> reads;
+			//! The types that the system writes.
+			std::vector<CompHash> writes;
+			//! Whether the system may run concurrently with other systems. The system must not make structural changes
+			//! to ecs (e.g. adding/removing components) or touch undeclared shared state within Run() when this is set.
+			bool allowsConcurrency{ false };
+
+			/*****************************************************************//*!
+			\brief
+				Checks whether running a system with this access concurrently with a system with another access would cause a data race.
+			\param other
+				The other system's access.
+			\return
+				True if either system writes a type that the other system reads or writes. False otherwise.
+			*//******************************************************************/
+			bool ConflictsWith(const SystemAccess& other) const;
+		};
+
 		/*****************************************************************//*!
 		\class System_Internal_Base
 		\brief
@@ -1512,13 +1817,64 @@ namespace ecs {
 			*//******************************************************************/
 			virtual void PostRun() {}
 
+			/*****************************************************************//*!
+			\brief
+				Called by ECS on the main thread before Run() is called on a worker thread, to prepare any state that
+				Run() would otherwise lazily create in shared containers.
+			*//******************************************************************/
+			virtual void INTERNAL_PrepareConcurrentRun() {}
+
+			/*****************************************************************//*!
+			\brief
+				Called by ECS on the main thread after Run(), to apply structural changes that Run() deferred
+				while executing on worker threads.
+			*//******************************************************************/
+			virtual void INTERNAL_ApplyDeferredChanges() {}
+
+			/*****************************************************************//*!
+			\brief
+				Gets the types that this system reads and writes, and whether this system may run concurrently with other systems.
+			\return
+				The access of this system.
+			*//******************************************************************/
+			const SystemAccess& GetAccess() const;
+
 		protected:
+			/*****************************************************************//*!
+			\brief
+				Declares types that this system reads in addition to its required components.
+			\tparam Types
+				The types that are read.
+			*//******************************************************************/
+			template <typename... Types>
+			void DeclareReads();
+
+			/*****************************************************************//*!
+			\brief
+				Declares types that this system writes in addition to its required components.
+			\tparam Types
+				The types that are written.
+			*//******************************************************************/
+			template <typename... Types>
+			void DeclareWrites();
+
+			/*****************************************************************//*!
+			\brief
+				Allows this system to run concurrently with other systems in the same layer that it doesn't conflict with.
+				Only call this if this system does not make structural changes to ecs and all shared state it touches is declared.
+			*//******************************************************************/
+			void AllowConcurrentExecution();
+
 			/*****************************************************************//*!
 			\brief
 				Dummy function that does nothing. This is for compatibility with System_Internal's constructor, where
 				in the case of a System requiring no components, this is used to satisfy the constructor's parameters.
 			*//******************************************************************/
 			void DummyFunc() {};
+
+		private:
+			//! The types that this system reads and writes.
+			SystemAccess access;
 		};
 
 		/*****************************************************************//*!
@@ -1576,6 +1932,13 @@ namespace ecs {
 			*//******************************************************************/
 			virtual void Run() override;
 
+			/*****************************************************************//*!
+			\brief
+				Ensures the CompArrs of the required components exist and the cached query is up to date,
+				so that Run() only reads shared ecs containers.
+			*//******************************************************************/
+			virtual void INTERNAL_PrepareConcurrentRun() override;
+
 		protected:
 			/*****************************************************************//*!
 			\brief
@@ -1587,6 +1950,22 @@ namespace ecs {
 				requires std::is_same_v<Predicate, std::nullptr_t> || std::predicate<Predicate, internal::InternalEntityHandle>
 			void RunOnCompArr(CompArr& compArr, Predicate pred = nullptr);
 
+			/*****************************************************************//*!
+			\brief
+				Executes this system on each entity matched by this system's cached query.
+				Entities are visited in the same order and with the same requirements as RunOnCompArr(), but the other
+				components are fetched through each entity's archetype index columns, so no per-entity map lookups are done.
+			\param pred
+				An optional predicate that filters which entities are processed.
+			\return
+				True if the system was executed. False if the current pool doesn't track archetypes.
+			*//******************************************************************/
+			template <typename Predicate = std::nullptr_t>
+				requires std::is_same_v<Predicate, std::nullptr_t> || std::predicate<Predicate, internal::InternalEntityHandle>
+			bool RunOnQuery(Predicate pred = nullptr);
+
+		protected:
+
 			/*****************************************************************//*!
 			\brief
 				This function exists for optimization, where it only does a map lookup within the specified entity for
@@ -1608,223 +1987,1260 @@ namespace ecs {
 			//! The user-defined system's function that processes 1 component set.
 			const std::function<void(System_Internal*, Args&...)> callProcessEntity;
 
+			//! The cached query of entities that have the components this system requires.
+			Query_Internal<Args...> query;
+
 		};
 
 		/*****************************************************************//*!
-		\class SystemsManager
+		\class ParallelSystem_Internal
 		\brief
-			This class stores various systems defined by the user and separates them into layers, for simplier management of systems.
-
-			// TODO: It might make sense to have systems be stored all in one place,
-			// then each SystemsManager in each ECSPool points to the systems,
-			// so we have the option to share systems between ECSPools.
+			A System_Internal that splits the active range of a CompArr into chunks and processes the chunks on the JobSystem.
+			The user function may be called on multiple threads at once, so it must only touch the components passed to it
+			(and other components of the same entity), and state that is read-only while this system runs.
+			Structural changes must be requested through ecs::DeferChange(), which records them into the shard of the
+			current chunk. Shards are applied in chunk order on the main thread after Run().
+		\tparam SysType
+			The system type.
+		\tparam Args
+			The components that the system requires before it processes the entity's components.
 		*//******************************************************************/
-		class SystemsManager
+		template <typename SysType, typename... Args>
+		class ParallelSystem_Internal : public System_Internal<SysType, Args...>
 		{
 		public:
+			//! The default minimum number of components within each chunk.
+			static constexpr uint32_t DEFAULT_MIN_CHUNK_SIZE{ 256 };
+
 			/*****************************************************************//*!
 			\brief
-				Destructor. Cleans up and deletes leftover systems.
+				Constructor. Refer to System_Internal's constructor.
+			\tparam ReturnType
+				The return type of the value returned by the user-defined member function.
+			\tparam ClassType
+				The class type of the user-defined member function.
+			\param memberFunc
+				The user-defined member function that will be called per entity to be processed.
+			\param minChunkSize
+				The minimum number of components within each chunk. This is rounded up so that each chunk spans whole cache lines.
 			*//******************************************************************/
-			~SystemsManager();
+			template <typename ReturnType = void, typename ClassType = System_Internal_Base>
+			ParallelSystem_Internal(ReturnType(ClassType::* memberFunc)(Args&...), uint32_t minChunkSize = DEFAULT_MIN_CHUNK_SIZE);
 
 			/*****************************************************************//*!
 			\brief
-				Adds a user-defined system into a layer within this SystemManager.
-			\tparam SysType
-				The type of the user-defined system.
-			\param layer
-				The layer to add the user-defined system into.
-			\param system
-				The system object to be added into this SystemManager.
-				As this object will be moved into this SystemManager, it is not safe to use the system object after this function call.
-			\return
-				A handle to the added system object.
+				Called by ECS to executes the system on each entity whose components meet the system's requirements.
+				Processes the CompArr with the least components in chunks across the JobSystem.
+			*//******************************************************************/
+			virtual void Run() override;
+
+			/*****************************************************************//*!
+			\brief
+				Applies structural changes deferred by each chunk, in chunk order.
+			*//******************************************************************/
+			virtual void INTERNAL_ApplyDeferredChanges() override;
+
+		protected:
+			/*****************************************************************//*!
+			\brief
+				Executes this system on each entity that has a component in the provided array, splitting the array into chunks
+				that are processed on the JobSystem. Returns once all chunks have completed.
+			\param compArr
+				The component array to execute on.
+			\param pred
+				An optional predicate that filters which entities are processed. This may be called on multiple threads at once.
+			*//******************************************************************/
+			template <typename Predicate = std::nullptr_t>
+				requires std::is_same_v<Predicate, std::nullptr_t> || std::predicate<Predicate, internal::InternalEntityHandle>
+			void RunOnCompArr(CompArr& compArr, Predicate pred = nullptr);
+
+		private:
+			/*****************************************************************//*!
+			\brief
+				Gets the number of components within each chunk of a CompArr, such that each chunk spans a whole number of cache lines.
+			\param compArr
+				The component array to be split into chunks.
+			\return
+				The number of components within each chunk.
+			*//******************************************************************/
+			uint32_t GetChunkSize(const CompArr& compArr) const;
+
+		private:
+			//! The minimum number of components within each chunk.
+			uint32_t minChunkSize;
+			//! The structural changes deferred by each chunk of the last run.
+			std::vector<CompChangesShard> shards;
+		};
+
+		/*****************************************************************//*!
+		\struct LayerRunStats
+		\brief
+			Statistics about how the systems within a layer ran.
+		*//******************************************************************/
+		struct LayerRunStats
+		{
+			//! The total time that each system's Run() took, as if the systems were run one after another, in milliseconds.
+			float serialMs;
+			//! The time that running the whole layer took, in milliseconds.
+			float wallMs;
+			//! The number of systems in the layer.
+			uint32_t numSystems;
+			//! The number of systems that ran concurrently with other systems.
+			uint32_t numConcurrentSystems;
+			//! The number of batches that the systems were run in.
+			uint32_t numBatches;
+		};
+
+		/*****************************************************************//*!
+		\class SystemsManager
+		\brief
+			This class stores various systems defined by the user and separates them into layers, for simplier management of systems.
+
+			// TODO: It might make sense to have systems be stored all in one place,
+			// then each SystemsManager in each ECSPool points to the systems,
+			// so we have the option to share systems between ECSPools.
+		*//******************************************************************/
+		class SystemsManager
+		{
+		public:
+			/*****************************************************************//*!
+			\brief
+				Destructor. Cleans up and deletes leftover systems.
+			*//******************************************************************/
+			~SystemsManager();
+
+			/*****************************************************************//*!
+			\brief
+				Adds a user-defined system into a layer within this SystemManager.
+			\tparam SysType
+				The type of the user-defined system.
+			\param layer
+				The layer to add the user-defined system into.
+			\param system
+				The system object to be added into this SystemManager.
+				As this object will be moved into this SystemManager, it is not safe to use the system object after this function call.
+			\return
+				A handle to the added system object.
+			*//******************************************************************/
+			template <typename SysType>
+			InternalGenericSysHandle<SysType> AddSystem(int layer, SysType&& system);
+
+			/*****************************************************************//*!
+			\brief
+				Gets a handle to the requested system that is stored within this SystemManager.
+				This operation is slightly expensive, so try not to call this unless required.
+			\tparam SysType
+				The type of the requested system.
+			\return
+				A handle to the requested system object.
+				nullptr if the system does not exist within this SystemManager.
+			*//******************************************************************/
+			template <typename SysType>
+			InternalGenericSysHandle<SysType> GetSystem();
+
+			/*****************************************************************//*!
+			\brief
+				Gets all systems stored within this SystemManager.
+				This operation is quite expensive, so try not to call this unless required.
+			\return
+				A container of pointers to all systems.
+			*//******************************************************************/
+			std::vector<InternalGenericSysHandle<System_Internal_Base>> GetAllSystems();
+
+			/*****************************************************************//*!
+			\brief
+				Removes and deletes a system from this SystemManager.
+			\tparam SysType
+				The type of the system to remove.
+			\return
+				True if the system was successfully removed. False otherwise.
+			*//******************************************************************/
+			template <typename SysType>
+			bool RemoveSystem();
+
+			/*****************************************************************//*!
+			\brief
+				Removes and deletes all systems within a layer in this SystemManager.
+			*//******************************************************************/
+			void RemoveSystemsInLayer(int layer);
+
+			/*****************************************************************//*!
+			\brief
+				Removes and deletes all systems stored in this SystemManager.
+			*//******************************************************************/
+			void RemoveAllSystems();
+
+			/*****************************************************************//*!
+			\brief
+				Run all systems stored within a layer in this SystemManager. The order of systems
+				within a layer is unspecified.
+				Systems that allow concurrency are gathered into batches of systems that don't conflict with each other,
+				and the Run() of each system in a batch is executed concurrently.
+			\param layer
+				Systems within this layer will be run.
+			\param allowConcurrency
+				Whether systems may run concurrently. If false, systems are run one after another on this thread.
+			*//******************************************************************/
+			void RunSystems(int layer, bool allowConcurrency);
+
+			/*****************************************************************//*!
+			\brief
+				Gets statistics about how systems within each layer ran the last time the layer was run.
+			\return
+				The map of layer to statistics.
+			*//******************************************************************/
+			const SysLayerStatsMapType& GetLayerStats() const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the number of batches of systems that have been run by this SystemsManager.
+			\return
+				The number of batches run.
+			*//******************************************************************/
+			uint64_t GetNumBatchesRun() const;
+
+		private:
+			/*****************************************************************//*!
+			\brief
+				Runs a batch of systems, calling PreRun() and PostRun() on this thread and Run() concurrently.
+			\param batch
+				The systems to run. Systems whose PreRun() return false are removed from this container.
+			\param stats
+				The statistics to add the batch's run times to.
+			*//******************************************************************/
+			void RunSystemsBatch(std::vector<System_Internal_Base*>& batch, LayerRunStats& stats);
+
+			/*****************************************************************//*!
+			\brief
+				Gets the map container that stores all system objects in the specified layer.
+			\param layer
+				The layer that the map to be retrieved is in.
+			\return
+				The map container that stores all system objects in the specified layer.
+			*//******************************************************************/
+			SysMapType& GetSystemsMap(int layer);
+
+		private:
+			//! The map container that maps layer to maps, each of which maps system type hash to system objects.
+			SysLayerMapType layerToSystemsMap;
+			//! The map container that maps system type hash to the layer that the system is in.
+			//! This exists to speed up GetSystem() queries, so we don't have to linearly search all layers for the requested system.
+			SysHashToLayerMapType hashToLayerMap;
+			//! The statistics of the last time each layer was run.
+			SysLayerStatsMapType layerStats;
+			//! The number of batches of systems that have been run.
+			uint64_t numBatchesRun{};
+		};
+
+#pragma endregion // Systems
+
+#pragma region Type Meta
+
+		/*****************************************************************//*!
+		\class CompTypeMeta
+		\brief
+			This class stores information about a component type and some useful things about it.
+		*//******************************************************************/
+		struct CompTypeMeta
+		{
+		public:
+			//! The component type hash of the component that this metadata describes.
+			CompHash hash;
+			//! The component's type as a string.
+			std::string name;
+		};
+
+		/*****************************************************************//*!
+		\class SysTypeMeta
+		\brief
+			This class stores information about a system type and some useful things about it.
+		*//******************************************************************/
+		struct SysTypeMeta
+		{
+		public:
+			//! The system type hash of the system that this metadata describes.
+			SysHash hash;
+			//! The system's type as a string.
+			std::string name;
+		};
+
+		/*****************************************************************//*!
+		\class TypeMetaManager
+		\brief
+			This class stores the metadata of all component and system types that have ever been added into ecs.
+		*//******************************************************************/
+		class TypeMetaManager
+		{
+		public:
+			/*****************************************************************//*!
+			\brief
+				Creates the metadata object that describes the specified type and stores it in a map container.
+			\tparam CompType
+				The component type.
+			*//******************************************************************/
+			template <typename CompType>
+			void RegisterCompType();
+
+			/*****************************************************************//*!
+			\brief
+				Gets the metadata of a component type, based on the component type's hash.
+			\param hash
+				The component type's hash.
+			\return
+				A const pointer to the metadata of the requested component type.
+			*//******************************************************************/
+			const CompTypeMeta* GetCompTypeMeta(CompHash hash) const;
+
+			/*****************************************************************//*!
+			\brief
+				Creates the metadata object that describes the specified type and stores it in a map container.
+			\tparam SysType
+				The system type.
+			*//******************************************************************/
+			template <typename SysType>
+			void RegisterSysType();
+
+			/*****************************************************************//*!
+			\brief
+				Gets the metadata of a system type, based on the system type's hash.
+			\param hash
+				The system type's hash.
+			\return
+				A const pointer to the metadata of the requested system type.
+			*//******************************************************************/
+			const SysTypeMeta* GetSysTypeMeta(SysHash hash) const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the metadata of all systems.
+			\return
+				The map containing all system metadata.
+			*//******************************************************************/
+			const SysTypeMetaMap& GetAllSysTypeMeta() const;
+
+			/*****************************************************************//*!
+			\brief
+				For shutdown purposes: Clears all metadata saved.
+			*//******************************************************************/
+			void Clear();
+
+		private:
+			//! The map container that maps component types' hashes to their metadata object describing their types.
+			CompTypeMetaMap compTypeMetaMap;
+			//! The map container that maps system types' hashes to their metadata object describing their types.
+			SysTypeMetaMap sysTypeMetaMap;
+		};
+
+#pragma endregion // Type Meta
+
+#pragma region Archetypes
+
+		/*****************************************************************//*!
+		\class Archetype
+		\brief
+			Groups all entities within a pool that have exactly the same set of fully attached component types.
+
+			Each entity occupies a row in this table. For each component type within the signature, a column stores the index
+			of each entity's component within the respective CompArr, parallel to the entity rows. Walking the rows of an
+			archetype therefore yields every component a system requires without any per-entity map lookups.
+			Component data itself continues to live within the CompArrs, so component addresses and ecs::GetEntity() are unaffected.
+		*//******************************************************************/
+		class Archetype
+		{
+		public:
+			//! The value returned by GetColumn() if the component type is not in this archetype.
+			static constexpr uint32_t NO_COLUMN{ std::numeric_limits<uint32_t>::max() };
+
+			/*****************************************************************//*!
+			\brief
+				Constructs an empty archetype.
+			\param index
+				The creation order of this archetype within its archetype manager.
+			\param signature
+				The sorted component type hashes that entities within this archetype have.
+			\param compArrMap
+				The map of CompArrs that entities within this archetype store their components in.
+			*//******************************************************************/
+			Archetype(size_t index, ArchetypeSignature&& signature, CompArrMapType& compArrMap);
+
+			Archetype(const Archetype&) = delete;
+
+			/*****************************************************************//*!
+			\brief
+				Appends a row for an entity. The component index of each column in the new row is set to 0.
+			\param entity
+				The entity.
+			\return
+				The index of the new row.
+			*//******************************************************************/
+			uint32_t AddRow(InternalEntityHandle entity);
+
+			/*****************************************************************//*!
+			\brief
+				Removes a row, moving the last row into its place and informing the entity of the moved row.
+			\param row
+				The index of the row to remove.
+			*//******************************************************************/
+			void RemoveRow(uint32_t row);
+
+			/*****************************************************************//*!
+			\brief
+				Gets the column that stores the indexes of the specified component type.
+			\param compHash
+				The component type.
+			\return
+				The column index. NO_COLUMN if the component type is not in this archetype.
+			*//******************************************************************/
+			uint32_t GetColumn(CompHash compHash) const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the columns of multiple component types.
+			\param compHashes
+				The component types.
+			\param outColumns
+				The column of each component type will be written into this array.
+			\param count
+				The number of component types.
+			\return
+				True if this archetype contains all the specified component types. False otherwise.
+			*//******************************************************************/
+			bool GetColumns(const CompHash* compHashes, uint32_t* outColumns, size_t count) const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the index within a CompArr of the component at the specified column and row.
+			\param column
+				The column.
+			\param row
+				The row.
+			\return
+				The index of the component within the column's CompArr.
+			*//******************************************************************/
+			uint32_t GetCompIndex(uint32_t column, uint32_t row) const;
+
+			/*****************************************************************//*!
+			\brief
+				Sets the index within a CompArr of the component at the specified column and row.
+			\param column
+				The column.
+			\param row
+				The row.
+			\param compIndex
+				The index of the component within the column's CompArr.
+			*//******************************************************************/
+			void SetCompIndex(uint32_t column, uint32_t row, uint32_t compIndex);
+
+			/*****************************************************************//*!
+			\brief
+				Gets the CompArr that stores the components of the specified column.
+			\param column
+				The column.
+			\return
+				The CompArr.
+			*//******************************************************************/
+			CompArr& GetCompArr(uint32_t column) const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the entity at the specified row.
+			\param row
+				The row.
+			\return
+				The entity.
+			*//******************************************************************/
+			InternalEntityHandle GetEntity(uint32_t row) const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the number of entities within this archetype.
+			\return
+				The number of entities within this archetype.
+			*//******************************************************************/
+			uint32_t GetNumRows() const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the sorted component type hashes that entities within this archetype have.
+			\return
+				The signature of this archetype.
+			*//******************************************************************/
+			const ArchetypeSignature& GetSignature() const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the creation order of this archetype within its archetype manager.
+			\return
+				The creation order of this archetype.
+			*//******************************************************************/
+			size_t GetIndex() const;
+
+		private:
+			//! The creation order of this archetype within its archetype manager.
+			const size_t index;
+			//! The sorted component type hashes that entities within this archetype have.
+			const ArchetypeSignature signature;
+			//! The CompArr of each column.
+			std::vector<CompArr*> compArrs;
+			//! The entity of each row.
+			std::vector<InternalEntityHandle> entities;
+			//! For each column, the index of each row's component within the column's CompArr.
+			std::vector<std::vector<uint32_t>> compIndexes;
+
+			//! Cached archetypes that result from adding a component type to this archetype.
+			ArchetypeEdgeMapType addEdges;
+			//! Cached archetypes that result from removing a component type from this archetype.
+			ArchetypeEdgeMapType removeEdges;
+
+			friend class ArchetypeManager;
+		};
+
+		/*****************************************************************//*!
+		\class ArchetypeManager
+		\brief
+			Tracks which archetype each entity within a pool is in, moving entities between archetypes as components
+			are attached and detached, and keeping archetype index columns updated as components move within CompArrs.
+			Archetypes are never destroyed until the pool is, so their addresses and creation order are stable.
+		*//******************************************************************/
+		class ArchetypeManager
+		{
+		public:
+			/*****************************************************************//*!
+			\brief
+				Constructor.
+			\param compArrMap
+				The map of CompArrs of the pool that this manager is in.
+			*//******************************************************************/
+			ArchetypeManager(CompArrMapType& compArrMap);
+
+			ArchetypeManager(const ArchetypeManager&) = delete;
+
+			/*****************************************************************//*!
+			\brief
+				Moves an entity into the archetype that includes a newly attached component.
+			\param entity
+				The entity.
+			\param compHash
+				The component type that was attached.
+			\param compIndex
+				The index of the component within its CompArr.
+			*//******************************************************************/
+			void OnCompAttached(InternalEntityHandle entity, CompHash compHash, uint32_t compIndex);
+
+			/*****************************************************************//*!
+			\brief
+				Moves an entity into the archetype that excludes a detached component.
+			\param entity
+				The entity.
+			\param compHash
+				The component type that was detached.
+			*//******************************************************************/
+			void OnCompDetached(InternalEntityHandle entity, CompHash compHash);
+
+			/*****************************************************************//*!
+			\brief
+				Updates the archetype index column of an entity's component that has moved within its CompArr.
+			\param entity
+				The entity.
+			\param compHash
+				The component type.
+			\param compIndex
+				The new index of the component within its CompArr.
+			*//******************************************************************/
+			void OnCompIndexChanged(InternalEntityHandle entity, CompHash compHash, uint32_t compIndex);
+
+			/*****************************************************************//*!
+			\brief
+				Removes an entity from the archetype that it is in.
+			\param entity
+				The entity.
+			*//******************************************************************/
+			void OnEntityErased(InternalEntityHandle entity);
+
+			/*****************************************************************//*!
+			\brief
+				Gets the archetype with the specified signature, creating it if it doesn't exist.
+			\param signature
+				The sorted component type hashes.
+			\return
+				The archetype.
+			*//******************************************************************/
+			Archetype& GetOrCreateArchetype(const ArchetypeSignature& signature);
+
+			/*****************************************************************//*!
+			\brief
+				Puts an entity that is not in any archetype directly into an archetype, for entities whose components
+				were all attached at once.
+			\param entity
+				The entity.
+			\param archetype
+				The archetype matching the entity's components.
+			\param compIndexes
+				The index of the entity's component within its CompArr, for each column of the archetype.
+			*//******************************************************************/
+			void AddEntity(InternalEntityHandle entity, Archetype& archetype, const uint32_t* compIndexes);
+
+			/*****************************************************************//*!
+			\brief
+				Gets the number of archetypes that have been created.
+			\return
+				The number of archetypes.
+			*//******************************************************************/
+			size_t GetNumArchetypes() const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets an archetype by creation order.
+			\param index
+				The creation order of the archetype.
+			\return
+				The archetype.
+			*//******************************************************************/
+			Archetype& GetArchetype(size_t index);
+
+			/*****************************************************************//*!
+			\brief
+				Gets the generation of this manager's archetypes. This is unique across all archetype managers and changes
+				whenever archetypes are deleted, so that cached archetype pointers can be checked for staleness even if a new
+				manager is allocated at the same address.
+			\return
+				The generation of this manager's archetypes.
+			*//******************************************************************/
+			size_t GetGeneration() const;
+
+			/*****************************************************************//*!
+			\brief
+				For shutdown purposes: Deletes all archetypes. Doesn't inform the entities.
+			*//******************************************************************/
+			void Clear();
+
+		private:
+			/*****************************************************************//*!
+			\brief
+				Gets the archetype with the specified signature, creating it if it doesn't exist.
+			\param signature
+				The sorted component type hashes.
+			\return
+				The archetype.
+			*//******************************************************************/
+			Archetype* FindOrCreate(ArchetypeSignature&& signature);
+
+			/*****************************************************************//*!
+			\brief
+				Moves an entity from its current archetype into another archetype, copying the component indexes
+				of all component types that both archetypes share.
+			\param entity
+				The entity.
+			\param dest
+				The archetype to move the entity into. nullptr to remove the entity from all archetypes.
+			\param newCompHash
+				The component type that was attached, whose index is not in the source archetype.
+				When detaching, this is the detached component type, which the destination archetype does not contain.
+			\param newCompIndex
+				The index of the attached component.
+			*//******************************************************************/
+			void MoveEntity(InternalEntityHandle entity, Archetype* dest, CompHash newCompHash, uint32_t newCompIndex);
+
+		private:
+			//! The map of CompArrs of the pool that this manager is in.
+			CompArrMapType& compArrMap;
+			//! All archetypes, in creation order.
+			std::vector<std::unique_ptr<Archetype>> archetypes;
+			//! Map of signatures to archetypes.
+			ArchetypeMapType signatureToArchetype;
+			//! Cached archetypes that contain only a single component type, for entities attaching their first component.
+			ArchetypeEdgeMapType rootEdges;
+			//! The generation of the archetypes within this manager.
+			size_t generation;
+		};
+
+#pragma endregion // Archetypes
+
+#pragma region Entity Templates
+
+		/*****************************************************************//*!
+		\class EntityTemplate
+		\brief
+			An entity hierarchy compiled into a flat form that can be instantiated many times.
+
+			Each component type is a column listing which entities in the hierarchy have that component, and a copy of each
+			component is kept as a prototype. Instantiating copies of the template reserves space within each CompArr once per
+			column, and attaches each entity's components and archetype at once, instead of walking each source entity's
+			component map and attaching its components one at a time.
+			The template does not refer to the entities it was compiled from, so it stays valid after they are destroyed.
+		*//******************************************************************/
+		class EntityTemplate
+		{
+		public:
+			//! The parent node of the root node.
+			static constexpr uint32_t NO_PARENT{ std::numeric_limits<uint32_t>::max() };
+
+			/*****************************************************************//*!
+			\brief
+				Compiles an entity within the current pool into a template.
+			\param root
+				The entity to compile.
+			\param recursive
+				Whether to compile child entities as well.
+			*//******************************************************************/
+			EntityTemplate(InternalEntityHandle root, bool recursive);
+
+			/*****************************************************************//*!
+			\brief
+				Compiles a single unparented entity with a default transform and the specified components into a template.
+			\param compTypes
+				The CompArr of each component's type, which describes how to copy the component. Each type must be unique.
+			\param comps
+				The components to be copied.
+			\param numComps
+				The number of components.
+			*//******************************************************************/
+			EntityTemplate(const CompArr* const* compTypes, const RawData* const* comps, size_t numComps);
+
+			/*****************************************************************//*!
+			\brief
+				Destroys the prototype components.
+			*//******************************************************************/
+			~EntityTemplate();
+
+			EntityTemplate(const EntityTemplate&) = delete;
+			EntityTemplate(EntityTemplate&&) noexcept = default;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the number of entities within the template's hierarchy.
+				Entities are numbered such that parents come before their children, starting from the root at 0.
+			\return
+				The number of entities.
+			*//******************************************************************/
+			uint32_t GetNumNodes() const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the parent of an entity within the template's hierarchy.
+			\param node
+				The entity's number.
+			\return
+				The number of the entity's parent. NO_PARENT if the entity is the root.
+			*//******************************************************************/
+			uint32_t GetParentNode(uint32_t node) const;
+
+			/*****************************************************************//*!
+			\brief
+				Copies the transform of an entity within the template's hierarchy. The root's world values are copied,
+				and other entities' local values are copied, so the transform should already be parented.
+			\param node
+				The entity's number.
+			\param transform
+				The transform to copy into.
+			*//******************************************************************/
+			void ApplyTransform(uint32_t node, Transform& transform) const;
+
+			/*****************************************************************//*!
+			\brief
+				Attaches copies of the template's components to entities within the current pool.
+				Attached callbacks are queued within the current pool's changes buffer, and must be flushed by the caller.
+			\param entities
+				Empty entities for each copy of the template, grouped by node such that entity i of node n is at n * count + i.
+			\param count
+				The number of copies of the template.
+			*//******************************************************************/
+			void InstantiateComps(const InternalEntityHandle* entities, uint32_t count) const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the entities of an instance of the template, checking that the instance still has the template's hierarchy
+				and exactly the template's component types, all of which are fully attached.
+				Children are ordered by the transform, so siblings may be matched to different nodes than they were instantiated from.
+			\param root
+				The root entity of the instance.
+			\param outEntities
+				The entity of each node will be written into this vector, indexed by node.
+			\return
+				True if the instance matches the template. False otherwise.
+			*//******************************************************************/
+			bool GetInstanceEntities(InternalEntityHandle root, std::vector<InternalEntityHandle>& outEntities) const;
+
+			/*****************************************************************//*!
+			\brief
+				Informs the components of an instance of the template that they have been detached, as if the instance was deleted.
+			\param entities
+				The entity of each node, as retrieved by GetInstanceEntities().
+			*//******************************************************************/
+			void DetachInstanceComps(const InternalEntityHandle* entities) const;
+
+			/*****************************************************************//*!
+			\brief
+				Overwrites the components of an instance of the template with copies of the template's components, in place.
+				Activeness changes to match the template are applied immediately, while attached callbacks are queued
+				within the current pool's changes buffer, and must be flushed by the caller.
+			\param entities
+				The entity of each node, as retrieved by GetInstanceEntities().
+			*//******************************************************************/
+			void ResetInstanceComps(const InternalEntityHandle* entities) const;
+
+		private:
+			/*****************************************************************//*!
+			\struct Node
+			\brief
+				An entity within the template's hierarchy.
+			*//******************************************************************/
+			struct Node
+			{
+				//! The number of the parent entity.
+				uint32_t parent;
+				//! The position. World position for the root, local position otherwise.
+				Vector2 position;
+				//! The scale. World scale for the root, local scale otherwise.
+				Vector2 scale;
+				//! The rotation. World rotation for the root, local rotation otherwise.
+				float rotation;
+				//! The z position.
+				float posZ;
+				//! The sorted component types of this entity, which is its archetype signature.
+				ArchetypeSignature signature;
+				//! For each component type within the signature, the column and the slot within that column.
+				std::vector<std::pair<uint32_t, uint32_t>> compSlots;
+			};
+
+			/*****************************************************************//*!
+			\struct CompSlot
+			\brief
+				A component of an entity within the template's hierarchy.
 			*//******************************************************************/
-			template <typename SysType>
-			InternalGenericSysHandle<SysType> AddSystem(int layer, SysType&& system);
+			struct CompSlot
+			{
+				//! The number of the entity.
+				uint32_t node;
+				//! The byte offset of the prototype component within prototypes.
+				size_t prototypeOffset;
+				//! Whether the component is inactive.
+				bool isInactive;
+			};
 
 			/*****************************************************************//*!
+			\struct Column
 			\brief
-				Gets a handle to the requested system that is stored within this SystemManager.
-				This operation is slightly expensive, so try not to call this unless required.
-			\tparam SysType
-				The type of the requested system.
-			\return
-				A handle to the requested system object.
-				nullptr if the system does not exist within this SystemManager.
+				All components of a single type within the template's hierarchy.
 			*//******************************************************************/
-			template <typename SysType>
-			InternalGenericSysHandle<SysType> GetSystem();
+			struct Column
+			{
+				//! An empty CompArr of this component type, which describes how to handle the components' data.
+				std::unique_ptr<CompArr> compType;
+				//! The components, with inactive components first.
+				std::vector<CompSlot> slots;
+				//! The number of inactive components.
+				uint32_t numInactive;
+			};
 
 			/*****************************************************************//*!
+			\struct SrcComp
 			\brief
-				Gets all systems stored within this SystemManager.
-				This operation is quite expensive, so try not to call this unless required.
-			\return
-				A container of pointers to all systems.
+				A component to be compiled into the template.
 			*//******************************************************************/
-			std::vector<InternalGenericSysHandle<System_Internal_Base>> GetAllSystems();
+			struct SrcComp
+			{
+				//! The number of the entity that the component belongs to.
+				uint32_t node;
+				//! The CompArr of the component's type.
+				const CompArr* compType;
+				//! The component.
+				const RawData* comp;
+				//! Whether the component is inactive.
+				bool isInactive;
+			};
 
 			/*****************************************************************//*!
 			\brief
-				Removes and deletes a system from this SystemManager.
-			\tparam SysType
-				The type of the system to remove.
+				Sorts components into columns and copies them into prototypes, then works out each node's archetype signature.
+				All nodes must have been added beforehand.
+			\param srcComps
+				The components to compile.
+			*//******************************************************************/
+			void CompileComps(const std::vector<SrcComp>& srcComps);
+
+			/*****************************************************************//*!
+			\brief
+				Adds an entity, and optionally its children, into the hierarchy.
+			\param entity
+				The entity.
+			\param parent
+				The number of the entity's parent within the hierarchy.
+			\param recursive
+				Whether to add child entities as well.
+			\param outEntities
+				The entity of each node will be appended into this vector.
+			*//******************************************************************/
+			void AddNode(InternalEntityHandle entity, uint32_t parent, bool recursive, std::vector<InternalEntityHandle>& outEntities);
+
+			//! The entities within the hierarchy, with parents before their children.
+			std::vector<Node> nodes;
+			//! The component types within the hierarchy.
+			std::vector<Column> columns;
+			//! The prototype of each component, aligned as the default allocator would.
+			std::vector<RawData> prototypes;
+		};
+
+#pragma endregion // Entity Templates
+
+#pragma region Query
+
+		/*****************************************************************//*!
+		\class Query_Internal
+		\brief
+			A persistent query for entities that have all of the specified component types.
+			The archetypes that match are cached, and only archetypes created since the last execution are checked
+			for a match, so executing the query is a straight walk over the matching archetypes' rows.
+			Archetype rows are kept updated by the ECS as components are added, removed or toggled active.
+		\tparam Args
+			The component types that entities must have.
+		*//******************************************************************/
+		template <typename... Args>
+		class Query_Internal
+		{
+		public:
+			/*****************************************************************//*!
+			\brief
+				Brings the cached set of matching archetypes up to date with the archetypes in the current pool.
 			\return
-				True if the system was successfully removed. False otherwise.
+				True if the current pool tracks archetypes. False otherwise, in which case this query cannot be executed.
 			*//******************************************************************/
-			template <typename SysType>
-			bool RemoveSystem();
+			bool Update();
 
 			/*****************************************************************//*!
 			\brief
-				Removes and deletes all systems within a layer in this SystemManager.
+				Executes a function on each entity that has all the required components, and whose required components are all active.
+				Update() must have returned true before calling this.
+				Entities that enter a matching archetype while executing are not visited.
+			\param func
+				The function to execute, taking each required component by reference in the order of Args.
+			\param pred
+				An optional predicate that filters which entities are processed.
 			*//******************************************************************/
-			void RemoveSystemsInLayer(int layer);
+			template <typename FuncType, typename Predicate = std::nullptr_t>
+				requires std::is_same_v<Predicate, std::nullptr_t> || std::predicate<Predicate, internal::InternalEntityHandle>
+			void ForEach(FuncType&& func, Predicate pred = nullptr);
 
 			/*****************************************************************//*!
 			\brief
-				Removes and deletes all systems stored in this SystemManager.
+				Executes a function on each entity with an active component in the provided CompArr that has all the required components,
+				in the order of the CompArr. Only the component within the provided CompArr needs to be active.
+				This matches how systems iterate CompArrs, while fetching the other components through archetype index columns.
+				Update() must have returned true before calling this.
+				Entities that enter a matching archetype created while executing are not visited.
+			\param compArr
+				The CompArr of one of the required component types to iterate.
+			\param func
+				The function to execute, taking each required component by reference in the order of Args.
+			\param pred
+				An optional predicate that filters which entities are processed.
 			*//******************************************************************/
-			void RemoveAllSystems();
+			template <typename FuncType, typename Predicate = std::nullptr_t>
+				requires std::is_same_v<Predicate, std::nullptr_t> || std::predicate<Predicate, internal::InternalEntityHandle>
+			void ForEachInCompArr(CompArr& compArr, FuncType&& func, Predicate pred = nullptr);
 
 			/*****************************************************************//*!
 			\brief
-				Run all systems stored within a layer in this SystemManager. The order of systems
-				within a layer is unspecified.
-			\param layer
-				Systems within this layer will be run.
+				Gets the number of archetypes that currently match this query.
+			\return
+				The number of matching archetypes.
 			*//******************************************************************/
-			void RunSystems(int layer);
+			size_t GetNumMatchedArchetypes() const;
 
-		private:
 			/*****************************************************************//*!
 			\brief
-				Gets the map container that stores all system objects in the specified layer.
-			\param layer
-				The layer that the map to be retrieved is in.
+				Gets the number of entities within the archetypes that currently match this query, including entities with inactive components.
 			\return
-				The map container that stores all system objects in the specified layer.
+				The number of entities.
 			*//******************************************************************/
-			SysMapType& GetSystemsMap(int layer);
+			size_t GetNumMatchedEntities() const;
 
 		private:
-			//! The map container that maps layer to maps, each of which maps system type hash to system objects.
-			SysLayerMapType layerToSystemsMap;
-			//! The map container that maps system type hash to the layer that the system is in.
-			//! This exists to speed up GetSystem() queries, so we don't have to linearly search all layers for the requested system.
-			SysHashToLayerMapType hashToLayerMap;
-		};
+			/*****************************************************************//*!
+			\struct MatchedArchetype
+			\brief
+				An archetype that matches this query, with the column and CompArr of each required component type resolved.
+			*//******************************************************************/
+			struct MatchedArchetype
+			{
+				Archetype* archetype;
+				std::array<uint32_t, sizeof...(Args)> columns;
+				std::array<CompArr*, sizeof...(Args)> compArrs;
+			};
 
-#pragma endregion // Systems
+			/*****************************************************************//*!
+			\brief
+				Executes a function on each entity within a matching archetype.
+			\param match
+				The matching archetype.
+			\param func
+				The function to execute.
+			\param pred
+				The predicate that filters which entities are processed.
+			*//******************************************************************/
+			template <typename FuncType, typename Predicate, size_t... Indexes>
+			void ForEachInArchetype(const MatchedArchetype& match, FuncType& func, Predicate& pred, std::index_sequence<Indexes...>);
 
-#pragma region Type Meta
+			/*****************************************************************//*!
+			\brief
+				Executes a function on each entity with an active component in a CompArr that is within a matching archetype.
+			\param compArr
+				The CompArr to iterate.
+			\param func
+				The function to execute.
+			\param pred
+				The predicate that filters which entities are processed.
+			*//******************************************************************/
+			template <typename FuncType, typename Predicate, size_t... Indexes>
+			void ForEachInCompArrImpl(CompArr& compArr, FuncType& func, Predicate& pred, std::index_sequence<Indexes...>);
 
-		/*****************************************************************//*!
-		\class CompTypeMeta
-		\brief
-			This class stores information about a component type and some useful things about it.
-		*//******************************************************************/
-		struct CompTypeMeta
-		{
-		public:
-			//! The component type hash of the component that this metadata describes.
-			CompHash hash;
-			//! The component's type as a string.
-			std::string name;
-		};
+			//! The value within matchIndexes of archetypes that don't match this query.
+			static constexpr uint32_t NO_MATCH{ std::numeric_limits<uint32_t>::max() };
 
-		/*****************************************************************//*!
-		\class SysTypeMeta
-		\brief
-			This class stores information about a system type and some useful things about it.
-		*//******************************************************************/
-		struct SysTypeMeta
-		{
-		public:
-			//! The system type hash of the system that this metadata describes.
-			SysHash hash;
-			//! The system's type as a string.
-			std::string name;
+		private:
+			//! The archetype manager of the pool that this query was last updated in.
+			ArchetypeManager* archetypes{ nullptr };
+			//! The generation of the archetype manager when this query was last updated.
+			size_t archetypesGeneration{};
+			//! The number of archetypes in the archetype manager that have been checked for a match.
+			size_t numArchetypesChecked{};
+			//! The archetypes that match this query.
+			std::vector<MatchedArchetype> matches;
+			//! For each checked archetype by creation order, its index within matches. NO_MATCH if it doesn't match.
+			std::vector<uint32_t> matchIndexes;
 		};
 
+#pragma endregion // Query
+
+#pragma region Pools
+
 		/*****************************************************************//*!
-		\class TypeMetaManager
+		\class EntitySlotMap
 		\brief
-			This class stores the metadata of all component and system types that have ever been added into ecs.
+			Stores entities in slots within fixed size pages that are never moved, so entity handles stay stable.
+			Each slot has a generation that is incremented whenever the entity within it is erased, and an entity's hash
+			is its slot index combined with the slot's generation, so stale hashes are rejected with a single compare.
+			Freed slots are reused oldest first, which keeps stale entity handles pointing to dead slots for as long as possible.
+			Pages are aligned to their size, so the slot that a handle points to is found from the handle's address alone.
+			Alive entities are also tracked within a dense array for iteration.
 		*//******************************************************************/
-		class TypeMetaManager
+		class EntitySlotMap
 		{
 		public:
+			//! The type of the iterator to alive entities.
+			using iterator = std::vector<InternalEntityHandle>::iterator;
+
+			EntitySlotMap();
+
 			/*****************************************************************//*!
 			\brief
-				Creates the metadata object that describes the specified type and stores it in a map container.
-			\tparam CompType
-				The component type.
+				Destructor. Destroys all entities.
 			*//******************************************************************/
-			template <typename CompType>
-			void RegisterCompType();
+			~EntitySlotMap();
+
+			// Disallow copying, since entity handles point into this container.
+			EntitySlotMap(const EntitySlotMap&) = delete;
 
 			/*****************************************************************//*!
 			\brief
-				Gets the metadata of a component type, based on the component type's hash.
-			\param hash
-				The component type's hash.
+				Constructs an entity within a free slot.
+			\tparam ArgTypes
+				The types of the arguments passed to the entity's constructor after its hash.
+			\param args
+				The arguments passed to the entity's constructor after its hash.
 			\return
-				A const pointer to the metadata of the requested component type.
+				A handle to the constructed entity.
 			*//******************************************************************/
-			const CompTypeMeta* GetCompTypeMeta(CompHash hash) const;
+			template <typename... ArgTypes>
+			InternalEntityHandle Emplace(ArgTypes&&... args);
 
 			/*****************************************************************//*!
 			\brief
-				Creates the metadata object that describes the specified type and stores it in a map container.
-			\tparam SysType
-				The system type.
+				Allocates pages up front so that the specified number of entities can be emplaced without allocating.
+			\param numEntities
+				The number of entities to be emplaced on top of the alive entities.
 			*//******************************************************************/
-			template <typename SysType>
-			void RegisterSysType();
+			void Reserve(size_t numEntities);
 
 			/*****************************************************************//*!
 			\brief
-				Gets the metadata of a system type, based on the system type's hash.
+				Gets the entity with the specified hash.
 			\param hash
-				The system type's hash.
+				The hash of the entity.
 			\return
-				A const pointer to the metadata of the requested system type.
+				A handle to the entity. nullptr if the entity doesn't exist.
 			*//******************************************************************/
-			const SysTypeMeta* GetSysTypeMeta(SysHash hash) const;
+			InternalEntityHandle Get(EntityHash hash);
 
 			/*****************************************************************//*!
 			\brief
-				Gets the metadata of all systems.
+				Destroys the entity with the specified hash and frees its slot.
+			\param hash
+				The hash of the entity.
 			\return
-				The map containing all system metadata.
+				True if the entity existed. False otherwise.
 			*//******************************************************************/
-			const SysTypeMetaMap& GetAllSysTypeMeta() const;
+			bool Erase(EntityHash hash);
 
 			/*****************************************************************//*!
 			\brief
-				For shutdown purposes: Clears all metadata saved.
+				Destroys all entities. Pages are kept for reuse.
 			*//******************************************************************/
 			void Clear();
 
+			/*****************************************************************//*!
+			\brief
+				Checks whether a handle points to an alive entity within this container.
+				The handle's page is looked up by its aligned start address, then the slot is checked directly.
+				A handle doesn't carry a generation, so a stale handle to a slot that has been reused passes this check.
+			\param handle
+				The handle to check.
+			\return
+				True if the handle points to an alive entity. False otherwise.
+			*//******************************************************************/
+			bool Contains(ConstInternalEntityHandle handle) const;
+
+			/*****************************************************************//*!
+			\brief
+				Checks whether a handle points to the alive entity that had the specified hash when the handle was taken.
+				The slot index and generation are decoded from the hash, so stale handles to reused slots are rejected.
+			\param handle
+				The handle to check.
+			\param hash
+				The hash of the entity when the handle was taken.
+			\return
+				True if the handle points to the alive entity with the hash. False otherwise.
+			*//******************************************************************/
+			bool Contains(ConstInternalEntityHandle handle, EntityHash hash) const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets the number of alive entities.
+			\return
+				The number of alive entities.
+			*//******************************************************************/
+			size_t size() const;
+
+			/*****************************************************************//*!
+			\brief
+				Gets an iterator to the first alive entity.
+			\return
+				An iterator to the first alive entity.
+			*//******************************************************************/
+			iterator begin();
+
+			/*****************************************************************//*!
+			\brief
+				Gets an iterator to 1 past the last alive entity.
+			\return
+				An iterator to 1 past the last alive entity.
+			*//******************************************************************/
+			iterator end();
+
 		private:
-			//! The map container that maps component types' hashes to their metadata object describing their types.
-			CompTypeMetaMap compTypeMetaMap;
-			//! The map container that maps system types' hashes to their metadata object describing their types.
-			SysTypeMetaMap sysTypeMetaMap;
-		};
+			/*****************************************************************//*!
+			\struct Slot
+			\brief
+				The storage of 1 entity. The entity is placed at the start of the slot, so a handle to the entity is also the slot's address.
+			*//******************************************************************/
+			struct Slot
+			{
+				//! The memory that the entity is constructed in.
+				alignas(Entity_Internal) RawData storage[sizeof(Entity_Internal)];
+				//! Incremented whenever the entity in this slot is erased.
+				uint32_t generation;
+				//! The index of the entity within aliveEntities. INVALID_INDEX if this slot is free.
+				uint32_t denseIndex;
+				//! The index of the next free slot, if this slot is free.
+				uint32_t nextFree;
+			};
 
-#pragma endregion // Type Meta
+			/*****************************************************************//*!
+			\struct PageDeleter
+			\brief
+				Frees a page, which is allocated with an alignment of its size.
+			*//******************************************************************/
+			struct PageDeleter
+			{
+				/*****************************************************************//*!
+				\brief
+					Frees a page.
+				\param page
+					The page.
+				*//******************************************************************/
+				void operator()(Slot* page) const;
+			};
 
-#pragma region Pools
+			/*****************************************************************//*!
+			\brief
+				Gets the slot at the specified index.
+			\param index
+				The index of the slot.
+			\return
+				The slot.
+			*//******************************************************************/
+			Slot& GetSlot(uint32_t index);
+
+			/*****************************************************************//*!
+			\brief
+				Gets the slot at the specified index.
+			\param index
+				The index of the slot.
+			\return
+				The slot.
+			*//******************************************************************/
+			const Slot& GetSlot(uint32_t index) const;
+
+			/*****************************************************************//*!
+			\brief
+				Takes the oldest free slot, allocating a new page if there are no free slots.
+			\return
+				The index of the slot.
+			*//******************************************************************/
+			uint32_t AcquireSlot();
+
+			/*****************************************************************//*!
+			\brief
+				Allocates a new page and appends all of its slots to the free list.
+			*//******************************************************************/
+			void AllocatePage();
+
+			/*****************************************************************//*!
+			\brief
+				Combines a slot index and generation into an entity hash.
+			\param index
+				The index of the slot.
+			\param generation
+				The generation of the slot.
+			\return
+				The entity hash.
+			*//******************************************************************/
+			static EntityHash MakeHash(uint32_t index, uint32_t generation);
+
+		private:
+			//! The number of slots within each page.
+			static constexpr uint32_t SLOTS_PER_PAGE{ 256 };
+			//! The size and alignment of each page. Rounded up to a power of 2 so that a page's start address is found by masking.
+			static constexpr size_t PAGE_BYTES{ std::bit_ceil(SLOTS_PER_PAGE * sizeof(Slot)) };
+			//! Marks a slot index as invalid.
+			static constexpr uint32_t INVALID_INDEX{ std::numeric_limits<uint32_t>::max() };
+
+			//! The pages of slots. Pages are never freed until this container is destroyed.
+			std::vector<std::unique_ptr<Slot[], PageDeleter>> pages;
+			//! The index of each page, by the page's start address.
+			std::unordered_map<uintptr_t, uint32_t> pageIndexes;
+			//! Handles to all alive entities.
+			std::vector<InternalEntityHandle> aliveEntities;
+			//! The index of the oldest free slot.
+			uint32_t freeHead;
+			//! The index of the newest free slot.
+			uint32_t freeTail;
+		};
 
 		/*****************************************************************//*!
 		\class EntityMapWrapper
 		\brief
-			Wraps the map of entities so that validEntityHandles will also be
-			updated alongside changes to the entities map.
+			Wraps the container of entities so that created entities are hooked up to the pool's archetype manager.
 		*//******************************************************************/
 		class EntityMapWrapper
 		{
@@ -1833,11 +3249,11 @@ namespace ecs {
 			\brief
 				Constructor
 			\param entities
-				The map of entities in the ECS pool.
-			\param validEntityHandles
-				The set that contains valid handles to entities within the map of entities.
+				The container of entities in the ECS pool.
+			\param archetypes
+				The archetype manager that created entities are tracked by. nullptr if the pool does not track archetypes.
 			*//******************************************************************/
-			EntityMapWrapper(EntMapType& entities, ValidEntHandleSetType& validEntityHandles);
+			EntityMapWrapper(EntMapType& entities, ArchetypeManager* archetypes);
 
 			/*****************************************************************//*!
 			\brief
@@ -1859,6 +3275,14 @@ namespace ecs {
 			*//******************************************************************/
 			InternalEntityHandle CreateEntity(Transform& transformCopy);
 
+			/*****************************************************************//*!
+			\brief
+				Reserves space so that the specified number of entities can be created without allocating.
+			\param numEntities
+				The number of entities to be created.
+			*//******************************************************************/
+			void Reserve(size_t numEntities);
+
 			/*****************************************************************//*!
 			\brief
 				Gets an entity with the specified hash.
@@ -1893,11 +3317,23 @@ namespace ecs {
 			*//******************************************************************/
 			bool CheckValidHandle(InternalEntityHandle handle);
 
+			/*****************************************************************//*!
+			\brief
+				Checks if a given entity handle is to the entity with the specified hash within this ECS pool.
+			\param handle
+				The handle to the supposed entity.
+			\param hash
+				The hash of the entity when the handle was taken.
+			\return
+				True if the handle is valid and the entity still has the hash. False otherwise.
+			*//******************************************************************/
+			bool CheckValidHandle(InternalEntityHandle handle, EntityHash hash);
+
 		private:
-			//! The map of entity hashes to entities.
+			//! The container of entities.
 			EntMapType& entities;
-			//! The set of valid entity handles.
-			ValidEntHandleSetType& validEntityHandles;
+			//! The archetype manager that created entities are tracked by.
+			ArchetypeManager* archetypes;
 
 		};
 
@@ -1917,8 +3353,10 @@ namespace ecs {
 				The id of this ECS pool.
 			\param compCallbacksEnabled
 				Whether component callbacks are enabled within this pool.
+			\param archetypesEnabled
+				Whether entities within this pool are tracked by archetype.
 			*//******************************************************************/
-			ECSPool(int id, bool compCallbacksEnabled);
+			ECSPool(int id, bool compCallbacksEnabled, bool archetypesEnabled);
 
 			/*****************************************************************//*!
 			\brief
@@ -1928,14 +3366,22 @@ namespace ecs {
 			*//******************************************************************/
 			bool GetIsCompCallbacksEnabled() const;
 
+			/*****************************************************************//*!
+			\brief
+				Gets the archetype manager of this pool.
+			\return
+				The archetype manager. nullptr if this pool does not track archetypes.
+			*//******************************************************************/
+			ArchetypeManager* GetArchetypes();
+
 			// It was kind of a mistake to make these variables public... but well that's
 			// too late now. Best we can do is hide stuff that shouldn't be public anymore and
 			// leave the rest as public for now.
 		private:
-			//! Map of entity UID to Entity_Internal class objects, stores all entities
+			//! Tracks entities by archetype. Declared before entities so that it outlives them.
+			ArchetypeManager archetypes;
+			//! Slot map of entity hash to Entity_Internal class objects, stores all entities
 			EntMapType entities;
-			//! Set storing valid entity handles to entities within this pool.
-			ValidEntHandleSetType validEntityHandles;
 
 		public:
 			//! Map of component hash to compArr, stores all components
@@ -1953,6 +3399,8 @@ namespace ecs {
 		private:
 			//! Whether this pool has component callbacks enabled.
 			bool compCallbacksEnabled;
+			//! Whether this pool tracks entities by archetype.
+			bool archetypesEnabled;
 
 			/* ITERATOR SUPPORT */
 		public:
@@ -2171,8 +3619,10 @@ namespace ecs {
 				Initializes ECS.
 			\param defaultPoolHasCompCallbacksEnabled
 				Whether the default pool (0) has component callbacks enabled.
+			\param defaultPoolHasArchetypesEnabled
+				Whether the default pool (0) tracks entities by archetype.
 			*//******************************************************************/
-			static void Init(bool defaultPoolHasCompCallbacksEnabled);
+			static void Init(bool defaultPoolHasCompCallbacksEnabled, bool defaultPoolHasArchetypesEnabled);
 
 			/*****************************************************************//*!
 			\brief
@@ -2228,6 +3678,14 @@ namespace ecs {
 			*//******************************************************************/
 			static TypeMetaManager& TypeMeta();
 
+			/*****************************************************************//*!
+			\brief
+				Gets the archetype manager of the active ECSPool.
+			\return
+				The archetype manager of the active ECSPool. nullptr if the pool does not track archetypes.
+			*//******************************************************************/
+			static ArchetypeManager* Archetypes();
+
 			/*****************************************************************//*!
 			\brief
 				Gets the CompArr map of the specified ECSPool.
@@ -2277,8 +3735,10 @@ namespace ecs {
 				The id of the ECSPool.
 			\param compCallbacksEnabled
 				Whether component callbacks are enabled in the pool.
+			\param archetypesEnabled
+				Whether the pool tracks entities by archetype.
 			*//******************************************************************/
-			static void SwitchToPool_CreateIfNotExist(int id, bool compCallbacksEnabled);
+			static void SwitchToPool_CreateIfNotExist(int id, bool compCallbacksEnabled, bool archetypesEnabled);
 
 			/*****************************************************************//*!
 			\brief
@@ -2546,7 +4006,7 @@ namespace ecs {
 		\param compAddr
 			The address of the component.
 		\return
-			The entity that the component is attached to.
+			The entity that the component is attached to. nullptr if the address is not within any CompArr.
 		*//******************************************************************/
 		InternalEntityHandle GetEntityFromCompAddr(void* compAddr);
 
@@ -2556,7 +4016,7 @@ namespace ecs {
 		\param compAddr
 			The address of the component.
 		\return
-			The entity that the component is attached to.
+			The entity that the component is attached to. nullptr if the address is not within any CompArr.
 		*//******************************************************************/
 		ConstInternalEntityHandle GetEntityFromCompAddr(const void* compAddr);
 
@@ -2581,16 +4041,6 @@ namespace ecs {
 		const CompArr* GetCompArrFromCompAddr(const void* compAddr);
 
 
-		/*****************************************************************//*!
-		\brief
-			Gets an unused EntityHash in an EntMapType pool.
-		\param entityPool
-			The pool of entities that are currently instanced.
-		\return
-			An unused EntityHash.
-		*//******************************************************************/
-		EntityHash GetUnusedEntityHash(const EntMapType& entityPool);
-
 	}
 }
 
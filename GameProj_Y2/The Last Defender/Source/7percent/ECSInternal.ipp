@@ -24,8 +24,11 @@ All rights reserved.
 #include "ECSInternal.h"
 #include <cassert>
 #include <iostream>
+#include <numeric>
+#include <new>
 #include "TypeID.h"
 #include "Utilities.h"
+#include "JobSystem.h"
 
 namespace ecs {
 
@@ -201,8 +204,9 @@ namespace ecs {
 
 		template <typename CompType, typename EntityHandleType, typename ValueType>
 		CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>::iterator_blueprint(
-			uint32_t compStepSize, pointer ptrToCompBaseLoc)
-			: ptr{ ptrToCompBaseLoc }
+			uint32_t compStepSize, pointer ptrToComp, const InternalEntityHandle* ptrToEntity)
+			: ptr{ ptrToComp }
+			, entityPtr{ ptrToEntity }
 			, compStepSize{ compStepSize }
 		{
 		}
@@ -210,37 +214,38 @@ namespace ecs {
 		template<typename CompType, typename EntityHandleType, typename ValueType>
 		CompType& CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>::operator*() const
 		{
-			return *reinterpret_cast<InternalCompHandle<CompType>>(ptr + CompArr::EntPtrSize);
+			return *reinterpret_cast<InternalCompHandle<CompType>>(ptr);
 		}
 
 		template<typename CompType, typename EntityHandleType, typename ValueType>
 		CompType* CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>::operator->() const
 		{
-			return reinterpret_cast<InternalCompHandle<CompType>>(ptr + CompArr::EntPtrSize);
+			return reinterpret_cast<InternalCompHandle<CompType>>(ptr);
 		}
 
 		template <typename CompType, typename EntityHandleType, typename ValueType>
 		InternalCompHandle<CompType> CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>::GetComp()
 		{
-			return reinterpret_cast<InternalCompHandle<CompType>>(ptr + CompArr::EntPtrSize);
+			return reinterpret_cast<InternalCompHandle<CompType>>(ptr);
 		}
 
 		template <typename CompType, typename EntityHandleType, typename ValueType>
 		EntityHandleType CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>::GetEntity()
 		{
-			return *reinterpret_cast<EntityHandleType*>(ptr);
+			return reinterpret_cast<EntityHandleType>(*entityPtr);
 		}
 
 		template<typename CompType, typename EntityHandleType, typename ValueType>
 		bool CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>::GetIsActive() const
 		{
-			return (*reinterpret_cast<CompArr**>(ptr - CompArr::CompArrPtrSize))->GetIsCompActive(GetComp());
+			return CompArr::FindFromCompAddr(ptr)->GetIsCompActive(ptr);
 		}
 
 		template <typename CompType, typename EntityHandleType, typename ValueType>
 		CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>& CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>::operator++()
 		{
 			ptr += compStepSize;
+			++entityPtr;
 			return *this;
 		}
 		template <typename CompType, typename EntityHandleType, typename ValueType>
@@ -255,6 +260,7 @@ namespace ecs {
 		CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>& CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>::operator--()
 		{
 			ptr -= compStepSize;
+			--entityPtr;
 			return *this;
 		}
 		template <typename CompType, typename EntityHandleType, typename ValueType>
@@ -269,7 +275,7 @@ namespace ecs {
 		CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType> operator+(
 			const CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>& iter, int offset)
 		{
-			return CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>{ iter.compStepSize, iter.ptr + offset * iter.compStepSize };
+			return CompArr::iterator_blueprint<CompType, EntityHandleType, ValueType>{ iter.compStepSize, iter.ptr + offset * static_cast<std::ptrdiff_t>(iter.compStepSize), iter.entityPtr + offset };
 		}
 
 		template <typename CompType, typename EntityHandleType, typename ValueType>
@@ -291,26 +297,43 @@ namespace ecs {
 		template<typename CompType, typename EntityHandleType>
 		CompArr::iterator_blueprint<CompType, EntityHandleType> CompArr::User_Begin()
 		{
-			return iterator_blueprint<CompType, EntityHandleType>{ compStepSize, arrRaw.data() + CompArrPtrSize };
+			return iterator_blueprint<CompType, EntityHandleType>{ compSize, arrRaw.data(), entities.data() };
 		}
 		template<typename CompType, typename EntityHandleType>
 		CompArr::iterator_blueprint<CompType, EntityHandleType> CompArr::User_Begin_Active()
 		{
-			return iterator_blueprint<CompType, EntityHandleType>{ compStepSize, arrRaw.data() + firstActiveIndex * compStepSize + CompArrPtrSize };
+			return iterator_blueprint<CompType, EntityHandleType>{ compSize, arrRaw.data() + firstActiveIndex * compSize, entities.data() + firstActiveIndex };
 		}
 		template<typename CompType, typename EntityHandleType>
 		CompArr::iterator_blueprint<CompType, EntityHandleType> CompArr::User_End()
 		{
-			return iterator_blueprint<CompType, EntityHandleType>{ compStepSize, arrRaw.data() + arrRaw.size() + CompArrPtrSize };
+			return iterator_blueprint<CompType, EntityHandleType>{ compSize, arrRaw.data() + arrRaw.size(), entities.data() + entities.size() };
 		}
 		template<typename CompType, typename EntityHandleType>
-		CompArr::iterator_blueprint<CompType, EntityHandleType> CompArr::User_Custom(InternalEntityHandle entityHandle)
+		CompArr::iterator_blueprint<CompType, EntityHandleType> CompArr::User_Custom(const void* compAddr)
 		{
-			return iterator_blueprint<CompType, EntityHandleType>{ compStepSize, reinterpret_cast<RawData*>(entityHandle) };
+			uint32_t index{ GetCompIndex(compAddr) };
+			return iterator_blueprint<CompType, EntityHandleType>{ compSize, arrRaw.data() + index * compSize, entities.data() + index };
 		}
 
 #pragma endregion // CompArr
 
+#pragma region System_Internal_Base
+
+		template <typename... Types>
+		void System_Internal_Base::DeclareReads()
+		{
+			(access.reads.push_back(GetCompHash<Types>()), ...);
+		}
+
+		template <typename... Types>
+		void System_Internal_Base::DeclareWrites()
+		{
+			(access.writes.push_back(GetCompHash<Types>()), ...);
+		}
+
+#pragma endregion // System_Internal_Base
+
 #pragma region System_Internal
 
 		template<typename SysType, typename ...Args>
@@ -318,6 +341,13 @@ namespace ecs {
 		System_Internal<SysType, Args...>::System_Internal(ReturnType(ClassType::*memberFunc)(Args&...))
 			: callProcessEntity{ [memberFunc](System_Internal* objPtr, Args&... args) -> ReturnType { return (reinterpret_cast<ClassType*>(objPtr)->*memberFunc)(args...); } }
 		{
+			// Required components taken by const reference are only read. All others are written.
+			([this]() -> void {
+				if constexpr (std::is_const_v<Args>)
+					DeclareReads<Args>();
+				else
+					DeclareWrites<Args>();
+			}(), ...);
 		}
 
 		template<typename SysType, typename ...Args>
@@ -333,9 +363,25 @@ namespace ecs {
 			// If this system runs on no components, we don't execute over any components and only let PostRun() execute on this system.
 			if constexpr (sizeof...(Args) == 0)
 				return;
-			else
-				// Execute on the components within the CompArr that has the least components, out of the components we want.
+			else if constexpr (sizeof...(Args) == 1)
+				// Execute on the components within the CompArr of the component we want.
 				RunOnCompArr(*GetCompArrWithLeastComps<Args...>());
+			else
+			{
+				// If this pool tracks archetypes, execute on the archetypes that contain all the components we want.
+				if (!RunOnQuery())
+					// Execute on the components within the CompArr that has the least components, out of the components we want.
+					RunOnCompArr(*GetCompArrWithLeastComps<Args...>());
+			}
+		}
+
+		template<typename SysType, typename ...Args>
+		void System_Internal<SysType, Args...>::INTERNAL_PrepareConcurrentRun()
+		{
+			// Getting CompArrs creates them if they don't exist yet
+			(GetCompArr<std::remove_const_t<Args>>(), ...);
+			if constexpr (sizeof...(Args) > 1)
+				query.Update();
 		}
 
 		template<typename SysType, typename ...Args>
@@ -368,6 +414,21 @@ namespace ecs {
 			}
 		}
 
+		template<typename SysType, typename ...Args>
+		template <typename Predicate>
+			requires std::is_same_v<Predicate, std::nullptr_t> || std::predicate<Predicate, internal::InternalEntityHandle>
+		bool System_Internal<SysType, Args...>::RunOnQuery(Predicate pred)
+		{
+			if (!query.Update())
+				return false;
+
+			// Iterate the same CompArr as RunOnCompArr() so that entities are processed in the same order with the same requirements
+			query.ForEachInCompArr(*GetCompArrWithLeastComps<Args...>(), [this](Args&... comps) -> void {
+				callProcessEntity(this, comps...);
+			}, pred);
+			return true;
+		}
+
 		template<typename SysType, typename ...Args>
 		InternalCompHandle<RawData> System_Internal<SysType, Args...>::GetComponent(InternalEntityHandle entity, CompHash obtainedCompHash, InternalCompHandle<RawData> obtainedComp, CompHash desiredCompHash)
 		{
@@ -379,6 +440,211 @@ namespace ecs {
 
 #pragma endregion // System_Internal
 
+#pragma region ParallelSystem_Internal
+
+		template<typename SysType, typename ...Args>
+		template <typename ReturnType, typename ClassType>
+		ParallelSystem_Internal<SysType, Args...>::ParallelSystem_Internal(ReturnType(ClassType::*memberFunc)(Args&...), uint32_t minChunkSize)
+			: System_Internal<SysType, Args...>{ memberFunc }
+			, minChunkSize{ std::max(minChunkSize, 1u) }
+		{
+		}
+
+		template<typename SysType, typename ...Args>
+		void ParallelSystem_Internal<SysType, Args...>::Run()
+		{
+			if constexpr (sizeof...(Args) > 0)
+				RunOnCompArr(*GetCompArrWithLeastComps<Args...>());
+		}
+
+		template<typename SysType, typename ...Args>
+		void ParallelSystem_Internal<SysType, Args...>::INTERNAL_ApplyDeferredChanges()
+		{
+			for (CompChangesShard& shard : shards)
+				shard.Apply();
+		}
+
+		template<typename SysType, typename ...Args>
+		template <typename Predicate>
+			requires std::is_same_v<Predicate, std::nullptr_t> || std::predicate<Predicate, internal::InternalEntityHandle>
+		void ParallelSystem_Internal<SysType, Args...>::RunOnCompArr(CompArr& compArr, [[maybe_unused]] Predicate pred)
+		{
+			uint32_t firstIndex{ compArr.GetFirstActiveIndex() };
+			uint32_t numActive{ compArr.GetNumComps() - firstIndex };
+			uint32_t chunkSize{ GetChunkSize(compArr) };
+
+			// Chunks are split the same way regardless of the number of threads, and each chunk gets its own shard,
+			// so deferred changes are applied in the same order as if the chunks were processed one after another.
+			shards.resize((numActive + chunkSize - 1) / chunkSize);
+
+			ST<JobSystem>::Get()->ParallelFor(numActive, chunkSize, [this, &compArr, firstIndex, &pred](uint32_t chunkIndex, uint32_t begin, uint32_t end) -> void {
+				CompChangesShard* prevShard{ CompChangesShard::GetActive() };
+				CompChangesShard::SetActive(&shards[chunkIndex]);
+
+				for (uint32_t index{ firstIndex + begin }, endIndex{ firstIndex + end }; index < endIndex; ++index)
+				{
+					InternalEntityHandle entity{ compArr.GetEntity(index) };
+
+					// Check if this entity has the required components
+					if constexpr (sizeof...(Args) > 1)
+						if (!((entity->INTERNAL_GetHasComp(GetCompHash<Args>())) && ...))
+							continue;
+
+					// Check for any extra requirements for which entities are processed
+					if constexpr (!std::is_same_v<Predicate, std::nullptr_t>)
+						if (!pred(entity))
+							continue;
+
+					if constexpr (sizeof...(Args) <= 1)
+						this->callProcessEntity(this, *reinterpret_cast<InternalCompHandle<Args>>(compArr.GetComp(index))...);
+					else
+						this->callProcessEntity(this, *reinterpret_cast<InternalCompHandle<Args>>(this->GetComponent(
+							entity, compArr.GetCompHash(), compArr.GetComp(index), GetCompHash<Args>()
+						))...);
+				}
+
+				CompChangesShard::SetActive(prevShard);
+			});
+		}
+
+		template<typename SysType, typename ...Args>
+		uint32_t ParallelSystem_Internal<SysType, Args...>::GetChunkSize(const CompArr& compArr) const
+		{
+			// The smallest number of components that spans a whole number of cache lines
+			constexpr uint32_t cacheLineSize{ static_cast<uint32_t>(std::hardware_destructive_interference_size) };
+			uint32_t compsPerLines{ cacheLineSize / std::gcd(compArr.GetCompStepSize(), cacheLineSize) };
+
+			return (minChunkSize + compsPerLines - 1) / compsPerLines * compsPerLines;
+		}
+
+#pragma endregion // ParallelSystem_Internal
+
+#pragma region Query
+
+		template <typename... Args>
+		bool Query_Internal<Args...>::Update()
+		{
+			ArchetypeManager* currentArchetypes{ CurrentPool::Archetypes() };
+			if (!currentArchetypes)
+				return false;
+
+			// Start over if we've switched pools, or if the archetypes we've checked have since been deleted.
+			// The generation is checked too, as a deleted pool's archetype manager may be reallocated at the same address.
+			if (archetypes != currentArchetypes || archetypesGeneration != currentArchetypes->GetGeneration())
+			{
+				archetypes = currentArchetypes;
+				archetypesGeneration = currentArchetypes->GetGeneration();
+				numArchetypesChecked = 0;
+				matches.clear();
+				matchIndexes.clear();
+			}
+
+			// Archetypes are only ever appended, so we only need to check archetypes that were created since the last update
+			const std::array<CompHash, sizeof...(Args)> compHashes{ GetCompHash<Args>()... };
+			for (size_t numArchetypes{ archetypes->GetNumArchetypes() }; numArchetypesChecked < numArchetypes; ++numArchetypesChecked)
+			{
+				MatchedArchetype match{ .archetype = &archetypes->GetArchetype(numArchetypesChecked) };
+				if (!match.archetype->GetColumns(compHashes.data(), match.columns.data(), match.columns.size()))
+				{
+					matchIndexes.push_back(NO_MATCH);
+					continue;
+				}
+
+				for (size_t i{}; i < match.columns.size(); ++i)
+					match.compArrs[i] = &match.archetype->GetCompArr(match.columns[i]);
+				matchIndexes.push_back(static_cast<uint32_t>(matches.size()));
+				matches.push_back(match);
+			}
+
+			return true;
+		}
+
+		template <typename... Args>
+		template <typename FuncType, typename Predicate>
+			requires std::is_same_v<Predicate, std::nullptr_t> || std::predicate<Predicate, internal::InternalEntityHandle>
+		void Query_Internal<Args...>::ForEach(FuncType&& func, Predicate pred)
+		{
+			for (const MatchedArchetype& match : matches)
+				if (match.archetype->GetNumRows())
+					ForEachInArchetype(match, func, pred, std::index_sequence_for<Args...>{});
+		}
+
+		template <typename... Args>
+		template <typename FuncType, typename Predicate>
+			requires std::is_same_v<Predicate, std::nullptr_t> || std::predicate<Predicate, internal::InternalEntityHandle>
+		void Query_Internal<Args...>::ForEachInCompArr(CompArr& compArr, FuncType&& func, Predicate pred)
+		{
+			ForEachInCompArrImpl(compArr, func, pred, std::index_sequence_for<Args...>{});
+		}
+
+		template <typename... Args>
+		size_t Query_Internal<Args...>::GetNumMatchedArchetypes() const
+		{
+			return matches.size();
+		}
+
+		template <typename... Args>
+		size_t Query_Internal<Args...>::GetNumMatchedEntities() const
+		{
+			size_t numEntities{};
+			for (const MatchedArchetype& match : matches)
+				numEntities += match.archetype->GetNumRows();
+			return numEntities;
+		}
+
+		template <typename... Args>
+		template <typename FuncType, typename Predicate, size_t... Indexes>
+		void Query_Internal<Args...>::ForEachInArchetype(const MatchedArchetype& match, FuncType& func, [[maybe_unused]] Predicate& pred, std::index_sequence<Indexes...>)
+		{
+			Archetype& archetype{ *match.archetype };
+
+			// Rows appended while executing are not visited. Rows may also be removed if components are attached/detached
+			// immediately while executing, so the current number of rows is checked too.
+			for (uint32_t row{}, numRows{ archetype.GetNumRows() }; row < numRows && row < archetype.GetNumRows(); ++row)
+			{
+				// Only process entities whose required components are all active
+				if (!(match.compArrs[Indexes]->GetIsCompActive(archetype.GetCompIndex(match.columns[Indexes], row)) && ...))
+					continue;
+
+				// Check for any extra requirements for which entities are processed
+				if constexpr (!std::is_same_v<Predicate, std::nullptr_t>)
+					if (!pred(archetype.GetEntity(row)))
+						continue;
+
+				// The archetype tells us where each required component is, so there's no need to look them up via the entity
+				func(*reinterpret_cast<InternalCompHandle<Args>>(
+					match.compArrs[Indexes]->GetComp(archetype.GetCompIndex(match.columns[Indexes], row))
+				)...);
+			}
+		}
+
+		template <typename... Args>
+		template <typename FuncType, typename Predicate, size_t... Indexes>
+		void Query_Internal<Args...>::ForEachInCompArrImpl(CompArr& compArr, FuncType& func, [[maybe_unused]] Predicate& pred, std::index_sequence<Indexes...>)
+		{
+			for (CompArr::iterator compIter{ compArr.begin_active() }, endIter{ compArr.end() }; compIter != endIter; ++compIter)
+			{
+				// Check if this entity has the required components, which is whether it is in a matching archetype
+				InternalEntityHandle entity{ compIter.GetEntity() };
+				const Archetype* archetype{ entity->archetype };
+				if (!archetype || archetype->GetIndex() >= matchIndexes.size() || matchIndexes[archetype->GetIndex()] == NO_MATCH)
+					continue;
+
+				// Check for any extra requirements for which entities are processed
+				if constexpr (!std::is_same_v<Predicate, std::nullptr_t>)
+					if (!pred(entity))
+						continue;
+
+				// The archetype tells us where each required component is, so there's no need to look them up via the entity
+				const MatchedArchetype& match{ matches[matchIndexes[archetype->GetIndex()]] };
+				func(*reinterpret_cast<InternalCompHandle<Args>>(
+					match.compArrs[Indexes]->GetComp(archetype->GetCompIndex(match.columns[Indexes], entity->archetypeRow))
+				)...);
+			}
+		}
+
+#pragma endregion // Query
+
 #pragma region SystemsManager
 
 		template<typename SysType>
@@ -458,6 +724,22 @@ namespace ecs {
 
 #pragma endregion // Type Meta
 
+#pragma region Pools
+
+		template <typename... ArgTypes>
+		InternalEntityHandle EntitySlotMap::Emplace(ArgTypes&&... args)
+		{
+			uint32_t index{ AcquireSlot() };
+			Slot& slot{ GetSlot(index) };
+
+			InternalEntityHandle entity{ new (slot.storage) Entity_Internal{ MakeHash(index, slot.generation), std::forward<ArgTypes>(args)... } };
+			slot.denseIndex = static_cast<uint32_t>(aliveEntities.size());
+			aliveEntities.push_back(entity);
+			return entity;
+		}
+
+#pragma endregion // Pools
+
 #pragma region ECSPool
 
 		template<typename EntityHandleType, typename EntContIterType, typename ValueType>
@@ -682,9 +964,12 @@ namespace ecs {
 			// Let's register this type since it seems like it's the first time we've seen it
 			CurrentPool::TypeMeta().RegisterCompType<T>();
 
+			// CompArr relies on the allocator to align its component memory
+			static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Over-aligned components are not supported");
+
 			bool doCompCallbacks{ DoComponentCallbacks && CurrentPool::HasCompCallbacksEnabled() };
 
-			return compArrPool.try_emplace(compHash, compHash, static_cast<uint32_t>(sizeof(T)),
+			return compArrPool.try_emplace(compHash, compHash, static_cast<uint32_t>(sizeof(T)), std::is_trivially_copyable_v<T>,
 				ComponentCopyMethod<T>, ComponentMoveMethod<T>, ComponentDestructorMethod<T>,
 				doCompCallbacks ? ComponentInformAttachedMethod<T> : [](InternalEntityHandle) -> void {},
 				doCompCallbacks ? ComponentInformDetachedMethod<T> : [](InternalEntityHandle) -> void {},
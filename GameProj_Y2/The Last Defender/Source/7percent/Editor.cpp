@@ -402,6 +402,7 @@ ecs::EntityHandle Editor::GetSelectedEntity() {
 void Editor::SetSelectedEntity(ecs::EntityHandle entity)
 {
 	selectedEntity = entity;
+	selectedEntityHash = (entity ? entity->GetHash() : 0);
 	if(selectedEntity) {
 		m_gizmo.attach(selectedEntity->GetTransform());
 		m_gizmo.setType(m_currentGizmoType = GizmoType::None);
@@ -451,7 +452,8 @@ void Editor::DeleteSelectedEntity()
 
 bool Editor::CheckIsSelectedEntityValid()
 {
-	if(selectedEntity && !ecs::IsEntityHandleValid(selectedEntity))
+	// The hash is checked too, as the selected entity's slot may have been reused by a new entity
+	if(selectedEntity && !ecs::IsEntityHandleValid(selectedEntity, selectedEntityHash))
 		selectedEntity = nullptr;
 	return selectedEntity;
 }
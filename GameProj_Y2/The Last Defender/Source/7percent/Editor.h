@@ -125,6 +125,7 @@ private:
 	bool m_snapToGrid{ false };
 	Vector4 m_gridColor{ 1.0f,1.0f,1.0f,1.0f };
 	ecs::EntityHandle selectedEntity{ nullptr };
+	ecs::EntityHash selectedEntityHash{};
 	bool drawBoxes{ true };
 
 	Gizmo m_gizmo;
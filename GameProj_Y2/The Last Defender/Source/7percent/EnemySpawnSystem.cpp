@@ -134,25 +134,29 @@ void EnemySpawnerComponent::SpawnEnemies()
 	std::string currentPrefab = "DropPod";
 	int currentSpawnLocation = 0;
 
-	for (int i = 0; i < numEnemiesToSpawn; ++i)
+	if (numEnemiesToSpawn <= 0)
 	{
-		ecs::EntityHandle temp = PrefabManager::LoadPrefab(currentPrefab);
-		if (temp)
-		{
-			temp->GetTransform().SetLocalPosition(spawnLocations[currentSpawnLocation]->GetTransform().GetWorldPosition());
+		enemiesSpawned = true;
+		return;
+	}
 
-			currentSpawnLocation++;
-			if (currentSpawnLocation >= spawnLocations.size())
-			{
-				currentSpawnLocation = 0;
-			}
-			
-		}
-		else
+	// Instantiate the whole wave at once so component arrays only grow once
+	std::vector<ecs::EntityHandle> spawned = PrefabManager::LoadPrefabs(currentPrefab, static_cast<uint32_t>(numEnemiesToSpawn));
+	if (spawned.empty())
+	{
+		CONSOLE_LOG_EXPLICIT("No such prefab with name: " + currentPrefab + " exists!", LogLevel::LEVEL_ERROR);
+		enemiesSpawned = true;
+		return;
+	}
+
+	for (ecs::EntityHandle temp : spawned)
+	{
+		temp->GetTransform().SetLocalPosition(spawnLocations[currentSpawnLocation]->GetTransform().GetWorldPosition());
+
+		currentSpawnLocation++;
+		if (currentSpawnLocation >= spawnLocations.size())
 		{
-			CONSOLE_LOG_EXPLICIT("No such prefab with name: " + currentPrefab + " exists!", LogLevel::LEVEL_ERROR);
-			enemiesSpawned = true;
-			return;
+			currentSpawnLocation = 0;
 		}
 	}
 	enemiesSpawned = true;
@@ -379,10 +383,12 @@ void EnemySpawnerComponent::SetBossAlive(bool value)
 		// stop spawning droppods
 		enemiesSpawned = true;
 		// kill all drop pods
+		std::vector<ecs::EntityHandle> pods;
 		for (auto podIte = ecs::GetCompsBegin<DropPodComponent>(), endPod = ecs::GetCompsEnd<DropPodComponent>(); podIte != endPod; ++podIte)
 		{
-			ecs::DeleteEntity(podIte.GetEntity());
+			pods.push_back(podIte.GetEntity());
 		}
+		ecs::DeleteEntities(pods);
 		// kill all bossminions
 		for (auto minionIte = ecs::GetCompsBegin<BossBoundedComponent>(), endMinion = ecs::GetCompsEnd<BossBoundedComponent>(); minionIte != endMinion; ++minionIte)
 		{
@@ -31,6 +31,8 @@ All rights reserved.
 #include "IGameComponentCallbacks.h"
 #include "TweenManager.h"
 #include "PrefabManager.h"
+#include "EntityRecycler.h"
+#include "Broadphase.h"
 #include "GameSettings.h"
 
 #include "SettingsWindow.h"
@@ -49,6 +51,7 @@ All rights reserved.
 #include "Import.h"
 #include "Filesystem.h"
 #include "FunctionQueue.h"
+#include "JobSystem.h"
 
 namespace {
 
@@ -640,6 +643,7 @@ void Engine::run() {
 		ST<Game>::Get()->Update();
 		FunctionQueue::ExecuteQueuedOperations();
 		ST<Scheduler>::Get()->Update(GameTime::FixedDt() * static_cast<float>(GameTime::NumFixedFrames()));
+		ST<EntityRecycler>::Get()->Update();
 
 		// render
 		// ------
@@ -717,6 +721,8 @@ void Engine::shutdown() {
 #endif
 	ST<HiddenComponentsStore>::Destroy();
 	ST<RegisteredComponents>::Destroy();
+	ST<EntityRecycler>::Destroy();
+	ST<Physics::Broadphase>::Destroy();
 	ST<PrefabManager>::Destroy();
 	ST<PrefabWindow>::Destroy();
 #ifdef IMGUI_ENABLED
@@ -725,6 +731,7 @@ void Engine::shutdown() {
 	CSharpScripts::CSScripting::Exit();
 
 	ecs::Shutdown();
+	ST<JobSystem>::Destroy();
 
 	ST<GameSettings>::Destroy();
 	//ST<Filepaths>::Destroy(); // Filepaths kinda needs to live for other threads to reference filepaths... smart pointers will free this later. sry about this
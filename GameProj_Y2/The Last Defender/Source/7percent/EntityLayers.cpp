@@ -20,6 +20,7 @@ All rights reserved.
 /******************************************************************************/
 
 #include "EntityLayers.h"
+#include "Collision.h"
 
 // Use X Macro to obtain enum name
 #define X(name, str) str,
@@ -38,6 +39,11 @@ void EntityLayerComponent::SetLayer(ENTITY_LAYER newLayer)
 	ST<EntitiesByLayer>::Get()->MoveEntity(GetLayer(), newLayer, ecs::GetEntity(this));
 	mask.SetMask(ENTITY_LAYER::ALL, false);
 	mask.SetMask(newLayer, true);
+
+	// Colliders cache their layer so that the broadphase doesn't need to fetch this component every update
+	if (ecs::EntityHandle entity{ ecs::GetEntity(this) })
+		if (ecs::CompHandle<Physics::ColliderComp> colliderComp{ entity->GetComp<Physics::ColliderComp>() })
+			colliderComp->SetCachedLayer(newLayer);
 }
 
 ENTITY_LAYER EntityLayerComponent::GetLayer() const
@@ -398,9 +398,13 @@ namespace ecs {
 			if (compArrWithFewestComps->GetNumComps() <= numEntitiesInLayers)
 			{
 				// Execute based on components
-				System<SysType, Args...>::RunOnCompArr(*compArrWithFewestComps, [layers = layers](internal::InternalEntityHandle entity) -> bool {
+				auto layerPredicate{ [layers = layers](internal::InternalEntityHandle entity) -> bool {
 					return layers.TestMask(reinterpret_cast<EntityHandle>(entity)->GetComp<EntityLayerComponent>()->GetLayer());
-				});
+				} };
+				if constexpr (sizeof...(Args) > 1)
+					if (System<SysType, Args...>::RunOnQuery(layerPredicate))
+						return;
+				System<SysType, Args...>::RunOnCompArr(*compArrWithFewestComps, layerPredicate);
 				return;
 			}
 
@@ -0,0 +1,207 @@
+/******************************************************************************/
+/*!
+\file   EntityRecycler.cpp
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the source file implementing a class that keeps dead instances of
+  frequently spawned prefabs parked and inactive, reviving them on the next spawn
+  instead of deleting and instantiating entities every time.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#include "EntityRecycler.h"
+#include "PrefabManager.h"
+
+namespace {
+	//! The minimum number of tracked instances before untracked instances are pruned.
+	constexpr size_t MIN_PRUNE_THRESHOLD{ 1024 };
+}
+
+EntityRecycler::EntityRecycler()
+	: pruneThreshold{ MIN_PRUNE_THRESHOLD }
+{
+	SetPoolSizes(ST<GameSettings>::Get()->m_prefabPoolSizes);
+}
+
+ecs::EntityHandle EntityRecycler::Spawn(const std::string& prefabName)
+{
+	auto poolIter{ pools.find(prefabName) };
+	if (poolIter == pools.end() || !poolIter->second.capacity)
+		return PrefabManager::LoadPrefab(prefabName);
+	Pool& pool{ poolIter->second };
+
+	// Revive the most recently parked instance, which is most likely to still be in cache.
+	// Instances that were deleted by other means, or no longer match the prefab, are dropped.
+	if (const ecs::EntityTemplate* prefabTemplate{ PrefabManager::GetPrefabTemplate(prefabName) })
+		while (!pool.parked.empty())
+		{
+			InstanceKey key{ pool.parked.back() };
+			pool.parked.pop_back();
+
+			ecs::EntityHandle entity{ GetInstanceEntity(key) };
+			if (entity && ecs::ReviveInstance(entity, *prefabTemplate))
+			{
+				instances.at(key).state = INSTANCE_STATE::ALIVE;
+				++pool.stats.hits;
+				return entity;
+			}
+
+			if (entity)
+				ecs::DeleteEntity(entity);
+			instances.erase(key);
+			++pool.stats.discards;
+		}
+
+	ecs::EntityHandle entity{ PrefabManager::LoadPrefab(prefabName) };
+	if (!entity)
+		return nullptr;
+	instances.insert_or_assign(InstanceKey{ ecs::GetCurrentPoolId(), entity->GetHash() }, Instance{ &pool, INSTANCE_STATE::ALIVE });
+	++pool.stats.misses;
+	return entity;
+}
+
+void EntityRecycler::Release(ecs::EntityHandle entity)
+{
+	InstanceKey key{ ecs::GetCurrentPoolId(), entity->GetHash() };
+	auto instanceIter{ instances.find(key) };
+	if (instanceIter == instances.end())
+	{
+		ecs::DeleteEntity(entity);
+		return;
+	}
+
+	Instance& instance{ instanceIter->second };
+	if (instance.state != INSTANCE_STATE::ALIVE)
+		return;
+
+	// Don't bother keeping the instance if it's just going to be deleted when parking
+	Pool& pool{ *instance.pool };
+	if (pool.parked.size() + pool.released.size() >= pool.capacity)
+	{
+		instances.erase(instanceIter);
+		ecs::DeleteEntity(entity);
+		++pool.stats.discards;
+		return;
+	}
+
+	// Stop the instance from being updated from the next flush onwards, same as deleting it would
+	instance.state = INSTANCE_STATE::RELEASED;
+	entity->SetActive(false);
+	pool.released.push_back(key);
+}
+
+void EntityRecycler::Update()
+{
+	bool anyParked{ false };
+	for (auto& [prefabName, pool] : pools)
+	{
+		if (pool.released.empty())
+			continue;
+
+		const ecs::EntityTemplate* prefabTemplate{ PrefabManager::GetPrefabTemplate(prefabName) };
+		for (const InstanceKey& key : pool.released)
+		{
+			ecs::EntityHandle entity{ GetInstanceEntity(key) };
+			if (entity && prefabTemplate && pool.parked.size() < pool.capacity && ecs::ParkInstance(entity, *prefabTemplate))
+			{
+				instances.at(key).state = INSTANCE_STATE::PARKED;
+				pool.parked.push_back(key);
+				++pool.stats.parks;
+				anyParked = true;
+				continue;
+			}
+
+			if (entity)
+				ecs::DeleteEntity(entity);
+			instances.erase(key);
+			++pool.stats.discards;
+		}
+		pool.released.clear();
+	}
+
+	// Make sure parked instances are inactive before any system runs again
+	if (anyParked)
+		ecs::FlushChanges();
+
+	PruneInstances();
+}
+
+void EntityRecycler::SetPoolSizes(const std::map<std::string, int>& poolSizes)
+{
+	// Pools are never removed since instances point to them, so prefabs that are no longer listed are given no capacity
+	for (auto& [prefabName, pool] : pools)
+		pool.capacity = 0;
+	for (const auto& [prefabName, poolSize] : poolSizes)
+		pools[prefabName].capacity = static_cast<uint32_t>(std::max(poolSize, 0));
+
+	for (auto& [prefabName, pool] : pools)
+		while (pool.parked.size() > pool.capacity)
+		{
+			InstanceKey key{ pool.parked.back() };
+			pool.parked.pop_back();
+
+			if (ecs::EntityHandle entity{ GetInstanceEntity(key) })
+				ecs::DeleteEntity(entity);
+			instances.erase(key);
+			++pool.stats.discards;
+		}
+}
+
+std::map<std::string, EntityRecycler::PoolStats> EntityRecycler::GetStats() const
+{
+	std::map<std::string, PoolStats> stats{};
+	for (const auto& [prefabName, pool] : pools)
+	{
+		PoolStats& poolStats{ stats.emplace(prefabName, pool.stats).first->second };
+		poolStats.numParked = static_cast<uint32_t>(pool.parked.size());
+		poolStats.capacity = pool.capacity;
+	}
+	return stats;
+}
+
+void EntityRecycler::ResetStats()
+{
+	for (auto& [prefabName, pool] : pools)
+		pool.stats = PoolStats{};
+}
+
+size_t EntityRecycler::InstanceKeyHasher::operator()(const InstanceKey& key) const
+{
+	// Same mixing as boost::hash_combine
+	size_t hash{ std::hash<ecs::EntityHash>{}(key.second) };
+	hash ^= std::hash<int>{}(static_cast<int>(key.first)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	return hash;
+}
+
+ecs::EntityHandle EntityRecycler::GetInstanceEntity(const InstanceKey& key) const
+{
+	// Entities can only be retrieved from the current ECS pool
+	if (key.first != ecs::GetCurrentPoolId() || !instances.contains(key))
+		return nullptr;
+	return ecs::GetEntity(key.second);
+}
+
+void EntityRecycler::PruneInstances()
+{
+	// Instances deleted by other means (e.g. unloading a scene) are never released, so they have to be found
+	if (instances.size() < pruneThreshold)
+		return;
+
+	// Instances within other ECS pools can't be checked until that pool is current again
+	std::erase_if(instances, [this, currentPool = ecs::GetCurrentPoolId()](const auto& keyInstancePair) -> bool {
+		return keyInstancePair.first.first == currentPool && !GetInstanceEntity(keyInstancePair.first);
+	});
+	pruneThreshold = std::max(instances.size() * 2, MIN_PRUNE_THRESHOLD);
+}
@@ -0,0 +1,210 @@
+/******************************************************************************/
+/*!
+\file   EntityRecycler.h
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is an interface file for a class that keeps dead instances of frequently
+  spawned prefabs parked and inactive, reviving them on the next spawn instead of
+  deleting and instantiating entities every time.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#pragma once
+
+/*****************************************************************//*!
+\class EntityRecycler
+\brief
+	Pools instances of prefabs that are spawned and destroyed at a high rate (e.g. bullets, shell casings).
+
+	Instances that are released are deactivated immediately (buffered), and are parked at the end of the frame, where their
+	components are informed that they are detached. Handles to parked instances fail ecs::IsEntityHandleValid(), same as
+	deleted entities. Spawning a pooled prefab revives a parked instance if there is one, resetting its transforms and
+	components to the prefab's and reactivating it immediately, otherwise a new instance is instantiated from the prefab.
+	Either way, the spawned instance can be configured and used within the same frame.
+	Prefabs without a pool size are simply loaded and deleted.
+	This class is not thread safe, and must only be used from the main thread.
+*//******************************************************************/
+class EntityRecycler
+{
+public:
+	// Enable singleton without exposing constructor
+	friend class ST<EntityRecycler>;
+
+	/*****************************************************************//*!
+	\struct PoolStats
+	\brief
+		Counters for a single prefab's pool.
+	*//******************************************************************/
+	struct PoolStats
+	{
+		//! The number of spawns that revived a parked instance.
+		uint32_t hits;
+		//! The number of spawns that instantiated a new instance.
+		uint32_t misses;
+		//! The number of released instances that were parked.
+		uint32_t parks;
+		//! The number of released instances that were deleted, because the pool was full or the instance was modified.
+		uint32_t discards;
+		//! The number of instances currently parked.
+		uint32_t numParked;
+		//! The maximum number of instances that can be parked.
+		uint32_t capacity;
+	};
+
+	/*****************************************************************//*!
+	\brief
+		Spawns an instance of a prefab, reviving a parked instance if there is one.
+	\param prefabName
+		The name of the prefab.
+	\return
+		The root entity of the instance. nullptr if the prefab doesn't exist.
+	*//******************************************************************/
+	ecs::EntityHandle Spawn(const std::string& prefabName);
+
+	/*****************************************************************//*!
+	\brief
+		Releases an instance that was spawned by this class, so that it may be revived by a later spawn.
+		Entities that were not spawned by this class are deleted via ecs::DeleteEntity() instead, so this may
+		be used in place of ecs::DeleteEntity() by components that may be on either kind of entity.
+		Releasing an instance more than once has no further effect.
+	\param entity
+		The root entity of the instance.
+	*//******************************************************************/
+	void Release(ecs::EntityHandle entity);
+
+	/*****************************************************************//*!
+	\brief
+		Parks instances that were released since the last update. Detached callbacks are executed here, so this
+		must be called at a point where no components are being iterated over.
+	*//******************************************************************/
+	void Update();
+
+	/*****************************************************************//*!
+	\brief
+		Sets the maximum number of instances of each prefab that can be parked.
+		Parked instances in excess of a prefab's new size are deleted.
+	\param poolSizes
+		The maximum number of instances of each prefab, by prefab name.
+	*//******************************************************************/
+	void SetPoolSizes(const std::map<std::string, int>& poolSizes);
+
+	/*****************************************************************//*!
+	\brief
+		Gets the counters of each prefab's pool.
+	\return
+		The counters of each pool, by prefab name.
+	*//******************************************************************/
+	std::map<std::string, PoolStats> GetStats() const;
+
+	/*****************************************************************//*!
+	\brief
+		Resets the hit, miss, park and discard counters of all pools.
+	*//******************************************************************/
+	void ResetStats();
+
+private:
+	/*****************************************************************//*!
+	\enum INSTANCE_STATE
+	\brief
+		The lifetime stage of an instance spawned by this class.
+	*//******************************************************************/
+	enum class INSTANCE_STATE
+	{
+		ALIVE,
+		RELEASED,
+		PARKED
+	};
+
+	//! The ECS pool and root entity hash that an instance is keyed by. Entity hashes are only unique within an ECS pool.
+	using InstanceKey = std::pair<ecs::POOL, ecs::EntityHash>;
+
+	/*****************************************************************//*!
+	\struct InstanceKeyHasher
+	\brief
+		Hashes the key of an instance.
+	*//******************************************************************/
+	struct InstanceKeyHasher
+	{
+		/*****************************************************************//*!
+		\brief
+			Hashes the key of an instance.
+		\param key
+			The key.
+		\return
+			The hash.
+		*//******************************************************************/
+		size_t operator()(const InstanceKey& key) const;
+	};
+
+	/*****************************************************************//*!
+	\struct Pool
+	\brief
+		The instances of a single prefab.
+	*//******************************************************************/
+	struct Pool
+	{
+		//! Instances released since the last update, to be parked.
+		std::vector<InstanceKey> released;
+		//! Parked instances, ready to be revived.
+		std::vector<InstanceKey> parked;
+		//! The maximum number of parked instances.
+		uint32_t capacity;
+		//! The counters of this pool. numParked and capacity are filled in when retrieved.
+		PoolStats stats;
+	};
+
+	/*****************************************************************//*!
+	\struct Instance
+	\brief
+		An instance spawned by this class.
+	*//******************************************************************/
+	struct Instance
+	{
+		//! The pool that the instance belongs to.
+		Pool* pool;
+		//! The lifetime stage of the instance.
+		INSTANCE_STATE state;
+	};
+
+	/*****************************************************************//*!
+	\brief
+		Constructor.
+	*//******************************************************************/
+	EntityRecycler();
+
+	/*****************************************************************//*!
+	\brief
+		Gets the entity of an instance, if it still exists within the current ECS pool.
+	\param key
+		The key of the instance.
+	\return
+		The entity. nullptr if the instance isn't tracked, isn't within the current ECS pool, or its entity no longer exists.
+	*//******************************************************************/
+	ecs::EntityHandle GetInstanceEntity(const InstanceKey& key) const;
+
+	/*****************************************************************//*!
+	\brief
+		Stops tracking instances within the current ECS pool whose entities have been deleted by other means, once enough instances are tracked.
+	*//******************************************************************/
+	void PruneInstances();
+
+private:
+	//! The pool of each prefab, by prefab name.
+	std::map<std::string, Pool> pools;
+	//! The instances spawned by this class, by ECS pool and root entity hash.
+	std::unordered_map<InstanceKey, Instance, InstanceKeyHasher> instances;
+	//! The number of tracked instances at which untracked instances will next be pruned.
+	size_t pruneThreshold;
+};
@@ -89,20 +89,20 @@ EntityRefUID EntityUIDLookup::GenerateAndRegisterNewUID()
 		EntityRefUID candidateUID{ util::Rand_UID() };
 		if (uidToEntity.find(candidateUID) != uidToEntity.end())
 			continue;
-		uidToEntity.try_emplace(candidateUID, nullptr); // We'll get the entity handle later
+		uidToEntity.try_emplace(candidateUID, 0); // We'll get the entity hash later
 		return candidateUID;
 	}
 }
 
 void EntityUIDLookup::RegisterUID(EntityRefUID uid, ecs::EntityHandle entity)
 {
-	auto emplaceResult{ uidToEntity.try_emplace(uid, entity) };
+	auto emplaceResult{ uidToEntity.try_emplace(uid, (entity ? entity->GetHash() : 0)) };
 
 	// If the UID failed to emplace, the UID already exists. Try to replace the entity handle.
 	if (!emplaceResult.second && entity)
 	{
 		CONSOLE_LOG(LEVEL_WARNING) << "UID CLASH DETECTED! \"" << uid << "\". If entity reference issues occur, please try manually modifying this UID in the scene file.";
-		emplaceResult.first->second = entity;
+		emplaceResult.first->second = entity->GetHash();
 	}
 }
 
@@ -120,14 +120,15 @@ ecs::EntityHandle EntityUIDLookup::GetEntity(EntityRefUID uid)
 	if (entityIter == uidToEntityMap.end())
 		return nullptr;
 
-	if (ecs::IsEntityHandleValid(entityIter->second))
-		return entityIter->second;
-	// The handle is invalid, search for the entity with the specified UID.
+	// The slot index and generation within the hash reject entities that have since been destroyed
+	if (ecs::EntityHandle entity{ ecs::GetEntity(entityIter->second) })
+		return entity;
+	// The hash is invalid, search for the entity with the specified UID.
 	for (auto uidCompIter{ ecs::GetCompsBegin<EntityUIDComponent>() }, endCompIter{ ecs::GetCompsEnd<EntityUIDComponent>() }; uidCompIter != endCompIter; ++uidCompIter)
 		if (uidCompIter->GetUID() == uid)
 		{
-			entityIter->second = uidCompIter.GetEntity();
-			return entityIter->second;
+			entityIter->second = uidCompIter.GetEntity()->GetHash();
+			return uidCompIter.GetEntity();
 		}
 	// An entity with the requested uid doesn't exist.
 	return nullptr;
@@ -162,8 +162,9 @@ public:
 	static ecs::EntityHandle GetEntity(EntityRefUID uid);
 
 private:
-	//! The map of entity uid to entity handles (handles may not be valid)
-	std::unordered_map<EntityRefUID, ecs::EntityHandle> uidToEntity;
+	//! The map of entity uid to entity hashes (the entities may no longer exist). Hashes are kept instead of handles,
+	//! as a handle to an entity's slot stays valid-looking after the slot is reused by another entity.
+	std::unordered_map<EntityRefUID, ecs::EntityHash> uidToEntity;
 
 };
 
@@ -23,6 +23,7 @@ All rights reserved.
 #include "pch.h"
 #include "FadeAndDie.h"
 #include "RenderComponent.h"
+#include "EntityRecycler.h"
 
 FadeAndDieComponent::FadeAndDieComponent() :
 #ifdef IMGUI_ENABLED
@@ -56,8 +57,9 @@ void FadeAndDieComponent::Update(float dt)
 		renderComps[i]->SetColor(color);
 	}
 
+	// Shell casings and gibs are recycled
 	if (!stillAlive)
-		ecs::DeleteEntity(ecs::GetEntity(this));
+		ST<EntityRecycler>::Get()->Release(ecs::GetEntity(this));
 }
 
 void FadeAndDieComponent::EditorDraw(FadeAndDieComponent& comp)
@@ -25,6 +25,12 @@ All rights reserved.
 #include "GameSettings.h"
 #include "EntityLayers.h"
 #include "Engine.h"
+#include "EntityRecycler.h"
+
+namespace {
+	//! The fixed timestep used in deterministic physics mode when no fixed timestep is set, as frame times are never the same between runs.
+	constexpr float DETERMINISTIC_FIXED_DT{ 1.0f / 60.0f };
+}
 
 GameSettings::GameSettings()
 {
@@ -50,12 +56,14 @@ void GameSettings::Load()
 void GameSettings::Apply()
 {
 	ST<Engine>::Get()->setFPS(m_maxFPS);
-	GameTime::SetTargetFixedDt(m_targetFixedDt);
+	GameTime::SetTargetFixedDt(m_physicsDeterministic && m_targetFixedDt <= 0.0f ? DETERMINISTIC_FIXED_DT : m_targetFixedDt);
 	ST<Console>::Get()->SetLogLevel(static_cast<LogLevel>(m_logLevel));
 
 	ApplyVolumes();
 	ApplyFullscreen();
 
+	ST<EntityRecycler>::Get()->SetPoolSizes(m_prefabPoolSizes);
+
 	// Set everything else here!
 }
 
@@ -69,9 +77,10 @@ void GameSettings::Serialize(Serializer& writer) const
 {
 	ISerializeable::Serialize(writer);
 
-	// In addition to the reflected vars, serialize the layers here.
+	// In addition to the reflected vars, serialize the layers and pool sizes here.
 	EntityLayerComponent::SerializeLayersMatrix(writer, "collisionLayers");
 	ST<ecs::RegisteredSystemsOperatingByLayer>::Get()->SerializeLayerSettings(writer, "systemLayers");
+	writer.Serialize("prefabPoolSizes", m_prefabPoolSizes);
 }
 
 void GameSettings::Deserialize(Deserializer& reader)
@@ -80,6 +89,7 @@ void GameSettings::Deserialize(Deserializer& reader)
 
 	EntityLayerComponent::DeserializeLayersMatrix(reader, "collisionLayers");
 	ST<ecs::RegisteredSystemsOperatingByLayer>::Get()->DeserializeLayerSettings(reader, "systemLayers");
+	reader.DeserializeVar("prefabPoolSizes", &m_prefabPoolSizes);
 }
 
 void GameSettings::ApplyFullscreen()
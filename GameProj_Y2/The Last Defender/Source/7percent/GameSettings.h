@@ -75,7 +75,7 @@ public:
 
 	void ApplyVolumes();
 
-	int m_settingsversion = 12;	//Increment this every time something is added
+	int m_settingsversion = 15;	//Increment this every time something is added
 
 	// The size of the physics simulation.
 	// The physics simulation will be centered around the player, and only updates objects within this range.
@@ -83,6 +83,29 @@ public:
 	// The size of the collision simulation.
 	// Collision will be checked against all colliders within this range.
 	float m_collisionSimulationSize = 1700.0f;
+	// Physics bodies that are allowed to sleep do so once they've moved slower than this speed for this many ticks.
+	// Sleeping bodies aren't simulated, and aren't checked against static colliders, until they're woken.
+	float m_physicsSleepSpeed = 10.0f;
+	int m_physicsSleepTicks = 30;
+	// The number of iterations that the contact solver runs over each island of touching bodies, to solve velocities and then push bodies apart.
+	// More iterations let stacks of bodies settle faster, at a higher cost.
+	int m_physicsVelocityIterations = 8;
+	int m_physicsPositionIterations = 3;
+	// Whether physics is simulated deterministically, so that the same inputs always produce the same simulation (e.g. to replay bug reports).
+	// The application always steps with a fixed timestep (1/60 if m_targetFixedDt is 0 or less), and PhysicsSystem hashes the state of all physics bodies each update so that divergence can be found.
+	bool m_physicsDeterministic = false;
+
+	// The maximum number of dead instances of each prefab kept for reuse by EntityRecycler. Prefabs not listed here are not recycled.
+	std::map<std::string, int> m_prefabPoolSizes{
+		{ "Bullet", 128 },
+		{ "BulletEnemy", 128 },
+		{ "BulletImpactBlue", 32 },
+		{ "BulletImpactRed", 32 },
+		{ "Enemy Gibs", 8 },
+		{ "Laser", 32 },
+		{ "LaserEnemy", 32 },
+		{ "ShellCasing", 64 }
+	};
 
 	float m_volumeBGM = 1.0f; // 0.0f - 1.0f
 	float m_volumeSFX = 1.0f; // 0.0f - 1.0f
@@ -117,6 +140,11 @@ property_begin(GameSettings)
 
 		property_var(m_physicsSimulationSize),
 		property_var(m_collisionSimulationSize),
+		property_var(m_physicsSleepSpeed),
+		property_var(m_physicsSleepTicks),
+		property_var(m_physicsVelocityIterations),
+		property_var(m_physicsPositionIterations),
+		property_var(m_physicsDeterministic),
 
 		property_var(m_volumeBGM),
 		property_var(m_volumeSFX),
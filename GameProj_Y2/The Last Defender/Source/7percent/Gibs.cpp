@@ -22,7 +22,7 @@ All rights reserved.
 #include "pch.h"
 #include "Gibs.h"
 #include "game.h"
-#include "PrefabManager.h"
+#include "EntityRecycler.h"
 #include "Physics.h"
 
 GibsComponent::GibsComponent() :
@@ -47,7 +47,7 @@ void GibsComponent::OnDetached()
 void GibsComponent::OnDead()
 {
 	ST<Scheduler>::Get()->Add(0.0f, [prefabName = prefabName, position = ecs::GetEntityTransform(this).GetWorldPosition()]() -> void {
-		ecs::EntityHandle gibsEntity{ ST<PrefabManager>::Get()->LoadPrefab(prefabName) };
+		ecs::EntityHandle gibsEntity{ ST<EntityRecycler>::Get()->Spawn(prefabName) };
 		gibsEntity->GetTransform().SetWorldPosition(position);
 		for (auto physComp : gibsEntity->GetCompInChildrenVec<Physics::PhysicsComp>())
 		{
@@ -83,6 +83,15 @@ private:
 	*//******************************************************************/
 	static void* ConstructDefaultAndAttachNowTo(ecs::EntityHandle entity);
 
+	/*****************************************************************//*!
+	\brief
+		Reserves space for this component type so that the specified number of components can be attached
+		without the component array growing in between.
+	\param numToAdd
+		The number of components that are about to be attached.
+	*//******************************************************************/
+	static void ReserveComps(uint32_t numToAdd);
+
 	/*****************************************************************//*!
 	\brief
 		Saves a component add event to history, so it can be undone.
@@ -122,6 +131,8 @@ public:
 	void (*ConstructDefaultAndAttachTo)(ecs::EntityHandle entity);
 	//! Default construct the component and attach it immediately to the specified entity.
 	void* (*ConstructDefaultAndAttachNowTo)(ecs::EntityHandle entity);
+	//! Reserve space for a number of components of this type that are about to be attached.
+	void (*ReserveComps)(uint32_t numToAdd);
 
 	//! Save component add event to history
 	void (*SaveHistory_CompAdd)(ecs::EntityHandle entity);
@@ -213,6 +224,7 @@ bool IRegisteredComponent<CompType>::RegisterComponent()
 		.isEditorHidden = std::is_base_of_v<IHiddenComponent<CompType>, CompType>,
 		.ConstructDefaultAndAttachTo = IRegisteredComponent<CompType>::ConstructDefaultAndAttachTo,
 		.ConstructDefaultAndAttachNowTo = IRegisteredComponent<CompType>::ConstructDefaultAndAttachNowTo,
+		.ReserveComps = IRegisteredComponent<CompType>::ReserveComps,
 		.SaveHistory_CompAdd = IRegisteredComponent<CompType>::SaveHistory_CompAdd,
 		.SaveHistory_CompRemove = IRegisteredComponent<CompType>::SaveHistory_CompRemove,
 		.SerializeFuncPtr = [](const void* compPtr, Serializer& writer) -> void {
@@ -244,6 +256,12 @@ void* IRegisteredComponent<CompType>::ConstructDefaultAndAttachNowTo(ecs::Entity
 	return entity->AddCompNow(CompType{});
 }
 
+template<typename CompType>
+void IRegisteredComponent<CompType>::ReserveComps(uint32_t numToAdd)
+{
+	ecs::ReserveComps<CompType>(numToAdd);
+}
+
 template<typename CompType>
 void IRegisteredComponent<CompType>::SaveHistory_CompAdd(ecs::EntityHandle entity)
 {
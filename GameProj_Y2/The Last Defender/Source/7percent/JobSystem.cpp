@@ -0,0 +1,172 @@
+/******************************************************************************/
+/*!
+\file   JobSystem.cpp
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the source file implementing a work-stealing thread pool that executes
+  batches of jobs, blocking the caller until the whole batch has completed.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#include "JobSystem.h"
+
+JobSystem::JobSystem()
+	: numQueuedJobs{}
+	, isRunning{ true }
+	, isSingleThreaded{ false }
+	, nextQueue{}
+{
+	// Leave 1 hardware thread for the main thread, which helps to execute jobs while waiting on them anyway.
+	unsigned int numWorkers{ std::thread::hardware_concurrency() };
+	numWorkers = (numWorkers > 1 ? numWorkers - 1 : 0);
+
+	queues.reserve(numWorkers);
+	for (unsigned int i{}; i < numWorkers; ++i)
+		queues.push_back(std::make_unique<WorkerQueue>());
+
+	workers.reserve(numWorkers);
+	for (unsigned int i{}; i < numWorkers; ++i)
+		workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+	isRunning = false;
+	{
+		std::lock_guard lock{ sleepMutex };
+	}
+	sleepCondition.notify_all();
+
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+void JobSystem::Dispatch(const std::vector<JobFunc>& jobs)
+{
+	// Execute on this thread if there's nothing to gain from other threads
+	if (isSingleThreaded || workers.empty() || jobs.size() <= 1)
+	{
+		for (const JobFunc& job : jobs)
+			job();
+		return;
+	}
+
+	// Count the jobs before they're queued so workers never see more jobs than are counted
+	std::atomic<size_t> numRemaining{ jobs.size() };
+	numQueuedJobs += jobs.size();
+
+	// Distribute the jobs across the workers' queues
+	size_t queueIndex{ nextQueue.fetch_add(1) };
+	for (const JobFunc& job : jobs)
+	{
+		WorkerQueue& queue{ *queues[queueIndex++ % queues.size()] };
+		std::lock_guard lock{ queue.mutex };
+		queue.jobs.push_back(Job{ &job, &numRemaining });
+	}
+
+	// Wake the workers. The lock ensures that no worker is between checking for jobs and going to sleep.
+	{
+		std::lock_guard lock{ sleepMutex };
+	}
+	sleepCondition.notify_all();
+
+	// Help to execute jobs until this batch has completed
+	while (numRemaining.load(std::memory_order_acquire) > 0)
+		if (!TryExecuteJob(queueIndex % queues.size()))
+			std::this_thread::yield();
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t chunkSize, const std::function<void(uint32_t chunkIndex, uint32_t begin, uint32_t end)>& func)
+{
+	if (!count)
+		return;
+
+	chunkSize = std::max(chunkSize, 1u);
+	uint32_t numChunks{ (count + chunkSize - 1) / chunkSize };
+
+	std::vector<JobFunc> jobs{};
+	jobs.reserve(numChunks);
+	for (uint32_t chunkIndex{}; chunkIndex < numChunks; ++chunkIndex)
+	{
+		uint32_t begin{ chunkIndex * chunkSize };
+		uint32_t end{ std::min(begin + chunkSize, count) };
+		jobs.emplace_back([&func, chunkIndex, begin, end]() -> void {
+			func(chunkIndex, begin, end);
+		});
+	}
+
+	Dispatch(jobs);
+}
+
+size_t JobSystem::GetNumWorkers() const
+{
+	return workers.size();
+}
+
+bool JobSystem::GetIsSingleThreaded() const
+{
+	return isSingleThreaded;
+}
+
+void JobSystem::SetIsSingleThreaded(bool singleThreaded)
+{
+	isSingleThreaded = singleThreaded;
+}
+
+void JobSystem::WorkerLoop(size_t workerIndex)
+{
+	while (isRunning)
+	{
+		if (TryExecuteJob(workerIndex))
+			continue;
+
+		// Sleep until there are jobs to be executed
+		std::unique_lock lock{ sleepMutex };
+		sleepCondition.wait(lock, [this]() -> bool {
+			return numQueuedJobs > 0 || !isRunning;
+		});
+	}
+}
+
+bool JobSystem::TryExecuteJob(size_t preferredQueue)
+{
+	std::optional<Job> job{};
+	for (size_t i{}; i < queues.size() && !job; ++i)
+	{
+		WorkerQueue& queue{ *queues[(preferredQueue + i) % queues.size()] };
+		std::lock_guard lock{ queue.mutex };
+		if (queue.jobs.empty())
+			continue;
+
+		// Take from the back of our own queue, and steal from the front of others' queues
+		if (i == 0)
+		{
+			job = queue.jobs.back();
+			queue.jobs.pop_back();
+		}
+		else
+		{
+			job = queue.jobs.front();
+			queue.jobs.pop_front();
+		}
+	}
+	if (!job)
+		return false;
+
+	--numQueuedJobs;
+	(*job->func)();
+	job->numRemaining->fetch_sub(1, std::memory_order_release);
+	return true;
+}
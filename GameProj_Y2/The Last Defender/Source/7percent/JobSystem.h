@@ -0,0 +1,163 @@
+/******************************************************************************/
+/*!
+\file   JobSystem.h
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is an interface file for a work-stealing thread pool that executes batches
+  of jobs, blocking the caller until the whole batch has completed.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+
+/*****************************************************************//*!
+\class JobSystem
+\brief
+	A pool of worker threads, each owning a queue of jobs. Workers execute jobs from the back of their own queue
+	and steal from the front of other workers' queues when theirs is empty.
+	The thread that dispatches a batch of jobs helps execute jobs until the batch completes, so batches may be
+	dispatched from within jobs.
+	When single threaded, jobs are executed on the calling thread in the order they were provided.
+*//******************************************************************/
+class JobSystem
+{
+public:
+	// Enable singleton without exposing constructor/destructor
+	friend class ST<JobSystem>;
+
+	//! The function type of a job.
+	using JobFunc = std::function<void()>;
+
+	/*****************************************************************//*!
+	\brief
+		Destructor. Stops and joins worker threads.
+	*//******************************************************************/
+	~JobSystem();
+
+	/*****************************************************************//*!
+	\brief
+		Executes a batch of jobs, returning once all jobs have completed.
+	\param jobs
+		The jobs to execute. These must stay alive until this function returns.
+	*//******************************************************************/
+	void Dispatch(const std::vector<JobFunc>& jobs);
+
+	/*****************************************************************//*!
+	\brief
+		Splits a range of indexes into chunks and executes a function on each chunk, returning once all chunks have completed.
+		Chunks are split in a deterministic manner that depends only on the count and chunk size.
+	\param count
+		The number of indexes.
+	\param chunkSize
+		The maximum number of indexes in each chunk.
+	\param func
+		The function to execute on each chunk, taking the chunk's index, and the first and 1 past the last index within the chunk.
+	*//******************************************************************/
+	void ParallelFor(uint32_t count, uint32_t chunkSize, const std::function<void(uint32_t chunkIndex, uint32_t begin, uint32_t end)>& func);
+
+	/*****************************************************************//*!
+	\brief
+		Gets the number of worker threads.
+	\return
+		The number of worker threads.
+	*//******************************************************************/
+	size_t GetNumWorkers() const;
+
+	/*****************************************************************//*!
+	\brief
+		Gets whether jobs are executed on the calling thread instead of on worker threads.
+	\return
+		True if single threaded. False otherwise.
+	*//******************************************************************/
+	bool GetIsSingleThreaded() const;
+
+	/*****************************************************************//*!
+	\brief
+		Sets whether jobs are executed on the calling thread instead of on worker threads.
+		This is useful to get deterministic execution order for debugging.
+	\param singleThreaded
+		Whether to be single threaded.
+	*//******************************************************************/
+	void SetIsSingleThreaded(bool singleThreaded);
+
+private:
+	/*****************************************************************//*!
+	\struct Job
+	\brief
+		A job queued within a worker's queue.
+	*//******************************************************************/
+	struct Job
+	{
+		//! The function to execute.
+		const JobFunc* func;
+		//! The counter of remaining jobs in the batch that this job belongs to.
+		std::atomic<size_t>* numRemaining;
+	};
+
+	/*****************************************************************//*!
+	\struct WorkerQueue
+	\brief
+		The queue of jobs owned by a worker.
+	*//******************************************************************/
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	/*****************************************************************//*!
+	\brief
+		Constructor. Starts worker threads.
+	*//******************************************************************/
+	JobSystem();
+
+	/*****************************************************************//*!
+	\brief
+		The loop that worker threads execute until the job system is destroyed.
+	\param workerIndex
+		The index of the worker's queue.
+	*//******************************************************************/
+	void WorkerLoop(size_t workerIndex);
+
+	/*****************************************************************//*!
+	\brief
+		Takes a job from the back of the specified queue, or steals a job from the front of another queue, and executes it.
+	\param preferredQueue
+		The index of the queue to take from first.
+	\return
+		True if a job was executed. False if all queues are empty.
+	*//******************************************************************/
+	bool TryExecuteJob(size_t preferredQueue);
+
+private:
+	//! The queue of each worker.
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+	//! The worker threads.
+	std::vector<std::thread> workers;
+	//! The number of jobs waiting within all queues.
+	std::atomic<size_t> numQueuedJobs;
+	//! Used to put workers to sleep while there are no jobs.
+	std::mutex sleepMutex;
+	//! Used to wake workers when jobs are queued.
+	std::condition_variable sleepCondition;
+	//! Whether workers should keep running.
+	std::atomic<bool> isRunning;
+	//! Whether jobs are executed on the calling thread.
+	bool isSingleThreaded;
+	//! Used to distribute batches of jobs across worker queues.
+	std::atomic<size_t> nextQueue;
+};
@@ -23,6 +23,7 @@ All rights reserved.
 #include "pch.h"
 #include "KillAnimationWhenFinish.h"
 #include "AnimatorComponent.h"
+#include "EntityRecycler.h"
 
 KillWhenAnimationFinishComponent::KillWhenAnimationFinishComponent()
 {
@@ -41,6 +42,6 @@ void AnimationFinishSystem::Update(KillWhenAnimationFinishComponent& comp)
 {
 	if (!ecs::GetEntity(&comp)->GetComp<AnimatorComponent>()->IsPlaying())
 	{
-		ecs::DeleteEntity(ecs::GetEntity(&comp));
+		ST<EntityRecycler>::Get()->Release(ecs::GetEntity(&comp));
 	}
 }
@@ -38,6 +38,7 @@ void LightingSystem::UpdateLightComp(LightComponent& lightComp) {
 LightBlinkSystem::LightBlinkSystem()
 	: System_Internal{ &LightBlinkSystem::UpdateComp }
 {
+	AllowConcurrentExecution();
 }
 
 void LightBlinkSystem::UpdateComp(LightBlinkComponent& blinkComp, LightComponent& lightComp)
@@ -0,0 +1,214 @@
+/******************************************************************************/
+/*!
+\file   Narrowphase.cpp
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the source file implementing a batch of AABB vs AABB collision tests,
+  with a scalar reference implementation and SSE/AVX implementations that must
+  produce identical results.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#include "Narrowphase.h"
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Physics {
+
+	void AABBPairBatch::Clear()
+	{
+		posAX.clear();
+		posAY.clear();
+		halfAX.clear();
+		halfAY.clear();
+		posBX.clear();
+		posBY.clear();
+		halfBX.clear();
+		halfBY.clear();
+	}
+
+	uint32_t AABBPairBatch::Add(const Vector2& posA, const Vector2& halfLengthsA, const Vector2& posB, const Vector2& halfLengthsB)
+	{
+		posAX.push_back(posA.x);
+		posAY.push_back(posA.y);
+		halfAX.push_back(halfLengthsA.x);
+		halfAY.push_back(halfLengthsA.y);
+		posBX.push_back(posB.x);
+		posBY.push_back(posB.y);
+		halfBX.push_back(halfLengthsB.x);
+		halfBY.push_back(halfLengthsB.y);
+		return static_cast<uint32_t>(posAX.size() - 1);
+	}
+
+	void AABBPairBatch::Test()
+	{
+		static const bool useAVX{ IsAVXSupported() };
+
+		hits.resize(Size());
+		depths.resize(Size());
+		normalsX.resize(Size());
+		normalsY.resize(Size());
+
+		uint32_t index{ 0 };
+		if (useAVX)
+			index = TestAVX(index);
+		index = TestSSE(index);
+		TestScalarRange(index, Size());
+	}
+
+	void AABBPairBatch::TestScalar()
+	{
+		hits.resize(Size());
+		depths.resize(Size());
+		normalsX.resize(Size());
+		normalsY.resize(Size());
+
+		TestScalarRange(0, Size());
+	}
+
+	uint32_t AABBPairBatch::Size() const
+	{
+		return static_cast<uint32_t>(posAX.size());
+	}
+
+	bool AABBPairBatch::IsPairAt(uint32_t index, const Vector2& posA, const Vector2& posB) const
+	{
+		return posAX[index] == posA.x && posAY[index] == posA.y && posBX[index] == posB.x && posBY[index] == posB.y;
+	}
+
+	bool AABBPairBatch::IsHit(uint32_t index) const
+	{
+		return hits[index];
+	}
+
+	float AABBPairBatch::GetPenetrationDepth(uint32_t index) const
+	{
+		return depths[index];
+	}
+
+	Vector2 AABBPairBatch::GetCollisionNormal(uint32_t index) const
+	{
+		return Vector2{ normalsX[index], normalsY[index] };
+	}
+
+	bool AABBPairBatch::IsAVXSupported()
+	{
+#ifdef _MSC_VER
+		// AVX needs both the CPU to support it and the OS to save the upper halves of the registers on context switches
+		int cpuInfo[4]{};
+		__cpuid(cpuInfo, 1);
+		bool osUsesXSave{ (cpuInfo[2] & (1 << 27)) != 0 };
+		bool cpuSupportsAVX{ (cpuInfo[2] & (1 << 28)) != 0 };
+		if (!osUsesXSave || !cpuSupportsAVX)
+			return false;
+		return (_xgetbv(0) & 0x6) == 0x6;
+#else
+		return __builtin_cpu_supports("avx");
+#endif
+	}
+
+	void AABBPairBatch::TestScalarRange(uint32_t begin, uint32_t end)
+	{
+		for (uint32_t i{ begin }; i < end; ++i)
+		{
+			// Same operations as AABB::TestCollision_AABB()
+			Vector2 halfLengthsTotal{ Vector2{ halfAX[i], halfAY[i] } + Vector2{ halfBX[i], halfBY[i] } };
+			Vector2 positionDiff{ Vector2{ posBX[i], posBY[i] } - Vector2{ posAX[i], posAY[i] } };
+			Vector2 penetrationDist{ halfLengthsTotal - Abs(positionDiff) };
+
+			hits[i] = !(penetrationDist.x < 0.0f || penetrationDist.y < 0.0f);
+			if (penetrationDist.x < penetrationDist.y)
+			{
+				normalsX[i] = (positionDiff.x >= 0.0f ? -1.0f : 1.0f);
+				normalsY[i] = 0.0f;
+				depths[i] = penetrationDist.x;
+			}
+			else
+			{
+				normalsX[i] = 0.0f;
+				normalsY[i] = (positionDiff.y >= 0.0f ? -1.0f : 1.0f);
+				depths[i] = penetrationDist.y;
+			}
+		}
+	}
+
+	uint32_t AABBPairBatch::TestSSE(uint32_t begin)
+	{
+		const __m128 zero{ _mm_setzero_ps() };
+		const __m128 one{ _mm_set1_ps(1.0f) };
+		const __m128 negOne{ _mm_set1_ps(-1.0f) };
+		const __m128 signMask{ _mm_set1_ps(-0.0f) };
+
+		// SSE2 has no blend, so selects are done with and/andnot/or
+		auto select{ [](__m128 mask, __m128 ifTrue, __m128 ifFalse) -> __m128 {
+			return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+		} };
+
+		uint32_t i{ begin };
+		for (; i + 4 <= Size(); i += 4)
+		{
+			__m128 diffX{ _mm_sub_ps(_mm_loadu_ps(&posBX[i]), _mm_loadu_ps(&posAX[i])) };
+			__m128 diffY{ _mm_sub_ps(_mm_loadu_ps(&posBY[i]), _mm_loadu_ps(&posAY[i])) };
+			__m128 penX{ _mm_sub_ps(_mm_add_ps(_mm_loadu_ps(&halfAX[i]), _mm_loadu_ps(&halfBX[i])), _mm_andnot_ps(signMask, diffX)) };
+			__m128 penY{ _mm_sub_ps(_mm_add_ps(_mm_loadu_ps(&halfAY[i]), _mm_loadu_ps(&halfBY[i])), _mm_andnot_ps(signMask, diffY)) };
+
+			// Comparisons are chosen so that NaNs resolve the same way as the scalar implementation's
+			int hitBits{ _mm_movemask_ps(_mm_and_ps(_mm_cmpnlt_ps(penX, zero), _mm_cmpnlt_ps(penY, zero))) };
+			__m128 useX{ _mm_cmplt_ps(penX, penY) };
+			__m128 signX{ select(_mm_cmpge_ps(diffX, zero), negOne, one) };
+			__m128 signY{ select(_mm_cmpge_ps(diffY, zero), negOne, one) };
+
+			_mm_storeu_ps(&depths[i], select(useX, penX, penY));
+			_mm_storeu_ps(&normalsX[i], _mm_and_ps(useX, signX));
+			_mm_storeu_ps(&normalsY[i], _mm_andnot_ps(useX, signY));
+			for (int lane{}; lane < 4; ++lane)
+				hits[i + lane] = static_cast<uint8_t>((hitBits >> lane) & 1);
+		}
+		return i;
+	}
+
+	uint32_t AABBPairBatch::TestAVX(uint32_t begin)
+	{
+		const __m256 zero{ _mm256_setzero_ps() };
+		const __m256 one{ _mm256_set1_ps(1.0f) };
+		const __m256 negOne{ _mm256_set1_ps(-1.0f) };
+		const __m256 signMask{ _mm256_set1_ps(-0.0f) };
+
+		uint32_t i{ begin };
+		for (; i + 8 <= Size(); i += 8)
+		{
+			__m256 diffX{ _mm256_sub_ps(_mm256_loadu_ps(&posBX[i]), _mm256_loadu_ps(&posAX[i])) };
+			__m256 diffY{ _mm256_sub_ps(_mm256_loadu_ps(&posBY[i]), _mm256_loadu_ps(&posAY[i])) };
+			__m256 penX{ _mm256_sub_ps(_mm256_add_ps(_mm256_loadu_ps(&halfAX[i]), _mm256_loadu_ps(&halfBX[i])), _mm256_andnot_ps(signMask, diffX)) };
+			__m256 penY{ _mm256_sub_ps(_mm256_add_ps(_mm256_loadu_ps(&halfAY[i]), _mm256_loadu_ps(&halfBY[i])), _mm256_andnot_ps(signMask, diffY)) };
+
+			// Comparisons are chosen so that NaNs resolve the same way as the scalar implementation's
+			int hitBits{ _mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(penX, zero, _CMP_NLT_UQ), _mm256_cmp_ps(penY, zero, _CMP_NLT_UQ))) };
+			__m256 useX{ _mm256_cmp_ps(penX, penY, _CMP_LT_OQ) };
+			__m256 signX{ _mm256_blendv_ps(one, negOne, _mm256_cmp_ps(diffX, zero, _CMP_GE_OQ)) };
+			__m256 signY{ _mm256_blendv_ps(one, negOne, _mm256_cmp_ps(diffY, zero, _CMP_GE_OQ)) };
+
+			_mm256_storeu_ps(&depths[i], _mm256_blendv_ps(penY, penX, useX));
+			_mm256_storeu_ps(&normalsX[i], _mm256_and_ps(useX, signX));
+			_mm256_storeu_ps(&normalsY[i], _mm256_andnot_ps(useX, signY));
+			for (int lane{}; lane < 8; ++lane)
+				hits[i + lane] = static_cast<uint8_t>((hitBits >> lane) & 1);
+		}
+		return i;
+	}
+
+}
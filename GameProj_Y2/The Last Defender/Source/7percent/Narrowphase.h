@@ -0,0 +1,197 @@
+/******************************************************************************/
+/*!
+\file   Narrowphase.h
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the interface file for a batch of AABB vs AABB collision tests, which
+  are stored as separate arrays of each component so that multiple pairs can be
+  tested at once with SIMD instructions.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#pragma once
+
+namespace Physics {
+
+	/*****************************************************************//*!
+	\class AABBPairBatch
+	\brief
+		A batch of AABB vs AABB collision tests. The penetration depth and normal of each pair are calculated
+		exactly as AABB::TestCollision_AABB() does, with the first AABB of each pair as the reference collider,
+		so that results can be used in place of testing the pair individually.
+
+		Pairs are tested 8 at a time with AVX if the CPU supports it, otherwise 4 at a time with SSE.
+	*//******************************************************************/
+	class AABBPairBatch
+	{
+	public:
+		//! The index representing a pair that is not within the batch.
+		static constexpr uint32_t NO_INDEX{ std::numeric_limits<uint32_t>::max() };
+
+		/*****************************************************************//*!
+		\brief
+			Removes all pairs from the batch.
+		*//******************************************************************/
+		void Clear();
+
+		/*****************************************************************//*!
+		\brief
+			Adds a pair of AABBs to the batch.
+		\param posA
+			The world position of the reference AABB.
+		\param halfLengthsA
+			The half lengths of the reference AABB.
+		\param posB
+			The world position of the other AABB.
+		\param halfLengthsB
+			The half lengths of the other AABB.
+		\return
+			The index of the pair within the batch.
+		*//******************************************************************/
+		uint32_t Add(const Vector2& posA, const Vector2& halfLengthsA, const Vector2& posB, const Vector2& halfLengthsB);
+
+		/*****************************************************************//*!
+		\brief
+			Tests all pairs within the batch using SIMD instructions.
+		*//******************************************************************/
+		void Test();
+
+		/*****************************************************************//*!
+		\brief
+			Tests all pairs within the batch one at a time. This is the reference that Test() must match exactly.
+		*//******************************************************************/
+		void TestScalar();
+
+		/*****************************************************************//*!
+		\brief
+			Gets the number of pairs within the batch.
+		\return
+			The number of pairs.
+		*//******************************************************************/
+		uint32_t Size() const;
+
+		/*****************************************************************//*!
+		\brief
+			Checks whether a pair was added with the specified positions, meaning the result of the pair is still valid
+			for AABBs at these positions. Half lengths are assumed to be unchanged.
+		\param index
+			The index of the pair.
+		\param posA
+			The world position of the reference AABB.
+		\param posB
+			The world position of the other AABB.
+		\return
+			True if the pair was added with these positions. False otherwise.
+		*//******************************************************************/
+		bool IsPairAt(uint32_t index, const Vector2& posA, const Vector2& posB) const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets whether a pair's AABBs are colliding, as of the last test.
+		\param index
+			The index of the pair.
+		\return
+			True if the AABBs are colliding. False otherwise.
+		*//******************************************************************/
+		bool IsHit(uint32_t index) const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets the penetration depth of a colliding pair, as of the last test.
+		\param index
+			The index of the pair.
+		\return
+			The penetration depth.
+		*//******************************************************************/
+		float GetPenetrationDepth(uint32_t index) const;
+
+		/*****************************************************************//*!
+		\brief
+			Gets the collision normal of a colliding pair relative to the reference AABB, as of the last test.
+		\param index
+			The index of the pair.
+		\return
+			The collision normal.
+		*//******************************************************************/
+		Vector2 GetCollisionNormal(uint32_t index) const;
+
+		/*****************************************************************//*!
+		\brief
+			Checks whether the CPU and OS support AVX instructions.
+		\return
+			True if AVX can be used. False otherwise.
+		*//******************************************************************/
+		static bool IsAVXSupported();
+
+	private:
+		/*****************************************************************//*!
+		\brief
+			Tests a range of pairs one at a time.
+		\param begin
+			The index of the first pair.
+		\param end
+			The index after the last pair.
+		*//******************************************************************/
+		void TestScalarRange(uint32_t begin, uint32_t end);
+
+		/*****************************************************************//*!
+		\brief
+			Tests pairs 4 at a time with SSE, for as many complete groups of 4 as there are from an index.
+		\param begin
+			The index of the first pair.
+		\return
+			The index of the first pair that was not tested.
+		*//******************************************************************/
+		uint32_t TestSSE(uint32_t begin);
+
+		/*****************************************************************//*!
+		\brief
+			Tests pairs 8 at a time with AVX, for as many complete groups of 8 as there are from an index.
+		\param begin
+			The index of the first pair.
+		\return
+			The index of the first pair that was not tested.
+		*//******************************************************************/
+		uint32_t TestAVX(uint32_t begin);
+
+	private:
+		//! The x positions of the reference AABBs.
+		std::vector<float> posAX;
+		//! The y positions of the reference AABBs.
+		std::vector<float> posAY;
+		//! The x half lengths of the reference AABBs.
+		std::vector<float> halfAX;
+		//! The y half lengths of the reference AABBs.
+		std::vector<float> halfAY;
+		//! The x positions of the other AABBs.
+		std::vector<float> posBX;
+		//! The y positions of the other AABBs.
+		std::vector<float> posBY;
+		//! The x half lengths of the other AABBs.
+		std::vector<float> halfBX;
+		//! The y half lengths of the other AABBs.
+		std::vector<float> halfBY;
+
+		//! Whether each pair is colliding. Non-zero if so.
+		std::vector<uint8_t> hits;
+		//! The penetration depth of each pair.
+		std::vector<float> depths;
+		//! The x component of the collision normal of each pair.
+		std::vector<float> normalsX;
+		//! The y component of the collision normal of each pair.
+		std::vector<float> normalsY;
+	};
+
+}
@@ -25,6 +25,11 @@ All rights reserved.
 #include "Performance.h"
 
 #include "ryan-c/VulkanManager.h"
+#include "JobSystem.h"
+#include "EntityRecycler.h"
+#include "Broadphase.h"
+#include "Engine.h"
+#include "ryan-c/Renderer.h"
 
 #ifdef max
 #undef max
@@ -205,6 +210,74 @@ void PerformanceProfiler::DrawContents() {
         ImGui::Unindent();
     }
 
+    if(ImGui::CollapsingHeader("Parallel Systems")) {
+        bool parallelSystemsEnabled{ ecs::GetParallelSystemsEnabled() };
+        if(ImGui::Checkbox("Run Systems Concurrently", &parallelSystemsEnabled))
+            ecs::SetParallelSystemsEnabled(parallelSystemsEnabled);
+        ImGui::Text("Worker Threads: %zu", ST<JobSystem>::Get()->GetNumWorkers());
+
+        // Speedup compares the time the layer's systems would take one after another against the time the layer actually took
+        ImGui::Text("Layer Speedup:");
+        ImGui::Indent();
+        bool anyConcurrentLayer{ false };
+        for(const auto& [layer, stats] : ecs::GetSystemsLayerStats()) {
+            if(!stats.numConcurrentSystems)
+                continue;
+            anyConcurrentLayer = true;
+            ImGui::Text("Layer %d: %u/%u systems in %u batches, %.3f ms serial / %.3f ms actual (%.2fx)",
+                        layer,
+                        stats.numConcurrentSystems,
+                        stats.numSystems,
+                        stats.numBatches,
+                        stats.serialMs,
+                        stats.wallMs,
+                        stats.wallMs > 0.0f ? stats.serialMs / stats.wallMs : 1.0f);
+        }
+        if(!anyConcurrentLayer)
+            ImGui::Text("No layers ran systems concurrently.");
+        ImGui::Unindent();
+    }
+
+    if(ImGui::CollapsingHeader("Entity Recycling")) {
+        // A hit is a spawn that revived a parked instance, a miss is a spawn that had to instantiate the prefab
+        if(ImGui::Button("Reset Counters"))
+            ST<EntityRecycler>::Get()->ResetStats();
+        ImGui::Indent();
+        for(const auto& [prefabName, stats] : ST<EntityRecycler>::Get()->GetStats()) {
+            uint32_t numSpawns{ stats.hits + stats.misses };
+            ImGui::Text("%s: %u hits / %u misses (%.1f%%), %u/%u parked, %u parks, %u discards",
+                        prefabName.c_str(),
+                        stats.hits,
+                        stats.misses,
+                        numSpawns ? static_cast<float>(stats.hits) / static_cast<float>(numSpawns) * 100.0f : 0.0f,
+                        stats.numParked,
+                        stats.capacity,
+                        stats.parks,
+                        stats.discards);
+        }
+        ImGui::Unindent();
+    }
+
+    if(ImGui::CollapsingHeader("Physics Bodies")) {
+        // Static colliders are never paired with each other, and sleeping bodies are skipped until woken
+        Physics::Broadphase::BodyCounts counts{ ST<Physics::Broadphase>::Get()->GetBodyCounts() };
+        ImGui::Text("Dynamic: %u awake / %u sleeping", counts.numAwake, counts.numSleeping);
+        ImGui::Text("Kinematic: %u", counts.numKinematic);
+        ImGui::Text("Static: %u", counts.numStatic);
+        ImGui::Text("Broadphase Pairs: %u", counts.numPairs);
+    }
+
+    if(ImGui::CollapsingHeader("Render Culling")) {
+        // Render components that are off screen are culled before their sprite instances are built
+        const Renderer::CullingStats& stats{ ST<Engine>::Get()->_vulkan->_renderer->getCullingStats() };
+        uint32_t numTested{ stats.numCulled + stats.numDrawn };
+        ImGui::Text("Drawn: %u", stats.numDrawn);
+        ImGui::Text("Culled: %u (%.1f%%)", stats.numCulled,
+                    numTested ? static_cast<float>(stats.numCulled) / static_cast<float>(numTested) * 100.0f : 0.0f);
+        ImGui::Text("Culled By Grid: %u", stats.numCulledByGrid);
+        ImGui::Text("Static In Grid: %u", stats.numStatic);
+    }
+
     if(ImGui::CollapsingHeader("Memory Usage", ImGuiTreeNodeFlags_DefaultOpen)) {
         ImGui::Text("Current: %.2f MB", memoryUsageMB);
         ImGui::Text("Peak: %.2f MB", max_memory);
@@ -33,6 +33,15 @@ static const char* physicsFlagNames[]{
 };
 #undef X
 
+namespace {
+	//! The fixed timestep enforced in deterministic mode when the application isn't stepping with a fixed timestep.
+	constexpr float DETERMINISTIC_DT{ 1.0f / 60.0f };
+	//! The starting value of a 64-bit FNV-1a hash.
+	constexpr uint64_t FNV_OFFSET_BASIS{ 14695981039346656037ull };
+	//! The prime that a 64-bit FNV-1a hash is multiplied by for each byte.
+	constexpr uint64_t FNV_PRIME{ 1099511628211ull };
+}
+
 namespace Physics
 {
 
@@ -51,6 +60,14 @@ namespace Physics
 		, frictionCoeff{ params.frictionCoeff }
 		, velocity{}
 		, angVelocity{ 0.0f }
+		, canSleep{ false }
+		, isSleeping{ false }
+		, hasRestingContact{ false }
+		, ticksAtRest{ 0 }
+		, isContinuous{ false }
+		, hasSweep{ false }
+		, sweepStart{}
+		, sweepEnd{}
 	{
 	}
 
@@ -62,6 +79,7 @@ namespace Physics
 		if (!IsDynamic())
 			return;
 
+		Wake();
 		AddVelocity(impulse * GetMassReciprocal());
 		if (canRotate && !IsRotationLocked())
 			// DIRTY FIX REMOVE WHEN PROJECT ENDS!
@@ -76,10 +94,14 @@ namespace Physics
 	}
 	void PhysicsComp::SetVelocity(const Vector2& newVel)
 	{
+		if (newVel != velocity)
+			Wake();
 		velocity = newVel;
 	}
 	void PhysicsComp::AddVelocity(const Vector2& addVel)
 	{
+		if (addVel != Vector2{})
+			Wake();
 		velocity += addVel;
 	}
 
@@ -142,6 +164,7 @@ namespace Physics
 	}
 	void PhysicsComp::SetIsDynamic(bool isDynamic)
 	{
+		Wake();
 		return SetFlag(PHYSICS_COMP_FLAG::IS_DYNAMIC, isDynamic);
 	}
 
@@ -156,6 +179,89 @@ namespace Physics
 			angVelocity = 0.0f;
 	}
 
+	bool PhysicsComp::CanSleep() const
+	{
+		return canSleep;
+	}
+	void PhysicsComp::SetCanSleep(bool newCanSleep)
+	{
+		canSleep = newCanSleep;
+		if (!canSleep)
+			Wake();
+	}
+
+	bool PhysicsComp::IsSleeping() const
+	{
+		return isSleeping;
+	}
+	void PhysicsComp::Wake()
+	{
+		if (!isSleeping)
+			return;
+
+		isSleeping = false;
+		ticksAtRest = 0;
+	}
+
+	void PhysicsComp::UpdateSleep(float maxSleepSpeed, int ticksToSleep)
+	{
+		if (isSleeping)
+		{
+			// If whatever this was resting on is gone, gravity should pull it down again
+			if (IsGravityEnabled() && !hasRestingContact)
+				Wake();
+			hasRestingContact = false;
+			return;
+		}
+
+		if (!canSleep || ticksToSleep <= 0 ||
+			velocity.LengthSquared() > maxSleepSpeed * maxSleepSpeed || std::fabs(angVelocity) > maxSleepSpeed)
+		{
+			ticksAtRest = 0;
+			return;
+		}
+		if (++ticksAtRest < ticksToSleep)
+			return;
+
+		isSleeping = true;
+		velocity = Vector2{};
+		angVelocity = 0.0f;
+		// The collision system hasn't had a chance to find what this is resting on yet
+		hasRestingContact = true;
+	}
+
+	void PhysicsComp::NotifyRestingContact()
+	{
+		hasRestingContact = true;
+	}
+
+	bool PhysicsComp::IsContinuous() const
+	{
+		return isContinuous;
+	}
+	void PhysicsComp::SetIsContinuous(bool newIsContinuous)
+	{
+		isContinuous = newIsContinuous;
+		hasSweep = false;
+	}
+
+	void PhysicsComp::RecordSweep(const Vector2& start, const Vector2& end)
+	{
+		hasSweep = true;
+		sweepStart = start;
+		sweepEnd = end;
+	}
+	bool PhysicsComp::TakeSweep(Vector2* outStart, Vector2* outEnd)
+	{
+		if (!hasSweep)
+			return false;
+
+		hasSweep = false;
+		*outStart = sweepStart;
+		*outEnd = sweepEnd;
+		return true;
+	}
+
 #ifdef IMGUI_ENABLED
 	void PhysicsComp::EditorDraw(PhysicsComp& comp)
 	{
@@ -166,6 +272,19 @@ namespace Physics
 		gui::VarDrag("Mass", &comp.mass, 0.02f, 0.01f, 50.0f);
 		gui::VarDrag("Restitution", &comp.restitutionCoeff, 0.002f, 0.0f, 1.0f);
 		gui::VarDrag("Friction", &comp.frictionCoeff, 0.002f, 0.0f, 1.0f, "%.2f");
+
+		bool canSleep{ comp.canSleep };
+		if (ImGui::Checkbox("Can Sleep", &canSleep))
+			comp.SetCanSleep(canSleep);
+		if (comp.isSleeping)
+		{
+			ImGui::SameLine();
+			ImGui::TextDisabled("(Sleeping)");
+		}
+
+		bool isContinuous{ comp.isContinuous };
+		if (ImGui::Checkbox("Continuous Collision", &isContinuous))
+			comp.SetIsContinuous(isContinuous);
 	}
 #endif
 
@@ -178,6 +297,8 @@ namespace Physics
 		writer.Serialize("frictionCoeff", frictionCoeff);
 		writer.Serialize("angVelocity", angVelocity);
 		writer.Serialize("velocity", velocity);
+		writer.Serialize("canSleep", canSleep);
+		writer.Serialize("continuousCollision", isContinuous);
 	}
 
 	void PhysicsComp::Deserialize(Deserializer& reader)
@@ -189,37 +310,74 @@ namespace Physics
 		reader.DeserializeVar("frictionCoeff", &frictionCoeff);
 		reader.DeserializeVar("angVelocity", &angVelocity);
 		reader.DeserializeVar("velocity", &velocity);
+		reader.DeserializeVar("canSleep", &canSleep);
+		reader.DeserializeVar("continuousCollision", &isContinuous);
 	}
 
 #pragma endregion // PhysicsComp
 
 #pragma region PhysicsSystem
 
+	uint64_t ComputeFrameHash()
+	{
+		// FNV-1a over the exact bits of each value, so that even the smallest difference changes the hash
+		uint64_t hash{ FNV_OFFSET_BASIS };
+		auto hashBytes{ [&hash](const void* data, size_t size) -> void {
+			const uint8_t* bytes{ static_cast<const uint8_t*>(data) };
+			for (size_t i{}; i < size; ++i)
+				hash = (hash ^ bytes[i]) * FNV_PRIME;
+		} };
+
+		for (auto physCompIter{ ecs::GetCompsActiveBegin<PhysicsComp>() }, endIter{ ecs::GetCompsEnd<PhysicsComp>() }; physCompIter != endIter; ++physCompIter)
+		{
+			const Transform& transform{ physCompIter.GetEntity()->GetTransform() };
+			ecs::EntityHash entity{ physCompIter.GetEntity()->GetHash() };
+			Vector2 position{ transform.GetWorldPosition() };
+			float rotation{ transform.GetWorldRotation() };
+			const Vector2& velocity{ physCompIter->GetVelocity() };
+			float angVelocity{ physCompIter->GetAngVelocity() };
+
+			hashBytes(&entity, sizeof(entity));
+			hashBytes(&position.x, sizeof(float));
+			hashBytes(&position.y, sizeof(float));
+			hashBytes(&rotation, sizeof(float));
+			hashBytes(&velocity.x, sizeof(float));
+			hashBytes(&velocity.y, sizeof(float));
+			hashBytes(&angVelocity, sizeof(float));
+		}
+		return hash;
+	}
+
 	PhysicsSystem::PhysicsSystem()
 		: SystemOperatingByLayer{ &PhysicsSystem::UpdatePhysComp }
 		, gravity{ -980.0f }
 		, dt{}
-		, emptyComp{ PhysicsCompParams{.isDynamic = false } } // Make emptyComp static
 		, simulationCenter{}
 		, simulationHalfLength{ 2048.0f }
+		, sleepSpeed{ ST<GameSettings>::Get()->m_physicsSleepSpeed }
+		, ticksToSleep{ ST<GameSettings>::Get()->m_physicsSleepTicks }
+		, frameHash{}
+		, frameNumber{}
 	{
 	}
 
-	void PhysicsSystem::OnAdded()
-	{
-		Messaging::Subscribe("OnCollision", PhysicsSystem::OnCollisionOccured);
-	}
-
-	void PhysicsSystem::OnRemoved()
-	{
-		Messaging::Unsubscribe("OnCollision", PhysicsSystem::OnCollisionOccured);
-	}
-
 	bool PhysicsSystem::PreRun()
 	{
 		dt = GameTime::FixedDt();
+		if (ST<GameSettings>::Get()->m_physicsDeterministic)
+		{
+			// Variable dt comes from frame times, which are never the same between runs. Deterministic mode was turned on
+			// without applying settings, so switch to fixed steps, which are accumulated from the next frame onwards.
+			if (!GameTime::IsFixedDtMode())
+			{
+				GameTime::SetTargetFixedDt(DETERMINISTIC_DT);
+				dt = DETERMINISTIC_DT;
+			}
+			frameHash = ComputeFrameHash();
+			++frameNumber;
+		}
 		// In case we're in variable dt mode, limit timestep
-		if (!GameTime::IsFixedDtMode() && dt > 1.0f / 60.0f)
+		else if (!GameTime::IsFixedDtMode() && dt > 1.0f / 60.0f)
 			dt = 1.0f / 60.0f;
 
 		// Setup simulation area
@@ -228,84 +386,27 @@ namespace Physics
 			simulationCenter = playerCompsIter.GetEntity()->GetTransform().GetWorldPosition();
 		simulationHalfLength = ST<GameSettings>::Get()->m_physicsSimulationSize * 0.5f;
 
+		sleepSpeed = ST<GameSettings>::Get()->m_physicsSleepSpeed;
+		ticksToSleep = ST<GameSettings>::Get()->m_physicsSleepTicks;
+
 		ST<GameManager>::Get()->Update(); // Update GameManager within physics system
 
 		return true;
 	}
 
-	void PhysicsSystem::ProcessCollision(ColliderComp& refComp, ecs::CompHandle<PhysicsComp> refPhysComp, ColliderComp& otherComp, ecs::CompHandle<PhysicsComp> otherPhysComp, const CollisionData* collisionData)
-	{
-		// Assume at least one of the physics comps are valid due to how collision system checks for collisions.
-		// If either physics comps are null, use emptyComp to simulate default physics parameters.
-		if (!otherPhysComp)
-			otherPhysComp = &emptyComp;
-		else if (!refPhysComp)
-			refPhysComp = &emptyComp;
-
-		// References to shorten names
-		const Vector2& normal{ collisionData->collisionNormal };
-		const Vector2& point{ collisionData->collisionPoint };
-
-		auto compIter{ ecs::GetCompsBegin<PointTestComp>() };
-		if (compIter != ecs::GetCompsEnd<PointTestComp>())
-			ecs::GetEntity(compIter.GetComp())->GetTransform().SetWorldPosition(point);
-
-		Transform& refTransform{ ecs::GetEntityTransform(&refComp) };
-		Transform& otherTransform{ ecs::GetEntityTransform(&otherComp) };
-
-		// Get distance from center to collision point.
-		Vector2 r1 = point - refTransform.GetWorldPosition();
-		Vector2 r2 = point - otherTransform.GetWorldPosition();
-		// Rotate these distances by 90 degrees to get perpendicular vector
-		Vector2 r1Perp = r1.Rotate90();
-		Vector2 r2Perp = r2.Rotate90();
-		Vector2 angLinearVel1 = r1Perp * math::ToRadians(refPhysComp->GetAngVelocity());
-		Vector2 angLinearVel2 = r2Perp * math::ToRadians(otherPhysComp->GetAngVelocity());
-		// Calculate relative velocity between the 2 colliders at the collision point
-		Vector2 relativeVelocity = (refPhysComp->GetVelocity() + angLinearVel1) - (otherPhysComp->GetVelocity() + angLinearVel2);
-
-		// If colliders are heading away from the collision, we shouldn't need to do anything
-		float dotVal = relativeVelocity.Dot(normal);
-		if (dotVal >= 0.0f)
-			return;
+	float PhysicsSystem::GetDt() const
+	{
+		return dt;
+	}
 
-		// Get the component of the perpendicular distances in the direction of the collision normal
-		float r1PerpDotNorm = r1Perp.Dot(normal);
-		float r2PerpDotNorm = r2Perp.Dot(normal);
-
-		// Calculate the restitution involved in this collision
-		float avgRestitution = (refPhysComp->GetRestitutionCoeff() + otherPhysComp->GetRestitutionCoeff()) * 0.5f;
-		// Calculate the velocity change value applied in the normal, ignoring mass/inertia for now
-		float velChangeByNormal = -(relativeVelocity * (1.0f + avgRestitution)).Dot(normal);
-		// Calculate the denominator consisting of mass and inertia that will make impulse take mass/inertia into account
-		// but only include inertia if the physics collider is dynamic.
-		float denominator = (refPhysComp->GetMassReciprocal() + otherPhysComp->GetMassReciprocal()); // mass
-		if (refPhysComp->IsDynamic())
-			denominator += math::PowSqr(r1PerpDotNorm) * refComp.GetMomentOfInertiaReciprocal(); // obj1 inertia
-		if (otherPhysComp->IsDynamic())
-			denominator += math::PowSqr(r2PerpDotNorm) * otherComp.GetMomentOfInertiaReciprocal(); // obj2 inertia
-		// Get the impulse applied onto both objects
-		float impulseMag = velChangeByNormal / denominator;
-		Vector2 impulse = normal * impulseMag;
-
-		// Calculate the friction involved in this collision
-		float actingFriction = std::min(refPhysComp->GetFrictionCoeff(), otherPhysComp->GetFrictionCoeff());
-		// Calculate the direction of friction
-		Vector2 frictionDir = normal.Rotate90();
-		if (relativeVelocity.Dot(frictionDir) > 0.0f)
-			frictionDir = -frictionDir;
-		// Calculate the velocity change value applied by friction, ignoring mass/inertia for now
-		float velChangeByFriction = -(relativeVelocity * 0.5f * actingFriction).Dot(frictionDir);
-		// Get the impulse applied by friction
-		float fricImpulseMag = velChangeByFriction / denominator;
-		impulse += frictionDir * fricImpulseMag * 100.0f * dt;
-
-		// Apply linear and angular velocity changes
-		refPhysComp->ApplyImpulse(impulse, r1, refComp.GetMomentOfInertia(), refComp.SupportsRotation());
-		if (otherPhysComp->IsDynamic())
-			otherPhysComp->ApplyImpulse(-impulse, r2, otherComp.GetMomentOfInertia(), otherComp.SupportsRotation());
-		//LimitVelocity(obj1);
-		//LimitVelocity(obj2);
+	uint64_t PhysicsSystem::GetFrameHash() const
+	{
+		return frameHash;
+	}
+
+	uint32_t PhysicsSystem::GetFrameNumber() const
+	{
+		return frameNumber;
 	}
 
 	void PhysicsSystem::UpdatePhysComp(PhysicsComp& physComp)
@@ -316,7 +417,12 @@ namespace Physics
 
 		// Only update this object if it's within the simulation range
 		Transform& transform{ ecs::GetEntityTransform(&physComp) };
-		if (!QuadTree::CheckIsOverlapping(simulationCenter, simulationHalfLength, transform.GetWorldPosition(), transform.GetWorldScale() * 0.5f))
+		if (!CheckIsOverlapping(simulationCenter, simulationHalfLength, transform.GetWorldPosition(), transform.GetWorldScale() * 0.5f))
+			return;
+
+		// Bodies that have come to rest aren't simulated until something wakes them
+		physComp.UpdateSleep(sleepSpeed, ticksToSleep);
+		if (physComp.IsSleeping())
 			return;
 
 		// Apply gravity and update position
@@ -324,22 +430,18 @@ namespace Physics
 		if (physComp.IsGravityEnabled())
 			finalVelocity.y += gravity * dt;
 
+		Vector2 startPosition{ transform.GetWorldPosition() };
 		transform.AddWorldPosition((physComp.GetVelocity() + finalVelocity) * (0.5f * dt));
 		physComp.SetVelocity(finalVelocity);
 
+		// Continuous components are swept along the path they moved by the CollisionSystem
+		if (physComp.IsContinuous())
+			physComp.RecordSweep(startPosition, transform.GetWorldPosition());
+
 		if (!physComp.IsRotationLocked())
 			transform.AddWorldRotation(physComp.GetAngVelocity() * dt);
 	}
 
-	void PhysicsSystem::OnCollisionOccured(const CollisionEventData& param)
-	{
-		// Don't apply velocity changes if this is a collision with a trigger.
-		if (param.isCollisionWithTrigger)
-			return;
-
-		ecs::GetSystem<PhysicsSystem>()->ProcessCollision(*param.refComp, param.refPhysComp, *param.otherComp, param.otherPhysComp, param.collisionData);
-	}
-
 	PhysicsVelocityDebugSystem::PhysicsVelocityDebugSystem()
 		: System_Internal{ &PhysicsVelocityDebugSystem::RenderComp }
 	{
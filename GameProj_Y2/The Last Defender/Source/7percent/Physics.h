@@ -263,6 +263,97 @@ X(ROTATION_LOCKED, "Lock Rotation")
 		*//******************************************************************/
 		void SetIsRotationLocked(bool isRotationLocked);
 
+		/*****************************************************************//*!
+		\brief
+			Gets whether this component is allowed to fall asleep once it comes to rest.
+		\return
+			True if this component can sleep. False otherwise.
+		*//******************************************************************/
+		bool CanSleep() const;
+
+		/*****************************************************************//*!
+		\brief
+			Sets whether this component is allowed to fall asleep once it comes to rest.
+			If not, it is woken immediately.
+		\param canSleep
+			Whether this component can sleep.
+		*//******************************************************************/
+		void SetCanSleep(bool canSleep);
+
+		/*****************************************************************//*!
+		\brief
+			Gets whether this component is sleeping, meaning it is not simulated until something wakes it.
+		\return
+			True if this component is sleeping. False otherwise.
+		*//******************************************************************/
+		bool IsSleeping() const;
+
+		/*****************************************************************//*!
+		\brief
+			Wakes this component if it is sleeping. Changing velocity or applying an impulse also wakes this component.
+		*//******************************************************************/
+		void Wake();
+
+		/*****************************************************************//*!
+		\brief
+			Puts this component to sleep if it has been at rest for long enough, or wakes it if gravity
+			would pull it down because it was no longer found resting against anything.
+			This is called by the PhysicsSystem every update, before this component is simulated.
+		\param maxSleepSpeed
+			The speed, in units (or degrees for angular velocity) per second, below which this component is at rest.
+		\param ticksToSleep
+			The number of consecutive updates this component must be at rest for before it sleeps. Sleeping is disabled if 0 or less.
+		*//******************************************************************/
+		void UpdateSleep(float maxSleepSpeed, int ticksToSleep);
+
+		/*****************************************************************//*!
+		\brief
+			Informs this component that a contact it had with something persisted while sleeping, so it is still supported.
+			This is called by the CollisionSystem.
+		*//******************************************************************/
+		void NotifyRestingContact();
+
+		/*****************************************************************//*!
+		\brief
+			Gets whether this component uses continuous collision detection, where the CollisionSystem sweeps its collider
+			along the path it moved each update to find anything it would have passed through.
+		\return
+			True if this component uses continuous collision detection. False otherwise.
+		*//******************************************************************/
+		bool IsContinuous() const;
+
+		/*****************************************************************//*!
+		\brief
+			Sets whether this component uses continuous collision detection.
+		\param isContinuous
+			Whether this component uses continuous collision detection.
+		*//******************************************************************/
+		void SetIsContinuous(bool isContinuous);
+
+		/*****************************************************************//*!
+		\brief
+			Records the path that this component moved along within the current update.
+			This is called by the PhysicsSystem for continuous components after they are moved.
+		\param start
+			The world position of this component before moving.
+		\param end
+			The world position of this component after moving.
+		*//******************************************************************/
+		void RecordSweep(const Vector2& start, const Vector2& end);
+
+		/*****************************************************************//*!
+		\brief
+			Takes the path that this component moved along within the current update, if it was recorded.
+			This is called by the CollisionSystem, and the path is forgotten once taken.
+		\param outStart
+			The world position of this component before moving is written here.
+		\param outEnd
+			The world position of this component after moving is written here.
+		\return
+			True if a path was recorded since it was last taken. False otherwise.
+		*//******************************************************************/
+		bool TakeSweep(Vector2* outStart, Vector2* outEnd);
+
 	private:
 		//! Bitflags of each physics component attribute.
 		PhysicsCompFlags flags;
@@ -278,6 +369,24 @@ X(ROTATION_LOCKED, "Lock Rotation")
 		//! The angular velocity of this component.
 		float angVelocity;
 
+		//! Whether this component is allowed to fall asleep once it comes to rest.
+		bool canSleep;
+		//! Whether this component is sleeping.
+		bool isSleeping;
+		//! Whether this component was found resting against something since the last update while sleeping.
+		bool hasRestingContact;
+		//! The number of consecutive updates that this component has been at rest for.
+		int ticksAtRest;
+
+		//! Whether this component uses continuous collision detection.
+		bool isContinuous;
+		//! Whether this component was moved since the CollisionSystem last swept it.
+		bool hasSweep;
+		//! The world position that this component started moving from within the current update.
+		Vector2 sweepStart;
+		//! The world position that this component moved to within the current update.
+		Vector2 sweepEnd;
+
 	private:
 #ifdef IMGUI_ENABLED
 		/*****************************************************************//*!
@@ -298,6 +407,17 @@ X(ROTATION_LOCKED, "Lock Rotation")
 		property_vtable()
 	};
 
+	/*****************************************************************//*!
+	\brief
+		Hashes the exact state of every active PhysicsComp in the current ECS pool, in the order they are stored:
+		the entity, its world position and rotation, and the component's velocity and angular velocity.
+		Two simulations that are in the same state produce the same hash, so comparing hashes between runs
+		finds the first update at which they diverged.
+	\return
+		The hash.
+	*//******************************************************************/
+	uint64_t ComputeFrameHash();
+
 	/*****************************************************************//*!
 	\class PhysicsSystem
 	\brief
@@ -314,44 +434,37 @@ X(ROTATION_LOCKED, "Lock Rotation")
 
 		/*****************************************************************//*!
 		\brief
-			This is called by ecs when this system is registered.
-			In here we subscribe to the collision system's OnCollision event.
+			This is called by ecs right before this system starts processing entities.
+			In here, we set our dt variable with an upper limit of 1/60fps to prevent tunnelling.
+			In deterministic mode, dt is always fixed, and the state that this update starts from is hashed.
+		\return
+			True. The system will process components every time.
 		*//******************************************************************/
-		void OnAdded() override;
+		bool PreRun() override;
 
 		/*****************************************************************//*!
 		\brief
-			This is called by ecs when this system is unregistered.
-			In here we unsubscribe from the collision system's OnCollision event.
+			Gets the timestep that PhysicsComps were simulated with this update.
+		\return
+			The timestep.
 		*//******************************************************************/
-		void OnRemoved() override;
+		float GetDt() const;
 
 		/*****************************************************************//*!
 		\brief
-			This is called by ecs right before this system starts processing entities.
-			In here, we set our dt variable with an upper limit of 1/60fps to prevent tunnelling.
+			Gets the hash of the state that this update started from. Only updated in deterministic mode.
 		\return
-			True. The system will process components every time.
+			The hash.
 		*//******************************************************************/
-		bool PreRun() override;
+		uint64_t GetFrameHash() const;
 
 		/*****************************************************************//*!
 		\brief
-			Resolves physics changes when a collision happens, such as velocity changes.
-			This is called by the CollisionSystem when a collision happens.
-		\param refComp
-			The ColliderComp from which collision parameters are relative to.
-		\param refPhysComp
-			The PhysicsComp of the reference entity.
-		\param otherComp
-			The ColliderComp which the reference entity is colliding with.
-		\param otherPhysComp
-			The PhysicsComp of the entity which the reference entity is colliding with.
-		\param collisionData
-			The collision parameters.
+			Gets the number of updates that this system has run in deterministic mode, including this one.
+		\return
+			The number of updates.
 		*//******************************************************************/
-		void ProcessCollision(ColliderComp& refComp, ecs::CompHandle<PhysicsComp> refPhysComp,
-			ColliderComp& otherComp, ecs::CompHandle<PhysicsComp> otherPhysComp, const CollisionData* collisionData);
+		uint32_t GetFrameNumber() const;
 
 	private:
 		/*****************************************************************//*!
@@ -362,15 +475,6 @@ X(ROTATION_LOCKED, "Lock Rotation")
 		*//******************************************************************/
 		void UpdatePhysComp(PhysicsComp& physComp);
 
-		/*****************************************************************//*!
-		\brief
-			Informs the physics system that a collision occured.
-			Temporary until messaging system is able to store functions bound to objects.
-		\param param
-			The CollisionEventData struct.
-		*//******************************************************************/
-		static void OnCollisionOccured(const CollisionEventData& param);
-
 	private:
 		//! The strength of gravity that this system applies to all PhysicsComp that it processes.
 		float gravity;
@@ -383,8 +487,15 @@ X(ROTATION_LOCKED, "Lock Rotation")
 		//! The half length of the physics simulation area
 		float simulationHalfLength;
 
-		//! For resolving physics collisions, this is substituted for cases where an entity has a ColliderComp but does not have a PhysicsComp.
-		PhysicsComp emptyComp;
+		//! The speed below which a PhysicsComp is at rest.
+		float sleepSpeed;
+		//! The number of consecutive updates a PhysicsComp must be at rest for before it sleeps.
+		int ticksToSleep;
+
+		//! The hash of the state that this update started from, in deterministic mode.
+		uint64_t frameHash;
+		//! The number of updates run in deterministic mode.
+		uint32_t frameNumber;
 	};
 
 	/*****************************************************************//*!
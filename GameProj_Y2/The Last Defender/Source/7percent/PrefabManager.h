@@ -29,6 +29,7 @@ class PrefabManager
 	friend ST<PrefabManager>;//! Declare this class as a singleton
 	std::vector<std::string> _allPrefabs;
 	std::map<std::string, ecs::EntityHandle>_prefabPool;
+	std::map<std::string, ecs::EntityTemplate> _prefabTemplates;
 private:
 	static const std::string& FolderDir()
 	{
@@ -92,23 +93,38 @@ public:
 		return true;
 	}
 	static ecs::EntityHandle LoadPrefab(std::string name)
+	{
+		std::vector<ecs::EntityHandle> entities = LoadPrefabs(name, 1);
+		return entities.empty() ? nullptr : entities.front();
+	}
+	static std::vector<ecs::EntityHandle> LoadPrefabs(const std::string& name, uint32_t count)
 	{
 		PrefabManager* prefabManager = ST<PrefabManager>::Get();
 
 		//Check if the prefab with this name exists
-		if (prefabManager->_prefabPool.find(name) == prefabManager->_prefabPool.end())
+		auto templateIter = prefabManager->_prefabTemplates.find(name);
+		if (templateIter == prefabManager->_prefabTemplates.end())
 		{
 			CONSOLE_LOG(LEVEL_ERROR) << "INVALID PREFAB NAME: " << name;
-			return nullptr;
+			return {};
 		}
-		ecs::POOL currentPool = ecs::GetCurrentPoolId();
-		ecs::SwitchToPool(ecs::POOL::PREFAB_CACHE);
 
-		ecs::EntityHandle clonedEntity = ecs::CloneEntityToPoolNow(prefabManager->_prefabPool[name], currentPool, true);
-
-		ecs::SwitchToPool(currentPool);
-
-		return clonedEntity;
+		// Instantiate from the compiled template instead of cloning the cached entity component by component
+		return ecs::Instantiate(templateIter->second, count);
+	}
+	// Gets the entity that a prefab is loaded into within the prefab cache pool, or nullptr if the prefab doesn't exist
+	static ecs::EntityHandle GetCachedPrefab(const std::string& name)
+	{
+		PrefabManager* prefabManager = ST<PrefabManager>::Get();
+		auto prefabIter = prefabManager->_prefabPool.find(name);
+		return prefabIter == prefabManager->_prefabPool.end() ? nullptr : prefabIter->second;
+	}
+	// Gets the template that a prefab is instantiated from, or nullptr if the prefab doesn't exist
+	static const ecs::EntityTemplate* GetPrefabTemplate(const std::string& name)
+	{
+		PrefabManager* prefabManager = ST<PrefabManager>::Get();
+		auto templateIter = prefabManager->_prefabTemplates.find(name);
+		return templateIter == prefabManager->_prefabTemplates.end() ? nullptr : &templateIter->second;
 	}
 	void Update(std::string name = "")
 	{
@@ -180,6 +196,15 @@ public:
 		// Flush activeness setting
 		ecs::FlushChanges();
 
+		// Compile the prefabs into templates now that their components are attached
+		if (name == "")
+			_prefabTemplates.clear();
+		else
+			_prefabTemplates.erase(name);
+		for (const auto& [prefabName, prefabEntity] : _prefabPool)
+			if (!_prefabTemplates.contains(prefabName))
+				_prefabTemplates.emplace(prefabName, ecs::CompileEntityTemplate(prefabEntity));
+
 		// Switch back to the previous pool
 		ecs::SwitchToPool(initialPool);
 	}
@@ -113,11 +113,16 @@ const MaterialInstance& RenderComponent::GetMaterialInstance() const {
 }
 
 MaterialInstance& RenderComponent::GetMaterialInstance() {
+    // The material may be changed through the reference, so the cull grid must check whether it still occludes light
+    cullGridHandle = CullGridHandle{};
     return m_materialInstance;
 }
 
 void RenderComponent::SetMaterial(const std::string& name)
 {
+    // The cull grid must check whether the new material occludes light
+    cullGridHandle = CullGridHandle{};
+
     // Check if the material exists in the material system
     if (ST<MaterialSystem>::Get()->materialExists(name)) {
         // Create a new material instance with the specified base material
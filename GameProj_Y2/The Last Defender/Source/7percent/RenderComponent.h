@@ -65,6 +65,21 @@ public:
     bool flippedX;
     bool flippedY;
     MaterialInstance m_materialInstance;
+
+    // Where this component is tracked within the renderer's cull grid. Not serialized.
+    // Copies start untracked since they belong to another entity, while moves within the ECS keep their entry.
+    struct CullGridHandle {
+        static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+        uint32_t index = INVALID_INDEX;
+        uint32_t generation = 0;
+
+        CullGridHandle() = default;
+        CullGridHandle(const CullGridHandle&) {}
+        CullGridHandle(CullGridHandle&&) noexcept = default;
+        CullGridHandle& operator=(const CullGridHandle&) { index = INVALID_INDEX; return *this; }
+        CullGridHandle& operator=(CullGridHandle&&) noexcept = default;
+    };
+    mutable CullGridHandle cullGridHandle;
     
 #ifdef IMGUI_ENABLED
     static void EditorDraw(RenderComponent& comp);
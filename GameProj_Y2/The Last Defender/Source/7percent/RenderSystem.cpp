@@ -25,8 +25,17 @@ RenderSystem::RenderSystem() : SystemOperatingByLayer(&RenderSystem::DrawRenderC
 {
 	renderer = ST<Engine>::Get()->_vulkan->_renderer.get();
 }
+bool RenderSystem::PreRun()
+{
+	renderer->BeginRenderQueue();
+	return true;
+}
 void RenderSystem::DrawRenderComp(RenderComponent& renderComp)
 {
 
-	renderer->AddRenderInstance(renderComp);
+	renderer->QueueRenderInstance(renderComp);
+}
+void RenderSystem::PostRun()
+{
+	renderer->ExtractRenderInstances();
 }
@@ -29,6 +29,8 @@ class RenderSystem : public ecs::SystemOperatingByLayer<RenderSystem, RenderComp
 {
 public:
   explicit RenderSystem();
+  bool PreRun() override;
+  void PostRun() override;
 private:
   Renderer* renderer;
   void DrawRenderComp(RenderComponent& renderComp);
@@ -39,6 +39,9 @@ void RotaterComponent::EditorDraw(RotaterComponent& comp)
 RotaterSystem::RotaterSystem() :
 	System_Internal(&RotaterSystem::UpdateRotaterComp)
 {
+	// Rotating marks the transforms of children dirty.
+	DeclareWrites<Transform>();
+	AllowConcurrentExecution();
 }
 
 void RotaterSystem::UpdateRotaterComp(RotaterComponent& comp)
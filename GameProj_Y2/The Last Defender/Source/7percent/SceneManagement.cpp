@@ -165,8 +165,8 @@ Scene::~Scene()
 	// Because deleting entities causes handle invalidation, we clear history whenever a scene is unloaded
 	ST<History>::Get()->Clear();
 
-	for (ecs::EntityHandle entity : entities)
-		ecs::DeleteEntity(entity);
+	std::vector<ecs::EntityHandle> toDelete{ entities.begin(), entities.end() };
+	ecs::DeleteEntities(toDelete);
 }
 
 int Scene::GetIndex() const
@@ -245,12 +245,21 @@ void Scene::LoadFromFile()
 	// Delete all entities under this scene
 	if (!entities.empty())
 	{
-		for (ecs::EntityHandle entity : entities)
-			ecs::DeleteEntity(entity);
+		std::vector<ecs::EntityHandle> toDelete{ entities.begin(), entities.end() };
+		ecs::DeleteEntities(toDelete);
 		ecs::FlushChanges();
 	}
 
+	// Reserve space for every entity and component in the file up front, so component arrays don't repeatedly grow while loading
+	std::map<ecs::CompHash, uint32_t> compCounts{};
+	uint32_t numEntities{ deserializer.GetNumRemainingEntities(&compCounts) };
+	for (const auto& [compHash, count] : compCounts)
+		if (const RegisteredComponentData* registeredData{ RegisteredComponents::GetData(compHash) })
+			registeredData->ReserveComps(count);
+	ecs::ReserveEntities(numEntities);
+
 	// Load the entities from file.
+	// The deserializer decides which entities remain, so entities are created one by one rather than trusting the counted number.
 	while (deserializer.HasEntity())
 	{
 		// Create entity and load serialized components
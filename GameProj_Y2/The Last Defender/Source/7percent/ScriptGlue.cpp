@@ -338,6 +338,22 @@ namespace CSharpScripts
 
 		return mono_string_new(mono_domain_get(), cStr);
 	}
+
+	//! The most colliders that a single spatial query from C# can return. Results are collected on the stack before being copied over.
+	static constexpr size_t MAX_QUERY_RESULTS{ 128 };
+
+	/*****************************************************************//*!
+	\brief
+		Helper function to get how many results a spatial query from C# may write into a C# array.
+	\param[in] arr
+		The C# array that results are written into.
+	\return
+		The number of results that fit within both the C# array and the C++ buffer.
+	*//******************************************************************/
+	static size_t GetQueryCapacity(MonoArray* arr)
+	{
+		return (arr ? std::min(static_cast<size_t>(mono_array_length(arr)), MAX_QUERY_RESULTS) : 0);
+	}
 #pragma region TestCalls
 
 	/*****************************************************************//*!	
@@ -1024,6 +1040,81 @@ namespace CSharpScripts
 		Physics::Raycast(origin, direction, mask, &raycastResult);
 		*hit = DummyRaycastHit(raycastResult);
 	}
+
+	/*****************************************************************//*!
+	\brief
+		Function to find the entities whose colliders overlap a box.
+	\param[in] center
+		The center of the box.
+	\param[in] halfLengths
+		The half lengths of the box.
+	\param[in] layerMask
+		The layer masks to search.
+	\param[out] entities
+		The entities found are written here. No more than fit are found.
+	\return
+		The number of entities written.
+	*//******************************************************************/
+	static int OverlapBox(Vector2 center, Vector2 halfLengths, int layerMask, MonoArray* entities)
+	{
+		std::array<ecs::CompHandle<Physics::ColliderComp>, MAX_QUERY_RESULTS> comps;
+		uint32_t numFound{ Physics::OverlapBox(center, halfLengths, EntityLayersMask(layerMask), std::span{ comps.data(), GetQueryCapacity(entities) }) };
+		for (uint32_t i{}; i < numFound; ++i)
+			mono_array_set(entities, uint64_t, i, reinterpret_cast<uint64_t>(ecs::GetEntity(comps[i])));
+		return static_cast<int>(numFound);
+	}
+
+	/*****************************************************************//*!
+	\brief
+		Function to find the entities whose colliders overlap a circle.
+	\param[in] center
+		The center of the circle.
+	\param[in] radius
+		The radius of the circle.
+	\param[in] layerMask
+		The layer masks to search.
+	\param[out] entities
+		The entities found are written here. No more than fit are found.
+	\return
+		The number of entities written.
+	*//******************************************************************/
+	static int OverlapCircle(Vector2 center, float radius, int layerMask, MonoArray* entities)
+	{
+		std::array<ecs::CompHandle<Physics::ColliderComp>, MAX_QUERY_RESULTS> comps;
+		uint32_t numFound{ Physics::OverlapCircle(center, radius, EntityLayersMask(layerMask), std::span{ comps.data(), GetQueryCapacity(entities) }) };
+		for (uint32_t i{}; i < numFound; ++i)
+			mono_array_set(entities, uint64_t, i, reinterpret_cast<uint64_t>(ecs::GetEntity(comps[i])));
+		return static_cast<int>(numFound);
+	}
+
+	/*****************************************************************//*!
+	\brief
+		Function to find the entities whose colliders are nearest to a point.
+	\param[in] point
+		The point to search from.
+	\param[in] maxDistance
+		The maximum distance to search within.
+	\param[in] layerMask
+		The layer masks to search.
+	\param[out] entities
+		The nearest entities are written here, from nearest to furthest. As many are found as fit.
+	\param[out] distances
+		The distance to each entity's collider is written here.
+	\return
+		The number of entities written.
+	*//******************************************************************/
+	static int QueryNearest(Vector2 point, float maxDistance, int layerMask, MonoArray* entities, MonoArray* distances)
+	{
+		std::array<Physics::NearestResult, MAX_QUERY_RESULTS> results;
+		size_t capacity{ std::min(GetQueryCapacity(entities), GetQueryCapacity(distances)) };
+		uint32_t numFound{ Physics::QueryNearest(point, maxDistance, EntityLayersMask(layerMask), std::span{ results.data(), capacity }) };
+		for (uint32_t i{}; i < numFound; ++i)
+		{
+			mono_array_set(entities, uint64_t, i, reinterpret_cast<uint64_t>(ecs::GetEntity(results[i].hitComp)));
+			mono_array_set(distances, float, i, results[i].distance);
+		}
+		return static_cast<int>(numFound);
+	}
 #pragma endregion
 
 #pragma region TextComponent
@@ -1702,6 +1793,9 @@ namespace CSharpScripts
 		ADD_INTERNAL_CALL(GetPhysicsAngularVelocity);
 
 		ADD_INTERNAL_CALL(Raycast);
+		ADD_INTERNAL_CALL(OverlapBox);
+		ADD_INTERNAL_CALL(OverlapCircle);
+		ADD_INTERNAL_CALL(QueryNearest);
 
 #pragma endregion
 
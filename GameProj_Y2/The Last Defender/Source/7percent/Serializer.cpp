@@ -699,6 +699,29 @@ bool Deserializer::HasEntity() const
     return GetCurrValue().HasMember("entity" + std::to_string(currentEntityIndex));
 }
 
+uint32_t Deserializer::GetNumRemainingEntities(std::map<ecs::CompHash, uint32_t>* outCompCounts) const
+{
+    const rj::Value& currValue{ GetCurrValue() };
+    uint32_t numEntities{};
+    while (true)
+    {
+        auto entityIter{ currValue.FindMember("entity" + std::to_string(currentEntityIndex + static_cast<int>(numEntities))) };
+        if (entityIter == currValue.MemberEnd())
+            break;
+        ++numEntities;
+
+        if (!outCompCounts || !entityIter->value.IsObject())
+            continue;
+
+        auto compsIter{ entityIter->value.FindMember("components") };
+        if (compsIter == entityIter->value.MemberEnd() || !compsIter->value.IsObject())
+            continue;
+        for (auto compIter{ compsIter->value.MemberBegin() }, compEnd{ compsIter->value.MemberEnd() }; compIter != compEnd; ++compIter)
+            ++(*outCompCounts)[std::stoull(compIter->name.GetString())];
+    }
+    return numEntities;
+}
+
 const rj::Value& Deserializer::GetCurrValue() const
 {
     return (valueStack.empty() ? document : *valueStack.top());
@@ -503,6 +503,16 @@ public:
     *//******************************************************************/
     bool HasEntity() const;
 
+    /*****************************************************************//*!
+    \brief
+        Counts the entities that are still available for reading, and the components on them.
+    \param outCompCounts
+        Optional. Receives the number of components of each type on the remaining entities.
+    \return
+        The number of entities still available for reading.
+    *//******************************************************************/
+    uint32_t GetNumRemainingEntities(std::map<ecs::CompHash, uint32_t>* outCompCounts = nullptr) const;
+
 private:
     /*****************************************************************//*!
     \brief
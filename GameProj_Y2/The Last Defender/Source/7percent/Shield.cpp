@@ -24,9 +24,16 @@ All rights reserved.
 #include "Bullet.h"
 #include "EntityLayers.h"
 #include "PrefabManager.h"
+#include "EntityRecycler.h"
 #include "Health.h"
 #include "Messaging.h"
 #include "GameManager.h"
+#include "Collision.h"
+
+namespace {
+	//! The number of enemy bullets that the shield first makes room for when finding bullets around the arm.
+	constexpr size_t INITIAL_BULLET_QUERY_CAPACITY{ 64 };
+}
 
 ShieldComponent::ShieldComponent() :
 #ifdef IMGUI_ENABLED
@@ -144,22 +151,35 @@ void ShieldSystem::UpdateShieldSystem(ShieldComponent& comp)
 		comp.shieldActivated = true;
 		// comp.regenTimer = 0.0f;
 
-		// Find all bullets in scene
-		for (auto bullet = ecs::GetCompsBegin<BulletComponent>(); bullet != ecs::GetCompsEnd<BulletComponent>(); ++bullet)
+		// Find enemy bullets around the arm. If the buffer fills, some bullets may have been left out and would pass through the shield,
+		// so search again with more room until they all fit.
+		Vector2 armPosition = comp.armPivotEntity->GetTransform().GetWorldPosition();
+		if (bulletColliders.size() < INITIAL_BULLET_QUERY_CAPACITY)
 		{
-			// Get related componenents and entities
-			ecs::CompHandle<BulletComponent> enemyBulletComponent = bullet.GetComp();
-			ecs::EntityHandle enemyBullet = ecs::GetEntity(enemyBulletComponent);
-			ecs::CompHandle<EntityLayerComponent> bulletLayer = enemyBullet->GetComp<EntityLayerComponent>();
-			
-			// Reject all non-enemy bullets
-			if (bulletLayer->GetLayer() != ENTITY_LAYER::ENEMYBULLET)
+			bulletColliders.resize(INITIAL_BULLET_QUERY_CAPACITY);
+		}
+		uint32_t numBulletColliders = 0;
+		while ((numBulletColliders = Physics::OverlapCircle(armPosition, comp.endMax, EntityLayersMask({ ENTITY_LAYER::ENEMYBULLET }), bulletColliders)) == bulletColliders.size())
+		{
+			bulletColliders.resize(bulletColliders.size() * 2);
+		}
+
+		// Releasing bullets may move their components around, so the bullets are kept by entity while they're released
+		bulletEntities.clear();
+		for (uint32_t i = 0; i < numBulletColliders; ++i)
+		{
+			bulletEntities.push_back(ecs::GetEntity(bulletColliders[i]));
+		}
+		for (ecs::EntityHandle enemyBullet : bulletEntities)
+		{
+			// Get related componenents
+			ecs::CompHandle<BulletComponent> enemyBulletComponent = enemyBullet->GetComp<BulletComponent>();
+			if (enemyBulletComponent == nullptr)
 			{
 				continue;
 			}
 
 			// Calculate distance squared
-			Vector2 armPosition = comp.armPivotEntity->GetTransform().GetWorldPosition();
 			Vector2 enemyBulletPosition = enemyBullet->GetTransform().GetWorldPosition();
 			float distanceSquared = (enemyBulletPosition - armPosition).LengthSquared();
 
@@ -201,7 +221,7 @@ void ShieldSystem::UpdateShieldSystem(ShieldComponent& comp)
 			ST<GameManager>::Get()->SetDamageShielded(ST<GameManager>::Get()->GetDamageShielded() + enemyBulletComponent->GetDamage());
 
 			// Kill the enemy bullet
-			ecs::DeleteEntity(enemyBullet);
+			ST<EntityRecycler>::Get()->Release(enemyBullet);
 
 			// Play sound
 			ST<AudioManager>::Get()->StartSound(comp.reflectSound);
@@ -23,6 +23,10 @@ All rights reserved.
 #include "EntityUID.h"
 #include "AudioManager.h"
 
+namespace Physics {
+	class ColliderComp;
+}
+
 /*****************************************************************//*!
 \class ShieldComponent
 \brief
@@ -152,6 +156,10 @@ public:
 private:
 	// Deferred player bullet prefab spawning to work around a crash
 	std::vector<DeferredPlayerBullet> deferredPlayerBullets;
+	// Colliders of enemy bullets around the arm. Reused between updates, and grown whenever bullets don't fit.
+	std::vector<ecs::CompHandle<Physics::ColliderComp>> bulletColliders;
+	// The entities of the enemy bullets around the arm, which stay valid while bullets are released
+	std::vector<ecs::EntityHandle> bulletEntities;
 
 	/*****************************************************************//*!
 	\brief
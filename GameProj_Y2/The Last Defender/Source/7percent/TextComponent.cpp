@@ -21,6 +21,7 @@ All rights reserved.
 #include "TextComponent.h"
 
 #include "ResourceManager.h"
+#include "ryan-c/VulkanContext.h"
 
 TextComponent::TextComponent()
     : TextComponent{ "Arial", "Default Text" }
@@ -57,6 +58,11 @@ TextComponent::TextComponent(size_t fontNameHash, const std::string& text, Vecto
     fontNameHash{ fontNameHash }, textString{ text }, color{ color }
 {
 }
+TextComponent::TextComponent(const TextComponent& other) = default;
+TextComponent::TextComponent(TextComponent&& other) noexcept = default;
+TextComponent& TextComponent::operator=(const TextComponent& other) = default;
+TextComponent& TextComponent::operator=(TextComponent&& other) noexcept = default;
+TextComponent::~TextComponent() = default;
 size_t TextComponent::GetFontHash() const
 {
     return this->fontNameHash;
@@ -70,7 +76,7 @@ const std::string& TextComponent::GetText() const
 void TextComponent::SetText(const std::string& text)
 {
     this->textString = text;
-    //dirtyTransform = true;
+    isLayoutDirty = true;
 }
 const Vector4& TextComponent::GetColor() const
 {
@@ -80,6 +86,7 @@ const Vector4& TextComponent::GetColor() const
 void TextComponent::SetColor(const Vector4& newColor)
 {
     this->color = newColor;
+    isLayoutDirty = true;
 }
 
 Transform TextComponent::GetWorldTextTransform() const
@@ -95,6 +102,7 @@ TextComponent::TextAlignment TextComponent::GetAlignment() const { return static
 
 void TextComponent::SetAlignment(TextAlignment newAlignment) { 
     alignment = static_cast<int>(newAlignment);
+    isLayoutDirty = true;
     CalculateWorldTransform();
 }
 
@@ -103,6 +111,83 @@ bool TextComponent::isUI() const
     return UI;
 }
 
+void TextComponent::UpdateLayout()
+{
+    const auto& transform = ecs::GetEntityTransform(this);
+    Vector2 position{ transform.GetWorldPosition() };
+    Vector2 scale{ transform.GetWorldScale() };
+    float zPos{ transform.GetZPos() };
+
+    // Most text rarely changes, so the glyphs of the last layout are reused until something they depend on changes
+    if(!isLayoutDirty && fontNameHash == layoutFontHash && position == layoutPosition && scale == layoutScale && zPos == layoutZPos)
+        return;
+
+    CalculateWorldTransform();
+    BuildGlyphInstances();
+
+    isLayoutDirty = false;
+    layoutFontHash = fontNameHash;
+    layoutPosition = position;
+    layoutScale = scale;
+    layoutZPos = zPos;
+}
+
+const std::vector<SpriteInstanceData>& TextComponent::GetGlyphInstances() const
+{
+    return glyphInstances;
+}
+
+void TextComponent::BuildGlyphInstances()
+{
+    const auto& atlas = ResourceManager::GetFont(GetFontHash());
+    const auto& transform = ecs::GetEntityTransform(this);
+    glm::vec2 scale = transform.GetWorldScale();
+    glm::vec2 baselineOffset = glm::vec2(0, atlas.ascender * scale.y);
+    glm::vec2 currentPos{ textStart };
+    float zPos = transform.GetZPos();
+
+    glyphInstances.clear();
+    uint32_t previousChar = 0;
+    for(char const c : textString) {
+        uint32_t currentChar = static_cast<uint32_t>(c);
+        if(currentChar < FontAtlas::FIRST_CHAR || currentChar > FontAtlas::LAST_CHAR) continue;
+
+        size_t glyphIndex = currentChar - FontAtlas::FIRST_CHAR;
+        const Glyph& glyph = atlas.glyphs[glyphIndex];
+
+        if(previousChar != 0) {
+            float kerning = atlas.getKerning(previousChar, currentChar);
+            currentPos.x += kerning * scale.x;
+        }
+
+        glm::vec2 pos = currentPos + baselineOffset;
+        pos.x += (glyph.planeBounds[0].x + glyph.planeBounds[1].x) * scale.x * 0.5f;
+        pos.y -= (glyph.planeBounds[0].y + glyph.planeBounds[1].y) * scale.y * 0.5f;
+
+        glm::vec2 quadSize = {
+            (glyph.planeBounds[1].x - glyph.planeBounds[0].x) * scale.x,
+            (glyph.planeBounds[1].y - glyph.planeBounds[0].y) * scale.y
+        };
+
+        // Translation then scale, as a quad is never rotated
+        glm::mat4 model = glm::mat4(1.0f);
+        model[0][0] = quadSize.x;
+        model[1][1] = quadSize.y;
+        model[3] = glm::vec4(pos, zPos, 1.0f);
+
+        glm::vec4 texCoords;
+        texCoords.x = glyph.atlasBounds[0].x / atlas.width;
+        texCoords.y = 1.0f - (glyph.atlasBounds[1].y / atlas.height);
+        texCoords.z = (glyph.atlasBounds[1].x - glyph.atlasBounds[0].x) / atlas.width;
+        texCoords.w = (glyph.atlasBounds[1].y - glyph.atlasBounds[0].y) / atlas.height;
+
+        glyphInstances.push_back(SpriteInstanceData{ model, color, texCoords, atlas.textureID, RENDER_FLAG_TEXT });
+
+        currentPos.x += (glyph.advance * scale.x);
+        previousChar = currentChar;
+    }
+}
+
 void TextComponent::CalculateWorldTransform()
 {
         const auto& atlas = ResourceManager::GetFont(GetFontHash());
@@ -192,6 +277,7 @@ void TextComponent::EditorDraw(TextComponent& comp)
             if(ImGui::Selectable(fontName.c_str(), isSelected))
             {
                 comp.fontNameHash = util::GenHash(fontName);
+                comp.isLayoutDirty = true;
                 comp.CalculateWorldTransform(); // Recalculate after font change
             }
             // Set initial focus when opening the combo
@@ -21,6 +21,8 @@ All rights reserved.
 
 #pragma once
 
+struct SpriteInstanceData;
+
 class TextComponent : public IRegisteredComponent<TextComponent>
 #ifdef IMGUI_ENABLED
     , IEditorComponent<TextComponent>
@@ -71,6 +73,15 @@ public:
      */
     TextComponent(size_t fontNameHash, const std::string& text, Vector4 color = glm::vec4{0.0f,0.0f,0.0f,1.0f});
 
+    /**
+     * \brief Copy, move and destruction are defined in TextComponent.cpp, where SpriteInstanceData is complete.
+     */
+    TextComponent(const TextComponent& other);
+    TextComponent(TextComponent&& other) noexcept;
+    TextComponent& operator=(const TextComponent& other);
+    TextComponent& operator=(TextComponent&& other) noexcept;
+    ~TextComponent();
+
     /**
      * \brief Get the hash value of the font name.
      * \return The hash value of the font name.
@@ -115,6 +126,17 @@ public:
 
     bool isUI () const;
 
+    /**
+     * \brief Lays out the text again if its text, font, color, alignment or transform changed since it was last laid out.
+     */
+    void UpdateLayout();
+
+    /**
+     * \brief Get the instances of the text's glyphs, as of the last layout.
+     * \return The glyph instances, in the order of the characters.
+     */
+    const std::vector<SpriteInstanceData>& GetGlyphInstances() const;
+
    private:
     size_t fontNameHash; ///< The hash value of the font name.
     std::string textString; ///< The text to be rendered.
@@ -124,8 +146,20 @@ public:
     Vector2 textStart; ///< The starting position of the text.
     bool UI = false; ///< Whether the text is UI text.
 
+    std::vector<SpriteInstanceData> glyphInstances; ///< The glyph instances of the last layout.
+    bool isLayoutDirty = true; ///< Whether the text, color or alignment changed since the last layout.
+    size_t layoutFontHash{}; ///< The font of the last layout.
+    Vector2 layoutPosition; ///< The world position of the entity as of the last layout.
+    Vector2 layoutScale; ///< The world scale of the entity as of the last layout.
+    float layoutZPos{}; ///< The z position of the entity as of the last layout.
+
     void CalculateWorldTransform();
 
+    /**
+     * \brief Builds the glyph instances from the text and the starting position found by CalculateWorldTransform().
+     */
+    void BuildGlyphInstances();
+
     /**
      * \brief Editor support function for drawing the TextComponent.
      * \param comp The TextComponent to be drawn.
@@ -138,9 +172,29 @@ public:
 property_begin(TextComponent)
 {
     property_var(fontNameHash),
-    property_var(textString),
-    property_var(color),
-    property_var(alignment),
+    // These mark the layout dirty when written, so that text changed through reflection (e.g. deserialization) is laid out again
+    property_var_fnbegin("textString", std::string)
+        if(isRead)
+            InOut = Self.textString;
+        else
+            Self.SetText(InOut);
+    property_var_fnend(),
+    property_var_fnbegin("color", Vector4)
+        if(isRead)
+            InOut = Self.color;
+        else
+            Self.SetColor(InOut);
+    property_var_fnend(),
+    // Not through SetAlignment(), which needs the entity's transform, as the component may not be attached yet
+    property_var_fnbegin("alignment", int)
+        if(isRead)
+            InOut = Self.alignment;
+        else
+        {
+            Self.alignment = InOut;
+            Self.isLayoutDirty = true;
+        }
+    property_var_fnend(),
     property_var(UI)
 }
 property_vend_h(TextComponent)
@@ -31,7 +31,7 @@ TextSystem::TextSystem()
 
 void TextSystem::DrawTextComp(TextComponent& textComp)
 {
-    textComp.CalculateWorldTransform();
+    textComp.UpdateLayout();
     renderer->AddTextInstance(textComp);
 }
 
@@ -3,6 +3,9 @@
 #include "Engine.h"
 
 TrailRendererSystem::TrailRendererSystem() : System_Internal(&TrailRendererSystem::UpdateTrailComp) {
+    // Getting the world position lazily updates the cached matrices of parent transforms.
+    DeclareWrites<Transform>();
+    AllowConcurrentExecution();
 }
 
 void TrailRendererSystem::UpdateTrailComp(TrailRendererComponent& trailComp)
@@ -29,6 +29,7 @@ Transform::Transform()
 	, rotation{ 0.0f }
 	, scale{ 1.0f, 1.0f }
 	, isTransformDirty{ false }
+	, changeStamp{}
 	, mat{}
 	, parent{ nullptr }
 	, children{}
@@ -41,6 +42,7 @@ Transform::Transform(const Transform& copy)
 	, rotation{ copy.rotation }
 	, scale{ copy.scale }
 	, isTransformDirty{ true }
+	, changeStamp{}
 	, mat{}
 	, parent{ copy.parent }
 	, children{}
@@ -264,6 +266,16 @@ ecs::ConstEntityHandle Transform::GetEntity() const
 	return reinterpret_cast<ecs::ConstEntityHandle>(reinterpret_cast<const ecs::internal::RawData*>(this) - ecs::internal::Entity_Internal::INTERNAL_GetTransformVarByteOffset());
 }
 
+void Transform::UpdateWorldMat() const
+{
+	GetWorldMat();
+}
+
+uint32_t Transform::GetChangeStamp() const
+{
+	return changeStamp;
+}
+
 void Transform::SetMat4ToWorld(glm::mat4* outMat4) const
 {
 	// This updates the world matrix if dirty
@@ -395,6 +407,7 @@ void Transform::EditorDraw()
 void Transform::SetDirty()
 {
 	isTransformDirty = true;
+	++changeStamp;
 	for (Transform* child : children)
 		child->SetDirty();
 }
@@ -399,6 +399,23 @@ public:
 	*//******************************************************************/
 	void SetMat4ToWorld(glm::mat4* outMat4) const;
 
+	/*****************************************************************//*!
+	\brief
+		Recalculates this transform's world matrix if it is dirty. Reading a dirty transform recalculates and writes its
+		matrix (and its parents'), so call this beforehand if the transform will be read from multiple threads.
+	*//******************************************************************/
+	void UpdateWorldMat() const;
+
+	/*****************************************************************//*!
+	\brief
+		Gets a number that changes whenever this transform's world matrix changes, including through a parent.
+		Unlike the dirty flag, this isn't reset when the matrix is recalculated, so caches of the world transform can
+		compare it against the stamp they were built with to tell if they're stale.
+	\return
+		The change stamp of this transform.
+	*//******************************************************************/
+	uint32_t GetChangeStamp() const;
+
 	/*****************************************************************//*!
 	\brief
 		Draws this transform to the current ImGui window.
@@ -442,6 +459,8 @@ private:
 
 	//! A flag to indicate whether the matrix within this Transform is dirty and thus needs to be recalculated before being accessed.
 	mutable bool isTransformDirty;
+	//! Incremented whenever this Transform is set as dirty.
+	uint32_t changeStamp;
 	//! The matrix of this Transform.
 	mutable Mat mat;
 
@@ -23,6 +23,7 @@ All rights reserved.
 #include "Weapon.h"
 #include "AudioManager.h"
 #include "PrefabManager.h"
+#include "EntityRecycler.h"
 #include "ResourceManager.h"
 #include "RenderComponent.h"
 #include "Collision.h"
@@ -362,7 +363,7 @@ WeaponComponent::FIRE_RESPONSE WeaponComponent::Fire()
 		{
 
 			// Create the laser
-			ecs::EntityHandle newLaser = PrefabManager::LoadPrefab(isPlayerWeapon ? "Laser" : "LaserEnemy");
+			ecs::EntityHandle newLaser = ST<EntityRecycler>::Get()->Spawn(isPlayerWeapon ? "Laser" : "LaserEnemy");
 			ecs::CompHandle<LaserComponent> laserComp = newLaser->GetComp<LaserComponent>();
 
 			// Get the laser's fire direction
@@ -378,8 +379,8 @@ WeaponComponent::FIRE_RESPONSE WeaponComponent::Fire()
 		break;
 	default:// This is for projectile bullets☺
 #pragma region Shell casings
-		// Load a shell casing from PrefabManager
-		ecs::EntityHandle shellCasing = PrefabManager::LoadPrefab("ShellCasing");
+		// Spawn a shell casing, reusing a dead one if there is one
+		ecs::EntityHandle shellCasing = ST<EntityRecycler>::Get()->Spawn("ShellCasing");
 		// Get the transform of the shell and set its position
 		Transform& shellTransform = shellCasing->GetTransform();
 		// Set shell position to the ejection point
@@ -419,8 +420,8 @@ WeaponComponent::FIRE_RESPONSE WeaponComponent::Fire()
 
 			finalfireangle = fireangle + (totalspread * randspread - totalspread / 2);
 			//CONSOLE_LOG_EXPLICIT("FIRE ANGLE: " + std::to_string(finalfireangle), LogLevel::LEVEL_DEBUG);
-			// Load a bullet from PrefabManager
-			ecs::EntityHandle newBullet = PrefabManager::LoadPrefab(isPlayerWeapon ? "Bullet" : "BulletEnemy");
+			// Spawn a bullet, reusing a dead one if there is one
+			ecs::EntityHandle newBullet = ST<EntityRecycler>::Get()->Spawn(isPlayerWeapon ? "Bullet" : "BulletEnemy");
 
 			// Get the transform of the new bullet and the weapon
 			Transform& bTransform = newBullet->GetTransform();
@@ -28,6 +28,7 @@ All rights reserved.
 #include <sstream>
 #include <array>
 #include <vector>
+#include <span>
 #include <deque>
 #include <queue>
 #include <stack>
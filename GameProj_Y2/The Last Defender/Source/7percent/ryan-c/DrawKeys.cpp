@@ -0,0 +1,101 @@
+/******************************************************************************/
+/*!
+\file   DrawKeys.cpp
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the source file implementing the sorting of render instances by depth
+  through draw keys.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#include "DrawKeys.h"
+#include <bit>
+
+namespace {
+	//! The number of bits that the depth is shifted up by within a draw key.
+	constexpr uint32_t DEPTH_SHIFT{ 32 };
+	//! The number of bits sorted in each radix sort pass.
+	constexpr uint32_t RADIX_BITS{ 8 };
+	//! The number of buckets in each radix sort pass.
+	constexpr uint32_t RADIX_SIZE{ 1u << RADIX_BITS };
+	//! The number of radix sort passes needed to sort the depth.
+	constexpr uint32_t NUM_PASSES{ 32 / RADIX_BITS };
+
+	/*****************************************************************//*!
+	\brief
+		Gets the digit of a draw key's depth that a radix sort pass sorts by.
+	\param key
+		The draw key.
+	\param pass
+		The radix sort pass, starting from the least significant digit.
+	\return
+		The digit.
+	*//******************************************************************/
+	uint32_t GetDigit(uint64_t key, uint32_t pass)
+	{
+		return static_cast<uint32_t>(key >> (DEPTH_SHIFT + pass * RADIX_BITS)) & (RADIX_SIZE - 1);
+	}
+}
+
+uint64_t DrawKeySorter::MakeKey(float depth, uint32_t index)
+{
+	// -0 and 0 have different bits but the same depth
+	if (depth == 0.0f)
+		depth = 0.0f;
+
+	// Flip all bits of negative floats and only the sign bit of positive floats, so that the bits compare as the floats do
+	uint32_t bits{ std::bit_cast<uint32_t>(depth) };
+	bits ^= (bits & 0x80000000u ? 0xFFFFFFFFu : 0x80000000u);
+	return (static_cast<uint64_t>(bits) << DEPTH_SHIFT) | index;
+}
+
+uint32_t DrawKeySorter::GetIndex(uint64_t key)
+{
+	return static_cast<uint32_t>(key);
+}
+
+void DrawKeySorter::SortKeys()
+{
+	if (keys.empty())
+		return;
+
+	// Count the digits of every pass up front, so that passes where all keys share the same digit can be skipped.
+	// Sprites tend to share a handful of depths, so most passes usually are.
+	std::array<std::array<uint32_t, RADIX_SIZE>, NUM_PASSES> counts{};
+	for (uint64_t key : keys)
+		for (uint32_t pass{}; pass < NUM_PASSES; ++pass)
+			++counts[pass][GetDigit(key, pass)];
+
+	scratch.resize(keys.size());
+	for (uint32_t pass{}; pass < NUM_PASSES; ++pass)
+	{
+		std::array<uint32_t, RADIX_SIZE>& offsets{ counts[pass] };
+		if (offsets[GetDigit(keys.front(), pass)] == keys.size())
+			continue;
+
+		// Turn the counts into where each bucket starts
+		uint32_t offset{};
+		for (uint32_t& bucket : offsets)
+		{
+			uint32_t count{ bucket };
+			bucket = offset;
+			offset += count;
+		}
+
+		for (uint64_t key : keys)
+			scratch[offsets[GetDigit(key, pass)]++] = key;
+		keys.swap(scratch);
+	}
+}
@@ -0,0 +1,103 @@
+/******************************************************************************/
+/*!
+\file   DrawKeys.h
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the interface file for sorting render instances by depth through
+  64-bit draw keys, so that only the keys are moved while sorting and each
+  instance is copied once into its sorted position.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#pragma once
+
+/*****************************************************************//*!
+\class DrawKeySorter
+\brief
+	Sorts render instances by depth, keeping instances of equal depth in the order they were added.
+	Each instance gets a draw key holding its depth in the upper 32 bits and its index in the lower 32 bits.
+	The keys are radix sorted by depth, and instances are then gathered in the sorted order into the destination,
+	which may be a mapped instance buffer. Keys are kept between sorts so that sorting doesn't allocate.
+*//******************************************************************/
+class DrawKeySorter
+{
+public:
+	/*****************************************************************//*!
+	\brief
+		Copies instances into a destination in order of increasing depth.
+	\tparam InstanceType
+		The type of instance.
+	\tparam DepthFunc
+		float(const InstanceType& instance). Gets the depth of an instance.
+	\param instances
+		The instances, in the order they were added.
+	\param getDepth
+		The function that gets the depth of an instance.
+	\param outInstances
+		The sorted instances are written here. Must have space for all instances.
+	*//******************************************************************/
+	template <typename InstanceType, typename DepthFunc>
+	void SortInto(const std::vector<InstanceType>& instances, DepthFunc&& getDepth, InstanceType* outInstances);
+
+	/*****************************************************************//*!
+	\brief
+		Makes the draw key of an instance.
+	\param depth
+		The depth of the instance.
+	\param index
+		The index of the instance.
+	\return
+		The draw key. Keys compare in order of depth, then index.
+	*//******************************************************************/
+	static uint64_t MakeKey(float depth, uint32_t index);
+
+	/*****************************************************************//*!
+	\brief
+		Gets the index of the instance that a draw key belongs to.
+	\param key
+		The draw key.
+	\return
+		The index of the instance.
+	*//******************************************************************/
+	static uint32_t GetIndex(uint64_t key);
+
+private:
+	/*****************************************************************//*!
+	\brief
+		Sorts the keys by depth with a least significant digit radix sort. As the keys start in order of index,
+		keys of equal depth stay in order of index.
+	*//******************************************************************/
+	void SortKeys();
+
+private:
+	//! The draw keys of the instances being sorted.
+	std::vector<uint64_t> keys;
+	//! The keys as of the previous radix sort pass.
+	std::vector<uint64_t> scratch;
+};
+
+template <typename InstanceType, typename DepthFunc>
+void DrawKeySorter::SortInto(const std::vector<InstanceType>& instances, DepthFunc&& getDepth, InstanceType* outInstances)
+{
+	keys.resize(instances.size());
+	for (size_t i{}; i < instances.size(); ++i)
+		keys[i] = MakeKey(getDepth(instances[i]), static_cast<uint32_t>(i));
+
+	SortKeys();
+
+	// Write each instance once, in order, which suits write-combined mapped memory
+	for (size_t i{}; i < keys.size(); ++i)
+		outInstances[i] = instances[GetIndex(keys[i])];
+}
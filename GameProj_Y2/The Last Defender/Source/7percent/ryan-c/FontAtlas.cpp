@@ -21,9 +21,15 @@ All rights reserved.
 #include "FontAtlas.h"
 
 float FontAtlas::getKerning(uint32_t char1, uint32_t char2) const {
-    auto it = kerningMap.find({char1, char2});
-    if (it != kerningMap.end()) {
-        return it->second;  // Return the found kerning value
+    if (char1 < FIRST_CHAR || char1 > LAST_CHAR || char2 < FIRST_CHAR || char2 > LAST_CHAR) {
+        return 0.0f;  // Default kerning for characters without glyphs
     }
-    return 0.0f;  // Default kerning if not found
+    return kerningTable[(char1 - FIRST_CHAR) * CHAR_COUNT + (char2 - FIRST_CHAR)];
+}
+
+void FontAtlas::setKerning(uint32_t char1, uint32_t char2, float kerning) {
+    if (char1 < FIRST_CHAR || char1 > LAST_CHAR || char2 < FIRST_CHAR || char2 > LAST_CHAR) {
+        return;  // Never looked up, as only characters with glyphs are drawn
+    }
+    kerningTable[(char1 - FIRST_CHAR) * CHAR_COUNT + (char2 - FIRST_CHAR)] = kerning;
 }
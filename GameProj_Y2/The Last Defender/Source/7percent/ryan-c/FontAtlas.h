@@ -21,15 +21,6 @@ All rights reserved.
 */
 /******************************************************************************/
 
-struct pair_hash {
-    template <class T1, class T2>
-    std::size_t operator () (const std::pair<T1, T2>& pair) const {
-        auto hash1 = std::hash<T1>{}(pair.first);
-        auto hash2 = std::hash<T2>{}(pair.second);
-        return hash1 ^ (hash2 << 1); // Combine the two hash values
-    }
-};
-
 struct Glyph {
     std::array<Vector2, 2> planeBounds;  // Top-left and bottom-right UV coordinates
     std::array<Vector2, 2> atlasBounds;  // Top-left and bottom-right pixel coordinates in the atlas
@@ -42,7 +33,7 @@ struct FontAtlas {
     static constexpr size_t CHAR_COUNT = LAST_CHAR - FIRST_CHAR + 1;
 
     std::array<Glyph, CHAR_COUNT> glyphs;               // Array of glyphs
-    std::unordered_map<std::pair<uint32_t, uint32_t>, float, pair_hash> kerningMap;
+    std::array<float, CHAR_COUNT * CHAR_COUNT> kerningTable{}; // Kerning of every pair of glyphs, indexed by the first glyph then the second
 
     // Atlas properties
     std::string textureName;  // Name of the texture file
@@ -55,6 +46,7 @@ struct FontAtlas {
     float descender;       // Distance from the baseline to the bottom of the font
 
     float getKerning(uint32_t char1, uint32_t char2) const;
+    void setKerning(uint32_t char1, uint32_t char2, float kerning);
 };
 
 
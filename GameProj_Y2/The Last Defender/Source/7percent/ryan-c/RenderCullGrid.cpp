@@ -0,0 +1,203 @@
+/******************************************************************************/
+/*!
+\file   RenderCullGrid.cpp
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the source file implementing the spatial grid of static render
+  components used for visibility culling.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#include "RenderCullGrid.h"
+
+void RenderCullGrid::BeginFrame(const glm::vec2& viewMin, const glm::vec2& viewMax)
+{
+	++frame;
+	viewMinCell = GetCellCoord(viewMin);
+	viewMaxCell = GetCellCoord(viewMax);
+
+	auto markCell{ [this](const Cell& cell) -> void {
+		for (uint32_t index : cell.entries)
+			entries[index].visibleFrame = frame;
+	} };
+
+	// Visit whichever is fewer: the cells within the view, or the cells that hold components
+	glm::i64vec2 numViewCells{ glm::i64vec2{ viewMaxCell } - glm::i64vec2{ viewMinCell } + glm::i64vec2{ 1 } };
+	if (static_cast<uint64_t>(numViewCells.x * numViewCells.y) <= cells.size())
+	{
+		for (int y{ viewMinCell.y }; y <= viewMaxCell.y; ++y)
+			for (int x{ viewMinCell.x }; x <= viewMaxCell.x; ++x)
+			{
+				auto cellIter{ cells.find(GetCellKey(glm::ivec2{ x, y })) };
+				if (cellIter != cells.end())
+					markCell(cellIter->second);
+			}
+	}
+	else
+	{
+		for (const auto& [key, cell] : cells)
+			if (cell.coord.x >= viewMinCell.x && cell.coord.x <= viewMaxCell.x && cell.coord.y >= viewMinCell.y && cell.coord.y <= viewMaxCell.y)
+				markCell(cell);
+	}
+
+	// Components that were deleted or stopped being drawn aren't announced, so they're forgotten once they haven't been drawn for a while
+	if (frame % FRAMES_TO_FORGET == 0)
+		for (uint32_t index{}; index < entries.size(); ++index)
+			if (entries[index].entity && entries[index].lastDrawnFrame + FRAMES_TO_FORGET < frame)
+				RemoveEntry(index);
+}
+
+bool RenderCullGrid::IsCulled(const RenderComponent& renderComp, ecs::ConstEntityHandle entity, const Transform& transform)
+{
+	Handle& handle{ renderComp.cullGridHandle };
+	uint32_t transformStamp{ transform.GetChangeStamp() };
+	if (handle.index >= entries.size() || entries[handle.index].generation != handle.generation || entries[handle.index].entity != entity)
+	{
+		handle.index = AddEntry(entity, transformStamp);
+		handle.generation = entries[handle.index].generation;
+		return false;
+	}
+
+	Entry& entry{ entries[handle.index] };
+	entry.lastDrawnFrame = frame;
+
+	// Moving components are tested individually, as keeping their cells up to date would cost more than testing them
+	if (entry.transformStamp != transformStamp)
+	{
+		entry.transformStamp = transformStamp;
+		entry.numUnchangedFrames = 0;
+		entry.isExcluded = false;
+		if (entry.isBucketed)
+			Unbucket(handle.index);
+		return false;
+	}
+
+	if (!entry.isBucketed)
+	{
+		if (entry.isExcluded || ++entry.numUnchangedFrames < FRAMES_TO_STATIC)
+			return false;
+		if (!Bucket(handle.index, renderComp, transform))
+		{
+			entry.isExcluded = true;
+			return false;
+		}
+
+		// Cells were marked before this component joined them, so its cells are checked against the view directly
+		return entry.maxCell.x < viewMinCell.x || entry.minCell.x > viewMaxCell.x || entry.maxCell.y < viewMinCell.y || entry.minCell.y > viewMaxCell.y;
+	}
+
+	return entry.visibleFrame != frame;
+}
+
+glm::vec2 RenderCullGrid::GetSpriteHalfExtents(const glm::vec2& size, float rotation)
+{
+	glm::vec2 halfExtents{ glm::abs(size) * 0.5f };
+	if (rotation != 0.0f)
+		halfExtents = glm::vec2{ glm::length(halfExtents) };
+	return halfExtents;
+}
+
+uint32_t RenderCullGrid::GetNumStatic() const
+{
+	return numBucketed;
+}
+
+uint32_t RenderCullGrid::GetNumCells() const
+{
+	return static_cast<uint32_t>(cells.size());
+}
+
+uint32_t RenderCullGrid::AddEntry(ecs::ConstEntityHandle entity, uint32_t transformStamp)
+{
+	uint32_t index{};
+	if (freeEntries.empty())
+	{
+		index = static_cast<uint32_t>(entries.size());
+		entries.emplace_back();
+	}
+	else
+	{
+		index = freeEntries.back();
+		freeEntries.pop_back();
+	}
+
+	Entry& entry{ entries[index] };
+	entry = Entry{ entity, entry.generation, transformStamp, 0, false, false, frame, 0, glm::ivec2{}, glm::ivec2{} };
+	return index;
+}
+
+void RenderCullGrid::RemoveEntry(uint32_t index)
+{
+	if (entries[index].isBucketed)
+		Unbucket(index);
+	entries[index].entity = nullptr;
+	++entries[index].generation;
+	freeEntries.push_back(index);
+}
+
+bool RenderCullGrid::Bucket(uint32_t index, const RenderComponent& renderComp, const Transform& transform)
+{
+	const MaterialInstance& materialInstance{ renderComp.GetMaterialInstance() };
+	uint32_t materialFlags{ materialInstance.hasParameterOverrides() ?
+		materialInstance.getOverrideFlags() : ST<MaterialSystem>::Get()->getEffectiveFlags(materialInstance) };
+	if (materialFlags & MaterialFlags::OccludesLight)
+		return false;
+
+	glm::vec2 position{ transform.GetWorldPosition() };
+	glm::vec2 halfExtents{ GetSpriteHalfExtents(transform.GetWorldScale(), transform.GetWorldRotation()) };
+	glm::ivec2 minCell{ GetCellCoord(position - halfExtents) }, maxCell{ GetCellCoord(position + halfExtents) };
+	if (static_cast<int64_t>(maxCell.x - minCell.x + 1) * (maxCell.y - minCell.y + 1) > MAX_CELLS_PER_ENTRY)
+		return false;
+
+	Entry& entry{ entries[index] };
+	entry.minCell = minCell;
+	entry.maxCell = maxCell;
+	entry.isBucketed = true;
+	for (int y{ minCell.y }; y <= maxCell.y; ++y)
+		for (int x{ minCell.x }; x <= maxCell.x; ++x)
+		{
+			Cell& cell{ cells[GetCellKey(glm::ivec2{ x, y })] };
+			cell.coord = glm::ivec2{ x, y };
+			cell.entries.push_back(index);
+		}
+	++numBucketed;
+	return true;
+}
+
+void RenderCullGrid::Unbucket(uint32_t index)
+{
+	Entry& entry{ entries[index] };
+	for (int y{ entry.minCell.y }; y <= entry.maxCell.y; ++y)
+		for (int x{ entry.minCell.x }; x <= entry.maxCell.x; ++x)
+		{
+			// Empty cells are kept, as static components tend to settle in the same places again
+			std::vector<uint32_t>& cellEntries{ cells[GetCellKey(glm::ivec2{ x, y })].entries };
+			auto entryIter{ std::find(cellEntries.begin(), cellEntries.end(), index) };
+			*entryIter = cellEntries.back();
+			cellEntries.pop_back();
+		}
+	entry.isBucketed = false;
+	--numBucketed;
+}
+
+glm::ivec2 RenderCullGrid::GetCellCoord(const glm::vec2& position)
+{
+	return glm::ivec2{ glm::floor(position / CELL_SIZE) };
+}
+
+uint64_t RenderCullGrid::GetCellKey(const glm::ivec2& coord)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) << 32) | static_cast<uint32_t>(coord.y);
+}
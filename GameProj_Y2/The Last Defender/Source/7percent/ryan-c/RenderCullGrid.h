@@ -0,0 +1,222 @@
+/******************************************************************************/
+/*!
+\file   RenderCullGrid.h
+\par    Project: 7percent
+\par    Course: CSD2401
+\par    Section B
+\par    Software Engineering Project 4
+\date   10/17/2026
+
+\author Kendrick Sim Hean Guan (100%)
+\par    email: kendrickheanguan.s\@digipen.edu
+\par    DigiPen login: kendrickheanguan.s
+
+\brief
+  This is the interface file for a coarse spatial grid of static render
+  components, which lets the renderer reject off screen sprites by cell
+  instead of testing each one against the view.
+
+All content © 2024 DigiPen Institute of Technology Singapore.
+All rights reserved.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "RenderComponent.h"
+
+/*****************************************************************//*!
+\class RenderCullGrid
+\brief
+	Buckets render components whose transforms haven't changed for a while into fixed size world space cells.
+	Each frame, only the cells overlapping the view are visited, and the components within them are marked visible.
+	Static components that weren't marked are off screen, and are rejected without looking up their sprite or material.
+	Components are taken out of the grid as soon as their transform changes, and are bucketed again once they settle.
+*//******************************************************************/
+class RenderCullGrid
+{
+public:
+	using Handle = RenderComponent::CullGridHandle;
+
+	/*****************************************************************//*!
+	\brief
+		Starts a frame. Marks the components in cells overlapping the view as visible,
+		and periodically forgets components that are no longer being drawn.
+	\param viewMin
+		The world space minimum corner of the area that can be seen.
+	\param viewMax
+		The world space maximum corner of the area that can be seen.
+	*//******************************************************************/
+	void BeginFrame(const glm::vec2& viewMin, const glm::vec2& viewMax);
+
+	/*****************************************************************//*!
+	\brief
+		Tracks a render component that is to be drawn this frame, and checks whether it is static and off screen.
+		Components that aren't culled should still be tested against the view individually, since cells are coarse.
+	\param renderComp
+		The render component.
+	\param entity
+		The entity of the render component.
+	\param transform
+		The transform of the entity.
+	\return
+		True if the component is in the grid and outside every visible cell. False otherwise.
+	*//******************************************************************/
+	bool IsCulled(const RenderComponent& renderComp, ecs::ConstEntityHandle entity, const Transform& transform);
+
+	/*****************************************************************//*!
+	\brief
+		Gets the half extents of a box that contains a sprite at any rotation. Rotated sprites use the circle through
+		their corners, which needs no trig and always contains the sprite.
+	\param size
+		The world scale of the sprite.
+	\param rotation
+		The world rotation of the sprite.
+	\return
+		The half extents of the box.
+	*//******************************************************************/
+	static glm::vec2 GetSpriteHalfExtents(const glm::vec2& size, float rotation);
+
+	/*****************************************************************//*!
+	\brief
+		Gets the number of render components currently bucketed into the grid.
+	\return
+		The number of static render components.
+	*//******************************************************************/
+	uint32_t GetNumStatic() const;
+
+	/*****************************************************************//*!
+	\brief
+		Gets the number of cells that have held components.
+	\return
+		The number of cells.
+	*//******************************************************************/
+	uint32_t GetNumCells() const;
+
+private:
+	//! The world space length of each side of a cell.
+	static constexpr float CELL_SIZE{ 512.0f };
+	//! The number of consecutive frames a component's transform must not change for before it is bucketed.
+	static constexpr uint32_t FRAMES_TO_STATIC{ 30 };
+	//! Components spanning more cells than this, such as backgrounds, are left out of the grid.
+	static constexpr int MAX_CELLS_PER_ENTRY{ 64 };
+	//! The number of frames between checks for components that are no longer drawn, and how long they must not be drawn for to be forgotten.
+	static constexpr uint64_t FRAMES_TO_FORGET{ 60 };
+
+	/*****************************************************************//*!
+	\struct Entry
+	\brief
+		A render component tracked by the grid.
+	*//******************************************************************/
+	struct Entry
+	{
+		//! The entity of the component. nullptr if this entry is unused.
+		ecs::ConstEntityHandle entity;
+		//! Incremented whenever this entry is freed, so that handles to the previous component are invalidated.
+		uint32_t generation;
+		//! The change stamp of the entity's transform when last seen.
+		uint32_t transformStamp;
+		//! The number of consecutive frames the entity's transform hasn't changed for.
+		uint32_t numUnchangedFrames;
+		//! Whether the component is bucketed into cells.
+		bool isBucketed;
+		//! Whether the component can't be bucketed until its transform changes, e.g. because it is too large.
+		bool isExcluded;
+		//! The last frame the component was drawn.
+		uint64_t lastDrawnFrame;
+		//! The last frame the component was within a visible cell.
+		uint64_t visibleFrame;
+		//! The minimum cell that the component overlaps, while bucketed.
+		glm::ivec2 minCell;
+		//! The maximum cell that the component overlaps, while bucketed.
+		glm::ivec2 maxCell;
+	};
+
+	/*****************************************************************//*!
+	\struct Cell
+	\brief
+		The components bucketed into an area of the world.
+	*//******************************************************************/
+	struct Cell
+	{
+		//! The coordinates of this cell.
+		glm::ivec2 coord;
+		//! The indexes of the entries bucketed into this cell.
+		std::vector<uint32_t> entries;
+	};
+
+	/*****************************************************************//*!
+	\brief
+		Starts tracking a component.
+	\param entity
+		The entity of the component.
+	\param transformStamp
+		The current change stamp of the entity's transform.
+	\return
+		The index of the new entry.
+	*//******************************************************************/
+	uint32_t AddEntry(ecs::ConstEntityHandle entity, uint32_t transformStamp);
+
+	/*****************************************************************//*!
+	\brief
+		Stops tracking a component, taking it out of its cells.
+	\param index
+		The index of the entry.
+	*//******************************************************************/
+	void RemoveEntry(uint32_t index);
+
+	/*****************************************************************//*!
+	\brief
+		Buckets a component into the cells that it overlaps, unless it occludes light or is too large.
+		Occluders are left out as their shadows must be built even while they're off screen.
+	\param index
+		The index of the component's entry.
+	\param renderComp
+		The render component.
+	\param transform
+		The transform of the component's entity.
+	\return
+		True if the component was bucketed. False otherwise.
+	*//******************************************************************/
+	bool Bucket(uint32_t index, const RenderComponent& renderComp, const Transform& transform);
+
+	/*****************************************************************//*!
+	\brief
+		Takes a component out of the cells it was bucketed into.
+	\param index
+		The index of the component's entry.
+	*//******************************************************************/
+	void Unbucket(uint32_t index);
+
+	/*****************************************************************//*!
+	\brief
+		Gets the cell containing a world position.
+	\param position
+		The world position.
+	\return
+		The coordinates of the cell.
+	*//******************************************************************/
+	static glm::ivec2 GetCellCoord(const glm::vec2& position);
+
+	/*****************************************************************//*!
+	\brief
+		Gets the key of a cell within the cell map.
+	\param coord
+		The coordinates of the cell.
+	\return
+		The key of the cell.
+	*//******************************************************************/
+	static uint64_t GetCellKey(const glm::ivec2& coord);
+
+	//! The tracked components, indexed by handles. Unused entries are reused.
+	std::vector<Entry> entries;
+	//! The indexes of unused entries.
+	std::vector<uint32_t> freeEntries;
+	//! The cells that have held components, by key.
+	std::unordered_map<uint64_t, Cell> cells;
+	//! The cells overlapping the view this frame.
+	glm::ivec2 viewMinCell{}, viewMaxCell{};
+	//! The current frame, incremented by BeginFrame().
+	uint64_t frame{};
+	//! The number of entries that are bucketed.
+	uint32_t numBucketed{};
+};
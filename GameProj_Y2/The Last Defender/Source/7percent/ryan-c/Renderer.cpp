@@ -33,6 +33,7 @@ All rights reserved.
 #include "DescriptorSetManager.h"
 #include "Engine.h"
 #include "TextureManager.h"
+#include "JobSystem.h"
 
 Renderer::Renderer(VulkanContext* context) : m_context(context) {
 }
@@ -1555,7 +1556,94 @@ void Renderer::renderDebugBounds(const Transform& transform)
 	AddLineInstance(corners[2], corners[0], lineColor);
 }
 
-void Renderer::AddRenderInstance(const RenderComponent& render_component) {
+void Renderer::BeginRenderQueue() {
+	m_cullingStats = CullingStats{};
+	m_cullRect = getCullRect();
+	m_cullGrid.BeginFrame(m_cullRect.min, m_cullRect.max);
+}
+
+void Renderer::QueueRenderInstance(const RenderComponent& render_component) {
+	ecs::ConstEntityHandle entity = ecs::GetEntity(&render_component);
+	const Transform& transform = entity->GetTransform();
+
+	// Static components in cells outside the view are rejected before anything else about them is looked up
+	if(m_cullGrid.IsCulled(render_component, entity, transform)) {
+		++m_cullingStats.numCulled;
+		++m_cullingStats.numCulledByGrid;
+		return;
+	}
+
+	// Resolve dirty world matrices here, as extraction jobs may share parents and must only read transforms
+	transform.UpdateWorldMat();
+
+	// Sprites are looked up here too, since looking one up may load its texture, which must only happen on the main thread
+	const Sprite* sprite = nullptr;
+	if(ResourceManager::SpriteExists(render_component.GetSpriteID())) {
+		sprite = &ResourceManager::GetSprite(render_component.GetSpriteID());
+		if(sprite->textureID == ResourceManager::INVALID_TEXTURE_ID) {
+			sprite = nullptr;
+		}
+	}
+	m_renderExtractQueue.push_back(RenderExtractItem{ &render_component, sprite });
+}
+
+void Renderer::ExtractRenderInstances() {
+	uint32_t numComps = static_cast<uint32_t>(m_renderExtractQueue.size());
+	m_cullingStats.numStatic = m_cullGrid.GetNumStatic();
+	if(numComps == 0) {
+		return;
+	}
+
+	uint32_t numChunks = (numComps + RENDER_EXTRACT_CHUNK_SIZE - 1) / RENDER_EXTRACT_CHUNK_SIZE;
+	if(m_renderExtractOutputs.size() < numChunks) {
+		m_renderExtractOutputs.resize(numChunks);
+	}
+
+	const CullRect& cullRect = m_cullRect;
+	auto extractChunk = [this, &cullRect](uint32_t chunkIndex, uint32_t begin, uint32_t end) {
+		RenderExtractOutput& out = m_renderExtractOutputs[chunkIndex];
+		out.clear();
+		for(uint32_t i = begin; i < end; ++i) {
+			extractRenderInstance(m_renderExtractQueue[i], cullRect, out);
+		}
+	};
+	if(numChunks == 1) {
+		extractChunk(0, 0, numComps);
+	}
+	else {
+		ST<JobSystem>::Get()->ParallelFor(numComps, RENDER_EXTRACT_CHUNK_SIZE, extractChunk);
+	}
+
+	// Merge in chunk order so everything stays in the order components were queued, which is the order equal depths are drawn in
+	auto& blockers = m_lightingSystem.frameStates[m_context->getCurrentFrameNumber()].blockers;
+	for(uint32_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex) {
+		const RenderExtractOutput& out = m_renderExtractOutputs[chunkIndex];
+		m_spriteBatches.lit.insert(m_spriteBatches.lit.end(), out.lit.begin(), out.lit.end());
+		m_spriteBatches.non_lit.insert(m_spriteBatches.non_lit.end(), out.non_lit.begin(), out.non_lit.end());
+		blockers.insert(blockers.end(), out.blockers.begin(), out.blockers.end());
+		for(const Transform* transform : out.debugBounds) {
+			renderDebugBounds(*transform);
+		}
+		m_cullingStats.numCulled += out.numCulled;
+		m_cullingStats.numDrawn += static_cast<uint32_t>(out.lit.size() + out.non_lit.size());
+	}
+	m_renderExtractQueue.clear();
+}
+
+const Renderer::CullingStats& Renderer::getCullingStats() const {
+	return m_cullingStats;
+}
+
+void Renderer::RenderExtractOutput::clear() {
+	lit.clear();
+	non_lit.clear();
+	blockers.clear();
+	debugBounds.clear();
+	numCulled = 0;
+}
+
+void Renderer::extractRenderInstance(const RenderExtractItem& item, const CullRect& cullRect, RenderExtractOutput& out) const {
+	const RenderComponent& render_component = *item.render_component;
 	const auto& transform = ecs::GetEntityTransform(&render_component);
 	const auto& materialInstance = render_component.GetMaterialInstance();
 
@@ -1580,18 +1668,17 @@ void Renderer::AddRenderInstance(const RenderComponent& render_component) {
 	glm::vec2 position = transform.GetWorldPosition();
 	glm::vec2 scale = transform.GetWorldScale();
 	if(materialFlags & MaterialFlags::OccludesLight) {
-		uint32_t frameIndex = m_context->getCurrentFrameNumber();
-		m_lightingSystem.addBlocker(transform, frameIndex);
+		LightingManager::addBlocker(transform, out.blockers);
 	}
-	if(!isInViewport(position, scale, transform.GetWorldRotation())) {
+	if(!isInCullRect(cullRect, position, scale, transform.GetWorldRotation())) {
+		++out.numCulled;
 		return;
 	}
 
 	// Validate sprite resource integrity
-	const Sprite* sprite = &ResourceManager::GetSprite(render_component.GetSpriteID());
-	if(!ResourceManager::SpriteExists(render_component.GetSpriteID()) ||
-		 sprite->textureID == ResourceManager::INVALID_TEXTURE_ID) {
-		renderDebugBounds(transform);
+	const Sprite* sprite = item.sprite;
+	if(!sprite) {
+		out.debugBounds.push_back(&transform);
 		return;
 	}
 
@@ -1636,89 +1723,25 @@ void Renderer::AddRenderInstance(const RenderComponent& render_component) {
 
 	// Add to appropriate batch based on lighting needs
 	if(materialFlags & MaterialFlags::ReceivesLight) {
-		m_spriteBatches.lit.push_back(data);
+		out.lit.push_back(data);
 	}
 	else {
-		m_spriteBatches.non_lit.push_back(data);
+		out.non_lit.push_back(data);
 	}
 }
 
 void Renderer::AddTextInstance(const TextComponent& text_component) {
-	const auto& atlas = ResourceManager::GetFont(text_component.GetFontHash());
-	std::string const text = text_component.GetText();
 	const auto& transform = ecs::GetEntityTransform(&text_component);
-	auto textureIndex = atlas.textureID;
-	uint32_t previousChar = 0;
-
-	bool UI = text_component.isUI();
-
-	glm::vec2 scale = transform.GetWorldScale();
-	glm::vec2 baselineOffset = glm::vec2(0, atlas.ascender * scale.y);
 	glm::vec2 TextScale{ text_component.GetWorldTextTransform().GetWorldScale() };
 
-	// Get the pre-calculated starting position
-	glm::vec2 currentPos{ text_component.GetTextStart() };
-
-	if(!isInViewport(currentPos, TextScale, transform.GetWorldRotation())) {
+	if(!isInViewport(text_component.GetTextStart(), TextScale, transform.GetWorldRotation())) {
 		return;
 	}
 
-	previousChar = 0;
-	for(char const c : text) {
-		uint32_t currentChar = static_cast<uint32_t>(c);
-		if(currentChar < FontAtlas::FIRST_CHAR || currentChar > FontAtlas::LAST_CHAR) continue;
-
-		size_t glyphIndex = currentChar - FontAtlas::FIRST_CHAR;
-		const Glyph& glyph = atlas.glyphs[glyphIndex];
-
-		if(previousChar != 0) {
-			float kerning = atlas.getKerning(previousChar, currentChar);
-			currentPos.x += kerning * scale.x;
-		}
-
-		glm::vec2 pos = currentPos + baselineOffset;
-		float glyphCenterOffsetX = (glyph.planeBounds[0].x + glyph.planeBounds[1].x) * scale.x * 0.5f;
-		float glyphCenterOffsetY = (glyph.planeBounds[0].y + glyph.planeBounds[1].y) * scale.y * 0.5f;
-
-		pos.x += glyphCenterOffsetX;
-		pos.y -= glyphCenterOffsetY;
-
-		glm::vec2 quadSize = {
-			(glyph.planeBounds[1].x - glyph.planeBounds[0].x) * scale.x,
-			(glyph.planeBounds[1].y - glyph.planeBounds[0].y) * scale.y
-		};
-
-		glm::mat4 model = glm::mat4(1.0f);
-		model = translate(model, glm::vec3(pos, transform.GetZPos()));
-		model = glm::scale(model, glm::vec3(quadSize.x, quadSize.y, 1.0f));
-
-		glm::vec4 texCoords;
-		texCoords.x = glyph.atlasBounds[0].x / atlas.width;
-		texCoords.y = 1.0f - (glyph.atlasBounds[1].y / atlas.height);
-		texCoords.z = (glyph.atlasBounds[1].x - glyph.atlasBounds[0].x) / atlas.width;
-		texCoords.w = (glyph.atlasBounds[1].y - glyph.atlasBounds[0].y) / atlas.height;
-
-		uint32_t flag;
-
-		glm::vec4 color = text_component.GetColor();
-		flag = RENDER_FLAG_TEXT;
-		if(UI)
-		{
-			m_spriteBatches.non_lit.emplace_back(model,
-																					 color,
-																					 texCoords,
-																					 textureIndex, flag);
-		}
-		else
-		{
-			m_spriteBatches.lit.emplace_back(model,
-																			 color,
-																			 texCoords,
-																			 textureIndex, flag);
-		}
-		currentPos.x += (glyph.advance * scale.x);
-		previousChar = currentChar;
-	}
+	// Glyphs are only laid out again when the text changes, so the component's cached run is copied straight into the batch
+	const auto& glyphs = text_component.GetGlyphInstances();
+	auto& batch = text_component.isUI() ? m_spriteBatches.non_lit : m_spriteBatches.lit;
+	batch.insert(batch.end(), glyphs.begin(), glyphs.end());
 }
 
 void Renderer::AddTrailInstance(const TrailRendererComponent& trailComp)
@@ -2094,7 +2117,7 @@ void Renderer::LightingManager::addLight(const LightComponent& light, uint32_t f
 	frameStates[frameIndex].lightData.emplace_back(shadowData);
 }
 
-void Renderer::LightingManager::addBlocker(const Transform& transform, uint32_t frameIndex) {
+void Renderer::LightingManager::addBlocker(const Transform& transform, std::vector<ShadowCaster>& blockers) {
 	glm::vec2 position = transform.GetWorldPosition();
 	glm::vec2 scale = transform.GetWorldScale();
 	float rad = -glm::radians(transform.GetWorldRotation());
@@ -2113,7 +2136,6 @@ void Renderer::LightingManager::addBlocker(const Transform& transform, uint32_t
 	corners[2] = position + rotMat * glm::vec2(halfScale.x, halfScale.y);   // Top-right
 	corners[3] = position + rotMat * glm::vec2(-halfScale.x, halfScale.y);  // Top-left
 
-	auto& blockers = frameStates[frameIndex].blockers;
 	// Ensure deterministic vertex order for each line segment
 	blockers.emplace_back(ShadowCaster{ corners[0], corners[1] }); // Bottom
 	blockers.emplace_back(ShadowCaster{ corners[1], corners[2] }); // Right
@@ -2283,9 +2305,9 @@ void Renderer::LightingManager::updateLightingData(uint32_t frameIndex)
 	vmaGetAllocationInfo(VulkanManager::Get().VkAllocator(),
 											 lightResources.lightPropertiesBuffer._allocation, &propsAllocInfo);
 
-	// Zero-initialize entire buffers
-	memset(lightAllocInfo.pMappedData, 0, sizeof(LightData) * MAX_ACTIVE_LIGHTS);
-	memset(propsAllocInfo.pMappedData, 0, sizeof(GPULightProperties) * MAX_ACTIVE_LIGHTS);
+	// Zero-initialize the unused tail of the buffers. Active entries are overwritten below, so each byte is only written once.
+	memset(static_cast<LightData*>(lightAllocInfo.pMappedData) + lightData.size(), 0, sizeof(LightData) * (MAX_ACTIVE_LIGHTS - lightData.size()));
+	memset(static_cast<GPULightProperties*>(propsAllocInfo.pMappedData) + lightProps.size(), 0, sizeof(GPULightProperties) * (MAX_ACTIVE_LIGHTS - lightProps.size()));
 
 	// Direct memory transfer of pre-initialized active entries
 	if(!lightData.empty()) {
@@ -3104,44 +3126,50 @@ void Renderer::updateCameraBuffer() {
 }
 
 template <typename InstanceType, typename ZDepthFunc >
-void Renderer::updateInstanceBuffer(std::vector<InstanceType>& instances, AllocatedBuffer& instanceBuffer,
+void Renderer::updateInstanceBuffer(const std::vector<InstanceType>& instances, AllocatedBuffer& instanceBuffer,
 																		VkDeviceSize& bufferSize, ZDepthFunc getZDepth
 ) const {
-	// Sort instances by Z depth using the provided accessor function
-	std::ranges::stable_sort(instances, [&getZDepth](const auto& a, const auto& b) {
-		return getZDepth(a) < getZDepth(b);
-	});
+	void* mappedData = reserveInstanceBuffer(instanceBuffer, bufferSize, sizeof(InstanceType) * instances.size());
 
-	VkDeviceSize requiredSize = sizeof(InstanceType) * instances.size();
+	// Sort instances by Z depth using the provided accessor function, writing them straight into the buffer in sorted order
+	if(mappedData != nullptr) {
+		m_drawKeySorter.SortInto(instances, getZDepth, static_cast<InstanceType*>(mappedData));
+	}
+}
+
+void* Renderer::reserveInstanceBuffer(AllocatedBuffer& instanceBuffer, VkDeviceSize& bufferSize, VkDeviceSize requiredSize) const {
 	VmaAllocationInfo mapped_alloc_info{};
 
 	if(instanceBuffer._buffer == VK_NULL_HANDLE || requiredSize > bufferSize) {
-		// Create or recreate the buffer if it doesn't exist or is too small
+		// Every frame in flight has its own instance buffers, and drawFrame() waits on this frame's fence before recording,
+		// so the GPU is done with the old buffer and it can be destroyed right away
 		if(instanceBuffer._buffer != VK_NULL_HANDLE) {
 			vmaDestroyBuffer(VulkanManager::Get().VkAllocator(), instanceBuffer._buffer, instanceBuffer._allocation);
 		}
 
+		// Grow geometrically so that instance counts creeping upwards don't recreate the buffer every frame
+		VkDeviceSize newSize = std::max({ requiredSize, bufferSize * 2, Constant::MIN_INSTANCE_BUFFER_SIZE });
+
 		VkBufferCreateInfo bufferInfo = {};
 		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		bufferInfo.size = requiredSize;
+		bufferInfo.size = newSize;
 		bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
 
+		// Stays mapped for the buffer's lifetime. Instances are only ever written front to back, never read back.
 		VmaAllocationCreateInfo allocInfo = {};
 		allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-		allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+		allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
 
 		vmaCreateBuffer(VulkanManager::Get().VkAllocator(), &bufferInfo, &allocInfo,
 										&instanceBuffer._buffer, &instanceBuffer._allocation, &mapped_alloc_info);
 
-		bufferSize = requiredSize;
+		bufferSize = newSize;
 	}
 	else {
 		vmaGetAllocationInfo(VulkanManager::Get().VkAllocator(), instanceBuffer._allocation, &mapped_alloc_info);
 	}
 
-	if(mapped_alloc_info.pMappedData != nullptr) {
-		memcpy(mapped_alloc_info.pMappedData, instances.data(), requiredSize);
-	}
+	return mapped_alloc_info.pMappedData;
 }
 
 void Renderer::updateTextureBuffer(std::vector<SpriteInstanceData>& sprites, AllocatedBuffer& instanceBuffer, VkDeviceSize& _instanceBufferSize) const
@@ -3192,81 +3220,41 @@ void Renderer::updateTextureBuffer(std::vector<SpriteInstanceData>& sprites, All
 void Renderer::updateLineBuffer()
 {
 	VkDeviceSize bufferSize = sizeof(LineInstanceData) * _lines.size();
-	VmaAllocationInfo mapped_alloc_info{};
 
 	auto& lineBuffer = m_context->getCurrentFrame().debugInstanceBuffer;
 	auto& _lineBufferSize = m_context->getCurrentFrame()._lineBufferSize;
 
-	if(lineBuffer._buffer == VK_NULL_HANDLE || bufferSize > _lineBufferSize) {
-		// Create or recreate the buffer if it doesn't exist or is too small
-		if(lineBuffer._buffer != VK_NULL_HANDLE) {
-			vmaDestroyBuffer(VulkanManager::Get().VkAllocator(), lineBuffer._buffer, lineBuffer._allocation);
-		}
-
-		VkBufferCreateInfo bufferInfo = {};
-		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		bufferInfo.size = bufferSize;
-		bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-
-		VmaAllocationCreateInfo allocInfo = {};
-		allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-		allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
-
-		vmaCreateBuffer(VulkanManager::Get().VkAllocator(), &bufferInfo, &allocInfo, &lineBuffer._buffer, &lineBuffer._allocation, &mapped_alloc_info);
-
-		_lineBufferSize = bufferSize;
-	}
-	else
-	{
-		vmaGetAllocationInfo(VulkanManager::Get().VkAllocator(), lineBuffer._allocation, &mapped_alloc_info);
-	}
-	if(mapped_alloc_info.pMappedData != nullptr)
+	void* mappedData = reserveInstanceBuffer(lineBuffer, _lineBufferSize, bufferSize);
+	if(mappedData != nullptr && bufferSize > 0)
 	{
-		memcpy(mapped_alloc_info.pMappedData, _lines.data(), bufferSize);//
+		memcpy(mappedData, _lines.data(), bufferSize);
 	}
 }
 bool Renderer::isInViewport(const glm::vec2& position, const glm::vec2& size, float rotation = 0.0f) const {
-    // Calculate buffer size
-    float bufferX = m_viewport.width * 0.1f;
-    float bufferY = std::abs(m_viewport.height) * 0.1f;
-
-		rotation = glm::radians(rotation);
-		// Check if the object is within the viewport, including the buffer zone
-    // For non-rotated entities, use the original faster AABB method
-    if (rotation == 0.0f || fmod(rotation, glm::two_pi<float>()) == 0.0f) {
-        // Convert world coordinates to screen coordinates
-        glm::vec2 screenPos = (position - m_cameraPosition) * m_zoom + glm::vec2(m_viewport.width / 2, std::abs(m_viewport.height) / 2);
-        glm::vec2 screenSize = size * m_zoom;
-        // Check if the object is within the viewport, including the buffer zone
-        return (screenPos.x + screenSize.x / 2 >= -bufferX &&
-                screenPos.x - screenSize.x / 2 <= m_viewport.width + bufferX &&
-                screenPos.y + screenSize.y / 2 >= -bufferY &&
-                screenPos.y - screenSize.y / 2 <= std::abs(m_viewport.height) + bufferY);
+    return isInCullRect(getCullRect(), position, size, rotation);
+}
+
+Renderer::CullRect Renderer::getCullRect() const {
+    // Use the camera as it will be drawn this frame, rather than what was last uploaded
+    const CameraData& camera = ST<CameraController>::Get()->GetCameraData();
+
+    // The viewport plus the buffer zone on each side, converted from screen to world units
+    glm::vec2 halfExtents = glm::vec2(m_viewport.width, std::abs(m_viewport.height)) * (0.5f + VIEWPORT_CULL_BUFFER) / camera.zoom;
+    // A rotated camera sees the viewport turned around its center, which always fits within the circle through its corners
+    if (camera.rotation != 0.0f) {
+        halfExtents = glm::vec2(glm::length(halfExtents));
     }
-    
-    // For rotated entities, calculate a bounding box that encompasses the rotated entity
-    
-    // Calculate half-size
-    float halfWidth = size.x / 2.0f;
-    float halfHeight = size.y / 2.0f;
-    
-    // Calculate the absolute values of sine and cosine of rotation angle
-    float cosA = std::abs(std::cos(rotation));
-    float sinA = std::abs(std::sin(rotation));
-    
-    // Calculate the maximum extent of the rotated box (projected onto x and y axes)
-    // This creates an AABB that fully contains the rotated box
-    float maxExtentX = halfWidth * cosA + halfHeight * sinA;
-    float maxExtentY = halfWidth * sinA + halfHeight * cosA;
-    
-    // Convert world coordinates to screen coordinates
-    glm::vec2 screenPos = (position - m_cameraPosition) * m_zoom + glm::vec2(m_viewport.width / 2, std::abs(m_viewport.height) / 2);
-    float screenExtentX = maxExtentX * m_zoom;
-    float screenExtentY = maxExtentY * m_zoom;
-    
-    // Check if the enlarged AABB overlaps with the viewport including buffer
-    return (screenPos.x + screenExtentX >= -bufferX &&
-            screenPos.x - screenExtentX <= m_viewport.width + bufferX &&
-            screenPos.y + screenExtentY >= -bufferY &&
-            screenPos.y - screenExtentY <= std::abs(m_viewport.height) + bufferY);
+
+    glm::vec2 center{ camera.position.x, camera.position.y };
+    return CullRect{ center - halfExtents, center + halfExtents };
+}
+
+bool Renderer::isInCullRect(const CullRect& cullRect, const glm::vec2& position, const glm::vec2& size, float rotation) {
+    // A rotated sprite always fits within the circle through its corners, so there's no need to find its rotated bounds
+    glm::vec2 halfExtents = RenderCullGrid::GetSpriteHalfExtents(size, rotation);
+
+    return (position.x + halfExtents.x >= cullRect.min.x &&
+            position.x - halfExtents.x <= cullRect.max.x &&
+            position.y + halfExtents.y >= cullRect.min.y &&
+            position.y - halfExtents.y <= cullRect.max.y);
 }
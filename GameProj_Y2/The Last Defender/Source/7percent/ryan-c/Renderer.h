@@ -22,11 +22,13 @@ All rights reserved.
 
 
 #include "CameraController.h"
+#include "DrawKeys.h"
 #include "LightingSystem.h"
 #include "Mesh3D.h"
 #include "RenderComponent.h"
 #include "LightComponent.h"
 #include "PostProcessingComponent.h"
+#include "RenderCullGrid.h"
 #include "TextComponent.h"
 #include "TextureManager.h"
 #include "TrailComponent.h"
@@ -34,6 +36,8 @@ All rights reserved.
 #include "VulkanManager.h"
 #include "VkInit.h"
 
+class Sprite;
+
 class Renderer {
     friend class VulkanContext;
     friend class LightResources;
@@ -64,7 +68,17 @@ class Renderer {
     void ResetPostProcessing();
 
     void renderDebugBounds(const Transform& transform);
-    void AddRenderInstance(const RenderComponent& render_component);
+    // Render components are queued as the render system visits them, then turned into sprite instances and shadow blockers on worker threads
+    void BeginRenderQueue();
+    void QueueRenderInstance(const RenderComponent& render_component);
+    void ExtractRenderInstances();
+    struct CullingStats {
+        uint32_t numCulled{};       // render components outside the view last frame
+        uint32_t numCulledByGrid{}; // of those, static ones rejected by their cull grid cell without being queued
+        uint32_t numDrawn{};        // sprite instances extracted from render components last frame
+        uint32_t numStatic{};       // render components bucketed into the cull grid
+    };
+    const CullingStats& getCullingStats() const;
     void AddTextInstance(const TextComponent& text_component);
     void AddTrailInstance(const TrailRendererComponent& trailComp);
     void AddLineInstance(const glm::vec2& start, const glm::vec2& end, const glm::vec4& color);
@@ -101,6 +115,7 @@ class Renderer {
         void clear();
     };
     SpriteBatches m_spriteBatches;
+    mutable DrawKeySorter m_drawKeySorter; // Only holds scratch keys, so instance buffers can be updated from const functions
     //std::vector<SpriteInstanceData> m_finalSpriteBuffer; // Buffer for GPU upload
     //std::vector<TextInstanceData> _glyphs;
     std::vector<LineInstanceData> _lines;
@@ -260,7 +275,7 @@ class Renderer {
         void cleanup();
 
         void addLight(const LightComponent& light, uint32_t frameIndex);
-        void addBlocker(const Transform& transform, uint32_t frameIndex);
+        static void addBlocker(const Transform& transform, std::vector<ShadowCaster>& blockers);
 
         void updateLightingData(uint32_t frameIndex);
 
@@ -276,8 +291,41 @@ class Renderer {
 
     void resizeAllTargets();
     void updateCameraBuffer();
+    // What one chunk of queued render components turned into, merged into the frame in chunk order
+    struct RenderExtractOutput {
+        std::vector<SpriteInstanceData> lit;
+        std::vector<SpriteInstanceData> non_lit;
+        std::vector<LightingManager::ShadowCaster> blockers;
+        std::vector<const Transform*> debugBounds; // sprites without a valid texture, drawn as lines once merged
+        uint32_t numCulled{};
+        void clear();
+    };
+    static constexpr uint32_t RENDER_EXTRACT_CHUNK_SIZE = 256; // render components extracted by each job
+    // A queued render component with its sprite, which is looked up when queueing since a lookup may load the sprite's texture
+    struct RenderExtractItem {
+        const RenderComponent* render_component;
+        const Sprite* sprite; // nullptr if the sprite doesn't exist or has no valid texture
+    };
+    std::vector<RenderExtractItem> m_renderExtractQueue;
+    std::vector<RenderExtractOutput> m_renderExtractOutputs; // one per chunk, kept between frames to reuse their memory
+    CullingStats m_cullingStats;
+
+    // World space rectangle that can be seen, computed once per frame so that each sprite's test is a few comparisons
+    struct CullRect {
+        glm::vec2 min;
+        glm::vec2 max;
+    };
+    static constexpr float VIEWPORT_CULL_BUFFER = 0.1f; // fraction of the viewport kept around it, so sprites don't pop in at the edges
+    CullRect getCullRect() const;
+    CullRect m_cullRect{}; // the area seen this frame, found when queueing begins
+    RenderCullGrid m_cullGrid;
+    static bool isInCullRect(const CullRect& cullRect, const glm::vec2& position, const glm::vec2& size, float rotation);
+    void extractRenderInstance(const RenderExtractItem& item, const CullRect& cullRect, RenderExtractOutput& out) const;
+
+    // Returns the persistently mapped memory of a per-frame instance buffer, growing it if it can't hold requiredSize bytes
+    void* reserveInstanceBuffer(AllocatedBuffer& instanceBuffer, VkDeviceSize& bufferSize, VkDeviceSize requiredSize) const;
     template<typename InstanceType , typename ZDepthFunc>
-    void updateInstanceBuffer(std::vector<InstanceType>& instances, 
+    void updateInstanceBuffer(const std::vector<InstanceType>& instances, 
                                    AllocatedBuffer& instanceBuffer, 
                                    VkDeviceSize& bufferSize,
                                    ZDepthFunc getZDepth) const;
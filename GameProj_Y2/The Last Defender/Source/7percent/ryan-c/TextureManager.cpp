@@ -300,7 +300,7 @@ FontAtlas TextureManager::loadJsonData(const std::string& jsonPath) {
 			uint32_t unicode1 = kerningObj["unicode1"].GetUint();
 			uint32_t unicode2 = kerningObj["unicode2"].GetUint();
 			float advance = kerningObj["advance"].GetFloat();
-			atlas.kerningMap[{unicode1, unicode2}] = advance;
+			atlas.setKerning(unicode1, unicode2, advance);
 		}
 	}
 	return atlas;
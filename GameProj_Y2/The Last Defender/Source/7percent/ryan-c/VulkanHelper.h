@@ -38,6 +38,7 @@ namespace Constant // for things that will never be changed.
   constexpr char name[] = "The Last Defender";
 #endif
   constexpr uint32_t MAX_TEXTURES = 1024;
+  constexpr VkDeviceSize MIN_INSTANCE_BUFFER_SIZE = 64 * 1024; // instance buffers start at this size and double as needed
 #ifdef _NDEBUG
   constexpr bool enableValidationLayers = false;
 #else
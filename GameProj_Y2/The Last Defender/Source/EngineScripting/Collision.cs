@@ -27,4 +27,23 @@ namespace EngineScripting
             InternalCalls.Raycast(origin, direction, layerMask, out hit);
         }
     }
+
+    public class Overlap
+    {
+        // Results are written into the arrays passed in, so that they can be reused between calls.
+        // Returns the number of entities written. No more entities are found than fit in the arrays.
+        public static int Box(Vector2 center, Vector2 halfLengths, int layerMask, UInt64[] entities)
+        {
+            return InternalCalls.OverlapBox(center, halfLengths, layerMask, entities);
+        }
+        public static int Circle(Vector2 center, float radius, int layerMask, UInt64[] entities)
+        {
+            return InternalCalls.OverlapCircle(center, radius, layerMask, entities);
+        }
+        // Entities are sorted from nearest to furthest.
+        public static int Nearest(Vector2 point, float maxDistance, int layerMask, UInt64[] entities, float[] distances)
+        {
+            return InternalCalls.QueryNearest(point, maxDistance, layerMask, entities, distances);
+        }
+    }
 }
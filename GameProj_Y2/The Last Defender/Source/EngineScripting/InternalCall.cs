@@ -186,6 +186,15 @@ namespace EngineScripting
         internal extern static void Raycast(Vector2 origin, Vector2 direction, int layerMask, out RaycastHit hit);
         #endregion
 
+        #region Overlap Queries
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static int OverlapBox(Vector2 center, Vector2 halfLengths, int layerMask, UInt64[] entities);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static int OverlapCircle(Vector2 center, float radius, int layerMask, UInt64[] entities);
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static int QueryNearest(Vector2 point, float maxDistance, int layerMask, UInt64[] entities, float[] distances);
+        #endregion
+
         #region Entity
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         internal static extern object GetScriptInstance(UInt64 entityHandle, string scriptName);